@@ -9,6 +9,7 @@ set_property(CACHE ASCEMU_VERSION PROPERTY STRINGS Classic TBC WotLK Cata Mop)
 option(BUILD_ASCEMUSCRIPTS "Build AscEmu modules." ON)
 option(BUILD_TOOLS "Build AscEmu tools." OFF)
 option(BUILD_EXTRAS "Build AscEmu extra." OFF)
+option(BUILD_BENCHMARKS "Build AscEmu benchmarks and their checks." OFF)
 option(BUILD_EVENTSCRIPTS "Build ascEventScripts." ON)
 option(BUILD_INSTANCESCRIPTS "Build ascInstanceScripts." ON)
 option(BUILD_EXTRASCRIPTS "Build ascExtraScripts." ON)
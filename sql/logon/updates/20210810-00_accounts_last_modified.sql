@@ -0,0 +1,11 @@
+-- The logonserver only reloads accounts changed since its last reload
+
+ALTER TABLE `accounts`
+    ADD COLUMN `last_modified` TIMESTAMP NOT NULL DEFAULT CURRENT_TIMESTAMP ON UPDATE CURRENT_TIMESTAMP AFTER `joindate`,
+    ADD INDEX `last_modified` (`last_modified`),
+    ADD INDEX `banned` (`banned`),
+    ADD INDEX `muted` (`muted`);
+
+-- update logon_db_version
+
+UPDATE `logon_db_version` SET LastUpdate = '20210810-00_accounts_last_modified';
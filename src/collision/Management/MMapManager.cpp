@@ -66,8 +66,12 @@ namespace MMAP
         }
         else
         {
+            // other threads look up their maps while this one adds a new one
             if (thread_safe_environment)
+            {
+                std::unique_lock<std::shared_mutex> tileGuard(tileLock);
                 itr = loadedMMaps.insert(MMapDataSet::value_type(mapId, nullptr)).first;
+            }
             else
             {
                 sLogger.failure("Invalid mapId %u passed to MMapManager after startup in thread unsafe environment", mapId);
@@ -117,6 +121,7 @@ namespace MMAP
         MMapData* mmap_data = new MMapData(mesh);
         mmap_data->mmapLoadedTiles.clear();
 
+        std::unique_lock<std::shared_mutex> tileGuard(tileLock);
         itr->second = mmap_data;
         return true;
     }
@@ -189,9 +194,12 @@ namespace MMAP
         dtMeshHeader* header = (dtMeshHeader*)data;
         dtTileRef tileRef = 0;
 
+        std::unique_lock<std::shared_mutex> tileGuard(tileLock);
+
         // memory allocated for data is now managed by detour, and will be deallocated when the tile is removed
         if (dtStatusSucceed(mmap->navMesh->addTile(data, fileHeader.size, DT_TILE_FREE_DATA, 0, &tileRef)))
         {
+            ++navMeshGeneration;
             mmap->mmapLoadedTiles.insert(std::pair<uint32, dtTileRef>(packedGridPos, tileRef));
             ++loadedTiles;
             sLogger.debug("MMAP:loadMap: Loaded mmtile %04i[%02i, %02i] into %04i[%02i, %02i]", mapId, x, y, mapId, header->x, header->y);
@@ -229,6 +237,9 @@ namespace MMAP
 
         dtTileRef tileRef = mmap->mmapLoadedTiles[packedGridPos];
 
+        std::unique_lock<std::shared_mutex> tileGuard(tileLock);
+        ++navMeshGeneration;
+
         // unload, and mark as non loaded
         if (dtStatusFailed(mmap->navMesh->removeTile(tileRef, nullptr, nullptr)))
         {
@@ -258,6 +269,9 @@ namespace MMAP
             return false;
         }
 
+        std::unique_lock<std::shared_mutex> tileGuard(tileLock);
+        ++navMeshGeneration;
+
         // unload all tiles from given map
         MMapData* mmap = itr->second;
         for (MMapTileSet::iterator i = mmap->mmapLoadedTiles.begin(); i != mmap->mmapLoadedTiles.end(); ++i)
@@ -341,4 +355,33 @@ namespace MMAP
 
         return mmap->navMeshQueries[instanceId];
     }
+
+    dtNavMeshQuery const* MMapManager::GetWorkerNavMeshQuery(uint32 mapId)
+    {
+        MMapDataSet::const_iterator itr = GetMMapData(mapId);
+        if (itr == loadedMMaps.end())
+            return nullptr;
+
+        MMapData* mmap = itr->second;
+        const std::thread::id threadId = std::this_thread::get_id();
+
+        std::lock_guard<std::mutex> guard(mmap->workerQueryLock);
+
+        WorkerNavMeshQuerySet::const_iterator queryItr = mmap->workerNavMeshQueries.find(threadId);
+        if (queryItr != mmap->workerNavMeshQueries.end())
+            return queryItr->second;
+
+        dtNavMeshQuery* query = dtAllocNavMeshQuery();
+        ASSERT(query);
+        if (dtStatusFailed(query->init(mmap->navMesh, 1024)))
+        {
+            dtFreeNavMeshQuery(query);
+            sLogger.failure("Failed to initialize worker dtNavMeshQuery for mapId %04u", mapId);
+            return nullptr;
+        }
+
+        sLogger.debug("MMAP:GetWorkerNavMeshQuery: created worker dtNavMeshQuery for mapId %04u", mapId);
+        mmap->workerNavMeshQueries.insert(std::pair<std::thread::id, dtNavMeshQuery*>(threadId, query));
+        return query;
+    }
 }
@@ -24,7 +24,11 @@
 #include "DetourNavMesh.h"
 #include "DetourNavMeshQuery.h"
 
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -33,6 +37,7 @@ namespace MMAP
 {
     typedef std::unordered_map<uint32, dtTileRef> MMapTileSet;
     typedef std::unordered_map<uint32, dtNavMeshQuery*> NavMeshQuerySet;
+    typedef std::unordered_map<std::thread::id, dtNavMeshQuery*> WorkerNavMeshQuerySet;
 
     // dummy struct to hold map's mmap data
     struct MMapData
@@ -43,6 +48,9 @@ namespace MMAP
             for (NavMeshQuerySet::iterator i = navMeshQueries.begin(); i != navMeshQueries.end(); ++i)
                 dtFreeNavMeshQuery(i->second);
 
+            for (WorkerNavMeshQuerySet::iterator i = workerNavMeshQueries.begin(); i != workerNavMeshQueries.end(); ++i)
+                dtFreeNavMeshQuery(i->second);
+
             if (navMesh)
                 dtFreeNavMesh(navMesh);
         }
@@ -52,6 +60,10 @@ namespace MMAP
         // we have to use single dtNavMeshQuery for every instance, since those are not thread safe
         NavMeshQuerySet navMeshQueries;     // instanceId to query
         MMapTileSet mmapLoadedTiles;        // maps [map grid coords] to [dtTile]
+
+        // pathfinding worker threads query the mesh concurrently to the map threads, each of them owns a query
+        std::mutex workerQueryLock;
+        WorkerNavMeshQuerySet workerNavMeshQueries;
     };
 
 
@@ -62,9 +74,10 @@ namespace MMAP
     class MMapManager
     {
         public:
-            MMapManager() : loadedTiles(0), thread_safe_environment(true) {}
+            MMapManager() : loadedTiles(0), thread_safe_environment(true), navMeshGeneration(0) {}
             ~MMapManager();
 
+            // registers all maps up front, loading a map afterwards never changes loadedMMaps itself
             void InitializeThreadUnsafe(const std::vector<uint32>& mapIds);
             bool loadMap(const std::string& basePath, uint32 mapId, int32 x, int32 y);
             bool unloadMap(uint32 mapId, int32 x, int32 y);
@@ -75,6 +88,16 @@ namespace MMAP
             dtNavMeshQuery const* GetNavMeshQuery(uint32 mapId, uint32 instanceId);
             dtNavMesh const* GetNavMesh(uint32 mapId);
 
+            // query owned by the calling thread, only valid while getTileLock() is held shared
+            dtNavMeshQuery const* GetWorkerNavMeshQuery(uint32 mapId);
+
+            // held exclusive while tiles are added or removed, threads other than the map threads
+            // have to hold it shared while they use a navmesh
+            std::shared_mutex& getTileLock() { return tileLock; }
+
+            // changes whenever a tile is added or removed, poly refs of an older generation may be stale
+            uint32 getNavMeshGeneration() const { return navMeshGeneration; }
+
             uint32 getLoadedTilesCount() const { return loadedTiles; }
             uint32 getLoadedMapsCount() const { return uint32(loadedMMaps.size()); }
         private:
@@ -85,6 +108,9 @@ namespace MMAP
             MMapDataSet loadedMMaps;
             uint32 loadedTiles;
             bool thread_safe_environment;
+
+            std::shared_mutex tileLock;
+            std::atomic<uint32> navMeshGeneration;
     };
 }
 
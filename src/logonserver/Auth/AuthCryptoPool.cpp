@@ -0,0 +1,131 @@
+/*
+Copyright (c) 2014-2021 AscEmu Team <http://www.ascemu.org>
+This file is released under the MIT license. See README-MIT for more information.
+*/
+
+#include "LogonStdAfx.h"
+#include "AuthCryptoPool.h"
+
+#include <algorithm>
+
+AuthCryptoPool& AuthCryptoPool::getInstance()
+{
+    static AuthCryptoPool mInstance;
+    return mInstance;
+}
+
+void AuthCryptoPool::initialize(uint32_t threadCount, uint32_t maxQueuedJobs)
+{
+    if (threadCount == 0 || !m_workers.empty())
+        return;
+
+    m_maxQueuedJobs = std::max(maxQueuedJobs, 1u);
+    m_shutdownRequested = false;
+
+    m_workers.reserve(threadCount);
+    for (uint32_t i = 0; i < threadCount; ++i)
+        m_workers.emplace_back(&AuthCryptoPool::workerRunner, this, i);
+
+    sLogger.info("AuthCryptoPool : Started %u workers, at most %u queued logins", threadCount, m_maxQueuedJobs);
+}
+
+void AuthCryptoPool::finalize()
+{
+    if (m_workers.empty())
+        return;
+
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        m_shutdownRequested = true;
+        m_jobs.clear();
+    }
+
+    m_condition.notify_all();
+
+    for (auto& worker : m_workers)
+        worker.join();
+
+    m_workers.clear();
+}
+
+bool AuthCryptoPool::addJob(AuthSocket* socket, std::function<void()> job)
+{
+    if (m_workers.empty())
+    {
+        job();
+        return true;
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        if (m_shutdownRequested || m_jobs.size() >= m_maxQueuedJobs)
+        {
+            ++m_statistics.rejectedJobs;
+            return false;
+        }
+
+        m_jobs.push_back({ socket, std::move(job), std::chrono::steady_clock::now() });
+        m_statistics.peakQueuedJobs = std::max(m_statistics.peakQueuedJobs, static_cast<uint32_t>(m_jobs.size()));
+    }
+
+    m_condition.notify_one();
+    return true;
+}
+
+void AuthCryptoPool::removeJobs(AuthSocket* socket)
+{
+    std::unique_lock<std::mutex> lock(m_lock);
+
+    m_jobs.erase(std::remove_if(m_jobs.begin(), m_jobs.end(), [socket](Job const& job) { return job.socket == socket; }), m_jobs.end());
+
+    m_finishedCondition.wait(lock, [this, socket]
+    {
+        return std::find(m_runningSockets.begin(), m_runningSockets.end(), socket) == m_runningSockets.end();
+    });
+}
+
+AuthCryptoPoolStatistics AuthCryptoPool::getStatistics()
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    AuthCryptoPoolStatistics statistics = m_statistics;
+    statistics.workerCount = static_cast<uint32_t>(m_workers.size());
+    statistics.queuedJobs = static_cast<uint32_t>(m_jobs.size());
+
+    return statistics;
+}
+
+void AuthCryptoPool::workerRunner(uint32_t workerId)
+{
+    SetThreadName("Auth Crypto %u", workerId);
+
+    std::unique_lock<std::mutex> lock(m_lock);
+    while (!m_shutdownRequested)
+    {
+        if (m_jobs.empty())
+        {
+            m_condition.wait(lock);
+            continue;
+        }
+
+        Job job = std::move(m_jobs.front());
+        m_jobs.pop_front();
+        m_runningSockets.push_back(job.socket);
+
+        lock.unlock();
+
+        const auto startTime = std::chrono::steady_clock::now();
+        job.run();
+        const auto endTime = std::chrono::steady_clock::now();
+
+        lock.lock();
+
+        m_runningSockets.erase(std::find(m_runningSockets.begin(), m_runningSockets.end(), job.socket));
+
+        ++m_statistics.finishedJobs;
+        m_statistics.totalWaitTime += std::chrono::duration_cast<std::chrono::microseconds>(startTime - job.queueTime).count();
+        m_statistics.totalRunTime += std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count();
+
+        m_finishedCondition.notify_all();
+    }
+}
@@ -0,0 +1,86 @@
+/*
+Copyright (c) 2014-2021 AscEmu Team <http://www.ascemu.org>
+This file is released under the MIT license. See README-MIT for more information.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class AuthSocket;
+
+struct AuthCryptoPoolStatistics
+{
+    uint32_t workerCount = 0;
+    uint32_t queuedJobs = 0;
+    uint32_t peakQueuedJobs = 0;
+    uint64_t finishedJobs = 0;
+    uint64_t rejectedJobs = 0;
+    uint64_t totalWaitTime = 0;                 // us jobs waited in the queue
+    uint64_t totalRunTime = 0;                  // us
+};
+
+// Runs the SRP6 calculations of the auth sockets on a fixed number of worker threads, the network threads only
+// read and send the packets. The queue is bounded by 'Performance.CryptoQueueSize', the caller has to refuse
+// the login when addJob fails. Without workers the jobs run right away on the calling thread.
+class AuthCryptoPool
+{
+private:
+
+    AuthCryptoPool() = default;
+    ~AuthCryptoPool() = default;
+
+public:
+
+    static AuthCryptoPool& getInstance();
+
+    AuthCryptoPool(AuthCryptoPool&&) = delete;
+    AuthCryptoPool(AuthCryptoPool const&) = delete;
+    AuthCryptoPool& operator=(AuthCryptoPool&&) = delete;
+    AuthCryptoPool& operator=(AuthCryptoPool const&) = delete;
+
+    void initialize(uint32_t threadCount, uint32_t maxQueuedJobs);
+
+    // queued jobs are dropped
+    void finalize();
+
+    // returns false when the queue is full
+    bool addJob(AuthSocket* socket, std::function<void()> job);
+
+    // removes the queued jobs of the socket and waits until its running job is finished
+    void removeJobs(AuthSocket* socket);
+
+    AuthCryptoPoolStatistics getStatistics();
+
+private:
+
+    struct Job
+    {
+        AuthSocket* socket;
+        std::function<void()> run;
+        std::chrono::steady_clock::time_point queueTime;
+    };
+
+    void workerRunner(uint32_t workerId);
+
+    std::vector<std::thread> m_workers;
+    uint32_t m_maxQueuedJobs = 0;
+
+    std::mutex m_lock;
+    std::condition_variable m_condition;
+    std::condition_variable m_finishedCondition;
+    std::deque<Job> m_jobs;
+    std::vector<AuthSocket*> m_runningSockets;
+    bool m_shutdownRequested = false;
+
+    AuthCryptoPoolStatistics m_statistics;
+};
+
+#define sAuthCryptoPool AuthCryptoPool::getInstance()
@@ -38,8 +38,8 @@ AuthSocket::AuthSocket(SOCKET fd) : Socket(fd, 32768, 4096)
 {
     N.SetHexStr("894B645E89E1535BBDAD5B8B290650530801B18EBFBF5E8FAB3C82872A3E9BB7");
     g.SetDword(7);
-    s.SetRand(256);
     m_authenticated = false;
+    m_isCryptoJobPending = false;
     m_account = NULL;
     last_recv = time(NULL);
     removedFromSet = false;
@@ -63,6 +63,8 @@ AuthSocket::AuthSocket(SOCKET fd) : Socket(fd, 32768, 4096)
 AuthSocket::~AuthSocket()
 {
     ASSERT(!m_patchJob);
+
+    sAuthCryptoPool.removeJobs(this);
 }
 
 void AuthSocket::OnDisconnect()
@@ -246,29 +248,24 @@ void AuthSocket::HandleChallenge()
         //m_account->forcedLanguage = temp;
     }
 
+    m_isCryptoJobPending = true;
+    if (!sAuthCryptoPool.addJob(this, [this]() { sendChallengeSrp6(); }))
+    {
+        m_isCryptoJobPending = false;
+        SendChallengeError(CE_SERVER_FULL);
+    }
+}
+
+void AuthSocket::sendChallengeSrp6()
+{
+    if (IsDeleted() || !IsConnected())
+        return;
+
     //////////////////////////////////////////////// SRP6 Challenge ////////////////////////////////////////////////
     //
+    // The salt s and the verifier v = g^x % N are taken from the account, see loadSrp6Verifier
     //
-    // First we will generate the Verifier value using the following formulas
-    //
-    // x = SHA1(s | SHA1(I | ":" | P))
-    // v = g^x % N
-    //
-    // The SHA1(I | ":" | P) part for x we have in the account database, this is the encrypted password, reversed
-    // N is a safe prime
-    // g is the generator
-    // | means concatenation in this contect
-    //
-    //
-
-    Sha1Hash sha;
-    sha.UpdateData(s.AsByteArray(), 32);
-    sha.UpdateData(m_account->SrpHash, 20);
-    sha.Finalize();
-
-    BigNumber x;
-    x.SetBinary(sha.GetDigest(), sha.GetLength());
-    v = g.ModExp(x, N);
+    loadSrp6Verifier();
 
     // Next we generate b, and B which are the public and private values of the server
     //
@@ -293,15 +290,19 @@ void AuthSocket::HandleChallenge()
     challenge.cmd = 0;
     challenge.error = 0;
     challenge.unk2 = CE_SUCCESS;
-    memcpy(challenge.B, B.AsByteArray(), 32);
+    // B, S and s can have leading zero bytes, AsByteArray only holds GetNumBytes() bytes
+    memset(challenge.B, 0, 32);
+    memcpy(challenge.B, B.AsByteArray(), B.GetNumBytes());
     challenge.g_len = 1;
     challenge.g = (g.AsByteArray())[0];
     challenge.N_len = 32;
     memcpy(challenge.N, N.AsByteArray(), 32);
-    memcpy(challenge.s, s.AsByteArray(), 32);
+    memset(challenge.s, 0, 32);
+    memcpy(challenge.s, s.AsByteArray(), s.GetNumBytes());
     memcpy(challenge.unk3, unk.AsByteArray(), 16);
     challenge.unk4 = 0;
 
+    m_isCryptoJobPending = false;
     Send(reinterpret_cast<uint8*>(&challenge), sizeof(sAuthLogonChallenge_S));
 }
 
@@ -334,6 +335,18 @@ void AuthSocket::HandleProof()
     //Read(sizeof(sAuthLogonProof_C), (uint8*)&lp);
     readBuffer.Read(&lp, sizeof(sAuthLogonProof_C));
 
+    m_isCryptoJobPending = true;
+    if (!sAuthCryptoPool.addJob(this, [this, lp]() { checkProofSrp6(lp); }))
+    {
+        m_isCryptoJobPending = false;
+        SendChallengeError(CE_SERVER_FULL);
+    }
+}
+
+void AuthSocket::checkProofSrp6(sAuthLogonProof_C lp)
+{
+    if (IsDeleted() || !IsConnected())
+        return;
 
     ////////////////////////////////////////////////////// SRP6 ///////////////////////////////////////////////
     //Now comes the famous secret Xi Chi fraternity handshake ( http://www.youtube.com/watch?v=jJSYBoI2si0 ),
@@ -363,7 +376,8 @@ void AuthSocket::HandleProof()
     uint8 t[32];
     uint8 t1[16];
     uint8 vK[40];
-    memcpy(t, S.AsByteArray(), 32);
+    memset(t, 0, 32);
+    memcpy(t, S.AsByteArray(), S.GetNumBytes());
     for (int i = 0; i < 16; i++)
     {
         t1[i] = t[i * 2];
@@ -419,11 +433,13 @@ void AuthSocket::HandleProof()
     M.SetBinary(sha.GetDigest(), 20);
 
     // Compare the M value the client sent us to the one we generated, this proves we both have the same values
-    // which proves we have the same username-password pairs
-    if (memcmp(lp.M1, M.AsByteArray(), 20) != 0)
+    // which proves we have the same username-password pairs. The digest is compared, M drops leading zero bytes
+    // and its byte array can be shorter than 20 bytes
+    if (memcmp(lp.M1, sha.GetDigest(), 20) != 0)
     {
         // Authentication failed.
         //SendProofError(4, 0);
+        m_isCryptoJobPending = false;
         SendChallengeError(CE_NO_ACCOUNT);
         sLogger.debug("[AuthLogonProof] M values don't match. ( Either invalid password or the logon server is bugged. )");
         return;
@@ -437,13 +453,14 @@ void AuthSocket::HandleProof()
     sha.UpdateBigNumbers(&A, &M, &m_sessionkey, 0);
     sha.Finalize();
 
+    // we're authenticated now :)
+    m_authenticated = true;
+
     //SendProofError(0, sha.GetDigest());
+    m_isCryptoJobPending = false;
     sendAuthProof(sha);
     sLogger.debug("[AuthLogonProof] Authentication Success.");
 
-    // we're authenticated now :)
-    m_authenticated = true;
-
     // Don't update when IP banned, but update anyway if it's an account ban
     sLogonSQL->Execute("UPDATE accounts SET lastlogin=NOW(), lastip='%s' WHERE id = %u;", GetRemoteIP().c_str(), m_account->AccountId);
 }
@@ -557,6 +574,10 @@ void AuthSocket::OnRead()
         return;
     }
 
+    // the client waits for the answer to its challenge or proof, anything it sends meanwhile stays in the buffer
+    if (m_isCryptoJobPending)
+        return;
+
     uint8 Command = *(uint8*)readBuffer.GetBufferStart();
     last_recv = UNIXTIME;
     if (Command < MAX_AUTH_CMD && Handlers[Command] != NULL)
@@ -34,3 +34,33 @@ void AuthSocket::sendAuthProof(Sha1Hash sha)
         Send(reinterpret_cast<uint8*>(&proof), sizeof(sAuthLogonProof_S));
     }
 }
+
+void AuthSocket::loadSrp6Verifier()
+{
+    auto verifier = std::atomic_load(&m_account->srp6Verifier);
+
+    // a reload of the accounts changes the password hash in place
+    if (verifier == nullptr || memcmp(verifier->srpHash, m_account->SrpHash, 20) != 0)
+    {
+        auto newVerifier = std::make_shared<Srp6Verifier>();
+        memcpy(newVerifier->srpHash, m_account->SrpHash, 20);
+        newVerifier->salt = Srp6Verifier::generateSalt();
+
+        // x = SHA1(s | SHA1(I | ":" | P)), the SHA1(I | ":" | P) part is the encrypted password of the account
+        // v = g^x % N
+        Sha1Hash sha;
+        sha.UpdateData(newVerifier->salt.AsByteArray(), 32);
+        sha.UpdateData(newVerifier->srpHash, 20);
+        sha.Finalize();
+
+        BigNumber x;
+        x.SetBinary(sha.GetDigest(), sha.GetLength());
+        newVerifier->verifier = g.ModExp(x, N);
+
+        verifier = newVerifier;
+        std::atomic_store(&m_account->srp6Verifier, verifier);
+    }
+
+    s = verifier->salt;
+    v = verifier->verifier;
+}
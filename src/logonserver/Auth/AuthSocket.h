@@ -33,6 +33,13 @@ class AuthSocket : public Socket
 
         //MIT
         void sendAuthProof(Sha1Hash sha);
+
+        // run by the AuthCryptoPool
+        void sendChallengeSrp6();
+        void checkProofSrp6(sAuthLogonProof_C lp);
+
+        // takes salt and verifier from the account, calculates them on its first login
+        void loadSrp6Verifier();
         //MIT end
 
         // Netcore related
@@ -67,6 +74,9 @@ class AuthSocket : public Socket
         std::shared_ptr<Account> m_account;
         bool m_authenticated;
 
+        // set while a challenge or proof is calculated, OnRead leaves the received data in the buffer meanwhile
+        std::atomic<bool> m_isCryptoJobPending;
+
         // BigNumbers for the SRP6 implementation
         BigNumber N; // Safe prime
         BigNumber g; // Generator
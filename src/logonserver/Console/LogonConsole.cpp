@@ -242,6 +242,15 @@ void LogonConsole::Info(char* /*str*/)
     std::cout << "-----------------------" << std::endl;
     std::cout << "CPU Usage: " << sLogon.getCPUUsage() << " %" << std::endl;
     std::cout << "RAM Usage: " << sLogon.getRAMUsage() << " MB" << std::endl;
+
+    const auto crypto = sAuthCryptoPool.getStatistics();
+    if (crypto.workerCount == 0)
+        return;
+
+    const uint64_t finishedJobs = std::max<uint64_t>(crypto.finishedJobs, 1);
+    std::cout << "Crypto workers: " << crypto.workerCount << ", " << crypto.queuedJobs << " queued (peak " << crypto.peakQueuedJobs << "), "
+        << crypto.finishedJobs << " finished, " << crypto.rejectedJobs << " rejected" << std::endl;
+    std::cout << "Crypto job average: " << crypto.totalWaitTime / finishedJobs << " us queued, " << crypto.totalRunTime / finishedJobs << " us run" << std::endl;
 }
 
 void LogonConsole::AccountCreate(char* str)
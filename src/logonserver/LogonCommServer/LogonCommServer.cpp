@@ -749,19 +749,17 @@ void LogonCommServerSocket::HandleRequestCheckAccount(WorldPacket & recvData)
 void LogonCommServerSocket::HandleRequestAllAccounts(WorldPacket& /*recvData*/)
 {
     std::string accountsArray;
-    auto accountMap = sAccountMgr.getAccountMap();
-
-    for (auto const map_itr :  accountMap)
+    sAccountMgr.forEachAccount([&accountsArray](std::string const& name, Account const& account)
     {
         std::string gm_flags;
 
-        if (map_itr.second->GMFlags)
-            gm_flags = map_itr.second->GMFlags;
+        if (account.GMFlags)
+            gm_flags = account.GMFlags;
         else
             gm_flags = "0";
 
-        accountsArray += std::to_string(map_itr.second->AccountId) + "," + map_itr.first + "," + (gm_flags.empty() ? "0" : gm_flags) + ";";
-    }
+        accountsArray += std::to_string(account.AccountId) + "," + name + "," + (gm_flags.empty() ? "0" : gm_flags) + ";";
+    });
 
     // remove last ; from string
     accountsArray.pop_back();
@@ -6,6 +6,8 @@ This file is released under the MIT license. See README-MIT for more information
 #include "LogonStdAfx.h"
 #include "AccountMgr.h"
 
+#include <unordered_set>
+
 AccountMgr& AccountMgr::getInstance()
 {
     static AccountMgr mInstance;
@@ -91,17 +93,30 @@ void AccountMgr::addAccount(Field* field)
 
     AscEmu::Util::Strings::toUpperCase(accountName);
 
-    _accountMap[accountName] = account;
+    AccountShard& shard = getShard(accountName);
+
+    std::lock_guard<std::shared_mutex> guard(shard.lock);
+
+    const auto result = shard.accounts.emplace(accountName, account);
+    if (!result.second)
+        return;
+
+    // the key of a node stays at its address until the node is erased
+    account->UsernamePtr = const_cast<std::string*>(&result.first->first);
+    ++m_accountCount;
 }
 
 std::shared_ptr<Account> AccountMgr::getAccountByName(std::string& Name)
 {
-    accountMgrMutex.Acquire();
+    AccountShard const& shard = getShard(Name);
 
-    auto pAccount = _getAccountByNameLockFree(Name);
+    std::shared_lock<std::shared_mutex> guard(shard.lock);
 
-    accountMgrMutex.Release();
-    return pAccount;
+    const auto itr = shard.accounts.find(Name);
+    if (itr == shard.accounts.end())
+        return nullptr;
+
+    return itr->second;
 }
 
 void AccountMgr::updateAccount(std::shared_ptr<Account> account, Field* field)
@@ -168,14 +183,16 @@ void AccountMgr::updateAccount(std::shared_ptr<Account> account, Field* field)
 
 void AccountMgr::reloadAccounts(bool silent)
 {
-    accountMgrMutex.Acquire();
+    std::lock_guard<std::mutex> guard(m_reloadLock);
 
     if (!silent)
         sLogger.info("[AccountMgr] Reloading Accounts...");
 
-    std::set<std::string> account_list;
+    // rows of the second of the last reload are loaded again, a row changed later in that second is not missed
+    QueryResult* result = sLogonSQL->Query("SELECT id, acc_name, encrypted_password, flags, banned, forceLanguage, muted, UNIX_TIMESTAMP(last_modified) FROM accounts "
+        "WHERE last_modified >= FROM_UNIXTIME(%u) OR (banned > 1 AND banned < UNIX_TIMESTAMP()) OR (muted > 1 AND muted < UNIX_TIMESTAMP())", m_lastModified);
 
-    QueryResult* result = sLogonSQL->Query("SELECT id, acc_name, encrypted_password, flags, banned, forceLanguage, muted FROM accounts");
+    uint32_t changedCount = 0;
     if (result)
     {
         do
@@ -185,51 +202,104 @@ void AccountMgr::reloadAccounts(bool silent)
 
             AscEmu::Util::Strings::toUpperCase(accountName);
 
-            const auto account = _getAccountByNameLockFree(accountName);
+            const auto account = getAccountByName(accountName);
             if (account == nullptr)
                 addAccount(field);
             else
                 updateAccount(account, field);
 
-            account_list.insert(accountName);
+            m_lastModified = std::max(m_lastModified, field[7].GetUInt32());
+            ++changedCount;
 
         } while (result->NextRow());
 
         delete result;
     }
 
-    for (auto accounts = _accountMap.begin(); accounts != _accountMap.end();)
+    // a deleted or renamed account leaves no changed row behind
+    size_t removedCount = 0;
+    if (QueryResult* countResult = sLogonSQL->Query("SELECT COUNT(*) FROM accounts"))
     {
-        auto accountsCopy = accounts;
-        ++accounts;
+        if (countResult->Fetch()[0].GetUInt64() < getCount())
+            removedCount = removeDeletedAccounts(countResult->Fetch()[0].GetUInt64());
 
-        if (account_list.find(accountsCopy->first) == account_list.end())
-            _accountMap.erase(accountsCopy);
-        else
-            accountsCopy->second->UsernamePtr = const_cast<std::string*>(&accountsCopy->first);
+        delete countResult;
     }
 
     if (!silent)
-        sLogger.info("[AccountMgr] Found %u accounts.", static_cast<uint32_t>(_accountMap.size()));
-
-    accountMgrMutex.Release();
+        sLogger.info("[AccountMgr] Found %u accounts, %u changed and %u removed.", static_cast<uint32_t>(getCount()), changedCount, static_cast<uint32_t>(removedCount));
 }
 
 size_t AccountMgr::getCount() const
 {
-    return _accountMap.size();
+    return m_accountCount;
 }
 
-std::map<std::string, std::shared_ptr<Account>> AccountMgr::getAccountMap() const
+void AccountMgr::forEachAccount(std::function<void(std::string const& name, Account const& account)> const& callback) const
 {
-    return _accountMap;
+    for (const auto& shard : m_shards)
+    {
+        std::shared_lock<std::shared_mutex> guard(shard.lock);
+
+        for (const auto& account : shard.accounts)
+            callback(account.first, *account.second);
+    }
 }
 
-std::shared_ptr<Account> AccountMgr::_getAccountByNameLockFree(std::string& Name)
+AccountMgr::AccountShard& AccountMgr::getShard(std::string const& name)
 {
-    const auto itr = _accountMap.find(Name);
-    if (itr == _accountMap.end())
-        return nullptr;
+    return m_shards[std::hash<std::string>()(name) % AccountShardCount];
+}
 
-    return itr->second;
+size_t AccountMgr::removeDeletedAccounts(uint64_t accountCount)
+{
+    // only the names are loaded, the shards are locked one after another
+    std::unordered_set<std::string> accountNames;
+    uint64_t loadedCount = 0;
+
+    QueryResult* result = sLogonSQL->Query("SELECT acc_name FROM accounts");
+    if (result)
+    {
+        accountNames.reserve(result->GetRowCount());
+
+        do
+        {
+            std::string accountName = result->Fetch()[0].GetString();
+            AscEmu::Util::Strings::toUpperCase(accountName);
+            accountNames.insert(std::move(accountName));
+            ++loadedCount;
+
+        } while (result->NextRow());
+
+        delete result;
+    }
+
+    // A failed query (e.g. a dropped connection) returns less rows than the table has. The removed accounts
+    // would not come back with the next reload, it only loads changed rows.
+    if (loadedCount < accountCount)
+    {
+        sLogger.failure("[AccountMgr] Loaded %llu of %llu account names, no accounts are removed", static_cast<unsigned long long>(loadedCount), static_cast<unsigned long long>(accountCount));
+        return 0;
+    }
+
+    size_t removedCount = 0;
+    for (auto& shard : m_shards)
+    {
+        std::lock_guard<std::shared_mutex> guard(shard.lock);
+
+        for (auto itr = shard.accounts.begin(); itr != shard.accounts.end();)
+        {
+            if (accountNames.find(itr->first) != accountNames.end())
+            {
+                ++itr;
+                continue;
+            }
+
+            itr = shard.accounts.erase(itr);
+            ++removedCount;
+        }
+    }
+
+    m_accountCount -= removedCount;
+    return removedCount;
 }
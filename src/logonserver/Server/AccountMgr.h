@@ -5,6 +5,34 @@ This file is released under the MIT license. See README-MIT for more information
 
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+// SRP6 salt and verifier of an account, calculated on its first login
+struct Srp6Verifier
+{
+    uint8_t srpHash[20];                        // password hash they were calculated from
+    BigNumber salt;
+    BigNumber verifier;
+
+    // the client gets the salt as 32 bytes while the proof hashes only GetNumBytes() of it,
+    // a salt with a leading zero byte would fail every login of the account
+    static BigNumber generateSalt()
+    {
+        BigNumber salt;
+        do
+        {
+            salt.SetRand(256);
+        } while (salt.GetNumBytes() != 32);
+
+        return salt;
+    }
+};
+
 struct Account
 {
     uint32_t AccountId;
@@ -17,6 +45,9 @@ struct Account
     std::string forcedLanguage;
     uint32_t Muted;
 
+    // read and replaced by the auth crypto workers with std::atomic_load/atomic_store
+    std::shared_ptr<const Srp6Verifier> srp6Verifier;
+
     Account()
     {
         GMFlags = NULL;
@@ -84,24 +115,40 @@ public:
     std::shared_ptr<Account> getAccountByName(std::string& Name);
 
     void updateAccount(std::shared_ptr<Account> account, Field* field);
+
+    // Applies the rows changed since the last reload and the bans and mutes which expired meanwhile.
+    // Deleted accounts are only searched for when the table has less rows than the index.
     void reloadAccounts(bool silent);
 
     size_t getCount() const;
 
-    std::map<std::string, std::shared_ptr<Account>> getAccountMap() const;
+    // the shard holding the account is read locked while the callback runs
+    void forEachAccount(std::function<void(std::string const& name, Account const& account)> const& callback) const;
 
 private:
 
-    std::shared_ptr<Account> _getAccountByNameLockFree(std::string& Name);
+    static constexpr size_t AccountShardCount = 64;
 
-    std::map<std::string, std::shared_ptr<Account>> _accountMap;
+    struct AccountShard
+    {
+        mutable std::shared_mutex lock;
+        std::unordered_map<std::string, std::shared_ptr<Account>> accounts;
+    };
 
-    std::unique_ptr<AscEmu::Threading::AEThread> m_reloadThread;
-    uint32_t m_reloadTime;
+    AccountShard& getShard(std::string const& name);
 
-protected:
+    // accountCount is the COUNT(*) of the accounts table, returns the number of removed accounts
+    size_t removeDeletedAccounts(uint64_t accountCount);
 
-    Mutex accountMgrMutex;
+    std::array<AccountShard, AccountShardCount> m_shards;
+    std::atomic<size_t> m_accountCount = 0;
+
+    // one reload at a time, lookups don't wait for it
+    std::mutex m_reloadLock;
+    uint32_t m_lastModified = 0;                // newest last_modified of the loaded rows, database time
+
+    std::unique_ptr<AscEmu::Threading::AEThread> m_reloadThread;
+    uint32_t m_reloadTime;
 };
 
 #define sAccountMgr AccountMgr::getInstance()
@@ -15,12 +15,18 @@ LogonConfig::LogonConfig()
 
     // logon.conf - Listen
     listen.port = 8093;
+    listen.networkThreads = 1;
+    listen.reusePort = false;
 
     // logon.conf - Logger
     logger.minimumMessageType = 2;
 
     // logon.conf - Rates
     rates.accountRefreshTime = 600;
+
+    // logon.conf - Performance
+    performance.cryptoThreads = 2;
+    performance.cryptoQueueSize = 5000;
 }
 
 void LogonConfig::loadConfigValues(bool reload /*false*/)
@@ -51,6 +57,8 @@ void LogonConfig::loadConfigValues(bool reload /*false*/)
     ASSERT(Config.MainConfig.tryGetString("Listen", "ISHost", &listen.interServerHost));
     ASSERT(Config.MainConfig.tryGetInt("Listen", "RealmListPort", &listen.realmListPort));
     ASSERT(Config.MainConfig.tryGetInt("Listen", "ServerPort", &listen.port));
+    ASSERT(Config.MainConfig.tryGetInt("Listen", "NetworkThreads", &listen.networkThreads));
+    ASSERT(Config.MainConfig.tryGetBool("Listen", "ReusePort", &listen.reusePort));
 
     // logon.conf - Logger Settings
     ASSERT(Config.MainConfig.tryGetInt("Logger", "MinimumMessageType", &logger.minimumMessageType));
@@ -62,4 +70,8 @@ void LogonConfig::loadConfigValues(bool reload /*false*/)
     ASSERT(Config.MainConfig.tryGetBool("LogonServer", "DisablePings", &logonServer.disablePings));
     ASSERT(Config.MainConfig.tryGetString("LogonServer", "AllowedIPs", &logonServer.allowedIps));
     ASSERT(Config.MainConfig.tryGetString("LogonServer", "AllowedModIPs", &logonServer.allowedModIps));
+
+    // logon.conf - Performance
+    ASSERT(Config.MainConfig.tryGetInt("Performance", "CryptoThreads", &performance.cryptoThreads));
+    ASSERT(Config.MainConfig.tryGetInt("Performance", "CryptoQueueSize", &performance.cryptoQueueSize));
 }
@@ -36,6 +36,8 @@ class SERVER_DECL LogonConfig
             std::string interServerHost;
             uint32_t realmListPort;
             uint32_t port;
+            uint32_t networkThreads;
+            bool reusePort;
         } listen;
 
         // logon.conf - Logger Settings
@@ -57,4 +59,11 @@ class SERVER_DECL LogonConfig
             std::string allowedIps;
             std::string allowedModIps;
         } logonServer;
+
+        // logon.conf - Performance
+        struct Performance
+        {
+            uint32_t cryptoThreads;
+            uint32_t cryptoQueueSize;
+        } performance;
 };
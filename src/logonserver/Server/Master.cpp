@@ -21,7 +21,7 @@ std::set<AuthSocket*> _authSockets;
 
 ConfigMgr Config;
 
-static const char* REQUIRED_LOGON_DB_VERSION = "20200221-00_utf8mb4_unicode_ci";
+static const char* REQUIRED_LOGON_DB_VERSION = "20210810-00_accounts_last_modified";
 
 MasterLogon& MasterLogon::getInstance()
 {
@@ -86,9 +86,15 @@ void MasterLogon::Run(int /*argc*/, char** /*argv*/)
     clientMinBuild = 5875;
     clientMaxBuild = 15595;
 
+    sAuthCryptoPool.initialize(logonConfig.performance.cryptoThreads, logonConfig.performance.cryptoQueueSize);
+
     ThreadPool.ExecuteTask(new LogonConsoleThread);
 
+#ifdef CONFIG_USE_EPOLL
+    sSocketMgr.initialize(logonConfig.listen.networkThreads, logonConfig.listen.reusePort);
+#else
     sSocketMgr.initialize();
+#endif
 
     auto realmlistSocket = new ListenSocket<AuthSocket>(logonConfig.listen.host.c_str(), logonConfig.listen.realmListPort);
     auto logonServerSocket = new ListenSocket<LogonCommServerSocket>(logonConfig.listen.interServerHost.c_str(), logonConfig.listen.port);
@@ -149,6 +155,7 @@ void MasterLogon::Run(int /*argc*/, char** /*argv*/)
     sSocketMgr.ShutdownThreads();
 #endif
     sLogonConsole.Kill();
+    sAuthCryptoPool.finalize();
     sAccountMgr.finalize();
     sRealmManager.finalize();
 
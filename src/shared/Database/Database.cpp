@@ -30,7 +30,6 @@
 #include <string>
 #include <vector>
 
-using AscEmu::Threading::AEThread;
 using std::unique_ptr;
 using std::make_unique;
 
@@ -39,84 +38,325 @@ SQLCallbackBase::~SQLCallbackBase()
 
 }
 
-void Database::createDbConnection()
+Database::Database()
+{
+    _counter = 0;
+    Connections = NULL;
+    mConnectionCount = -1;   // Not connected.
+    //ThreadRunning = true;
+    mPort = 3306;
+    qt = nullptr;
+
+    m_writerCount = 1;
+    m_keyedWriteCount = 0;
+    m_barrierWriteCount = 0;
+
+    m_asyncQueryShutdownRequested = false;
+}
+
+Database::~Database()
 {
-    if (m_dbConnection == nullptr)
-        m_dbConnection = GetFreeConnection();
+
 }
 
-void Database::destroyDbConnection()
+void Database::_Initialize()
 {
-    if (m_dbConnection)
+    const auto now = std::chrono::steady_clock::now();
+
     {
-        m_dbConnection->Busy.Release();
-        m_dbConnection = nullptr;
+        std::lock_guard<std::mutex> guard(m_poolLock);
+        m_freeConnections.clear();
+        for (int32 i = 0; i < mConnectionCount; ++i)
+        {
+            Connections[i]->lastUsed = now;
+            m_freeConnections.push_back(Connections[i]);
+        }
+
+        m_poolStatistics = DatabasePoolStatistics();
+        m_poolStatistics.connectionCount = static_cast<uint32_t>(mConnectionCount);
     }
+
+    if (!m_writers.empty())
+        return;
+
+    for (uint32_t i = 0; i < m_writerCount; ++i)
+        m_writers.push_back(make_unique<DatabaseWriter>());
+
+    for (auto& writer : m_writers)
+        writer->thread = std::thread(&Database::writerRunner, this, std::ref(*writer));
 }
 
-void Database::createQueryBufferConnection()
+DatabaseConnection* Database::GetFreeConnection()
 {
-    if (m_queryBufferConnection == nullptr)
-        m_queryBufferConnection = GetFreeConnection();
+    std::unique_lock<std::mutex> lock(m_poolLock);
+
+    ++m_poolStatistics.acquireCount;
+    if (m_freeConnections.empty())
+    {
+        const auto startTime = std::chrono::steady_clock::now();
+
+        ++m_poolStatistics.waitingCallers;
+        m_poolCondition.wait(lock, [this] { return !m_freeConnections.empty(); });
+        --m_poolStatistics.waitingCallers;
+
+        const uint64_t waitTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+        ++m_poolStatistics.waitCount;
+        m_poolStatistics.totalWaitTime += waitTime;
+        m_poolStatistics.maxWaitTime = std::max(m_poolStatistics.maxWaitTime, waitTime);
+    }
+
+    DatabaseConnection* con = m_freeConnections.back();
+    m_freeConnections.pop_back();
+    ++m_poolStatistics.busyConnections;
+
+    lock.unlock();
+
+    // the server closes connections after wait_timeout, check it before a query fails on it
+    if (std::chrono::steady_clock::now() - con->lastUsed > std::chrono::minutes(1))
+        _CheckConnection(con);
+
+    return con;
 }
 
-void Database::dbThreadRunner(AEThread& /*thread*/)
+void Database::releaseConnection(DatabaseConnection* con)
 {
-    dbRunAllQueries();
+    con->lastUsed = std::chrono::steady_clock::now();
+
+    {
+        std::lock_guard<std::mutex> guard(m_poolLock);
+        m_freeConnections.push_back(con);
+        --m_poolStatistics.busyConnections;
+    }
+
+    m_poolCondition.notify_one();
+}
+
+void Database::setWriterCount(uint32_t writerCount)
+{
+    m_writerCount = std::max(writerCount, 1u);
 }
 
-void Database::dbThreadShutdown()
+DatabasePoolStatistics Database::getPoolStatistics()
 {
-    // Shut down thread
-    m_dbThread->killAndJoin();
+    DatabasePoolStatistics statistics;
+    {
+        std::lock_guard<std::mutex> guard(m_poolLock);
+        statistics = m_poolStatistics;
+    }
+
+    statistics.pendingWrites = GetQueueSize();
+    statistics.keyedWriteCount = m_keyedWriteCount;
+    statistics.barrierWriteCount = m_barrierWriteCount;
 
-    // Execute remaining queries
-    dbRunAllQueries();
-    destroyDbConnection();
+    std::lock_guard<std::mutex> guard(m_asyncQueryLock);
+    statistics.pendingAsyncQueries = static_cast<uint32_t>(m_asyncQueryTasks.size());
+
+    return statistics;
 }
 
-Database::Database()
+uint32 Database::GetQueueSize()
 {
-    _counter = 0;
-    Connections = NULL;
-    mConnectionCount = -1;   // Not connected.
-    //ThreadRunning = true;
-    mPort = 3306;
-    qt = nullptr;
+    uint64_t pendingWrites = 0;
+    for (auto& writer : m_writers)
+    {
+        std::lock_guard<std::mutex> guard(writer->lock);
+        pendingWrites += writer->queuedCount - writer->finishedCount - writer->barrierCopyCount;
+    }
 
-    m_dbConnection = nullptr;
-    m_queryBufferConnection = nullptr;
+    return static_cast<uint32>(pendingWrites);
 }
 
-Database::~Database()
+void Database::queueWrite(uint32_t shardKey, DatabaseWriter::Task task)
 {
+    DatabaseWriter& writer = getWriter(shardKey);
+
+    {
+        std::lock_guard<std::mutex> guard(writer.lock);
+        if (!writer.shutdownRequested)
+        {
+            writer.tasks.push_back(task);
+            ++writer.queuedCount;
+            writer.condition.notify_one();
+            return;
+        }
+    }
 
+    // the writers are gone, write it right away
+    DatabaseConnection* con = GetFreeConnection();
+    runWrite(con, task);
+    releaseConnection(con);
 }
 
-void Database::_Initialize()
+void Database::queueOrderedWrite(DatabaseWriter::Task task)
 {
-    if (m_dbThread == nullptr)
-        m_dbThread = std::make_unique<AEThread>("DatabaseThread", [this](AEThread& thread) { this->dbThreadRunner(thread); }, std::chrono::milliseconds(10));
-    else
-        m_dbThread->reboot();
+    if (m_writers.size() <= 1)
+    {
+        queueWrite(0, task);
+        return;
+    }
+
+    task.barrier = std::make_shared<DatabaseWriteBarrier>();
+    ++m_barrierWriteCount;
+
+    // always locked in this order, a keyed write holds only the lock of its writer
+    std::vector<std::unique_lock<std::mutex>> locks;
+    locks.reserve(m_writers.size());
+    for (auto& writer : m_writers)
+    {
+        locks.emplace_back(writer->lock);
+        if (!writer->shutdownRequested)
+            continue;
 
-    if (m_queryBufferThread == nullptr)
-        m_queryBufferThread = std::make_unique<AEThread>("QueryBufferThread", [this](AEThread& thread) { this->queryBufferThreadRunner(thread); }, std::chrono::milliseconds(10));
+        locks.clear();
+
+        DatabaseConnection* con = GetFreeConnection();
+        runWrite(con, task);
+        releaseConnection(con);
+        return;
+    }
+
+    for (size_t i = 0; i < m_writers.size(); ++i)
+    {
+        DatabaseWriter& writer = *m_writers[i];
+        if (i == 0)
+        {
+            writer.tasks.push_back(task);
+        }
+        else
+        {
+            writer.tasks.push_back({ nullptr, nullptr, task.barrier });
+            ++writer.barrierCopyCount;
+        }
+
+        ++writer.queuedCount;
+        writer.condition.notify_one();
+    }
+}
+
+void Database::runWrite(DatabaseConnection* con, DatabaseWriter::Task const& task)
+{
+    if (task.buffer != nullptr)
+    {
+        PerformQueryBuffer(task.buffer, con);
+        delete task.buffer;
+    }
     else
-        m_queryBufferThread->reboot();
+    {
+        _SendQueuedQuery(con, *task.query);
+        delete task.query;
+    }
 }
 
-DatabaseConnection* Database::GetFreeConnection()
+void Database::runBarrierWrite(DatabaseWriter& writer, DatabaseConnection*& connection, DatabaseWriter::Task const& task)
 {
-    uint32 i = 0;
+    std::unique_lock<std::mutex> lock(m_writeBarrierLock);
+    ++task.barrier->arrivedWriters;
+
+    if (&writer != m_writers.front().get())
+    {
+        // the first writer may need the connection
+        if (connection != nullptr)
+        {
+            releaseConnection(connection);
+            connection = nullptr;
+        }
+
+        m_writeBarrierCondition.notify_all();
+        m_writeBarrierCondition.wait(lock, [&task] { return task.barrier->isDone; });
+        return;
+    }
+
+    m_writeBarrierCondition.wait(lock, [this, &task] { return task.barrier->arrivedWriters == m_writers.size(); });
+    lock.unlock();
+
+    if (connection == nullptr)
+        connection = GetFreeConnection();
+
+    runWrite(connection, task);
+
+    lock.lock();
+    task.barrier->isDone = true;
+    m_writeBarrierCondition.notify_all();
+}
+
+void Database::writerRunner(DatabaseWriter& writer)
+{
+    DatabaseConnection* connection = nullptr;
+
+    std::unique_lock<std::mutex> lock(writer.lock);
     for (;;)
     {
-        DatabaseConnection* con = Connections[((i++) % mConnectionCount)];
-        if (con->Busy.AttemptAcquire())
-            return con;
+        if (writer.tasks.empty())
+        {
+            if (connection != nullptr)
+            {
+                releaseConnection(connection);
+                connection = nullptr;
+            }
+
+            if (writer.shutdownRequested)
+                break;
+
+            writer.condition.wait(lock);
+            continue;
+        }
+
+        const DatabaseWriter::Task task = writer.tasks.front();
+        writer.tasks.pop_front();
+
+        lock.unlock();
+
+        if (task.barrier != nullptr)
+        {
+            runBarrierWrite(writer, connection, task);
+        }
+        else
+        {
+            if (connection == nullptr)
+                connection = GetFreeConnection();
+
+            runWrite(connection, task);
+        }
+
+        lock.lock();
+
+        if (task.query == nullptr && task.buffer == nullptr)
+            --writer.barrierCopyCount;
+
+        ++writer.finishedCount;
+        writer.finishedCondition.notify_all();
+    }
+}
+
+void Database::writersShutdown()
+{
+    for (auto& writer : m_writers)
+    {
+        std::lock_guard<std::mutex> guard(writer->lock);
+        writer->shutdownRequested = true;
+        writer->condition.notify_one();
+    }
+
+    // queued writes are still run
+    for (auto& writer : m_writers)
+    {
+        if (writer->thread.joinable())
+            writer->thread.join();
     }
 }
 
+void Database::waitForWrites(uint32_t shardKey)
+{
+    if (m_writers.empty())
+        return;
+
+    DatabaseWriter& writer = getWriter(shardKey);
+
+    std::unique_lock<std::mutex> lock(writer.lock);
+    const uint64_t queuedCount = writer.queuedCount;
+    writer.finishedCondition.wait(lock, [&writer, queuedCount] { return writer.finishedCount >= queuedCount; });
+}
+
 // Use this when we request data that can return a value (not async)
 QueryResult* Database::Query(const char* QueryString, ...)
 {
@@ -133,7 +373,7 @@ QueryResult* Database::Query(const char* QueryString, ...)
     if (_SendQuery(con, sql, false))
         qResult = _StoreQueryResult(con);
 
-    con->Busy.Release();
+    releaseConnection(con);
     return qResult;
 }
 
@@ -159,7 +399,7 @@ QueryResult* Database::Query(bool *success, const char* QueryString, ...)
         *success = false;
     }
 
-    con->Busy.Release();
+    releaseConnection(con);
     return qResult;
 }
 
@@ -172,7 +412,7 @@ QueryResult* Database::QueryNA(const char* QueryString)
     if (_SendQuery(con, QueryString, false))
         qResult = _StoreQueryResult(con);
 
-    con->Busy.Release();
+    releaseConnection(con);
     return qResult;
 }
 
@@ -204,7 +444,7 @@ void QueryBuffer::AddQuery(const char* format, ...)
     char* pBuffer = new char[len + 1];
     memcpy(pBuffer, query, len + 1);
 
-    queries.push_back(pBuffer);
+    queries.push_back({ pBuffer, nullptr });
 }
 
 void QueryBuffer::AddQueryNA(const char* str)
@@ -213,47 +453,12 @@ void QueryBuffer::AddQueryNA(const char* str)
     char* pBuffer = new char[len + 1];
     memcpy(pBuffer, str, len + 1);
 
-    queries.push_back(pBuffer);
+    queries.push_back({ pBuffer, nullptr });
 }
 
-void Database::destroyQueryBufferConnection()
+void QueryBuffer::AddPreparedStatement(PreparedStatement* statement)
 {
-    if (m_queryBufferConnection)
-    {
-        m_queryBufferConnection->Busy.Release();
-        m_queryBufferConnection = nullptr;
-    }
-}
-
-void Database::dbRunAllQueries()
-{
-    while (auto query = queries_queue.pop())
-    {
-        createDbConnection();
-        _SendQuery(m_dbConnection, query, false);
-        delete[] query;
-    }
-}
-
-void Database::queryBufferThreadRunner(AEThread& /*thread*/)
-{
-    queryBufferRunAllQueries();
-}
-
-void Database::queryBufferThreadShutdown() {
-    m_queryBufferThread->killAndJoin();
-    queryBufferRunAllQueries();
-    destroyQueryBufferConnection();
-}
-
-void Database::queryBufferRunAllQueries()
-{
-    while (auto query = query_buffer.pop())
-    {
-        createQueryBufferConnection();
-        PerformQueryBuffer(query, m_queryBufferConnection);
-        delete query;
-    }
+    queries.push_back({ nullptr, statement });
 }
 
 void QueryBuffer::AddQueryStr(const std::string & str)
@@ -262,7 +467,7 @@ void QueryBuffer::AddQueryStr(const std::string & str)
     char* pBuffer = new char[len + 1];
     memcpy(pBuffer, str.c_str(), len + 1);
 
-    queries.push_back(pBuffer);
+    queries.push_back({ pBuffer, nullptr });
 }
 
 void Database::PerformQueryBuffer(QueryBuffer* b, DatabaseConnection* ccon)
@@ -276,16 +481,17 @@ void Database::PerformQueryBuffer(QueryBuffer* b, DatabaseConnection* ccon)
 
     _BeginTransaction(con);
 
-    for (std::vector<char*>::iterator itr = b->queries.begin(); itr != b->queries.end(); ++itr)
-    {
-        _SendQuery(con, *itr, false);
-        delete[](*itr);
-    }
+    bool success = true;
+    for (auto& query : b->queries)
+        success = _SendQueuedQuery(con, query) && success;
 
-    _EndTransaction(con);
+    success = _EndTransaction(con) && success;
 
     if (ccon == NULL)
-        con->Busy.Release();
+        releaseConnection(con);
+
+    if (b->completionHandler)
+        b->completionHandler(success);
 }
 // Use this when we do not have a result. ex: INSERT into SQL 1
 bool Database::Execute(const char* QueryString, ...)
@@ -297,27 +503,105 @@ bool Database::Execute(const char* QueryString, ...)
     vsnprintf(query, 16384, QueryString, vlist);
     va_end(vlist);
 
-    if (m_dbThread->isKilled())
-        return WaitExecuteNA(query);
+    return ExecuteNA(query);
+}
 
-    size_t len = strlen(query);
+bool Database::ExecuteNA(const char* QueryString)
+{
+    size_t len = strlen(QueryString);
     char* pBuffer = new char[len + 1];
-    memcpy(pBuffer, query, len + 1);
+    memcpy(pBuffer, QueryString, len + 1);
 
-    queries_queue.push(pBuffer);
+    queueOrderedWrite({ new QueuedQuery{ pBuffer, nullptr }, nullptr });
     return true;
 }
 
-bool Database::ExecuteNA(const char* QueryString)
+bool Database::_SendQueuedQuery(DatabaseConnection* con, QueuedQuery& query)
+{
+    bool success;
+    if (query.statement != nullptr)
+    {
+        success = _SendPreparedStatement(con, *query.statement, nullptr);
+        delete query.statement;
+    }
+    else
+    {
+        success = _SendQuery(con, query.query, false);
+        delete[] query.query;
+    }
+
+    return success;
+}
+
+void Database::registerPreparedStatement(uint32_t statementId, std::string sql)
+{
+    if (statementId >= m_preparedStatements.size())
+        m_preparedStatements.resize(statementId + 1);
+
+    m_preparedStatements[statementId] = std::move(sql);
+}
+
+std::string const& Database::getPreparedStatement(uint32_t statementId) const
+{
+    static const std::string emptyStatement;
+    if (statementId >= m_preparedStatements.size())
+        return emptyStatement;
+
+    return m_preparedStatements[statementId];
+}
+
+QueryResult* Database::Query(PreparedStatement* statement)
+{
+    QueryResult* qResult = nullptr;
+    DatabaseConnection* con = GetFreeConnection();
+
+    _SendPreparedStatement(con, *statement, &qResult);
+
+    releaseConnection(con);
+    return qResult;
+}
+
+bool Database::WaitExecute(PreparedStatement* statement)
+{
+    DatabaseConnection* con = GetFreeConnection();
+    const bool result = _SendPreparedStatement(con, *statement, nullptr);
+    releaseConnection(con);
+    return result;
+}
+
+bool Database::Execute(PreparedStatement* statement)
 {
-    if (m_dbThread->isKilled())
-        return WaitExecuteNA(QueryString);
+    queueOrderedWrite({ new QueuedQuery{ nullptr, statement }, nullptr });
+    return true;
+}
 
+bool Database::Execute(uint32_t shardKey, PreparedStatement* statement)
+{
+    ++m_keyedWriteCount;
+    queueWrite(shardKey, { new QueuedQuery{ nullptr, statement }, nullptr });
+    return true;
+}
+
+bool Database::Execute(uint32_t shardKey, const char* QueryString, ...)
+{
+    char query[16384];
+
+    va_list vlist;
+    va_start(vlist, QueryString);
+    vsnprintf(query, 16384, QueryString, vlist);
+    va_end(vlist);
+
+    return ExecuteNA(shardKey, query);
+}
+
+bool Database::ExecuteNA(uint32_t shardKey, const char* QueryString)
+{
     size_t len = strlen(QueryString);
     char* pBuffer = new char[len + 1];
     memcpy(pBuffer, QueryString, len + 1);
 
-    queries_queue.push(pBuffer);
+    ++m_keyedWriteCount;
+    queueWrite(shardKey, { new QueuedQuery{ pBuffer, nullptr }, nullptr });
     return true;
 }
 
@@ -332,7 +616,7 @@ bool Database::WaitExecute(const char* QueryString, ...)
 
     DatabaseConnection* con = GetFreeConnection();
     bool Result = _SendQuery(con, sql, false);
-    con->Busy.Release();
+    releaseConnection(con);
     return Result;
 }
 
@@ -340,7 +624,7 @@ bool Database::WaitExecuteNA(const char* QueryString)
 {
     DatabaseConnection* con = GetFreeConnection();
     bool Result = _SendQuery(con, QueryString, false);
-    con->Busy.Release();
+    releaseConnection(con);
     return Result;
 }
 
@@ -359,16 +643,37 @@ void AsyncQuery::AddQuery(const char* format, ...)
     res.query[len] = 0;
     memcpy(res.query, buffer, len);
     res.result = NULL;
+    res.statement = nullptr;
+    queries.push_back(res);
+}
+
+void AsyncQuery::AddPreparedStatement(PreparedStatement* statement)
+{
+    AsyncQueryResult res;
+    res.query = nullptr;
+    res.result = nullptr;
+    res.statement = statement;
     queries.push_back(res);
 }
 
+void AsyncQuery::runQuery(DatabaseConnection* conn, AsyncQueryResult& query)
+{
+    if (query.statement != nullptr)
+        db->_SendPreparedStatement(conn, *query.statement, &query.result);
+    else
+        query.result = db->FQuery(query.query, conn);
+}
+
 void AsyncQuery::Perform()
 {
+    if (hasWriteKey)
+        db->waitForWrites(writeKey);
+
     DatabaseConnection* conn = db->GetFreeConnection();
-    for (std::vector<AsyncQueryResult>::iterator itr = queries.begin(); itr != queries.end(); ++itr)
-        itr->result = db->FQuery(itr->query, conn);
+    for (auto& query : queries)
+        runQuery(conn, query);
 
-    conn->Busy.Release();
+    db->releaseConnection(conn);
     func->run(queries);
 
     delete this;
@@ -383,36 +688,165 @@ AsyncQuery::~AsyncQuery()
             delete itr->result;
 
         delete[] itr->query;
+        delete itr->statement;
     }
 }
 
 void Database::EndThreads()
 {
-    if (m_dbThread)
-        m_dbThread->requestKill();
-    if (m_queryBufferThread)
-        m_queryBufferThread->requestKill();
-
-    dbThreadShutdown();
-    queryBufferThreadShutdown();
+    asyncQueryWorkersShutdown();
+    writersShutdown();
 }
 
 
 void Database::QueueAsyncQuery(AsyncQuery* query)
 {
     query->db = this;
-    query->Perform();
+
+    if (m_asyncQueryWorkers.empty() || query->queries.empty())
+    {
+        query->Perform();
+        return;
+    }
+
+    const size_t queryCount = query->queries.size();
+    query->pendingQueries = static_cast<uint32_t>(queryCount);
+
+    {
+        std::lock_guard<std::mutex> guard(m_asyncQueryLock);
+        for (size_t i = 0; i < queryCount; ++i)
+            m_asyncQueryTasks.push_back({ query, i });
+    }
+
+    if (queryCount == 1)
+        m_asyncQueryCondition.notify_one();
+    else
+        m_asyncQueryCondition.notify_all();
 }
 
-void Database::AddQueryBuffer(QueryBuffer* b)
+void Database::startAsyncQueryWorkers(uint32_t threadCount)
 {
-    if (qt != NULL)
-        query_buffer.push(b);
-    else
+    if (threadCount == 0 || !m_asyncQueryWorkers.empty())
+        return;
+
+    const uint32_t maxThreadCount = static_cast<uint32_t>(std::max<int32>(mConnectionCount - static_cast<int32>(m_writerCount), 1));
+    if (threadCount > maxThreadCount)
+    {
+        sLogger.info("Database : %u async query workers need more connections to `%s`, starting %u", threadCount, mDatabaseName.c_str(), maxThreadCount);
+        threadCount = maxThreadCount;
+    }
+
+    m_asyncQueryShutdownRequested = false;
+
+    m_asyncQueryWorkers.reserve(threadCount);
+    for (uint32_t i = 0; i < threadCount; ++i)
+        m_asyncQueryWorkers.emplace_back(&Database::asyncQueryWorkerRunner, this);
+}
+
+void Database::processAsyncQueryCallbacks()
+{
+    while (AsyncQuery* query = m_finishedAsyncQueries.pop())
+    {
+        query->func->run(query->queries);
+        delete query;
+    }
+}
+
+void Database::asyncQueryWorkerRunner()
+{
+    DatabaseConnection* connection = nullptr;
+
+    std::unique_lock<std::mutex> lock(m_asyncQueryLock);
+    for (;;)
+    {
+        if (m_asyncQueryTasks.empty())
+        {
+            // synchronous queries share the connections, only keep one while there is work
+            if (connection != nullptr)
+            {
+                releaseConnection(connection);
+                connection = nullptr;
+            }
+
+            if (m_asyncQueryShutdownRequested)
+                break;
+
+            m_asyncQueryCondition.wait(lock);
+            continue;
+        }
+
+        const AsyncQueryTask task = m_asyncQueryTasks.front();
+        m_asyncQueryTasks.pop_front();
+
+        lock.unlock();
+
+        if (task.query->hasWriteKey)
+        {
+            // the writer may need this connection
+            if (connection != nullptr)
+            {
+                releaseConnection(connection);
+                connection = nullptr;
+            }
+
+            waitForWrites(task.query->writeKey);
+        }
+
+        if (connection == nullptr)
+            connection = GetFreeConnection();
+
+        task.query->runQuery(connection, task.query->queries[task.index]);
+
+        // the last finished query hands the results to the owner
+        if (--task.query->pendingQueries == 0)
+        {
+            AsyncQuery* query = task.query;
+            m_finishedAsyncQueries.push(query);
+        }
+
+        lock.lock();
+    }
+}
+
+void Database::asyncQueryWorkersShutdown()
+{
+    if (m_asyncQueryWorkers.empty())
+        return;
+
     {
-        PerformQueryBuffer(b, NULL);
-        delete b;
+        std::lock_guard<std::mutex> guard(m_asyncQueryLock);
+        m_asyncQueryShutdownRequested = true;
     }
+
+    m_asyncQueryCondition.notify_all();
+
+    // queued queries are still run
+    for (auto& worker : m_asyncQueryWorkers)
+        worker.join();
+
+    m_asyncQueryWorkers.clear();
+
+    // nobody processes the callbacks anymore, their owners are already gone
+    uint32_t droppedCount = 0;
+    while (AsyncQuery* query = m_finishedAsyncQueries.pop())
+    {
+        delete query;
+        ++droppedCount;
+    }
+
+    if (droppedCount != 0)
+        sLogger.info("Database : Dropped the results of %u async queries to `%s`", droppedCount, mDatabaseName.c_str());
+}
+
+void Database::AddQueryBuffer(QueryBuffer* b)
+{
+    queueOrderedWrite({ nullptr, b });
+}
+
+void Database::AddQueryBuffer(QueryBuffer* b, uint32_t shardKey)
+{
+    ++m_keyedWriteCount;
+    queueWrite(shardKey, { nullptr, b });
 }
 
 void Database::FreeQueryResult(QueryResult* p)
@@ -22,9 +22,18 @@
 
 #include "CThreads.h"
 #include "Field.hpp"
+#include "PreparedStatement.hpp"
 #include "../Threading/Queue.h"
 #include "../CallBack.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include "Threading/AEThread.h"
 
 class QueryResult;
@@ -34,13 +43,22 @@ class SQLCallbackBase;
 
 struct DatabaseConnection
 {
-    Mutex Busy;
+    // end of the last use, connections idle for a while are checked before they are handed out again
+    std::chrono::steady_clock::time_point lastUsed;
 };
 
 struct SERVER_DECL AsyncQueryResult
 {
     QueryResult* result;
     char* query;
+    PreparedStatement* statement;
+};
+
+// Text query or prepared statement waiting for asynchronous execution
+struct SERVER_DECL QueuedQuery
+{
+    char* query;
+    PreparedStatement* statement;
 };
 
 class SERVER_DECL AsyncQuery
@@ -51,48 +69,132 @@ class SERVER_DECL AsyncQuery
         std::vector<AsyncQueryResult> queries;
         Database* db;
 
+        // queries not yet run by the async query workers
+        std::atomic<uint32_t> pendingQueries;
+        void runQuery(DatabaseConnection* conn, AsyncQueryResult& query);
+
+        bool hasWriteKey;
+        uint32_t writeKey;
+
     public:
 
-        AsyncQuery(SQLCallbackBase* f) : func(f), db(nullptr) {}
+        AsyncQuery(SQLCallbackBase* f) : func(f), db(nullptr), pendingQueries(0), hasWriteKey(false), writeKey(0) {}
         ~AsyncQuery();
         void AddQuery(const char* format, ...);
+        // takes ownership of the statement
+        void AddPreparedStatement(PreparedStatement* statement);
+        // the queries see the writes queued for the shard key before they run, see Database::AddQueryBuffer
+        void WaitForWrites(uint32_t shardKey) { hasWriteKey = true; writeKey = shardKey; }
         void Perform();
         inline void SetDB(Database* dbb) { db = dbb; }
 };
 
 class SERVER_DECL QueryBuffer
 {
-        std::vector<char*> queries;
+        std::vector<QueuedQuery> queries;
+        std::function<void(bool)> completionHandler;
     public:
 
         friend class Database;
         void AddQuery(const char* format, ...);
         void AddQueryNA(const char* str);
         void AddQueryStr(const std::string & str);
+        // takes ownership of the statement
+        void AddPreparedStatement(PreparedStatement* statement);
+
+        // called on the writer thread after the transaction, false when a query or the commit failed
+        void setCompletionHandler(std::function<void(bool)> handler) { completionHandler = std::move(handler); }
+
+        uint32_t getQueryCount() const { return static_cast<uint32_t>(queries.size()); }
 };
 
-class SERVER_DECL Database
+struct DatabasePoolStatistics
 {
-    friend class QueryThread;
-    friend class AsyncQuery;
+    uint32_t connectionCount = 0;
+    uint32_t busyConnections = 0;
+    uint32_t waitingCallers = 0;
+    uint32_t pendingWrites = 0;
+    uint32_t pendingAsyncQueries = 0;
+
+    uint64_t keyedWriteCount = 0;               // writes queued on the writer of their shard key
+    uint64_t barrierWriteCount = 0;             // writes without shard key, all writers stop until they ran
+
+    uint64_t acquireCount = 0;
+    uint64_t waitCount = 0;                     // acquires which found no free connection
+    uint64_t totalWaitTime = 0;                 // us
+    uint64_t maxWaitTime = 0;                   // us
+};
 
-    DatabaseConnection* m_dbConnection;
-    void createDbConnection();
-    void destroyDbConnection();
+// A write without shard key is queued on every writer. The first writer runs it once all writers reached it,
+// so it stays in order with the keyed writes queued before and after it.
+struct DatabaseWriteBarrier
+{
+    uint32_t arrivedWriters = 0;
+    bool isDone = false;
+};
 
-    DatabaseConnection* m_queryBufferConnection;
-    void createQueryBufferConnection();
-    void destroyQueryBufferConnection();
+// Runs the Execute queries and query buffers of one shard on its own thread, in the order they were queued
+struct DatabaseWriter
+{
+    struct Task
+    {
+        QueuedQuery* query;
+        QueryBuffer* buffer;
+        std::shared_ptr<DatabaseWriteBarrier> barrier;
+    };
+
+    std::thread thread;
+    std::mutex lock;
+    std::condition_variable condition;
+    std::condition_variable finishedCondition;
+    std::deque<Task> tasks;
+    uint64_t queuedCount = 0;
+    uint64_t finishedCount = 0;
+    uint64_t barrierCopyCount = 0;              // queued barriers of writes run by the first writer
+    bool shutdownRequested = false;
+};
 
-    std::unique_ptr<AscEmu::Threading::AEThread> m_dbThread;
-    void dbThreadRunner(AscEmu::Threading::AEThread& thread);
-    void dbThreadShutdown();
-    void dbRunAllQueries();
+class SERVER_DECL Database
+{
+    friend class QueryThread;
+    friend class AsyncQuery;
 
-    std::unique_ptr<AscEmu::Threading::AEThread> m_queryBufferThread;
-    void queryBufferThreadRunner(AscEmu::Threading::AEThread& thread);
-    void queryBufferThreadShutdown();
-    void queryBufferRunAllQueries();
+    // free connections, callers wait on m_poolCondition while all are in use
+    std::mutex m_poolLock;
+    std::condition_variable m_poolCondition;
+    std::vector<DatabaseConnection*> m_freeConnections;
+    DatabasePoolStatistics m_poolStatistics;
+
+    uint32_t m_writerCount;
+    std::vector<std::unique_ptr<DatabaseWriter>> m_writers;
+    DatabaseWriter& getWriter(uint32_t shardKey) { return *m_writers[shardKey % m_writers.size()]; }
+    void queueWrite(uint32_t shardKey, DatabaseWriter::Task task);
+    void queueOrderedWrite(DatabaseWriter::Task task);
+    void runWrite(DatabaseConnection* con, DatabaseWriter::Task const& task);
+    void runBarrierWrite(DatabaseWriter& writer, DatabaseConnection*& connection, DatabaseWriter::Task const& task);
+    void writerRunner(DatabaseWriter& writer);
+    void writersShutdown();
+
+    std::mutex m_writeBarrierLock;
+    std::condition_variable m_writeBarrierCondition;
+    std::atomic<uint64_t> m_keyedWriteCount;
+    std::atomic<uint64_t> m_barrierWriteCount;
+
+    // one query of an AsyncQuery
+    struct AsyncQueryTask
+    {
+        AsyncQuery* query;
+        size_t index;
+    };
+
+    std::vector<std::thread> m_asyncQueryWorkers;
+    std::mutex m_asyncQueryLock;
+    std::condition_variable m_asyncQueryCondition;
+    std::deque<AsyncQueryTask> m_asyncQueryTasks;
+    bool m_asyncQueryShutdownRequested;
+    FQueue<AsyncQuery*> m_finishedAsyncQueries;
+    void asyncQueryWorkerRunner();
+    void asyncQueryWorkersShutdown();
 
     public:
 
@@ -123,26 +225,72 @@ class SERVER_DECL Database
         virtual bool Execute(const char* QueryString, ...);
         virtual bool ExecuteNA(const char* QueryString);
 
+        //////////////////////////////////////////////////////////////////////////////////////////
+        // Prepared Statements
+        //////////////////////////////////////////////////////////////////////////////////////////
+        // Statements are registered at startup before they are used, each connection prepares them on first use
+        void registerPreparedStatement(uint32_t statementId, std::string sql);
+        std::string const& getPreparedStatement(uint32_t statementId) const;
+
+        // Waits for the result, the statement stays owned by the caller
+        QueryResult* Query(PreparedStatement* statement);
+        bool WaitExecute(PreparedStatement* statement);
+
+        // Queued like Execute, takes ownership of the statement
+        bool Execute(PreparedStatement* statement);
+
         // Initialized on load: Database::Database() : CThread()
         //bool ThreadRunning;
 
         const std::string & GetHostName() { return mHostname; }
         const std::string & GetDatabaseName() { return mDatabaseName; }
-        uint32 GetQueueSize() { return queries_queue.get_size(); }
+
+        // writes queued or running on the writers
+        uint32 GetQueueSize();
 
         virtual std::string EscapeString(std::string Escape) = 0;
         virtual void EscapeLongString(const char* str, uint32 len, std::stringstream & out) = 0;
         virtual std::string EscapeString(const char* esc, DatabaseConnection* con) = 0;
 
+        // The queries of an AsyncQuery are split over the async query workers, its callback runs on the thread
+        // calling processAsyncQueryCallbacks once all of them are done. Without workers it runs right away.
         void QueueAsyncQuery(AsyncQuery* query);
+
+        // Each worker takes a connection while it has queries to run, at most one for each connection not used by a writer
+        void startAsyncQueryWorkers(uint32_t threadCount);
+
+        // runs the callbacks of the finished async queries
+        void processAsyncQueryCallbacks();
+
         void EndThreads();
 
         void FreeQueryResult(QueryResult* p);
 
+        //////////////////////////////////////////////////////////////////////////////////////////
+        // Connection Pool
+        //////////////////////////////////////////////////////////////////////////////////////////
+        // Waits until a connection is free, it has to be given back with releaseConnection
         DatabaseConnection* GetFreeConnection();
+        void releaseConnection(DatabaseConnection* con);
+
+        // Number of writer threads, each with its own connection while it has work. Has to be set before Initialize.
+        void setWriterCount(uint32_t writerCount);
+
+        DatabasePoolStatistics getPoolStatistics();
 
         void PerformQueryBuffer(QueryBuffer* b, DatabaseConnection* ccon);
+
+        // Queued on the writer of the shard key, writes with the same key run in the order they were added.
+        // Writes without a key (Execute, AddQueryBuffer(b)) wait for all writes queued before them and
+        // all writes queued after them wait for them.
         void AddQueryBuffer(QueryBuffer* b);
+        void AddQueryBuffer(QueryBuffer* b, uint32_t shardKey);
+        bool Execute(uint32_t shardKey, PreparedStatement* statement);
+        bool Execute(uint32_t shardKey, const char* QueryString, ...);
+        bool ExecuteNA(uint32_t shardKey, const char* QueryString);
+
+        // Blocks until the writes queued for the shard key and the writes without a key queued before the call are done
+        void waitForWrites(uint32_t shardKey);
 
         static Database* CreateDatabaseInterface();
         static void CleanupLibs();
@@ -156,19 +304,24 @@ class SERVER_DECL Database
         void _Initialize();
 
         virtual void _BeginTransaction(DatabaseConnection* conn) = 0;
-        virtual void _EndTransaction(DatabaseConnection* conn) = 0;
+        virtual bool _EndTransaction(DatabaseConnection* conn) = 0;
 
         // actual query function
         virtual bool _SendQuery(DatabaseConnection* con, const char* Sql, bool Self) = 0;
         virtual QueryResult* _StoreQueryResult(DatabaseConnection* con) = 0;
 
-        //////////////////////////////////////////////////////////////////////////////////////////
-        FQueue<QueryBuffer*> query_buffer;
+        // result is only filled when it is not null
+        virtual bool _SendPreparedStatement(DatabaseConnection* con, PreparedStatement const& statement, QueryResult** result) = 0;
+
+        // reconnects when the server does not answer anymore
+        virtual void _CheckConnection(DatabaseConnection* con) = 0;
+        bool _SendQueuedQuery(DatabaseConnection* con, QueuedQuery& query);
 
         //////////////////////////////////////////////////////////////////////////////////////////
-        FQueue<char*> queries_queue;
         DatabaseConnection** Connections;
 
+        std::vector<std::string> m_preparedStatements;
+
         uint32 _counter;
         //////////////////////////////////////////////////////////////////////////////////////////
 
@@ -10,25 +10,65 @@ This file is released under the MIT license. See README-MIT for more information
 #include "Common.hpp"
 #include "CommonTypes.hpp"
 
+// Values of text protocol results are kept as string and converted on access,
+// prepared statement results store numbers in their binary form.
+enum class FieldType : uint8_t
+{
+    Text,
+    Int64,
+    UInt64,
+    Double
+};
+
 class Field
 {
 public:
     bool isSet() const { return mValue ? true : false; }
-    inline void SetValue(char* value) { mValue = value; }
+    inline void SetValue(char* value) { mValue = value; mType = FieldType::Text; }
+
+    inline void SetInt64(int64_t value) { mInt64 = value; setNumber(FieldType::Int64); }
+    inline void SetUInt64(uint64_t value) { mUInt64 = value; setNumber(FieldType::UInt64); }
+    inline void SetDouble(double value) { mDouble = value; setNumber(FieldType::Double); }
+    inline void SetNull() { mValue = nullptr; mType = FieldType::Text; }
+
+    FieldType GetType() const { return mType; }
 
-    inline const char* GetString() { return mValue; }
-    inline float GetFloat() { return mValue ? static_cast<float>(atof(mValue)) : 0; }
-    inline bool GetBool() { return mValue ? atoi(mValue) > 0 : false; }
+    inline const char* GetString()
+    {
+        if (mType != FieldType::Text && !mIsFormatted)
+            formatNumber();
 
-    inline uint8_t GetUInt8() { return mValue ? static_cast<uint8_t>(atol(mValue)) : 0; }
-    inline int8_t GetInt8() { return mValue ? static_cast<int8_t>(atol(mValue)) : 0; }
-    inline uint16_t GetUInt16() { return mValue ? static_cast<uint16_t>(atol(mValue)) : 0; }
-    inline int16_t GetInt16() { return mValue ? static_cast<int16_t>(atol(mValue)) : 0; }
-    inline uint32_t GetUInt32() { return mValue ? static_cast<uint32_t>(atol(mValue)) : 0; }
-    inline int32_t GetInt32() { return mValue ? static_cast<int32_t>(atol(mValue)) : 0; }
+        return mValue;
+    }
+
+    inline float GetFloat()
+    {
+        if (mType == FieldType::Text)
+            return mValue ? static_cast<float>(atof(mValue)) : 0;
+
+        return static_cast<float>(getNumber<double>());
+    }
+
+    inline bool GetBool()
+    {
+        if (mType == FieldType::Text)
+            return mValue ? atoi(mValue) > 0 : false;
+
+        return getNumber<int64_t>() > 0;
+    }
+
+    inline uint8_t GetUInt8() { return mType == FieldType::Text ? (mValue ? static_cast<uint8_t>(atol(mValue)) : 0) : getNumber<uint8_t>(); }
+    inline int8_t GetInt8() { return mType == FieldType::Text ? (mValue ? static_cast<int8_t>(atol(mValue)) : 0) : getNumber<int8_t>(); }
+    inline uint16_t GetUInt16() { return mType == FieldType::Text ? (mValue ? static_cast<uint16_t>(atol(mValue)) : 0) : getNumber<uint16_t>(); }
+    inline int16_t GetInt16() { return mType == FieldType::Text ? (mValue ? static_cast<int16_t>(atol(mValue)) : 0) : getNumber<int16_t>(); }
+    inline uint32_t GetUInt32() { return mType == FieldType::Text ? (mValue ? static_cast<uint32_t>(atol(mValue)) : 0) : getNumber<uint32_t>(); }
+    inline int32_t GetInt32() { return mType == FieldType::Text ? (mValue ? static_cast<int32_t>(atol(mValue)) : 0) : getNumber<int32_t>(); }
 
     uint64_t GetUInt64()
     {
+        if (mType != FieldType::Text)
+            return getNumber<uint64_t>();
+
         if (mValue)
         {
             uint64_t value;
@@ -45,5 +85,62 @@ public:
     }
 
 private:
+    inline void setNumber(FieldType type)
+    {
+        mType = type;
+        mValue = mText;
+        mIsFormatted = false;
+    }
+
+    template <typename T>
+    inline T getNumber() const
+    {
+        if (mValue == nullptr)
+            return 0;
+
+        switch (mType)
+        {
+            case FieldType::Int64:
+                return static_cast<T>(mInt64);
+            case FieldType::UInt64:
+                return static_cast<T>(mUInt64);
+            default:
+                return static_cast<T>(mDouble);
+        }
+    }
+
+    // GetString on a binary value, only used by callers reading numbers as text
+    void formatNumber()
+    {
+        if (mValue == nullptr)
+            return;
+
+        switch (mType)
+        {
+            case FieldType::Int64:
+                snprintf(mText, sizeof(mText), "%lld", static_cast<long long int>(mInt64));
+                break;
+            case FieldType::UInt64:
+                snprintf(mText, sizeof(mText), I64FMTD, static_cast<unsigned long long int>(mUInt64));
+                break;
+            default:
+                snprintf(mText, sizeof(mText), "%.17g", mDouble);
+                break;
+        }
+
+        mIsFormatted = true;
+    }
+
     char* mValue;
+    FieldType mType;
+    bool mIsFormatted;
+
+    union
+    {
+        int64_t mInt64;
+        uint64_t mUInt64;
+        double mDouble;
+    };
+
+    char mText[32];
 };
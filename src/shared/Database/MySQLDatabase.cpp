@@ -21,10 +21,13 @@
 #include "DatabaseCommon.hpp"
 #include "MySQLDatabase.h"
 
+#include <algorithm>
+
 MySQLDatabase::~MySQLDatabase()
 {
     for(int32 i = 0; i < mConnectionCount; ++i)
     {
+        _ClosePreparedStatements((MySQLDatabaseConnection*)Connections[i]);
         mysql_close(((MySQLDatabaseConnection*)Connections[i])->MySql);
         delete Connections[i];
     }
@@ -41,9 +44,9 @@ void MySQLDatabase::_BeginTransaction(DatabaseConnection* conn)
     _SendQuery(conn, "START TRANSACTION", false);
 }
 
-void MySQLDatabase::_EndTransaction(DatabaseConnection* conn)
+bool MySQLDatabase::_EndTransaction(DatabaseConnection* conn)
 {
-    _SendQuery(conn, "COMMIT", false);
+    return _SendQuery(conn, "COMMIT", false);
 }
 
 bool MySQLDatabase::Initialize(const char* Hostname, unsigned int port, const char* Username, const char* Password, const char* DatabaseName, uint32 ConnectionCount, uint32 /*BufferSize*/)
@@ -68,7 +71,10 @@ bool MySQLDatabase::Initialize(const char* Hostname, unsigned int port, const ch
     {
         temp = mysql_init(NULL);
         if(temp == NULL)
-            continue;
+        {
+            sLogger.failure("Could not initialize connection %u to `%s`", i, DatabaseName);
+            return false;
+        }
 
         if(mysql_options(temp, MYSQL_SET_CHARSET_NAME, "utf8"))
             sLogger.failure("Could not set utf8 character set.");
@@ -103,7 +109,7 @@ std::string MySQLDatabase::EscapeString(std::string Escape)
     else
         ret = a2;
 
-    con->Busy.Release();
+    releaseConnection(con);
 
     return std::string(ret);
 }
@@ -120,7 +126,7 @@ void MySQLDatabase::EscapeLongString(const char* str, uint32 len, std::stringstr
         ret = a2;
 
     out.write(a2, (std::streamsize)strlen(a2));
-    con->Busy.Release();
+    releaseConnection(con);
 }
 
 std::string MySQLDatabase::EscapeString(const char* esc, DatabaseConnection* con)
@@ -237,9 +243,309 @@ bool MySQLDatabase::_Reconnect(MySQLDatabaseConnection* conn)
         return false;
     }
 
+    // statements belong to the old connection
+    _ClosePreparedStatements(conn);
+
     if(conn->MySql != NULL)
         mysql_close(conn->MySql);
 
     conn->MySql = temp;
     return true;
 }
+
+void MySQLDatabase::_CheckConnection(DatabaseConnection* con)
+{
+    MySQLDatabaseConnection* mysqlCon = static_cast<MySQLDatabaseConnection*>(con);
+
+    const unsigned long threadId = mysql_thread_id(mysqlCon->MySql);
+    if(mysql_ping(mysqlCon->MySql) != 0)
+    {
+        sLogger.failure("Connection to `%s` lost due to `%s`, reconnecting", mDatabaseName.c_str(), mysql_error(mysqlCon->MySql));
+        _Reconnect(mysqlCon);
+        return;
+    }
+
+    // the client library reconnected on its own (MYSQL_OPT_RECONNECT), the statements belong to the old connection
+    if(mysql_thread_id(mysqlCon->MySql) != threadId)
+        _ClosePreparedStatements(mysqlCon);
+}
+
+void MySQLDatabase::_ClosePreparedStatements(MySQLDatabaseConnection* con)
+{
+    for (auto& statement : con->Statements)
+    {
+        if (statement != nullptr)
+            mysql_stmt_close(statement);
+
+        statement = nullptr;
+    }
+}
+
+MYSQL_STMT* MySQLDatabase::_GetPreparedStatement(MySQLDatabaseConnection* con, uint32_t statementId)
+{
+    if (statementId >= con->Statements.size())
+        con->Statements.resize(statementId + 1, nullptr);
+
+    if (con->Statements[statementId] != nullptr)
+        return con->Statements[statementId];
+
+    std::string const& sql = getPreparedStatement(statementId);
+    if (sql.empty())
+    {
+        sLogger.failure("Prepared statement %u is not registered", statementId);
+        return nullptr;
+    }
+
+    MYSQL_STMT* statement = mysql_stmt_init(con->MySql);
+    if (statement == nullptr)
+        return nullptr;
+
+    if (mysql_stmt_prepare(statement, sql.c_str(), static_cast<unsigned long>(sql.size())))
+    {
+        sLogger.failure("Could not prepare statement %u due to [%s], Query: [%s]", statementId, mysql_stmt_error(statement), sql.c_str());
+        mysql_stmt_close(statement);
+        return nullptr;
+    }
+
+    // string buffers of results are sized by the longest value
+    decltype(MYSQL_BIND::is_null_value) updateMaxLength = 1;
+    mysql_stmt_attr_set(statement, STMT_ATTR_UPDATE_MAX_LENGTH, &updateMaxLength);
+
+    con->Statements[statementId] = statement;
+    return statement;
+}
+
+bool MySQLDatabase::_SendPreparedStatement(DatabaseConnection* con, PreparedStatement const& statement, QueryResult** result)
+{
+    MySQLDatabaseConnection* mysqlCon = static_cast<MySQLDatabaseConnection*>(con);
+    auto const& values = statement.getValues();
+
+    // the second attempt is made after a reconnect
+    for (uint8_t attempt = 0; attempt < 2; ++attempt)
+    {
+        MYSQL_STMT* stmt = _GetPreparedStatement(mysqlCon, statement.getId());
+        if (stmt == nullptr)
+            return false;
+
+        if (mysql_stmt_param_count(stmt) != values.size())
+        {
+            sLogger.failure("Prepared statement %u needs %u parameters but got %u", statement.getId(), static_cast<uint32_t>(mysql_stmt_param_count(stmt)), static_cast<uint32_t>(values.size()));
+            return false;
+        }
+
+        std::vector<MYSQL_BIND> binds(values.size());
+        if (!binds.empty())
+            memset(binds.data(), 0, sizeof(MYSQL_BIND) * binds.size());
+
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            auto const& value = values[i];
+            switch (value.type)
+            {
+                case PreparedStatementValueType::Int64:
+                    binds[i].buffer_type = MYSQL_TYPE_LONGLONG;
+                    binds[i].buffer = const_cast<int64_t*>(&value.int64Value);
+                    break;
+                case PreparedStatementValueType::UInt64:
+                    binds[i].buffer_type = MYSQL_TYPE_LONGLONG;
+                    binds[i].buffer = const_cast<uint64_t*>(&value.uint64Value);
+                    binds[i].is_unsigned = true;
+                    break;
+                case PreparedStatementValueType::Double:
+                    binds[i].buffer_type = MYSQL_TYPE_DOUBLE;
+                    binds[i].buffer = const_cast<double*>(&value.doubleValue);
+                    break;
+                case PreparedStatementValueType::String:
+                    binds[i].buffer_type = MYSQL_TYPE_STRING;
+                    binds[i].buffer = const_cast<char*>(value.stringValue.data());
+                    binds[i].buffer_length = static_cast<unsigned long>(value.stringValue.size());
+                    break;
+                default:
+                    binds[i].buffer_type = MYSQL_TYPE_NULL;
+                    break;
+            }
+        }
+
+        if (mysql_stmt_bind_param(stmt, binds.data()) || mysql_stmt_execute(stmt))
+        {
+            const uint32 errorNumber = mysql_stmt_errno(stmt);
+
+            // 1243: unknown prepared statement handler, the client reconnected on its own
+            if (attempt == 0 && (errorNumber == 1243 || _HandleError(mysqlCon, errorNumber)))
+            {
+                _ClosePreparedStatements(mysqlCon);
+                continue;
+            }
+
+            sLogger.failure("Prepared statement %u failed due to [%s], Query: [%s]", statement.getId(), mysql_stmt_error(stmt), getPreparedStatement(statement.getId()).c_str());
+            return false;
+        }
+
+        if (result == nullptr)
+        {
+            mysql_stmt_free_result(stmt);
+            return true;
+        }
+
+        *result = nullptr;
+
+        MYSQL_RES* metadata = mysql_stmt_result_metadata(stmt);
+        if (metadata == nullptr)
+            return true;
+
+        if (mysql_stmt_store_result(stmt))
+        {
+            sLogger.failure("Prepared statement %u could not store result due to [%s]", statement.getId(), mysql_stmt_error(stmt));
+            mysql_free_result(metadata);
+            return false;
+        }
+
+        const uint32 rowCount = static_cast<uint32>(mysql_stmt_num_rows(stmt));
+        const uint32 fieldCount = mysql_num_fields(metadata);
+        if (rowCount > 0 && fieldCount > 0)
+        {
+            auto preparedResult = new MySQLPreparedQueryResult(stmt, metadata, fieldCount, rowCount);
+            if (preparedResult->NextRow())
+                *result = preparedResult;
+            else
+                delete preparedResult;
+        }
+
+        mysql_stmt_free_result(stmt);
+        mysql_free_result(metadata);
+        return true;
+    }
+
+    return false;
+}
+
+MySQLPreparedQueryResult::MySQLPreparedQueryResult(MYSQL_STMT* statement, MYSQL_RES* metadata, uint32 FieldCount, uint32 RowCount) : QueryResult(FieldCount, RowCount), mNextRow(0)
+{
+    MYSQL_FIELD* fields = mysql_fetch_fields(metadata);
+
+    std::vector<MYSQL_BIND> binds(FieldCount);
+    memset(binds.data(), 0, sizeof(MYSQL_BIND) * FieldCount);
+
+    std::vector<uint64_t> numberBuffers(FieldCount);
+    std::vector<std::vector<char>> stringBuffers(FieldCount);
+    mColumnTypes.resize(FieldCount);
+
+    for (uint32 i = 0; i < FieldCount; ++i)
+    {
+        switch (fields[i].type)
+        {
+            case MYSQL_TYPE_TINY:
+            case MYSQL_TYPE_SHORT:
+            case MYSQL_TYPE_INT24:
+            case MYSQL_TYPE_LONG:
+            case MYSQL_TYPE_LONGLONG:
+            case MYSQL_TYPE_YEAR:
+                mColumnTypes[i] = (fields[i].flags & UNSIGNED_FLAG) ? FieldType::UInt64 : FieldType::Int64;
+                binds[i].buffer_type = MYSQL_TYPE_LONGLONG;
+                binds[i].buffer = &numberBuffers[i];
+                binds[i].is_unsigned = (fields[i].flags & UNSIGNED_FLAG) != 0;
+                break;
+            case MYSQL_TYPE_FLOAT:
+            case MYSQL_TYPE_DOUBLE:
+                mColumnTypes[i] = FieldType::Double;
+                binds[i].buffer_type = MYSQL_TYPE_DOUBLE;
+                binds[i].buffer = &numberBuffers[i];
+                break;
+            default:
+                // strings, blobs, decimals and dates are handed out as text like in MySQLQueryResult
+                mColumnTypes[i] = FieldType::Text;
+                stringBuffers[i].resize(fields[i].max_length + 1);
+                binds[i].buffer_type = MYSQL_TYPE_STRING;
+                binds[i].buffer = stringBuffers[i].data();
+                binds[i].buffer_length = static_cast<unsigned long>(stringBuffers[i].size());
+                break;
+        }
+
+        binds[i].is_null = &binds[i].is_null_value;
+        binds[i].length = &binds[i].length_value;
+    }
+
+    mValues.reserve(static_cast<size_t>(RowCount) * FieldCount);
+    mNullValues.reserve(static_cast<size_t>(RowCount) * FieldCount);
+
+    if (mysql_stmt_bind_result(statement, binds.data()) == 0)
+    {
+        for (;;)
+        {
+            const int fetchResult = mysql_stmt_fetch(statement);
+            if (fetchResult == 1 || fetchResult == MYSQL_NO_DATA)
+                break;
+
+            for (uint32 i = 0; i < FieldCount; ++i)
+            {
+                if (binds[i].is_null_value)
+                {
+                    mNullValues.push_back(1);
+                    mValues.push_back(0);
+                    continue;
+                }
+
+                mNullValues.push_back(0);
+
+                if (mColumnTypes[i] != FieldType::Text)
+                {
+                    mValues.push_back(numberBuffers[i]);
+                    continue;
+                }
+
+                const size_t length = std::min<size_t>(binds[i].length_value, stringBuffers[i].size() - 1);
+                mValues.push_back(mStrings.size());
+                mStrings.insert(mStrings.end(), stringBuffers[i].data(), stringBuffers[i].data() + length);
+                mStrings.push_back(0);
+            }
+        }
+    }
+
+    mRowCount = static_cast<uint32>(mNullValues.size() / FieldCount);
+    mCurrentRow = new Field[FieldCount];
+}
+
+MySQLPreparedQueryResult::~MySQLPreparedQueryResult()
+{
+    delete [] mCurrentRow;
+}
+
+bool MySQLPreparedQueryResult::NextRow()
+{
+    if (mNextRow >= mRowCount)
+        return false;
+
+    const size_t rowOffset = static_cast<size_t>(mNextRow) * mFieldCount;
+    for (uint32 i = 0; i < mFieldCount; ++i)
+    {
+        const uint64_t value = mValues[rowOffset + i];
+        if (mNullValues[rowOffset + i])
+        {
+            mCurrentRow[i].SetNull();
+            continue;
+        }
+
+        switch (mColumnTypes[i])
+        {
+            case FieldType::Int64:
+                mCurrentRow[i].SetInt64(static_cast<int64_t>(value));
+                break;
+            case FieldType::UInt64:
+                mCurrentRow[i].SetUInt64(value);
+                break;
+            case FieldType::Double:
+            {
+                double doubleValue;
+                memcpy(&doubleValue, &value, sizeof(double));
+                mCurrentRow[i].SetDouble(doubleValue);
+                break;
+            }
+            default:
+                mCurrentRow[i].SetValue(&mStrings[static_cast<size_t>(value)]);
+                break;
+        }
+    }
+
+    ++mNextRow;
+    return true;
+}
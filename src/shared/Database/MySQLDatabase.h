@@ -21,12 +21,16 @@
 #define _MYSQLDATABASE_H
 
 #include <string>
+#include <vector>
 #include <mysql.h>
 
 
 struct MySQLDatabaseConnection : public DatabaseConnection
 {
     MYSQL* MySql;
+
+    // indexed by statement id, prepared on first use
+    std::vector<MYSQL_STMT*> Statements;
 };
 
 
@@ -59,10 +63,15 @@ class SERVER_DECL MySQLDatabase : public Database
         bool _SendQuery(DatabaseConnection* con, const char* Sql, bool Self = false);
 
         void _BeginTransaction(DatabaseConnection* conn);
-        void _EndTransaction(DatabaseConnection* conn);
+        bool _EndTransaction(DatabaseConnection* conn);
         bool _Reconnect(MySQLDatabaseConnection* conn);
+        void _CheckConnection(DatabaseConnection* con);
 
         QueryResult* _StoreQueryResult(DatabaseConnection* con);
+
+        bool _SendPreparedStatement(DatabaseConnection* con, PreparedStatement const& statement, QueryResult** result);
+        MYSQL_STMT* _GetPreparedStatement(MySQLDatabaseConnection* con, uint32_t statementId);
+        void _ClosePreparedStatements(MySQLDatabaseConnection* con);
 };
 
 
@@ -80,4 +89,27 @@ class SERVER_DECL MySQLQueryResult : public QueryResult
         MYSQL_RES* mResult;
 };
 
+// Rows of a prepared statement are copied out of the MYSQL_BIND buffers while the connection is still owned,
+// numeric columns keep their binary value.
+class SERVER_DECL MySQLPreparedQueryResult : public QueryResult
+{
+    public:
+
+        MySQLPreparedQueryResult(MYSQL_STMT* statement, MYSQL_RES* metadata, uint32 FieldCount, uint32 RowCount);
+        ~MySQLPreparedQueryResult();
+
+        bool NextRow();
+
+    protected:
+
+        std::vector<FieldType> mColumnTypes;
+
+        // FieldCount values per row, numbers are stored as is, strings as offset into mStrings
+        std::vector<uint64_t> mValues;
+        std::vector<uint8_t> mNullValues;
+        std::vector<char> mStrings;
+
+        uint32 mNextRow;
+};
+
 #endif        // _MYSQLDATABASE_H
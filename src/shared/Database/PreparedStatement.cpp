@@ -0,0 +1,47 @@
+/*
+Copyright (c) 2014-2021 AscEmu Team <http://www.ascemu.org>
+This file is released under the MIT license. See README-MIT for more information.
+*/
+
+#include "PreparedStatement.hpp"
+
+PreparedStatementValue& PreparedStatement::getValue(uint8_t index)
+{
+    if (index >= m_values.size())
+        m_values.resize(index + 1);
+
+    return m_values[index];
+}
+
+void PreparedStatement::setUInt64(uint8_t index, uint64_t value)
+{
+    auto& parameter = getValue(index);
+    parameter.type = PreparedStatementValueType::UInt64;
+    parameter.uint64Value = value;
+}
+
+void PreparedStatement::setInt64(uint8_t index, int64_t value)
+{
+    auto& parameter = getValue(index);
+    parameter.type = PreparedStatementValueType::Int64;
+    parameter.int64Value = value;
+}
+
+void PreparedStatement::setDouble(uint8_t index, double value)
+{
+    auto& parameter = getValue(index);
+    parameter.type = PreparedStatementValueType::Double;
+    parameter.doubleValue = value;
+}
+
+void PreparedStatement::setString(uint8_t index, std::string value)
+{
+    auto& parameter = getValue(index);
+    parameter.type = PreparedStatementValueType::String;
+    parameter.stringValue = std::move(value);
+}
+
+void PreparedStatement::setNull(uint8_t index)
+{
+    getValue(index).type = PreparedStatementValueType::Null;
+}
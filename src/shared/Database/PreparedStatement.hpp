@@ -0,0 +1,74 @@
+/*
+Copyright (c) 2014-2021 AscEmu Team <http://www.ascemu.org>
+This file is released under the MIT license. See README-MIT for more information.
+*/
+
+#pragma once
+
+#include "CommonTypes.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+enum class PreparedStatementValueType : uint8_t
+{
+    Null,
+    Int64,
+    UInt64,
+    Double,
+    String
+};
+
+struct PreparedStatementValue
+{
+    PreparedStatementValueType type = PreparedStatementValueType::Null;
+
+    union
+    {
+        int64_t int64Value;
+        uint64_t uint64Value;
+        double doubleValue;
+    };
+
+    std::string stringValue;
+
+    PreparedStatementValue() : uint64Value(0) {}
+};
+
+// Parameters for a statement registered with Database::registerPreparedStatement.
+// Values are sent in their binary form, strings do not have to be escaped.
+class SERVER_DECL PreparedStatement
+{
+public:
+
+    explicit PreparedStatement(uint32_t statementId) : m_statementId(statementId) {}
+
+    uint32_t getId() const { return m_statementId; }
+
+    void setBool(uint8_t index, bool value) { setUInt64(index, value ? 1 : 0); }
+    void setUInt8(uint8_t index, uint8_t value) { setUInt64(index, value); }
+    void setUInt16(uint8_t index, uint16_t value) { setUInt64(index, value); }
+    void setUInt32(uint8_t index, uint32_t value) { setUInt64(index, value); }
+    void setUInt64(uint8_t index, uint64_t value);
+
+    void setInt8(uint8_t index, int8_t value) { setInt64(index, value); }
+    void setInt16(uint8_t index, int16_t value) { setInt64(index, value); }
+    void setInt32(uint8_t index, int32_t value) { setInt64(index, value); }
+    void setInt64(uint8_t index, int64_t value);
+
+    void setFloat(uint8_t index, float value) { setDouble(index, value); }
+    void setDouble(uint8_t index, double value);
+
+    void setString(uint8_t index, std::string value);
+    void setNull(uint8_t index);
+
+    std::vector<PreparedStatementValue> const& getValues() const { return m_values; }
+
+private:
+
+    PreparedStatementValue& getValue(uint8_t index);
+
+    uint32_t m_statementId;
+    std::vector<PreparedStatementValue> m_values;
+};
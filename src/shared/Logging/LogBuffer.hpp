@@ -0,0 +1,89 @@
+/*
+Copyright (c) 2014-2021 AscEmu Team <http://www.ascemu.org>
+This file is released under the MIT license. See README-MIT for more information.
+*/
+
+#pragma once
+
+#include "MessageType.hpp"
+#include "Severity.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace AscEmu::Logging
+{
+    // A formatted message waiting for the writer thread
+    struct LogRecord
+    {
+        static constexpr size_t INLINE_TEXT_SIZE = 240;
+
+        std::chrono::system_clock::time_point time;
+        Severity severity;
+        MessageType messageType;
+        bool writeToConsole;
+
+        char text[INLINE_TEXT_SIZE];
+        std::unique_ptr<char[]> longText;       // set when the message does not fit into text
+
+        const char* getText() const { return longText ? longText.get() : text; }
+    };
+
+    // Ring of log records of one thread. The owning thread is the only producer, the writer thread the only consumer,
+    // so neither side takes a lock.
+    class LogBuffer
+    {
+    public:
+        static constexpr size_t CAPACITY = 1024;
+
+        LogBuffer() : m_records(std::make_unique<LogRecord[]>(CAPACITY)) {}
+
+        // producer, returns nullptr when the ring is full
+        LogRecord* beginWrite()
+        {
+            const size_t head = m_head.load(std::memory_order_relaxed);
+            if (head - m_tail.load(std::memory_order_acquire) >= CAPACITY)
+                return nullptr;
+
+            return &m_records[head % CAPACITY];
+        }
+
+        void commitWrite() { m_head.store(m_head.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+        // consumer, returns nullptr when the ring is empty
+        LogRecord* peek()
+        {
+            const size_t tail = m_tail.load(std::memory_order_relaxed);
+            if (tail == m_head.load(std::memory_order_acquire))
+                return nullptr;
+
+            return &m_records[tail % CAPACITY];
+        }
+
+        void pop()
+        {
+            const size_t tail = m_tail.load(std::memory_order_relaxed);
+            m_records[tail % CAPACITY].longText = nullptr;
+            m_tail.store(tail + 1, std::memory_order_release);
+        }
+
+        size_t getSize() const { return m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_acquire); }
+
+        bool isEmpty() const { return m_tail.load(std::memory_order_acquire) == m_head.load(std::memory_order_acquire); }
+
+        // messages the owning thread could not queue, reset by the writer when it reports them
+        std::atomic<uint64_t> droppedMessages{ 0 };
+
+        // the owning thread has exited, the writer removes the ring once it is empty
+        std::atomic<bool> isAbandoned{ false };
+
+    private:
+        std::unique_ptr<LogRecord[]> m_records;
+
+        alignas(64) std::atomic<size_t> m_head{ 0 };
+        alignas(64) std::atomic<size_t> m_tail{ 0 };
+    };
+}
@@ -5,24 +5,61 @@ This file is released under the MIT license. See README-MIT for more information
 
 #include "Logger.hpp"
 #include "ConsoleDefines.hpp"
+#include "LogBuffer.hpp"
 #include "Util.hpp"
 #include "Config/Config.h"
 
+#include <algorithm>
 #include <iostream>
 #include <cstdarg>
+#include <ctime>
 #include <string>
 #include "../../src/world/WorldConf.h"
 
 namespace AscEmu::Logging
 {
+    namespace
+    {
+        // Keeps the ring of a thread registered with the logger, the writer drops it once the thread has exited
+        struct ThreadBufferHolder
+        {
+            std::shared_ptr<LogBuffer> buffer;
+
+            ~ThreadBufferHolder()
+            {
+                if (buffer != nullptr)
+                    buffer->isAbandoned = true;
+            }
+        };
+
+        struct QueuedLine
+        {
+            std::chrono::system_clock::time_point time;
+            Severity severity;
+            bool writeToConsole;
+            std::string text;
+        };
+
+        const std::chrono::milliseconds writerInterval(10);
+    }
+
     Logger& Logger::getInstance()
     {
         static Logger mInstance;
         return mInstance;
     }
 
+    Logger::~Logger()
+    {
+        stopAsyncWriter();
+    }
+
     void Logger::finalize()
     {
+        stopAsyncWriter();
+
+        std::lock_guard<std::mutex> guard(outputLock);
+
         if (this->normalLogFile != nullptr)
         {
             fflush(this->normalLogFile);
@@ -63,6 +100,47 @@ namespace AscEmu::Logging
             std::cerr << __FUNCTION__ << " : Error opening file " << error_filename << std::endl;
         else
             writeFile(this->errorLogFile, logMessage);
+
+        startAsyncWriter();
+    }
+
+    void Logger::startAsyncWriter()
+    {
+        if (isWriterRunning)
+            return;
+
+        {
+            std::lock_guard<std::mutex> guard(writerLock);
+            stopWriter = false;
+        }
+
+        writerThread = std::thread(&Logger::runWriter, this);
+        isWriterRunning = true;
+    }
+
+    void Logger::stopAsyncWriter()
+    {
+        if (!isWriterRunning.exchange(false))
+            return;
+
+        {
+            std::lock_guard<std::mutex> guard(writerLock);
+            stopWriter = true;
+        }
+        writerCondition.notify_one();
+
+        // the crash handler may finalize the logger on the writer thread itself
+        if (writerThread.get_id() == std::this_thread::get_id())
+        {
+            writerThread.detach();
+            return;
+        }
+
+        if (writerThread.joinable())
+            writerThread.join();
+
+        // messages queued while the writer was stopping
+        writeQueuedMessages();
     }
 
     void Logger::setMinimumMessageType(MessageType minimumMessageType)
@@ -131,26 +209,33 @@ namespace AscEmu::Logging
         if (this->minimumMessageType > messageType)
             return;
 
-        char logMessage[327680];
-        createLogMessage(logMessage, severity, messageType, message, arguments);
-  
-        setSeverityConsoleColor(severity);
-        std::cout << logMessage << std::endl;
-        setConsoleColor(CONSOLE_COLOR_NORMAL);
-
-        if (severity >= Severity::FAILURE)
-            writeFile(this->errorLogFile, logMessage);
-
-        writeFile(this->normalLogFile, logMessage);
+        // fatal messages are usually followed by an exit, they must not wait for the writer
+        if (severity == Severity::FATAL || !queueMessage(severity, messageType, true, message, arguments))
+            writeSynchronous(severity, messageType, true, message, arguments);
     }
 
     void Logger::file(Severity severity, MessageType messageType, const char* message, ...)
     {
-        char logMessage[327680];
         va_list arguments;
         va_start(arguments, message);
-        createLogMessage(logMessage, severity, messageType, message, arguments);
+        if (severity == Severity::FATAL || !queueMessage(severity, messageType, false, message, arguments))
+            writeSynchronous(severity, messageType, false, message, arguments);
         va_end(arguments);
+    }
+
+    void Logger::writeSynchronous(Severity severity, MessageType messageType, bool writeToConsole, const char* message, va_list arguments)
+    {
+        char logMessage[327680];
+        createLogMessage(logMessage, severity, messageType, message, arguments);
+
+        std::lock_guard<std::mutex> guard(outputLock);
+
+        if (writeToConsole)
+        {
+            setSeverityConsoleColor(severity);
+            std::cout << logMessage << std::endl;
+            setConsoleColor(CONSOLE_COLOR_NORMAL);
+        }
 
         if (severity >= Severity::FAILURE)
             writeFile(this->errorLogFile, logMessage);
@@ -158,6 +243,175 @@ namespace AscEmu::Logging
         writeFile(this->normalLogFile, logMessage);
     }
 
+    // returns false when the writer thread is not running, the message has to be written synchronously then
+    bool Logger::queueMessage(Severity severity, MessageType messageType, bool writeToConsole, const char* message, va_list arguments)
+    {
+        if (!isWriterRunning.load(std::memory_order_acquire))
+            return false;
+
+        LogBuffer* buffer = getThreadBuffer();
+        LogRecord* record = buffer->beginWrite();
+        if (record == nullptr)
+        {
+            buffer->droppedMessages.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+
+        record->time = std::chrono::system_clock::now();
+        record->severity = severity;
+        record->messageType = messageType;
+        record->writeToConsole = writeToConsole;
+
+        va_list argumentsCopy;
+        va_copy(argumentsCopy, arguments);
+
+        const int length = vsnprintf(record->text, LogRecord::INLINE_TEXT_SIZE, message, arguments);
+        if (length >= static_cast<int>(LogRecord::INLINE_TEXT_SIZE))
+        {
+            record->longText = std::make_unique<char[]>(length + 1);
+            vsnprintf(record->longText.get(), length + 1, message, argumentsCopy);
+        }
+
+        va_end(argumentsCopy);
+
+        buffer->commitWrite();
+
+        // wake the writer early instead of dropping the next messages of a burst
+        if (buffer->getSize() >= LogBuffer::CAPACITY / 2 && !isWriteRequested.exchange(true))
+            writerCondition.notify_one();
+
+        return true;
+    }
+
+    LogBuffer* Logger::getThreadBuffer()
+    {
+        thread_local ThreadBufferHolder holder;
+
+        if (holder.buffer == nullptr)
+        {
+            holder.buffer = std::make_shared<LogBuffer>();
+
+            std::lock_guard<std::mutex> guard(buffersLock);
+            buffers.push_back(holder.buffer);
+        }
+
+        return holder.buffer.get();
+    }
+
+    void Logger::runWriter()
+    {
+        std::unique_lock<std::mutex> lock(writerLock);
+        while (!stopWriter)
+        {
+            writerCondition.wait_for(lock, writerInterval, [this] { return stopWriter || isWriteRequested; });
+            isWriteRequested = false;
+
+            lock.unlock();
+            writeQueuedMessages();
+            lock.lock();
+        }
+    }
+
+    void Logger::writeQueuedMessages()
+    {
+        std::vector<std::shared_ptr<LogBuffer>> currentBuffers;
+        {
+            std::lock_guard<std::mutex> guard(buffersLock);
+            currentBuffers = buffers;
+        }
+
+        std::vector<QueuedLine> lines;
+        uint64_t dropped = 0;
+
+        for (const auto& buffer : currentBuffers)
+        {
+            dropped += buffer->droppedMessages.exchange(0, std::memory_order_relaxed);
+
+            while (LogRecord* record = buffer->peek())
+            {
+                lines.push_back({ record->time, record->severity, record->writeToConsole, createLogPrefix(record->time, record->severity, record->messageType) + record->getText() });
+                buffer->pop();
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> guard(buffersLock);
+            buffers.erase(std::remove_if(buffers.begin(), buffers.end(), [](std::shared_ptr<LogBuffer> const& buffer)
+            {
+                return buffer->isAbandoned && buffer->isEmpty() && buffer->droppedMessages == 0;
+            }), buffers.end());
+        }
+
+        if (dropped != 0)
+        {
+            droppedMessages += dropped;
+
+            char text[128];
+            snprintf(text, sizeof(text), "Logger : %llu messages were dropped, the log buffer of their thread was full", static_cast<unsigned long long>(dropped));
+
+            const auto now = std::chrono::system_clock::now();
+            lines.push_back({ now, Severity::WARNING, true, createLogPrefix(now, Severity::WARNING, MessageType::MINOR) + text });
+        }
+
+        if (lines.empty())
+            return;
+
+        // each ring is in order, the lines of different threads are merged by time
+        std::stable_sort(lines.begin(), lines.end(), [](QueuedLine const& first, QueuedLine const& second) { return first.time < second.time; });
+
+        std::string normalText;
+        std::string errorText;
+
+        std::lock_guard<std::mutex> guard(outputLock);
+
+        bool hasConsoleLines = false;
+        Severity consoleSeverity = Severity::INFO;
+        for (const auto& line : lines)
+        {
+            if (line.writeToConsole)
+            {
+                // the color is applied to the console right away, the text before it has to be written first
+                if (!hasConsoleLines || line.severity != consoleSeverity)
+                {
+                    fflush(stdout);
+                    setSeverityConsoleColor(line.severity);
+                    consoleSeverity = line.severity;
+                }
+
+                fputs(line.text.c_str(), stdout);
+                fputc('\n', stdout);
+                hasConsoleLines = true;
+            }
+
+            normalText += line.text;
+            normalText += '\n';
+
+            if (line.severity >= Severity::FAILURE)
+            {
+                errorText += line.text;
+                errorText += '\n';
+            }
+        }
+
+        if (hasConsoleLines)
+        {
+            fflush(stdout);
+            setConsoleColor(CONSOLE_COLOR_NORMAL);
+        }
+
+        if (this->normalLogFile != nullptr)
+        {
+            fwrite(normalText.data(), 1, normalText.size(), this->normalLogFile);
+            fflush(this->normalLogFile);
+        }
+
+        if (this->errorLogFile != nullptr && !errorText.empty())
+        {
+            fwrite(errorText.data(), 1, errorText.size(), this->errorLogFile);
+            fflush(this->errorLogFile);
+        }
+    }
+
     void Logger::createLogMessage(char* result, Severity severity, MessageType messageType, const char* message, va_list arguments)
     {
         char formattedMessage[32768];
@@ -170,6 +424,24 @@ namespace AscEmu::Logging
         sprintf(result, "%s %s %s: %s", currentTime.c_str(), severityText.c_str(), messageTypeText.c_str(), formattedMessage);
     }
 
+    std::string Logger::createLogPrefix(std::chrono::system_clock::time_point time, Severity severity, MessageType messageType)
+    {
+        const time_t seconds = std::chrono::system_clock::to_time_t(time);
+
+        // the writer thread formats the time while other threads may call localtime
+        tm localTime;
+#ifdef _WIN32
+        localtime_s(&localTime, &seconds);
+#else
+        localtime_r(&seconds, &localTime);
+#endif
+
+        char currentTime[20];
+        strftime(currentTime, sizeof(currentTime), "%H:%M:%S", &localTime);
+
+        return std::string(currentTime) + " " + getSeverityText(severity) + " " + getMessageTypeText(messageType) + ": ";
+    }
+
     std::string Logger::getMessageTypeText(MessageType messageType)
     {
         switch (messageType)
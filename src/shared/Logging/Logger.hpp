@@ -10,14 +10,42 @@ This file is released under the MIT license. See README-MIT for more information
 #include "MessageType.hpp"
 #include "Severity.hpp"
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 namespace AscEmu::Logging
 {
+    class LogBuffer;
+
+    // Messages are formatted by the calling thread and queued in a ring buffer of that thread,
+    // a writer thread adds the prefix and writes them in batches to the console and the log files.
+    // A message is dropped when the ring of its thread is full, fatal messages are written right away.
     class SERVER_DECL Logger
     {
         FILE* normalLogFile = nullptr;
         FILE* errorLogFile = nullptr;;
         MessageType minimumMessageType = MessageType::MINOR;
 
+        // console and log files, taken by the writer thread and by messages written synchronously
+        std::mutex outputLock;
+
+        std::mutex buffersLock;
+        std::vector<std::shared_ptr<LogBuffer>> buffers;
+
+        std::thread writerThread;
+        std::atomic<bool> isWriterRunning{ false };
+        bool stopWriter = false;
+        std::atomic<bool> isWriteRequested{ false };
+        std::mutex writerLock;
+        std::condition_variable writerCondition;
+
+        std::atomic<uint64_t> droppedMessages{ 0 };
+
 #ifdef _WIN32
         HANDLE handle_stdout;
 #endif
@@ -34,6 +62,13 @@ namespace AscEmu::Logging
 
         void initalizeLogger(std::string file_prefix);
 
+        // started by initalizeLogger, while stopped every message is written by the calling thread
+        void startAsyncWriter();
+        void stopAsyncWriter();
+
+        // messages dropped since the start because the ring buffer of their thread was full
+        uint64_t getDroppedMessages() const { return droppedMessages; }
+
         void setMinimumMessageType(MessageType messsageType);
 
         void trace(const char* message, ...);
@@ -56,9 +91,17 @@ namespace AscEmu::Logging
 
     private:
         Logger() = default;
-        ~Logger() = default;
+        ~Logger();
 
         void createLogMessage(char* result, Severity severity, MessageType messageType, const char* message, va_list arguments);
+        std::string createLogPrefix(std::chrono::system_clock::time_point time, Severity severity, MessageType messageType);
+
+        void writeSynchronous(Severity severity, MessageType messageType, bool writeToConsole, const char* message, va_list arguments);
+        bool queueMessage(Severity severity, MessageType messageType, bool writeToConsole, const char* message, va_list arguments);
+
+        LogBuffer* getThreadBuffer();
+        void runWriter();
+        void writeQueuedMessages();
         std::string getMessageTypeText(MessageType messageType);
         std::string getSeverityText(Severity severity);
 
@@ -13,13 +13,14 @@
 
 #include "SocketDefines.h"
 #include <errno.h>
+#include <vector>
 
 class ListenSocketBase
 {
 
     public:
         virtual ~ListenSocketBase() {}
-        virtual void OnAccept() = 0;
+        virtual void OnAccept(int fd) = 0;
         virtual int GetFd() = 0;
 };
 
@@ -29,11 +30,6 @@ class ListenSocket : public ListenSocketBase
     public:
         ListenSocket(const char* ListenAddress, uint32 Port) : ListenSocketBase()
         {
-            m_socket = socket(AF_INET, SOCK_STREAM, 0);
-            SocketOps::ReuseAddr(m_socket);
-            SocketOps::Nonblocking(m_socket);
-            SocketOps::SetTimeout(m_socket, 60);
-
             m_address.sin_family = AF_INET;
             m_address.sin_port = ntohs((u_short)Port);
             m_address.sin_addr.s_addr = htonl(INADDR_ANY);
@@ -46,69 +42,88 @@ class ListenSocket : public ListenSocketBase
                     memcpy(&m_address.sin_addr.s_addr, hostname->h_addr_list[0], hostname->h_length);
             }
 
-            // bind.. well attempt to.
-            int ret = ::bind(m_socket, (const sockaddr*)&m_address, sizeof(m_address));
-            if (ret != 0)
+            // with SO_REUSEPORT every reactor gets its own listen socket and the kernel spreads new connections
+            uint32 socketCount = sSocketMgr.GetListenSocketCount();
+            for (uint32 i = 0; i < socketCount; ++i)
             {
-                sLogger.failure("Bind unsuccessful on port %u.", (unsigned int)Port);
-                return;
+                SOCKET listenSocket = socket(AF_INET, SOCK_STREAM, 0);
+                SocketOps::ReuseAddr(listenSocket);
+                if (socketCount > 1 && !SocketOps::ReusePort(listenSocket))
+                {
+                    sLogger.failure("SO_REUSEPORT unsuccessful on port %u, using a single listen socket.", (unsigned int)Port);
+                    sSocketMgr.DisableReusePort();
+                    socketCount = 1;
+
+                    // the sockets opened so far already share the port, this one could not bind next to them
+                    if (i > 0)
+                    {
+                        SocketOps::CloseSocket(listenSocket);
+                        break;
+                    }
+                }
+                SocketOps::Nonblocking(listenSocket);
+                SocketOps::SetTimeout(listenSocket, 60);
+
+                // bind.. well attempt to.
+                int ret = ::bind(listenSocket, (const sockaddr*)&m_address, sizeof(m_address));
+                if (ret != 0)
+                {
+                    sLogger.failure("Bind unsuccessful on port %u.", (unsigned int)Port);
+                    SocketOps::CloseSocket(listenSocket);
+                    break;
+                }
+
+                ret = listen(listenSocket, 5);
+                if (ret != 0)
+                {
+                    sLogger.failure("Unable to listen on port %u.", (unsigned int)Port);
+                    SocketOps::CloseSocket(listenSocket);
+                    break;
+                }
+
+                m_sockets.push_back(listenSocket);
+                sSocketMgr.AddListenSocket(this, listenSocket, i);
             }
 
-            ret = listen(m_socket, 5);
-            if (ret != 0)
-            {
-                sLogger.failure("Unable to listen on port %u.", (unsigned int)Port);
-                return;
-            }
-            len = sizeof(sockaddr_in);
-            m_opened = true;
-            sSocketMgr.AddListenSocket(this);
+            m_opened = !m_sockets.empty();
         }
 
         ~ListenSocket()
         {
-            if (m_opened)
-                SocketOps::CloseSocket(m_socket);
+            Close();
         }
 
         void Close()
         {
             if (m_opened)
-                SocketOps::CloseSocket(m_socket);
+            {
+                for (auto listenSocket : m_sockets)
+                    SocketOps::CloseSocket(listenSocket);
+            }
             m_opened = false;
         }
 
-        /*void Update()
+        // can be called by several reactor threads at once, keep it free of member state
+        void OnAccept(int fd)
         {
-            aSocket = accept(m_socket, (sockaddr*)&m_tempAddress, (socklen_t*)&len);
-            if (aSocket == -1)
-                return;
-
-            dsocket = new T(aSocket);
-            dsocket->Accept(&m_tempAddress);
-        }*/
+            struct sockaddr_in tempAddress;
+            socklen_t len = sizeof(sockaddr_in);
 
-        void OnAccept()
-        {
-            aSocket = accept(m_socket, (sockaddr*)&m_tempAddress, (socklen_t*)&len);
+            SOCKET aSocket = accept(fd, (sockaddr*)&tempAddress, &len);
             if (aSocket == -1)
                 return;
 
-            dsocket = new T(aSocket);
-            dsocket->Accept(&m_tempAddress);
+            T* dsocket = new T(aSocket);
+            dsocket->Accept(&tempAddress);
         }
 
         inline bool IsOpen() { return m_opened; }
-        int GetFd() { return m_socket; }
+        int GetFd() { return m_sockets.empty() ? -1 : m_sockets.front(); }
 
     private:
-        SOCKET m_socket;
-        SOCKET aSocket;
+        std::vector<SOCKET> m_sockets;
         struct sockaddr_in m_address;
-        struct sockaddr_in m_tempAddress;
         bool m_opened;
-        uint32 len;
-        T* dsocket;
 };
 
 #endif
@@ -22,6 +22,13 @@ Socket::Socket(SOCKET fd, uint32 sendbuffersize, uint32 recvbuffersize) : m_fd(f
     m_completionPort = 0;
 #endif
 
+    // EPOLL Member Variables
+#ifdef CONFIG_USE_EPOLL
+    m_reactorId = 0;
+    m_sharedSegmentRingBytes = 0;
+    m_sharedSegmentBytes = 0;
+#endif
+
     // Check for needed fd allocation.
     if(m_fd == 0)
     {
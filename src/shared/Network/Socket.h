@@ -12,11 +12,14 @@
 #include "SocketDefines.h"
 #include "NetworkIncludes.hpp"
 #include "CircularBuffer.h"
+#include "ByteBuffer.h"
 #include "Log.hpp"
 #include <string>
 #include <mutex>
 #include <atomic>
+#include <deque>
 #include <map>
+#include <memory>
 #include <set>
 
 #ifdef _MSC_VER
@@ -64,6 +67,14 @@ class SERVER_DECL Socket
         // Burst system - Adds bytes to output buffer.
         bool BurstSend(const uint8* Bytes, uint32 Size);
 
+        // Burst system - Adds a shared, immutable buffer to the output.
+        // With epoll it is sent straight from the buffer (writev), other platforms copy it to the output buffer
+        // and return false without writing anything when it does not fit.
+        bool BurstSendShared(std::shared_ptr<const ByteBuffer> const& buffer);
+
+        // Bytes waiting to be sent, output buffer and shared buffers.
+        size_t GetPendingSendSize();
+
         // Burst system - Pushes event to queue - do at the end of write events.
         void BurstPush();
 
@@ -174,6 +185,27 @@ class SERVER_DECL Socket
             res = (m_writeLock.load() != 0);
             return res;
         }
+
+        // Reactor (epoll set and worker thread) owning this socket, assigned by SocketMgr::AddSocket.
+        inline uint32 GetReactorId() { return m_reactorId; }
+        inline void SetReactorId(uint32 reactorId) { m_reactorId = reactorId; }
+
+    private:
+        uint32 m_reactorId;
+
+        // Shared buffers waiting to be sent, interleaved with the bytes of writeBuffer.
+        struct SharedSendSegment
+        {
+            std::shared_ptr<const ByteBuffer> buffer;
+            size_t ringBytesBefore;     // bytes of writeBuffer that have to be sent before this buffer
+            size_t offset;              // bytes of buffer already sent
+        };
+
+        std::deque<SharedSendSegment> m_sharedSegments;
+        size_t m_sharedSegmentRingBytes;    // sum of ringBytesBefore
+        size_t m_sharedSegmentBytes;        // unsent bytes of all shared buffers
+
+        void _WriteSharedSegments();
 #endif
 
         /* FreeBSD - kqueue specific calls */
@@ -78,4 +78,18 @@ void Socket::BurstPush()
         PostEvent(EVFILT_WRITE, true);
 }
 
+bool Socket::BurstSendShared(std::shared_ptr<const ByteBuffer> const& buffer)
+{
+    // no scatter-gather send here, copy it to the output buffer
+    if(buffer->size() == 0)
+        return true;
+
+    return BurstSend(buffer->contents(), static_cast<uint32>(buffer->size()));
+}
+
+size_t Socket::GetPendingSendSize()
+{
+    return writeBuffer.GetSize();
+}
+
 #endif
@@ -9,9 +9,12 @@
 #include "Network.h"
 #ifdef CONFIG_USE_EPOLL
 
+#include <algorithm>
+#include <sys/uio.h>
+
 void Socket::PostEvent(uint32 events)
 {
-    int epoll_fd = sSocketMgr.GetEpollFd();
+    int epoll_fd = sSocketMgr.GetEpollFd(m_reactorId);
 
     struct epoll_event ev;
     memset(&ev, 0, sizeof(epoll_event));
@@ -43,6 +46,7 @@ void Socket::ReadCallback(uint32 len)
     {
         //m_readByteCount += bytes;
         readBuffer.IncrementWritten(bytes);
+        sSocketMgr.GetReactor(m_reactorId).bytes_received += bytes;
         // call virtual onread()
         OnRead();
     }
@@ -56,6 +60,12 @@ void Socket::WriteCallback()
     if(IsDeleted() || !IsConnected())
         return;
 
+    if(!m_sharedSegments.empty())
+    {
+        _WriteSharedSegments();
+        return;
+    }
+
     // We should already be locked at this point, so try to push everything out.
     int bytes_written = send(m_fd, writeBuffer.GetBufferStart(), writeBuffer.GetContiguiousBytes(), 0);
     if(bytes_written < 0)
@@ -65,11 +75,109 @@ void Socket::WriteCallback()
         return;
     }
     m_BytesSent += bytes_written;
+    sSocketMgr.GetReactor(m_reactorId).bytes_sent += bytes_written;
 
     //RemoveWriteBufferBytes(bytes_written, false);
     writeBuffer.Remove(bytes_written);
 }
 
+void Socket::_WriteSharedSegments()
+{
+    // Output buffer bytes and shared buffers are interleaved, send them in order until the kernel buffer is full.
+    struct iovec iov[2];
+    while(!m_sharedSegments.empty())
+    {
+        SharedSendSegment& segment = m_sharedSegments.front();
+
+        int iovCount = 0;
+        size_t ringBytes = 0;
+        if(segment.ringBytesBefore > 0)
+        {
+            ringBytes = std::min(segment.ringBytesBefore, writeBuffer.GetContiguiousBytes());
+            iov[iovCount].iov_base = writeBuffer.GetBufferStart();
+            iov[iovCount].iov_len = ringBytes;
+            ++iovCount;
+        }
+
+        size_t sharedBytes = 0;
+        if(ringBytes == segment.ringBytesBefore)
+        {
+            sharedBytes = segment.buffer->size() - segment.offset;
+            iov[iovCount].iov_base = const_cast<uint8*>(segment.buffer->contents() + segment.offset);
+            iov[iovCount].iov_len = sharedBytes;
+            ++iovCount;
+        }
+
+        ssize_t bytes_written = writev(m_fd, iov, iovCount);
+        if(bytes_written < 0)
+        {
+            if(errno == EAGAIN || errno == EWOULDBLOCK)
+                return;
+
+            // error.
+            Disconnect();
+            return;
+        }
+
+        m_BytesSent += bytes_written;
+        sSocketMgr.GetReactor(m_reactorId).bytes_sent += bytes_written;
+
+        const size_t ringWritten = std::min(static_cast<size_t>(bytes_written), ringBytes);
+        writeBuffer.Remove(ringWritten);
+        segment.ringBytesBefore -= ringWritten;
+        m_sharedSegmentRingBytes -= ringWritten;
+
+        const size_t sharedWritten = static_cast<size_t>(bytes_written) - ringWritten;
+        segment.offset += sharedWritten;
+        m_sharedSegmentBytes -= sharedWritten;
+
+        if(segment.offset == segment.buffer->size())
+            m_sharedSegments.pop_front();
+
+        // short write, the kernel buffer is full
+        if(static_cast<size_t>(bytes_written) < ringBytes + sharedBytes)
+            return;
+    }
+
+    // output buffer bytes queued after the last shared buffer
+    if(writeBuffer.GetSize() > 0)
+    {
+        int bytes_written = send(m_fd, writeBuffer.GetBufferStart(), writeBuffer.GetContiguiousBytes(), 0);
+        if(bytes_written < 0)
+        {
+            if(errno != EAGAIN && errno != EWOULDBLOCK)
+                Disconnect();
+            return;
+        }
+
+        m_BytesSent += bytes_written;
+        sSocketMgr.GetReactor(m_reactorId).bytes_sent += bytes_written;
+        writeBuffer.Remove(bytes_written);
+    }
+}
+
+bool Socket::BurstSendShared(std::shared_ptr<const ByteBuffer> const& buffer)
+{
+    if(buffer->size() == 0)
+        return true;
+
+    // everything in writeBuffer not yet claimed by an earlier shared buffer goes out before this one
+    SharedSendSegment segment;
+    segment.buffer = buffer;
+    segment.ringBytesBefore = writeBuffer.GetSize() - m_sharedSegmentRingBytes;
+    segment.offset = 0;
+
+    m_sharedSegmentRingBytes += segment.ringBytesBefore;
+    m_sharedSegmentBytes += buffer->size();
+    m_sharedSegments.push_back(std::move(segment));
+    return true;
+}
+
+size_t Socket::GetPendingSendSize()
+{
+    return writeBuffer.GetSize() + m_sharedSegmentBytes;
+}
+
 void Socket::BurstPush()
 {
     if(AcquireSendLock())
@@ -11,6 +11,9 @@
 
 //#define ENABLE_ANTI_DOS
 
+/// reactor of the calling worker thread, sockets accepted by a SO_REUSEPORT listener stay on it
+static thread_local int32 t_currentReactor = -1;
+
 void SocketMgr::AddSocket(Socket* s)
 {
 #ifdef ENABLE_ANTI_DOS
@@ -43,9 +46,28 @@ void SocketMgr::AddSocket(Socket* s)
         return;
     }
 
-    if(max_fd < s->GetFd()) max_fd = s->GetFd();
+    // pick a reactor, the accepting one for SO_REUSEPORT listeners, otherwise the one with the fewest sockets
+    uint32 reactorId = 0;
+    if(reuse_port && t_currentReactor >= 0)
+    {
+        reactorId = static_cast<uint32>(t_currentReactor);
+    }
+    else
+    {
+        for(uint32 i = 1; i < reactor_count; ++i)
+        {
+            if(reactors[i].socket_count.load() < reactors[reactorId].socket_count.load())
+                reactorId = i;
+        }
+    }
+
+    s->SetReactorId(reactorId);
+
+    int currentMaxFd = max_fd.load();
+    while(currentMaxFd < s->GetFd() && !max_fd.compare_exchange_weak(currentMaxFd, s->GetFd()));
     fds[s->GetFd()] = s;
     ++socket_count;
+    ++reactors[reactorId].socket_count;
 
     // Add epoll event based on socket activity.
     struct epoll_event ev;
@@ -54,23 +76,24 @@ void SocketMgr::AddSocket(Socket* s)
     ev.events |= EPOLLET;            /* use edge-triggered instead of level-triggered because we're using nonblocking sockets */
     ev.data.fd = s->GetFd();
 
-    if(epoll_ctl(epoll_fd, EPOLL_CTL_ADD, ev.data.fd, &ev))
+    if(epoll_ctl(reactors[reactorId].epoll_fd, EPOLL_CTL_ADD, ev.data.fd, &ev))
         sLogger.failure("Could not add event to epoll set on fd %u", ev.data.fd);
 }
 
-void SocketMgr::AddListenSocket(ListenSocketBase* s)
+void SocketMgr::AddListenSocket(ListenSocketBase* s, int fd, uint32 reactorId)
 {
-    assert(listenfds[s->GetFd()] == 0);
-    listenfds[s->GetFd()] = s;
+    assert(listenfds[fd] == 0);
+    assert(reactorId < reactor_count);
+    listenfds[fd] = s;
 
     // Add epoll event based on socket activity.
     struct epoll_event ev;
     memset(&ev, 0, sizeof(epoll_event));
     ev.events = EPOLLIN;
     ev.events |= EPOLLET;            /* use edge-triggered instead of level-triggered because we're using nonblocking sockets */
-    ev.data.fd = s->GetFd();
+    ev.data.fd = fd;
 
-    if(epoll_ctl(epoll_fd, EPOLL_CTL_ADD, ev.data.fd, &ev))
+    if(epoll_ctl(reactors[reactorId].epoll_fd, EPOLL_CTL_ADD, ev.data.fd, &ev))
         sLogger.failure("Could not add event to epoll set on fd %u", ev.data.fd);
 }
 
@@ -84,6 +107,7 @@ void SocketMgr::RemoveSocket(Socket* s)
 
     fds[s->GetFd()] = NULL;
     --socket_count;
+    --reactors[s->GetReactorId()].socket_count;
 
     // Remove from epoll list.
     struct epoll_event ev;
@@ -91,7 +115,7 @@ void SocketMgr::RemoveSocket(Socket* s)
     ev.data.fd = s->GetFd();
     ev.events = EPOLLIN | EPOLLOUT | EPOLLERR | EPOLLHUP | EPOLLONESHOT;
 
-    if(epoll_ctl(epoll_fd, EPOLL_CTL_DEL, ev.data.fd, &ev))
+    if(epoll_ctl(reactors[s->GetReactorId()].epoll_fd, EPOLL_CTL_DEL, ev.data.fd, &ev))
         sLogger.failure("Could not remove fd %u from epoll set, errno %u", s->GetFd(), errno);
 }
 
@@ -104,14 +128,22 @@ void SocketMgr::CloseAll()
 
 void SocketMgr::SpawnWorkerThreads()
 {
-    uint32 count = 1;
-    for(uint32 i = 0; i < count; ++i)
-        ThreadPool.ExecuteTask(new SocketWorkerThread());
+    for(uint32 i = 0; i < reactor_count; ++i)
+        ThreadPool.ExecuteTask(new SocketWorkerThread(i));
 }
 
 void SocketMgr::ShowStatus()
 {
     sLogger.info("sockets count = %u", static_cast<uint32_t>(socket_count.load()));
+
+    for(uint32 i = 0; i < reactor_count; ++i)
+    {
+        const SocketReactor& reactor = reactors[i];
+        sLogger.info("reactor %u: sockets = %u, events = %llu, received = %llu bytes, sent = %llu bytes, event queue = %u (max %u)",
+            i, static_cast<uint32_t>(reactor.socket_count.load()), static_cast<unsigned long long>(reactor.event_count.load()),
+            static_cast<unsigned long long>(reactor.bytes_received.load()), static_cast<unsigned long long>(reactor.bytes_sent.load()),
+            reactor.last_event_queue.load(), reactor.max_event_queue.load());
+    }
 }
 
 bool SocketWorkerThread::runThread()
@@ -121,9 +153,20 @@ bool SocketWorkerThread::runThread()
     int i;
     running = true;
 
+    SocketReactor& reactor = sSocketMgr.reactors[reactorId];
+    t_currentReactor = static_cast<int32>(reactorId);
+
     while(running)
     {
-        fd_count = epoll_wait(sSocketMgr.epoll_fd, events, THREAD_EVENT_SIZE, 5000);
+        fd_count = epoll_wait(reactor.epoll_fd, events, THREAD_EVENT_SIZE, 5000);
+        if(fd_count > 0)
+        {
+            reactor.event_count += fd_count;
+            reactor.last_event_queue = static_cast<uint32_t>(fd_count);
+            if(static_cast<uint32_t>(fd_count) > reactor.max_event_queue.load())
+                reactor.max_event_queue = static_cast<uint32_t>(fd_count);
+        }
+
         for(i = 0; i < fd_count; ++i)
         {
             if(events[i].data.fd >= SOCKET_HOLDER_SIZE)
@@ -137,7 +180,7 @@ bool SocketWorkerThread::runThread()
             if(ptr == NULL)
             {
                 if((ptr = ((Socket*)sSocketMgr.listenfds[events[i].data.fd])) != NULL)
-                    ((ListenSocketBase*)ptr)->OnAccept();
+                    ((ListenSocketBase*)ptr)->OnAccept(events[i].data.fd);
                 else
                     sLogger.failure("Returned invalid fd (no pointer) of FD %u", events[i].data.fd);
 
@@ -154,14 +197,14 @@ bool SocketWorkerThread::runThread()
                 ptr->ReadCallback(0);               // Len is unknown at this point.
 
                 /* changing to written state? */
-                if(ptr->writeBuffer.GetSize() && !ptr->HasSendLock() && ptr->IsConnected())
+                if(ptr->GetPendingSendSize() && !ptr->HasSendLock() && ptr->IsConnected())
                     ptr->PostEvent(EPOLLOUT);
             }
             else if(events[i].events & EPOLLOUT)
             {
                 ptr->BurstBegin();          // Lock receive mutex
                 ptr->WriteCallback();       // Perform actual send()
-                if(ptr->writeBuffer.GetSize() > 0)
+                if(ptr->GetPendingSendSize() > 0)
                 {
                     /* we don't have to do anything here. no more oneshots :) */
                 }
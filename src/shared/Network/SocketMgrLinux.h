@@ -22,14 +22,38 @@
 #define THREAD_EVENT_SIZE 4096      // This is the number of socket events each thread can receieve at once.
 // This default value should be more than enough.
 
+#define SOCKET_MAX_REACTORS 16       // Upper limit of epoll sets / worker threads.
+
 class Socket;
 class SocketWorkerThread;
 class ListenSocketBase;
 
+/// one epoll set served by one SocketWorkerThread
+struct SocketReactor
+{
+    /// /dev/epoll instance handle
+    int epoll_fd;
+
+    /// sockets assigned to this reactor
+    std::atomic<unsigned long> socket_count;
+
+    /// statistics, shown by SocketMgr::ShowStatus()
+    std::atomic<uint64_t> event_count;
+    std::atomic<uint64_t> bytes_received;
+    std::atomic<uint64_t> bytes_sent;
+    /// events returned by the last/biggest epoll_wait call
+    std::atomic<uint32_t> last_event_queue;
+    std::atomic<uint32_t> max_event_queue;
+};
+
 class SocketMgr
 {
-        /// /dev/epoll instance handle
-        int epoll_fd;
+        /// epoll sets, sockets are spread over the first reactor_count entries
+        SocketReactor reactors[SOCKET_MAX_REACTORS];
+        uint32 reactor_count;
+
+        /// one listen socket per reactor with SO_REUSEPORT, cleared when a listen socket falls back to a single socket
+        std::atomic<bool> reuse_port;
 
         // fd -> pointer binding.
         Socket* fds[SOCKET_HOLDER_SIZE];
@@ -38,7 +62,8 @@ class SocketMgr
         /// socket counter
         std::atomic<unsigned long> socket_count;
 
-        int max_fd;
+        /// raised by every reactor that accepts a socket
+        std::atomic<int> max_fd;
 
     private:
         SocketMgr() = default;
@@ -55,14 +80,33 @@ class SocketMgr
             return mInstance;
         }
 
-        /// constructor > create epoll device handle + initialize event set
-        void initialize()
+        /// constructor > create epoll device handles + initialize event set
+        void initialize(uint32 reactorCount = 1, bool reusePort = false)
         {
-            epoll_fd = epoll_create(SOCKET_HOLDER_SIZE);
-            if(epoll_fd == -1)
+            if (reactorCount == 0)
+                reactorCount = 1;
+            else if (reactorCount > SOCKET_MAX_REACTORS)
+                reactorCount = SOCKET_MAX_REACTORS;
+
+            reactor_count = reactorCount;
+            reuse_port = reusePort && reactorCount > 1;
+
+            for (uint32 i = 0; i < reactor_count; ++i)
             {
-                sLogger.failure("Could not create epoll fd (/dev/epoll).");
-                exit(-1);
+                SocketReactor& reactor = reactors[i];
+                reactor.epoll_fd = epoll_create(SOCKET_HOLDER_SIZE);
+                if (reactor.epoll_fd == -1)
+                {
+                    sLogger.failure("Could not create epoll fd (/dev/epoll).");
+                    exit(-1);
+                }
+
+                reactor.socket_count = 0;
+                reactor.event_count = 0;
+                reactor.bytes_received = 0;
+                reactor.bytes_sent = 0;
+                reactor.last_event_queue = 0;
+                reactor.max_event_queue = 0;
             }
 
             // null out the pointer array
@@ -71,11 +115,12 @@ class SocketMgr
             max_fd = 0;
         }
 
-        /// destructor > destroy epoll handle
+        /// destructor > destroy epoll handles
         void finalize()
         {
-            // close epoll handle
-            close(epoll_fd);
+            // close epoll handles
+            for (uint32 i = 0; i < reactor_count; ++i)
+                close(reactors[i].epoll_fd);
         }
 
         SocketMgr(SocketMgr&&) = delete;
@@ -83,22 +128,33 @@ class SocketMgr
         SocketMgr& operator=(SocketMgr&&) = delete;
         SocketMgr& operator=(SocketMgr const&) = delete;
 
-        /// add a new socket to the epoll set and to the fd mapping
+        /// add a new socket to the epoll set of the least loaded reactor and to the fd mapping
         void AddSocket(Socket* s);
-        void AddListenSocket(ListenSocketBase* s);
+
+        /// add a listen socket fd to the epoll set of a reactor
+        void AddListenSocket(ListenSocketBase* s, int fd, uint32 reactorId = 0);
 
         /// remove a socket from epoll set/fd mapping
         void RemoveSocket(Socket* s);
 
-        /// returns epoll fd
-        inline int GetEpollFd() { return epoll_fd; }
+        /// returns epoll fd of a reactor
+        inline int GetEpollFd(uint32 reactorId = 0) { return reactors[reactorId].epoll_fd; }
+
+        inline SocketReactor& GetReactor(uint32 reactorId) { return reactors[reactorId]; }
+        inline uint32 GetReactorCount() { return reactor_count; }
+
+        /// number of listen sockets a ListenSocket should open on its port
+        inline uint32 GetListenSocketCount() { return reuse_port ? reactor_count : 1; }
+
+        /// SO_REUSEPORT is not available, new sockets are spread over the reactors by load again
+        inline void DisableReusePort() { reuse_port = false; }
 
         /// closes all sockets
         void CloseAll();
 
         uint32 GetSocketCount() { return socket_count.load(); }
 
-        /// spawns worker threads
+        /// spawns one worker thread per reactor
         void SpawnWorkerThreads();
 
         /// show status
@@ -110,7 +166,10 @@ class SocketWorkerThread : public ThreadBase
         /// epoll event struct
         struct epoll_event events[THREAD_EVENT_SIZE];
         bool running;
+        uint32 reactorId;
     public:
+        explicit SocketWorkerThread(uint32 reactor) : running(false), reactorId(reactor) {}
+
         bool runThread();
         void onShutdown()
         {
@@ -74,6 +74,13 @@ namespace SocketOps
             printf("SO_REUSEADDR setsockopt error\n");
     }
 
+    // Sets reuseport, allows several listen sockets on the same port
+    bool ReusePort(SOCKET fd)
+    {
+        uint32 option = 1;
+        return (setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, (const char*)&option, 4) == 0);
+    }
+
     // Set internal timeout.
     bool SetTimeout(SOCKET fd, uint32 timeout)
     {
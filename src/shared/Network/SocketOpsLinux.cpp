@@ -83,6 +83,17 @@ namespace SocketOps
         if (setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, (const char*)&option, 4) < 0)
             printf("SO_REUSEADDR setsockopt error\n");
     }
+
+    // Sets reuseport, allows several listen sockets on the same port
+    bool ReusePort(SOCKET fd)
+    {
+#ifdef SO_REUSEPORT
+        uint32 option = 1;
+        return (setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, (const char*)&option, 4) == 0);
+#else
+        return false;
+#endif
+    }
 }
 
 #endif
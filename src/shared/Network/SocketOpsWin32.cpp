@@ -82,6 +82,12 @@ namespace SocketOps
         if (setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, (const char*)&option, 4) < 0)
             printf("SO_REUSEADDR setsockopt error\n");
     }
+
+    // SO_REUSEPORT is not available on windows
+    bool ReusePort(SOCKET /*fd*/)
+    {
+        return false;
+    }
 }
 
 #endif
@@ -0,0 +1,140 @@
+/*
+Copyright (c) 2014-2021 AscEmu Team <http://www.ascemu.org>
+This file is released under the MIT license. See README-MIT for more information.
+*/
+
+#include "AEWorkerPool.h"
+#include <algorithm>
+
+using std::lock_guard;
+using std::mutex;
+using std::string;
+using std::unique_lock;
+
+namespace AscEmu::Threading
+{
+    AEWorkerPool::AEWorkerPool(string poolName, uint16_t threadCount) :
+        m_poolName(poolName),
+        m_shutdownRequested(false)
+    {
+        if (threadCount == 0)
+            threadCount = 1;
+
+        m_workers.reserve(threadCount);
+        for (uint16_t i = 0; i < threadCount; ++i)
+            m_workers.emplace_back(&AEWorkerPool::workerRunner, this);
+    }
+
+    AEWorkerPool::~AEWorkerPool() { shutdown(); }
+
+    void AEWorkerPool::workerRunner()
+    {
+        for (;;)
+        {
+            Job job;
+
+            {
+                unique_lock<mutex> lock(m_mtx);
+                m_condition.wait(lock, [this] { return m_shutdownRequested || !m_jobs.empty(); });
+
+                if (m_jobs.empty())
+                    return;
+
+                job = std::move(m_jobs.front());
+                m_jobs.pop_front();
+            }
+
+            job();
+        }
+    }
+
+    void AEWorkerPool::enqueue(Job job)
+    {
+        {
+            lock_guard<mutex> guard(m_mtx);
+            m_jobs.push_back(std::move(job));
+        }
+
+        m_condition.notify_one();
+    }
+
+    void AEWorkerPool::runAndWait(std::vector<Job>& jobs)
+    {
+        if (jobs.empty())
+            return;
+
+        if (jobs.size() == 1)
+        {
+            jobs.front()();
+            return;
+        }
+
+        // Every participant claims the next unstarted job, so a batch finishes even if no worker is free
+        struct Batch
+        {
+            std::vector<Job>* jobs;
+            size_t total;
+            std::atomic<size_t> next;
+            std::atomic<size_t> finished;
+            mutex mtx;
+            std::condition_variable done;
+        };
+
+        auto batch = std::make_shared<Batch>();
+        batch->jobs = &jobs;
+        batch->total = jobs.size();
+        batch->next = 0;
+        batch->finished = 0;
+
+        const auto runBatch = [](Batch& current)
+        {
+            // total is cached, helpers starting after the batch is done never touch the jobs vector
+            const size_t total = current.total;
+            size_t index;
+            while ((index = current.next++) < total)
+            {
+                (*current.jobs)[index]();
+
+                if (++current.finished == total)
+                {
+                    lock_guard<mutex> guard(current.mtx);
+                    current.done.notify_all();
+                }
+            }
+        };
+
+        const size_t helpers = std::min(jobs.size() - 1, m_workers.size());
+        for (size_t i = 0; i < helpers; ++i)
+            enqueue([batch, runBatch]() { runBatch(*batch); });
+
+        runBatch(*batch);
+
+        unique_lock<mutex> lock(batch->mtx);
+        batch->done.wait(lock, [&batch] { return batch->finished == batch->total; });
+    }
+
+    void AEWorkerPool::shutdown()
+    {
+        {
+            lock_guard<mutex> guard(m_mtx);
+            if (m_shutdownRequested)
+                return;
+
+            m_shutdownRequested = true;
+        }
+
+        m_condition.notify_all();
+
+        for (auto& worker : m_workers)
+        {
+            if (worker.joinable())
+                worker.join();
+        }
+    }
+
+    size_t AEWorkerPool::getQueueSize()
+    {
+        lock_guard<mutex> guard(m_mtx);
+        return m_jobs.size();
+    }
+}
@@ -0,0 +1,59 @@
+/*
+Copyright (c) 2014-2021 AscEmu Team <http://www.ascemu.org>
+This file is released under the MIT license. See README-MIT for more information.
+*/
+
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Fixed size pool of worker threads for short lived jobs.
+// Unlike AEThreadPool it does not pulse, jobs are handed to a sleeping worker immediately.
+namespace AscEmu::Threading
+{
+    class AEWorkerPool
+    {
+    public:
+        typedef std::function<void()> Job;
+
+        AEWorkerPool(std::string poolName, uint16_t threadCount);
+        ~AEWorkerPool();
+
+        AEWorkerPool(AEWorkerPool const&) = delete;
+        AEWorkerPool& operator=(AEWorkerPool const&) = delete;
+
+        // Queues a job, it will be executed by the next idle worker
+        void enqueue(Job job);
+
+        // Executes all jobs and returns when every job is finished.
+        // The calling thread takes part in the work, so this can not dead lock when all workers are busy.
+        void runAndWait(std::vector<Job>& jobs);
+
+        // Stops all workers after the queued jobs are done
+        void shutdown();
+
+        uint16_t getThreadCount() const { return static_cast<uint16_t>(m_workers.size()); }
+        size_t getQueueSize();
+
+        std::string getName() const { return m_poolName; }
+
+    private:
+        void workerRunner();
+
+        std::string m_poolName;
+        std::vector<std::thread> m_workers;
+
+        std::mutex m_mtx;
+        std::condition_variable m_condition;
+        std::deque<Job> m_jobs;
+        bool m_shutdownRequested;
+    };
+}
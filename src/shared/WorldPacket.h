@@ -8,6 +8,8 @@ This file is released under the MIT license. See README-MIT for more information
 #include "CommonTypes.hpp"
 #include "ByteBuffer.h"
 
+#include <memory>
+
 class SERVER_DECL WorldPacket : public ByteBuffer
 {
 public:
@@ -31,3 +33,6 @@ protected:
     uint16_t m_opcode;
 
 };
+
+// Immutable packet referenced by all recipients of a broadcast instead of being copied for each of them
+typedef std::shared_ptr<const WorldPacket> SharedWorldPacket;
@@ -0,0 +1,180 @@
+/*
+Copyright (c) 2014-2021 AscEmu Team <http://www.ascemu.org>
+This file is released under the MIT license. See README-MIT for more information.
+*/
+
+// Collects the targets of an AoE spell from 300 in-range units, like Spell::FillAllTargetsInArea does.
+// "copy" is the old std::vector in-range set: the accessor returned a copy and the hostile check searched
+// the opposite faction vector. "view" iterates an InRangeSet::View and checks the hashed index.
+// Every round one target dies while the targets are collected and comes back afterwards.
+//
+// usage: aoe_target_benchmark [rounds]
+
+#include "Objects/InRangeSet.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+class Object
+{
+public:
+    float x;
+    float y;
+    float z;
+};
+
+namespace
+{
+    const size_t unitCount = 300;
+    const float spellRadius = 15.0f;
+
+    bool isInRadius(Object const* caster, Object const* target)
+    {
+        const float dx = caster->x - target->x;
+        const float dy = caster->y - target->y;
+        const float dz = caster->z - target->z;
+        return dx * dx + dy * dy + dz * dz <= spellRadius * spellRadius;
+    }
+
+    struct OldInRangeSets
+    {
+        std::vector<Object*> objects;
+        std::vector<Object*> oppositeFaction;
+
+        std::vector<Object*> getInRangeObjectsSet() { return objects; }
+
+        bool isHostile(Object* object) const
+        {
+            return std::find(oppositeFaction.begin(), oppositeFaction.end(), object) != oppositeFaction.end();
+        }
+
+        void remove(Object* object)
+        {
+            objects.erase(std::remove(objects.begin(), objects.end(), object), objects.end());
+            oppositeFaction.erase(std::remove(oppositeFaction.begin(), oppositeFaction.end(), object), oppositeFaction.end());
+        }
+    };
+
+    struct NewInRangeSets
+    {
+        InRangeSet objects;
+        InRangeSet oppositeFaction;
+
+        void remove(Object* object)
+        {
+            objects.erase(object);
+            oppositeFaction.erase(object);
+        }
+    };
+
+    template <typename Collect>
+    double measure(uint32_t rounds, Collect collect)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < rounds; ++i)
+            collect(i);
+
+        return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / rounds;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const uint32_t rounds = argc > 1 ? static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10)) : 20000;
+    if (rounds == 0)
+    {
+        printf("usage: %s [rounds]\n", argv[0]);
+        return 1;
+    }
+
+    std::mt19937 random(4711);
+    std::uniform_real_distribution<float> position(-30.0f, 30.0f);
+
+    Object caster = { 0.0f, 0.0f, 0.0f };
+    std::vector<Object> units(unitCount);
+
+    OldInRangeSets oldSets;
+    NewInRangeSets newSets;
+    for (size_t i = 0; i < unitCount; ++i)
+    {
+        units[i] = { position(random), position(random), position(random) / 10.0f };
+
+        oldSets.objects.push_back(&units[i]);
+        newSets.objects.insert(&units[i]);
+
+        // two thirds of the units are hostile
+        if (i % 3 != 0)
+        {
+            oldSets.oppositeFaction.push_back(&units[i]);
+            newSets.oppositeFaction.insert(&units[i]);
+        }
+    }
+
+    std::vector<Object*> targets;
+    targets.reserve(unitCount);
+
+    size_t oldTargetCount = 0;
+    const double oldTime = measure(rounds, [&](uint32_t round)
+    {
+        targets.clear();
+
+        Object* dyingUnit = &units[round % unitCount];
+        const bool wasHostile = oldSets.isHostile(dyingUnit);
+
+        for (Object* object : oldSets.getInRangeObjectsSet())
+        {
+            if (object == dyingUnit)
+                oldSets.remove(dyingUnit);
+
+            if (isInRadius(&caster, object) && oldSets.isHostile(object))
+                targets.push_back(object);
+        }
+
+        oldSets.objects.push_back(dyingUnit);
+        if (wasHostile)
+            oldSets.oppositeFaction.push_back(dyingUnit);
+
+        oldTargetCount += targets.size();
+    });
+
+    size_t newTargetCount = 0;
+    const double newTime = measure(rounds, [&](uint32_t round)
+    {
+        targets.clear();
+
+        Object* dyingUnit = &units[round % unitCount];
+        const bool wasHostile = newSets.oppositeFaction.contains(dyingUnit);
+
+        {
+            auto view = newSets.objects.view();
+            for (Object* object : view)
+            {
+                // the old vector copy still visited the dying unit, the view skips it from now on
+                if (object == dyingUnit)
+                {
+                    newSets.remove(dyingUnit);
+                    continue;
+                }
+
+                if (isInRadius(&caster, object) && newSets.oppositeFaction.contains(object))
+                    targets.push_back(object);
+            }
+        }
+
+        newSets.objects.insert(dyingUnit);
+        if (wasHostile)
+            newSets.oppositeFaction.insert(dyingUnit);
+
+        newTargetCount += targets.size();
+    });
+
+    printf("%u rounds over %u in-range units, spell radius %.0f yards\n", rounds, static_cast<uint32_t>(unitCount), spellRadius);
+    printf("copy: %10.1f ns per cast, %.1f targets\n", oldTime, static_cast<double>(oldTargetCount) / rounds);
+    printf("view: %10.1f ns per cast, %.1f targets\n", newTime, static_cast<double>(newTargetCount) / rounds);
+
+    return 0;
+}
@@ -0,0 +1,277 @@
+/*
+Copyright (c) 2014-2021 AscEmu Team <http://www.ascemu.org>
+This file is released under the MIT license. See README-MIT for more information.
+*/
+
+// Searches a synthetic auction house of 100k auctions over 8000 items for one page of 50 results,
+// with the filters players use most: browsing a category, a level range, a minimum quality and names.
+// "scan" is the old AuctionHouse::sendAuctionList, it checked every auction and copied each item
+// name. "index" is AuctionHouseIndex. Before measuring, the complete result of every search is
+// compared, the benchmark fails when the two differ.
+//
+// usage: auction_search_benchmark [auctions] [rounds]
+
+#include "Management/AuctionHouseIndex.hpp"
+#include "Management/ItemPrototype.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct Auction
+{
+    uint32_t Id;
+    bool isRemoved;
+    ItemProperties const* properties;
+};
+
+namespace
+{
+    const uint32_t itemCount = 8000;
+    const uint32_t pageSize = 50;
+
+    const char* const prefixes[] = { "sturdy ", "heavy ", "fine ", "runed ", "ancient ", "shadow ", "blessed ", "cracked " };
+    const char* const materials[] = { "iron ", "copper ", "mithril ", "thorium ", "silk ", "linen ", "leather ", "felsteel " };
+    const char* const suffixes[] = { "", "", " of the bear", " of the eagle", " of the monkey", " of healing" };
+
+    struct ItemKind
+    {
+        const char* name;
+        uint32_t itemClass;
+        uint16_t subClass;
+        uint32_t inventoryType;
+    };
+
+    const ItemKind itemKinds[] =
+    {
+        { "sword", 2, 7, 13 }, { "axe", 2, 0, 13 }, { "mace", 2, 4, 13 }, { "staff", 2, 10, 17 }, { "bow", 2, 2, 15 },
+        { "helm", 4, 4, 1 }, { "chestplate", 4, 4, 5 }, { "robe", 4, 1, 20 }, { "gloves", 4, 2, 10 }, { "boots", 4, 3, 8 },
+        { "ring", 4, 0, 11 }, { "potion", 0, 1, 0 }, { "bandage", 0, 7, 0 }, { "ore", 7, 7, 0 }, { "cloth", 7, 5, 0 }
+    };
+
+    std::vector<ItemProperties> buildItems(std::mt19937& random)
+    {
+        std::vector<ItemProperties> items(itemCount);
+        for (uint32_t i = 0; i < itemCount; ++i)
+        {
+            ItemKind const& kind = itemKinds[random() % (sizeof(itemKinds) / sizeof(itemKinds[0]))];
+
+            ItemProperties& item = items[i];
+            item.ItemId = 1000 + i;
+            item.Class = kind.itemClass;
+            item.SubClass = kind.subClass;
+            item.InventoryType = kind.inventoryType;
+            item.Quality = random() % 5;
+            item.RequiredLevel = random() % 81;
+            item.lowercase_name = std::string(prefixes[random() % 8]) + materials[random() % 8] + kind.name + suffixes[random() % 6];
+            item.Name = item.lowercase_name;
+        }
+
+        return items;
+    }
+
+    struct Search
+    {
+        AuctionSearchFilter filter;
+        uint32_t listFrom;
+    };
+
+    std::vector<Search> buildSearches()
+    {
+        // the first search has no filter, like opening the auction house
+        std::vector<Search> searches(8);
+
+        searches[1].filter.itemClass = 2;
+        searches[1].filter.itemSubClass = 7;
+        searches[1].filter.levelMin = 20;
+        searches[1].filter.levelMax = 30;
+
+        searches[2].filter.itemClass = 4;
+        searches[2].filter.inventoryType = 5;
+        searches[2].filter.quality = 2;
+
+        searches[3].filter.name = "iron";
+
+        searches[4].filter.name = "of the bear";
+        searches[4].listFrom = 100;
+
+        searches[5].filter.name = "mithril sword";
+        searches[5].filter.levelMin = 60;
+        searches[5].filter.levelMax = 70;
+
+        searches[6].filter.name = "of";
+
+        searches[7].filter.name = "arcanite";
+
+        return searches;
+    }
+
+    // the filter checks of the old AuctionHouse::sendAuctionList
+    bool oldMatches(Auction const* auction, AuctionSearchFilter const& filter)
+    {
+        ItemProperties const* proto = auction->properties;
+
+        if (filter.inventoryType != 0xffffffff && filter.inventoryType != proto->InventoryType)
+            return false;
+
+        if (filter.itemClass != 0xffffffff && filter.itemClass != proto->Class)
+            return false;
+
+        if (filter.itemSubClass != 0xffffffff && filter.itemSubClass != proto->SubClass)
+            return false;
+
+        std::string proto_lower = proto->lowercase_name;
+        if (filter.name.length() > 0 && proto_lower.find(filter.name) == std::string::npos)
+            return false;
+
+        if (filter.quality != 0xffffffff && filter.quality > proto->Quality)
+            return false;
+
+        if (filter.levelMin && proto->RequiredLevel < filter.levelMin)
+            return false;
+
+        if (filter.levelMax && proto->RequiredLevel > filter.levelMax)
+            return false;
+
+        return true;
+    }
+
+    std::vector<uint32_t> oldSearchPage(std::unordered_map<uint32_t, Auction*> const& auctions, Search const& search)
+    {
+        std::vector<uint32_t> page;
+        uint32_t totalcount = 0;
+
+        for (const auto& auction : auctions)
+        {
+            if (auction.second->isRemoved || !oldMatches(auction.second, search.filter))
+                continue;
+
+            if (page.size() < pageSize && totalcount >= search.listFrom)
+                page.push_back(auction.second->Id);
+
+            ++totalcount;
+        }
+
+        return page;
+    }
+
+    std::vector<uint32_t> newSearchPage(AuctionHouseIndex const& index, Search const& search)
+    {
+        std::vector<uint32_t> page;
+        uint32_t totalcount = 0;
+
+        index.search(search.filter, [&](Auction* auction)
+        {
+            if (auction->isRemoved)
+                return true;
+
+            if (page.size() < pageSize && totalcount >= search.listFrom)
+                page.push_back(auction->Id);
+
+            ++totalcount;
+
+            return page.size() < pageSize;
+        });
+
+        return page;
+    }
+
+    uint32_t countMismatches(std::unordered_map<uint32_t, Auction*> const& auctions, AuctionHouseIndex const& index, std::vector<Search> const& searches)
+    {
+        uint32_t mismatches = 0;
+        for (const auto& search : searches)
+        {
+            std::vector<uint32_t> scanned;
+            for (const auto& auction : auctions)
+            {
+                if (!auction.second->isRemoved && oldMatches(auction.second, search.filter))
+                    scanned.push_back(auction.second->Id);
+            }
+
+            std::vector<uint32_t> indexed;
+            index.search(search.filter, [&indexed](Auction* auction)
+            {
+                if (!auction->isRemoved)
+                    indexed.push_back(auction->Id);
+
+                return true;
+            });
+
+            std::sort(scanned.begin(), scanned.end());
+            std::sort(indexed.begin(), indexed.end());
+            if (scanned != indexed)
+            {
+                printf("search \"%s\": scan found %u auctions, index %u\n", search.filter.name.c_str(), static_cast<uint32_t>(scanned.size()), static_cast<uint32_t>(indexed.size()));
+                ++mismatches;
+            }
+        }
+
+        return mismatches;
+    }
+
+    template <typename Lookup>
+    double measure(uint32_t rounds, size_t searchesPerRound, Lookup lookup)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < rounds; ++i)
+            lookup();
+
+        return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / (static_cast<double>(rounds) * searchesPerRound);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const uint32_t auctionCount = argc > 1 ? static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10)) : 100000;
+    const uint32_t rounds = argc > 2 ? static_cast<uint32_t>(std::strtoul(argv[2], nullptr, 10)) : 20;
+    if (auctionCount == 0 || rounds == 0)
+    {
+        printf("usage: %s [auctions] [rounds]\n", argv[0]);
+        return 1;
+    }
+
+    std::mt19937 random(10);
+    const std::vector<ItemProperties> items = buildItems(random);
+
+    std::vector<Auction> auctionStore(auctionCount);
+    std::unordered_map<uint32_t, Auction*> auctions;
+    AuctionHouseIndex index;
+    for (uint32_t i = 0; i < auctionCount; ++i)
+    {
+        Auction& auction = auctionStore[i];
+        auction.Id = i + 1;
+        auction.isRemoved = random() % 50 == 0;
+        auction.properties = &items[random() % itemCount];
+
+        auctions.emplace(auction.Id, &auction);
+        index.addAuction(&auction, auction.Id, auction.properties);
+    }
+
+    const std::vector<Search> searches = buildSearches();
+
+    const uint32_t mismatches = countMismatches(auctions, index, searches);
+    printf("%u of %u searches differ between scan and index\n", mismatches, static_cast<uint32_t>(searches.size()));
+    if (mismatches != 0)
+        return 1;
+
+    printf("%u auctions of %u items, %u rounds\n", auctionCount, itemCount, rounds);
+
+    size_t scanResults = 0;
+    size_t indexResults = 0;
+    for (const auto& search : searches)
+    {
+        const double scanTime = measure(rounds, 1, [&]() { scanResults += oldSearchPage(auctions, search).size(); });
+        const double indexTime = measure(rounds, 1, [&]() { indexResults += newSearchPage(index, search).size(); });
+
+        printf("name \"%s\" class %d subclass %d slot %d quality %d level %u-%u from %u: scan %.1f us, index %.1f us\n", search.filter.name.c_str(),
+            static_cast<int>(search.filter.itemClass), static_cast<int>(search.filter.itemSubClass), static_cast<int>(search.filter.inventoryType),
+            static_cast<int>(search.filter.quality), search.filter.levelMin, search.filter.levelMax, search.listFrom, scanTime, indexTime);
+    }
+
+    return scanResults == indexResults ? 0 : 1;
+}
@@ -0,0 +1,195 @@
+/*
+Copyright (c) 2014-2021 AscEmu Team <http://www.ascemu.org>
+This file is released under the MIT license. See README-MIT for more information.
+*/
+
+// Updates the timed events of a busy map, 100ms per update. 30% of the events repeat every 0.1s to 1s
+// like AI and spell timers, 50% every 1s to 30s like auras and regeneration and the rest every 1min
+// to 10min like respawns. Every update removes 1% of the events and adds as many new ones.
+// "list" is the old EventableObjectHolder, its update walked all events and decremented their time
+// left. "wheel" is the timing wheel of EventableObjectHolder. All periods are multiples of the update
+// time, so both run every event the same number of times and the benchmark fails when they don't.
+//
+// usage: event_holder_benchmark [events] [updates]
+
+#include "Common.hpp"
+#include "Threading/Mutex.h"
+#include "Threading/LegacyThreadPool.h"
+#include "Server/EventableObject.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+#include <random>
+#include <vector>
+
+namespace
+{
+    const time_t updateTime = 100;
+
+    class CountingCallback : public CallbackBase
+    {
+    public:
+
+        explicit CountingCallback(uint64* counter) : m_counter(counter) {}
+
+        void execute() override { ++*m_counter; }
+
+    private:
+
+        uint64* m_counter;
+    };
+
+    // the update of EventableObjectHolder before the timing wheel
+    class ListEventHolder
+    {
+    public:
+
+        ~ListEventHolder()
+        {
+            for (auto ev : m_events)
+                ev->DecRef();
+        }
+
+        void AddEvent(TimedEvent* ev)
+        {
+            ev->IncRef();
+            m_events.push_back(ev);
+        }
+
+        void Update(time_t time_difference)
+        {
+            auto itr = m_events.begin();
+            while (itr != m_events.end())
+            {
+                auto it2 = itr++;
+                TimedEvent* ev = *it2;
+
+                if (ev->deleted)
+                {
+                    ev->DecRef();
+                    m_events.erase(it2);
+                    continue;
+                }
+
+                if (ev->currTime <= time_difference)
+                {
+                    ev->cb->execute();
+
+                    if (ev->repeats && --ev->repeats == 0)
+                    {
+                        ev->deleted = true;
+                        ev->DecRef();
+                        m_events.erase(it2);
+                        continue;
+                    }
+
+                    ev->currTime = ev->msTime;
+                }
+                else
+                {
+                    ev->currTime -= time_difference;
+                }
+            }
+        }
+
+    private:
+
+        std::list<TimedEvent*> m_events;
+    };
+
+    time_t getRandomPeriod(std::mt19937& random)
+    {
+        const uint32 kind = random() % 10;
+        if (kind < 3)
+            return updateTime * (1 + random() % 10);
+
+        if (kind < 8)
+            return updateTime * (10 + random() % 291);
+
+        return updateTime * (600 + random() % 5401);
+    }
+
+    // events are owned like EventableObject owns them, the holder gets its own reference
+    template <typename Holder>
+    double run(Holder& holder, int32 instanceId, uint32 eventCount, uint32 updates, uint64& executions)
+    {
+        std::mt19937 random(11);
+        std::vector<TimedEvent*> events;
+
+        const auto addEvent = [&]()
+        {
+            TimedEvent* ev = new TimedEvent(nullptr, new CountingCallback(&executions), EVENT_UNK, getRandomPeriod(random), 0, 0);
+            ev->instanceId = instanceId;
+            ev->IncRef();
+            holder.AddEvent(ev);
+            return ev;
+        };
+
+        for (uint32 i = 0; i < eventCount; ++i)
+            events.push_back(addEvent());
+
+        const uint32 churn = eventCount / 100;
+
+        double updateNanoseconds = 0.0;
+        for (uint32 i = 0; i < updates; ++i)
+        {
+            for (uint32 j = 0; j < churn; ++j)
+            {
+                const size_t index = random() % events.size();
+                events[index]->deleted = true;
+                events[index]->DecRef();
+                events[index] = addEvent();
+            }
+
+            const auto start = std::chrono::steady_clock::now();
+            holder.Update(updateTime);
+            updateNanoseconds += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        }
+
+        for (auto ev : events)
+        {
+            ev->deleted = true;
+            ev->DecRef();
+        }
+
+        return updateNanoseconds / updates;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const uint32 eventCount = argc > 1 ? static_cast<uint32>(std::strtoul(argv[1], nullptr, 10)) : 20000;
+    const uint32 updates = argc > 2 ? static_cast<uint32>(std::strtoul(argv[2], nullptr, 10)) : 3000;
+    if (eventCount < 100 || updates == 0)
+    {
+        printf("usage: %s [events >= 100] [updates]\n", argv[0]);
+        return 1;
+    }
+
+    uint64 listExecutions = 0;
+    double listTime;
+    {
+        ListEventHolder holder;
+        listTime = run(holder, 1, eventCount, updates, listExecutions);
+    }
+
+    uint64 wheelExecutions = 0;
+    double wheelTime;
+    {
+        EventableObjectHolder holder(1);
+        wheelTime = run(holder, 1, eventCount, updates, wheelExecutions);
+    }
+
+    printf("%u events, %u updates of %u ms, %llu executions\n", eventCount, updates, static_cast<uint32>(updateTime), static_cast<unsigned long long>(wheelExecutions));
+    printf("list %.1f us, wheel %.1f us per update\n", listTime / 1000.0, wheelTime / 1000.0);
+
+    if (listExecutions != wheelExecutions)
+    {
+        printf("list executed %llu events, wheel %llu\n", static_cast<unsigned long long>(listExecutions), static_cast<unsigned long long>(wheelExecutions));
+        return 1;
+    }
+
+    return 0;
+}
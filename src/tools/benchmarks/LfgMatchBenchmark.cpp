@@ -0,0 +1,179 @@
+/*
+Copyright (c) 2014-2021 AscEmu Team <http://www.ascemu.org>
+This file is released under the MIT license. See README-MIT for more information.
+*/
+
+// Matches a synthetic dungeon finder queue of 2000 damage dealers waiting for tanks and healers,
+// each queued for 1-3 of 8 dungeons. Every job checks 60 new players and 10 tank/healer premades
+// against that queue, like an update after a burst of joins. "miss" runs the job on a new LfgMatcher,
+// every compatibility answer is computed. "hit" runs the same job again on that matcher, the answers
+// come from its cache. Both have to form the same groups, the benchmark fails when they don't.
+//
+// usage: lfg_match_benchmark [queued players] [rounds]
+
+#include "WorldConf.h"
+#include "Management/LFG/LFG.hpp"
+#include "Management/LFG/LFGMatcher.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    const uint32_t dungeonCount = 8;
+    const uint32_t newPlayerCount = 60;
+    const uint32_t newGroupCount = 10;
+
+    LfgMatchEntry makeEntry(uint64_t guid, uint32_t ticket, std::mt19937& random)
+    {
+        LfgMatchEntry entry;
+        entry.guid = guid;
+        entry.ticket = ticket;
+        entry.playerCount = 0;
+        entry.isGroup = false;
+        entry.isLfgGroup = false;
+        entry.isOnline = true;
+        entry.roleMask = LFG_EMPTY_ROLE_MASK;
+
+        const uint32_t selectedDungeons = 1 + random() % 3;
+        for (uint32_t i = 0; i < selectedDungeons; ++i)
+            entry.dungeons.set(1 + random() % dungeonCount);
+
+        return entry;
+    }
+
+    void addPlayer(LfgMatchEntry& entry, uint64_t guid, uint8_t roles)
+    {
+        entry.players[entry.playerCount].guid = guid;
+        entry.players[entry.playerCount].roles = roles;
+        ++entry.playerCount;
+
+        entry.roleMask = LfgMatcher::combineRoleMasks(entry.roleMask, LfgMatcher::getPlayerRoleMask(roles));
+    }
+
+    // the queue as LfgMgr::CreateMatchJob copies it, the current queue first and the new entries behind it
+    std::unique_ptr<LfgMatchJob> buildJob(uint32_t queuedPlayers)
+    {
+        std::mt19937 random(15);
+        std::unique_ptr<LfgMatchJob> job = std::make_unique<LfgMatchJob>();
+
+        LfgMatchQueue queue;
+        queue.queueId = 0;
+
+        uint32_t ticket = 0;
+        uint64_t playerGuid = 0;
+
+        for (uint32_t i = 0; i < queuedPlayers; ++i)
+        {
+            LfgMatchEntry entry = makeEntry(++playerGuid, ++ticket, random);
+            addPlayer(entry, entry.guid, ROLE_DAMAGE);
+
+            queue.currentSlots.push_back(static_cast<uint16_t>(job->entries.size()));
+            job->entries.push_back(entry);
+        }
+
+        const uint8_t newPlayerRoles[] = { ROLE_TANK, ROLE_HEALER, ROLE_DAMAGE, ROLE_DAMAGE, ROLE_TANK | ROLE_DAMAGE, ROLE_HEALER | ROLE_DAMAGE };
+        for (uint32_t i = 0; i < newPlayerCount; ++i)
+        {
+            LfgMatchEntry entry = makeEntry(++playerGuid, ++ticket, random);
+            addPlayer(entry, entry.guid, newPlayerRoles[random() % 6]);
+
+            queue.newSlots.push_back(static_cast<uint16_t>(job->entries.size()));
+            job->entries.push_back(entry);
+        }
+
+        for (uint32_t i = 0; i < newGroupCount; ++i)
+        {
+            LfgMatchEntry entry = makeEntry(0x1F10000000000000ULL | (i + 1), ++ticket, random);
+            entry.isGroup = true;
+            addPlayer(entry, ++playerGuid, ROLE_TANK);
+            addPlayer(entry, ++playerGuid, ROLE_HEALER);
+
+            queue.newSlots.push_back(static_cast<uint16_t>(job->entries.size()));
+            job->entries.push_back(entry);
+        }
+
+        job->queues.push_back(std::move(queue));
+        return job;
+    }
+
+    std::unique_ptr<LfgMatchJob> runJob(LfgMatcher& matcher, std::unique_ptr<LfgMatchJob> job)
+    {
+        matcher.submit(std::move(job));
+
+        std::unique_ptr<LfgMatchJob> finishedJob;
+        while ((finishedJob = matcher.takeFinishedJob()) == nullptr)
+            std::this_thread::yield();
+
+        return finishedJob;
+    }
+
+    bool isSameResult(LfgMatchJob const& first, LfgMatchJob const& second)
+    {
+        if (first.outcomes.size() != second.outcomes.size())
+            return false;
+
+        for (size_t i = 0; i < first.outcomes.size(); ++i)
+        {
+            if (first.outcomes[i].guid != second.outcomes[i].guid || first.outcomes[i].queues != second.outcomes[i].queues)
+                return false;
+        }
+
+        return true;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const uint32_t queuedPlayers = argc > 1 ? static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10)) : 2000;
+    const uint32_t rounds = argc > 2 ? static_cast<uint32_t>(std::strtoul(argv[2], nullptr, 10)) : 20;
+    if (queuedPlayers == 0 || queuedPlayers + newPlayerCount + newGroupCount > UINT16_MAX || rounds == 0)
+    {
+        printf("usage: %s [queued players] [rounds]\n", argv[0]);
+        return 1;
+    }
+
+    uint64_t missDuration = 0;
+    uint64_t hitDuration = 0;
+    size_t groupsFound = 0;
+    bool isSame = true;
+
+    for (uint32_t i = 0; i < rounds; ++i)
+    {
+        LfgMatcher matcher;
+        matcher.initialize();
+
+        const std::unique_ptr<LfgMatchJob> missJob = runJob(matcher, buildJob(queuedPlayers));
+        const std::unique_ptr<LfgMatchJob> hitJob = runJob(matcher, buildJob(queuedPlayers));
+
+        missDuration += missJob->duration;
+        hitDuration += hitJob->duration;
+
+        groupsFound = 0;
+        for (const auto& outcome : missJob->outcomes)
+        {
+            if (!outcome.queues.empty())
+                ++groupsFound;
+        }
+
+        isSame = isSame && isSameResult(*missJob, *hitJob);
+
+        matcher.finalize();
+    }
+
+    printf("%u queued players, %u new players and %u premades, %u rounds, %u groups found\n", queuedPlayers, newPlayerCount, newGroupCount, rounds, static_cast<uint32_t>(groupsFound));
+    printf("cache miss %.1f us, cache hit %.1f us per job\n", static_cast<double>(missDuration) / rounds, static_cast<double>(hitDuration) / rounds);
+
+    if (!isSame)
+    {
+        printf("cache hit and cache miss formed different groups\n");
+        return 1;
+    }
+
+    return 0;
+}
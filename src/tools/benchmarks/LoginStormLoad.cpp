@@ -0,0 +1,192 @@
+/*
+Copyright (c) 2014-2021 AscEmu Team <http://www.ascemu.org>
+This file is released under the MIT license. See README-MIT for more information.
+*/
+
+// Login storm against a character database: every login queues the AsyncQuery of Player::LoadFromDB
+// in the same world update, like after a restart when all clients log back in at once. A simulated
+// world thread then runs the updates every 50 ms and processes the finished queries like World::Update.
+// With 0 async query workers the queries run inline while they are queued, like before.
+// The characters of the database are loaded in turn, logins beyond their number load them again.
+//
+// usage: login_storm_load <host> <port> <user> <password> <database> [logins] [async workers] [connections] [writers]
+
+#include "Database/Database.h"
+#include "Server/CharacterDatabaseStatements.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    const uint32_t worldUpdateInterval = 50;    // ms
+    const uint32_t loginNoFlag = 0;             // LOGIN_NO_FLAG
+
+    class LoginStorm
+    {
+    public:
+
+        explicit LoginStorm(uint32_t loginCount) : m_queueTimes(loginCount), m_loadTimes(loginCount) {}
+
+        void queueLogin(Database& database, uint32_t login, uint32_t guid)
+        {
+            // same queries as Player::LoadFromDB
+            AsyncQuery* query = new AsyncQuery(new SQLClassCallbackP1<LoginStorm, uint32_t>(this, &LoginStorm::onLoaded, login));
+
+            PreparedStatement* loginStatement = new PreparedStatement(CHAR_SEL_CHARACTER_LOGIN);
+            loginStatement->setUInt32(0, guid);
+            loginStatement->setUInt32(1, loginNoFlag);
+            query->AddPreparedStatement(loginStatement);
+
+            for (uint32_t statementId = CHAR_SEL_CHARACTER_TUTORIALS; statementId <= CHAR_SEL_CHARACTER_ACHIEVEMENT_PROGRESS; ++statementId)
+            {
+                PreparedStatement* statement = new PreparedStatement(statementId);
+                statement->setUInt32(0, guid);
+                query->AddPreparedStatement(statement);
+            }
+
+            query->WaitForWrites(guid);
+
+            m_queueTimes[login] = std::chrono::steady_clock::now();
+            database.QueueAsyncQuery(query);
+        }
+
+        void onLoaded(QueryResultVector& results, uint32_t login)
+        {
+            m_loadTimes[login] = std::chrono::steady_clock::now();
+            ++m_loadedCount;
+
+            for (const auto& result : results)
+            {
+                if (result.result != nullptr)
+                    m_rowCount += result.result->GetRowCount();
+            }
+        }
+
+        uint32_t getLoadedCount() const { return m_loadedCount; }
+        uint64_t getRowCount() const { return m_rowCount; }
+
+        // us from queueing the login to its callback
+        uint64_t getLoadTime(uint32_t login) const
+        {
+            return std::chrono::duration_cast<std::chrono::microseconds>(m_loadTimes[login] - m_queueTimes[login]).count();
+        }
+
+    private:
+
+        std::vector<std::chrono::steady_clock::time_point> m_queueTimes;
+        std::vector<std::chrono::steady_clock::time_point> m_loadTimes;
+        uint32_t m_loadedCount = 0;
+        uint64_t m_rowCount = 0;
+    };
+
+    double toMs(std::chrono::steady_clock::duration duration)
+    {
+        return std::chrono::duration<double, std::milli>(duration).count();
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 6)
+    {
+        printf("usage: %s <host> <port> <user> <password> <database> [logins] [async workers] [connections] [writers]\n", argv[0]);
+        return 1;
+    }
+
+    const uint32_t loginCount = argc > 6 ? static_cast<uint32_t>(std::strtoul(argv[6], nullptr, 10)) : 500;
+    const uint32_t workerCount = argc > 7 ? static_cast<uint32_t>(std::strtoul(argv[7], nullptr, 10)) : 2;
+    const uint32_t connectionCount = argc > 8 ? static_cast<uint32_t>(std::strtoul(argv[8], nullptr, 10)) : 5;
+    const uint32_t writerCount = argc > 9 ? static_cast<uint32_t>(std::strtoul(argv[9], nullptr, 10)) : 1;
+    if (loginCount == 0 || connectionCount == 0)
+    {
+        printf("usage: %s <host> <port> <user> <password> <database> [logins] [async workers] [connections] [writers]\n", argv[0]);
+        return 1;
+    }
+
+    Database* database = Database::CreateDatabaseInterface();
+    database->setWriterCount(writerCount);
+    if (!database->Initialize(argv[1], static_cast<unsigned int>(std::strtoul(argv[2], nullptr, 10)), argv[3], argv[4], argv[5], connectionCount, 16384))
+    {
+        // the connections of a failed Initialize are not all set up, the database can not be deleted
+        printf("could not connect to `%s` on %s:%s\n", argv[5], argv[1], argv[2]);
+        return 1;
+    }
+
+    registerCharacterDatabaseStatements(*database);
+    database->startAsyncQueryWorkers(workerCount);
+
+    std::vector<uint32_t> guids;
+    if (QueryResult* result = database->Query("SELECT guid FROM characters ORDER BY guid LIMIT %u", loginCount))
+    {
+        do
+        {
+            guids.push_back(result->Fetch()[0].GetUInt32());
+        } while (result->NextRow());
+
+        delete result;
+    }
+
+    if (guids.empty())
+    {
+        printf("`%s` has no characters to load\n", argv[5]);
+        database->EndThreads();
+        delete database;
+        Database::CleanupLibs();
+        return 1;
+    }
+
+    LoginStorm storm(loginCount);
+
+    // first world update: the sessions handle CMSG_PLAYER_LOGIN of every client
+    const auto startTime = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < loginCount; ++i)
+        storm.queueLogin(*database, i, guids[i % guids.size()]);
+
+    auto updateTime = std::chrono::steady_clock::now();
+    const double queueTime = toMs(updateTime - startTime);
+    double maxCallbackTime = 0.0;
+    uint32_t updateCount = 1;
+
+    // following world updates
+    while (storm.getLoadedCount() < loginCount)
+    {
+        updateTime += std::chrono::milliseconds(worldUpdateInterval);
+        std::this_thread::sleep_until(updateTime);
+
+        const auto callbackStart = std::chrono::steady_clock::now();
+        database->processAsyncQueryCallbacks();
+        maxCallbackTime = std::max(maxCallbackTime, toMs(std::chrono::steady_clock::now() - callbackStart));
+        ++updateCount;
+    }
+
+    const double totalTime = toMs(std::chrono::steady_clock::now() - startTime);
+    const DatabasePoolStatistics statistics = database->getPoolStatistics();
+
+    uint64_t totalLoadTime = 0;
+    uint64_t maxLoadTime = 0;
+    for (uint32_t i = 0; i < loginCount; ++i)
+    {
+        totalLoadTime += storm.getLoadTime(i);
+        maxLoadTime = std::max(maxLoadTime, storm.getLoadTime(i));
+    }
+
+    printf("%u logins of %u characters, %u async query workers, %u connections, %u writers\n",
+        loginCount, static_cast<uint32_t>(guids.size()), workerCount, connectionCount, writerCount);
+    printf("world thread: %.1f ms queueing the logins, %.1f ms longest callback update, %u updates\n",
+        queueTime, maxCallbackTime, updateCount);
+    printf("all characters loaded after %.1f ms, login %.1f ms average, %.1f ms max, %llu rows\n",
+        totalTime, totalLoadTime / 1000.0 / loginCount, maxLoadTime / 1000.0, static_cast<unsigned long long>(storm.getRowCount()));
+    printf("pool: %llu acquires, %llu waited, %.3f ms longest wait\n",
+        static_cast<unsigned long long>(statistics.acquireCount), static_cast<unsigned long long>(statistics.waitCount), statistics.maxWaitTime / 1000.0);
+
+    database->EndThreads();
+    delete database;
+    Database::CleanupLibs();
+
+    return 0;
+}
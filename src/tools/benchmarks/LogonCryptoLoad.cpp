@@ -0,0 +1,360 @@
+/*
+Copyright (c) 2014-2021 AscEmu Team <http://www.ascemu.org>
+This file is released under the MIT license. See README-MIT for more information.
+*/
+
+// Load generator for the AuthCryptoPool of the logon server. Client threads run complete SRP6 logins:
+// the challenge job builds B from the cached verifier of the account, the client answers with A and M1,
+// and the proof job derives the session key and checks M1. The server side math is the one of
+// AuthSocket::sendChallengeSrp6 and AuthSocket::checkProofSrp6, the pool is the real one.
+// With 0 crypto threads every job runs on the calling client thread, like on the network threads before.
+// Before the run a login with a salt that has a leading zero byte checks why such salts are never handed out.
+//
+// usage: logon_crypto_load [logins] [client threads] [crypto threads] [queue size] [accounts]
+
+#include "LogonStdAfx.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    struct TestAccount
+    {
+        std::string username;
+        uint8 srpHash[20];                      // SHA1(I | ":" | P), like accounts.encrypted_password
+        std::shared_ptr<const Srp6Verifier> srp6Verifier;
+    };
+
+    // state the AuthSocket of a login keeps between challenge and proof
+    struct Login
+    {
+        TestAccount* account;
+        BigNumber b;
+        BigNumber B;
+        BigNumber s;
+        BigNumber v;
+        uint8 challengeSalt[32];                // the salt as the client gets it in the challenge
+        bool isAuthenticated = false;
+    };
+
+    BigNumber N;
+    BigNumber g;
+    std::atomic<uint32_t> verifierCalculations{ 0 };
+
+    void loadSrp6Verifier(Login& login)
+    {
+        auto verifier = std::atomic_load(&login.account->srp6Verifier);
+        if (verifier == nullptr)
+        {
+            auto newVerifier = std::make_shared<Srp6Verifier>();
+            memcpy(newVerifier->srpHash, login.account->srpHash, 20);
+            newVerifier->salt = Srp6Verifier::generateSalt();
+
+            Sha1Hash sha;
+            sha.UpdateData(newVerifier->salt.AsByteArray(), 32);
+            sha.UpdateData(newVerifier->srpHash, 20);
+            sha.Finalize();
+
+            BigNumber x;
+            x.SetBinary(sha.GetDigest(), sha.GetLength());
+            newVerifier->verifier = g.ModExp(x, N);
+
+            verifier = newVerifier;
+            std::atomic_store(&login.account->srp6Verifier, verifier);
+            ++verifierCalculations;
+        }
+
+        login.s = verifier->salt;
+        login.v = verifier->verifier;
+    }
+
+    // M = H(H(N) xor H(g), H(I), s, A, B, K), K is interleaved from S
+    // the server hashes GetNumBytes() bytes of s, the client the 32 bytes of the challenge
+    void calculateProof(std::string const& username, uint8 const* salt, int saltLength, BigNumber& A, BigNumber& B, BigNumber& S, uint8* proof)
+    {
+        uint8 t[32];
+        uint8 t1[16];
+        uint8 vK[40];
+        memset(t, 0, 32);
+        memcpy(t, S.AsByteArray(), S.GetNumBytes());
+
+        Sha1Hash sha;
+        for (int i = 0; i < 16; i++)
+            t1[i] = t[i * 2];
+        sha.UpdateData(t1, 16);
+        sha.Finalize();
+        for (int i = 0; i < 20; i++)
+            vK[i * 2] = sha.GetDigest()[i];
+
+        for (int i = 0; i < 16; i++)
+            t1[i] = t[i * 2 + 1];
+        sha.Initialize();
+        sha.UpdateData(t1, 16);
+        sha.Finalize();
+        for (int i = 0; i < 20; i++)
+            vK[i * 2 + 1] = sha.GetDigest()[i];
+
+        BigNumber K;
+        K.SetBinary(vK, 40);
+
+        uint8 hash[20];
+        sha.Initialize();
+        sha.UpdateBigNumbers(&N, NULL);
+        sha.Finalize();
+        memcpy(hash, sha.GetDigest(), 20);
+        sha.Initialize();
+        sha.UpdateBigNumbers(&g, NULL);
+        sha.Finalize();
+        for (int i = 0; i < 20; i++)
+            hash[i] ^= sha.GetDigest()[i];
+
+        BigNumber t3;
+        t3.SetBinary(hash, 20);
+
+        sha.Initialize();
+        sha.UpdateData(username);
+        sha.Finalize();
+
+        BigNumber t4;
+        t4.SetBinary(sha.GetDigest(), 20);
+
+        sha.Initialize();
+        sha.UpdateBigNumbers(&t3, &t4, NULL);
+        sha.UpdateData(salt, saltLength);
+        sha.UpdateBigNumbers(&A, &B, &K, NULL);
+        sha.Finalize();
+
+        memcpy(proof, sha.GetDigest(), 20);
+    }
+
+    BigNumber calculateU(BigNumber& A, BigNumber& B)
+    {
+        Sha1Hash sha;
+        sha.UpdateBigNumbers(&A, &B, NULL);
+        sha.Finalize();
+
+        BigNumber u;
+        u.SetBinary(sha.GetDigest(), 20);
+        return u;
+    }
+
+    void sendChallenge(Login& login)
+    {
+        loadSrp6Verifier(login);
+
+        login.b.SetRand(152);
+        BigNumber gmod = g.ModExp(login.b, N);
+        login.B = ((login.v * 3) + gmod) % N;
+
+        memset(login.challengeSalt, 0, 32);
+        memcpy(login.challengeSalt, login.s.AsByteArray(), login.s.GetNumBytes());
+    }
+
+    void checkProof(Login& login, BigNumber A, std::array<uint8, 20> M1)
+    {
+        BigNumber u = calculateU(A, login.B);
+        BigNumber S = (A * (login.v.ModExp(u, N))).ModExp(login.b, N);
+        uint8 M[20];
+        calculateProof(login.account->username, login.s.AsByteArray(), login.s.GetNumBytes(), A, login.B, S, M);
+
+        login.isAuthenticated = memcmp(M1.data(), M, 20) == 0;
+    }
+
+    // runs the job on the pool and waits for it, false when the pool refused it
+    bool runJob(Login& login, std::function<void()> job)
+    {
+        auto done = std::make_shared<std::promise<void>>();
+        std::future<void> finished = done->get_future();
+
+        // the pool only compares the socket pointer, the login stands in for the AuthSocket
+        if (!sAuthCryptoPool.addJob(reinterpret_cast<AuthSocket*>(&login), [job, done]() { job(); done->set_value(); }))
+            return false;
+
+        finished.wait();
+        return true;
+    }
+
+    // a complete login of the client, false when the pool refused one of its jobs
+    bool runLogin(Login& login)
+    {
+        if (!runJob(login, [&login]() { sendChallenge(login); }))
+            return false;
+
+        // client: A = g^a, S = (B - k * g^x) ^ (a + u * x), the client knows x from the password
+        BigNumber a;
+        a.SetRand(152);
+        BigNumber A = g.ModExp(a, N);
+        BigNumber u = calculateU(A, login.B);
+
+        Sha1Hash sha;
+        sha.UpdateData(login.challengeSalt, 32);
+        sha.UpdateData(login.account->srpHash, 20);
+        sha.Finalize();
+        BigNumber x;
+        x.SetBinary(sha.GetDigest(), 20);
+
+        BigNumber kgx = (g.ModExp(x, N) * 3) % N;
+        BigNumber base = (login.B + N - kgx) % N;
+        BigNumber S = base.ModExp(a + u * x, N);
+        std::array<uint8, 20> M1;
+        calculateProof(login.account->username, login.challengeSalt, 32, A, login.B, S, M1.data());
+
+        return runJob(login, [&login, A, M1]() { checkProof(login, A, M1); });
+    }
+
+    // Salts with a leading zero byte: the client hashes the 32 bytes of the challenge, the proof only 31 of them.
+    // A cached short salt fails every login of its account, Srp6Verifier::generateSalt never returns one.
+    bool checkShortSalt()
+    {
+        uint32_t shortSalts = 0;
+        for (uint32_t i = 0; i < 4096; ++i)
+        {
+            if (Srp6Verifier::generateSalt().GetNumBytes() != 32)
+                ++shortSalts;
+        }
+
+        TestAccount account;
+        account.username = "SHORTSALT";
+        Sha1Hash sha;
+        sha.UpdateData(account.username + ":PASSWORD");
+        sha.Finalize();
+        memcpy(account.srpHash, sha.GetDigest(), 20);
+
+        auto verifier = std::make_shared<Srp6Verifier>();
+        memcpy(verifier->srpHash, account.srpHash, 20);
+        do
+        {
+            verifier->salt.SetRand(248);
+        } while (verifier->salt.GetNumBytes() != 31);
+
+        uint8 saltBytes[32];
+        memset(saltBytes, 0, 32);
+        memcpy(saltBytes, verifier->salt.AsByteArray(), 31);
+
+        sha.Initialize();
+        sha.UpdateData(saltBytes, 32);
+        sha.UpdateData(verifier->srpHash, 20);
+        sha.Finalize();
+
+        BigNumber x;
+        x.SetBinary(sha.GetDigest(), sha.GetLength());
+        verifier->verifier = g.ModExp(x, N);
+        account.srp6Verifier = verifier;
+
+        Login login;
+        login.account = &account;
+        const bool isRefused = !runLogin(login);
+
+        printf("short salt: %u of 4096 generated salts short, login with a short salt %s\n", shortSalts,
+            isRefused ? "refused" : (login.isAuthenticated ? "authenticated" : "rejected"));
+
+        return shortSalts == 0 && !isRefused && !login.isAuthenticated;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const uint32_t loginCount = argc > 1 ? static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10)) : 2000;
+    const uint32_t clientThreads = argc > 2 ? static_cast<uint32_t>(std::strtoul(argv[2], nullptr, 10)) : 16;
+    const uint32_t cryptoThreads = argc > 3 ? static_cast<uint32_t>(std::strtoul(argv[3], nullptr, 10)) : 2;
+    const uint32_t queueSize = argc > 4 ? static_cast<uint32_t>(std::strtoul(argv[4], nullptr, 10)) : 5000;
+    const uint32_t accountCount = argc > 5 ? static_cast<uint32_t>(std::strtoul(argv[5], nullptr, 10)) : 500;
+    if (loginCount == 0 || clientThreads == 0 || accountCount == 0)
+    {
+        printf("usage: %s [logins] [client threads] [crypto threads] [queue size] [accounts]\n", argv[0]);
+        return 1;
+    }
+
+    N.SetHexStr("894B645E89E1535BBDAD5B8B290650530801B18EBFBF5E8FAB3C82872A3E9BB7");
+    g.SetDword(7);
+
+    std::vector<TestAccount> accounts(accountCount);
+    for (uint32_t i = 0; i < accountCount; ++i)
+    {
+        accounts[i].username = "LOADTEST" + std::to_string(i);
+
+        Sha1Hash sha;
+        sha.UpdateData(accounts[i].username + ":PASSWORD");
+        sha.Finalize();
+        memcpy(accounts[i].srpHash, sha.GetDigest(), 20);
+    }
+
+    sAuthCryptoPool.initialize(cryptoThreads, queueSize);
+
+    const bool isShortSaltHandled = checkShortSalt();
+
+    std::atomic<uint32_t> nextLogin{ 0 };
+    std::atomic<uint32_t> authenticated{ 0 };
+    std::atomic<uint32_t> failed{ 0 };
+    std::atomic<uint32_t> refused{ 0 };
+    std::atomic<uint64_t> totalLoginTime{ 0 };
+    std::atomic<uint64_t> maxLoginTime{ 0 };
+
+    const auto clientRunner = [&]()
+    {
+        for (uint32_t i = nextLogin++; i < loginCount; i = nextLogin++)
+        {
+            const auto loginStart = std::chrono::steady_clock::now();
+
+            Login login;
+            login.account = &accounts[i % accountCount];
+
+            if (!runLogin(login))
+            {
+                ++refused;
+                continue;
+            }
+
+            if (login.isAuthenticated)
+                ++authenticated;
+            else
+                ++failed;
+
+            const uint64_t loginTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - loginStart).count();
+            totalLoginTime += loginTime;
+
+            uint64_t currentMax = maxLoginTime.load();
+            while (currentMax < loginTime && !maxLoginTime.compare_exchange_weak(currentMax, loginTime));
+        }
+    };
+
+    const auto startTime = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> clients;
+    for (uint32_t i = 0; i < clientThreads; ++i)
+        clients.emplace_back(clientRunner);
+
+    for (auto& client : clients)
+        client.join();
+
+    const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    // the last job counts itself after its client was released, finalize waits for it
+    sAuthCryptoPool.finalize();
+    const AuthCryptoPoolStatistics statistics = sAuthCryptoPool.getStatistics();
+
+    const uint32_t finishedLogins = authenticated + failed;
+    printf("%u logins of %u accounts from %u client threads, %u crypto threads, queue size %u\n",
+        loginCount, accountCount, clientThreads, cryptoThreads, queueSize);
+    printf("%u authenticated, %u wrong proofs, %u refused, %u verifiers calculated\n",
+        authenticated.load(), failed.load(), refused.load(), verifierCalculations.load());
+    printf("%.2fs, %.0f logins/s, login %.2fms average, %.2fms max\n", elapsed, finishedLogins / elapsed,
+        finishedLogins ? totalLoginTime / 1000.0 / finishedLogins : 0.0, maxLoginTime / 1000.0);
+
+    if (statistics.finishedJobs != 0)
+    {
+        printf("pool: %llu jobs, %u peak queued, %.3fms average wait, %.3fms average run\n",
+            static_cast<unsigned long long>(statistics.finishedJobs), statistics.peakQueuedJobs,
+            statistics.totalWaitTime / 1000.0 / statistics.finishedJobs, statistics.totalRunTime / 1000.0 / statistics.finishedJobs);
+    }
+
+    return failed != 0 || !isShortSaltHandled ? 1 : 0;
+}
@@ -0,0 +1,166 @@
+/*
+Copyright (c) 2014-2021 AscEmu Team <http://www.ascemu.org>
+This file is released under the MIT license. See README-MIT for more information.
+*/
+
+// Translates the opcodes of a synthetic packet stream, 60% movement and the rest spread over the
+// client opcodes of the version. "scan" and "map" are the old lookups, incoming packets searched the
+// HexToId vector of the version and outgoing packets looked up multiversionOpcodeStore. "index" are
+// the direct indexed tables of OpcodeTables. Before measuring both are compared for every hex value
+// and internal id of every version, the benchmark fails when they differ.
+//
+// usage: opcode_lookup_benchmark [rounds]
+
+#include "Server/OpcodeTable.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace
+{
+    struct HexToId
+    {
+        HexToId(uint16_t hex, uint32_t intId) : hexValue(hex), internalId(intId) {}
+
+        uint16_t hexValue;
+        uint32_t internalId;
+    };
+
+    std::vector<HexToId> oldVersionHexTable[MAX_VERSION_INDEX];
+
+    void buildOldTables()
+    {
+        for (const auto& opcodeStore : multiversionOpcodeStore)
+        {
+            for (auto hexIndex = 0; hexIndex < MAX_VERSION_INDEX; ++hexIndex)
+                oldVersionHexTable[hexIndex].emplace_back(opcodeStore.second.hexValues[hexIndex], opcodeStore.first);
+        }
+    }
+
+    uint32_t oldGetInternalIdForHex(uint16_t hex, int versionId)
+    {
+        for (const auto& table : oldVersionHexTable[versionId])
+        {
+            if (table.hexValue == hex)
+                return table.internalId;
+        }
+
+        return 0;
+    }
+
+    uint16_t oldGetHexValueForVersionId(int versionId, uint32_t internalId)
+    {
+        auto multiversionTable = multiversionOpcodeStore.find(internalId);
+        if (multiversionTable != multiversionOpcodeStore.end())
+            return multiversionTable->second.hexValues[versionId];
+
+        return 0;
+    }
+
+    uint32_t countMismatches()
+    {
+        uint32_t mismatches = 0;
+        for (auto versionId = 0; versionId < MAX_VERSION_INDEX; ++versionId)
+        {
+            for (uint32_t hex = 0; hex <= 0xFFFF; ++hex)
+            {
+                if (oldGetInternalIdForHex(static_cast<uint16_t>(hex), versionId) != sOpcodeTables.getInternalIdForHex(static_cast<uint16_t>(hex), versionId))
+                    ++mismatches;
+            }
+
+            for (const auto& opcodeStore : multiversionOpcodeStore)
+            {
+                if (oldGetHexValueForVersionId(versionId, opcodeStore.first) != sOpcodeTables.getHexValueForVersionId(versionId, opcodeStore.first))
+                    ++mismatches;
+            }
+        }
+
+        return mismatches;
+    }
+
+    template <typename Lookup>
+    double measure(uint32_t rounds, size_t lookupsPerRound, Lookup lookup)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < rounds; ++i)
+            lookup();
+
+        return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / (static_cast<double>(rounds) * lookupsPerRound);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const uint32_t rounds = argc > 1 ? static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10)) : 200;
+    if (rounds == 0)
+    {
+        printf("usage: %s [rounds]\n", argv[0]);
+        return 1;
+    }
+
+    sOpcodeTables.initialize();
+    buildOldTables();
+
+    const uint32_t mismatches = countMismatches();
+    printf("%u mismatches between scan and index over all versions\n", mismatches);
+    if (mismatches != 0)
+        return 1;
+
+    const int versionId = sOpcodeTables.getVersionIdForAEVersion();
+
+    const std::vector<uint32_t> movementOpcodes = { MSG_MOVE_HEARTBEAT, MSG_MOVE_HEARTBEAT, MSG_MOVE_HEARTBEAT, MSG_MOVE_START_FORWARD };
+    std::vector<uint32_t> clientOpcodes;
+    for (const auto& opcodeStore : multiversionOpcodeStore)
+    {
+        if (opcodeStore.second.name.compare(0, 5, "CMSG_") == 0)
+            clientOpcodes.push_back(opcodeStore.first);
+    }
+
+    std::mt19937 random(4);
+    std::vector<uint16_t> incomingHex;
+    std::vector<uint32_t> outgoingIds;
+    for (uint32_t i = 0; i < 10000; ++i)
+    {
+        const uint32_t internalId = random() % 10 < 6 ? movementOpcodes[random() % movementOpcodes.size()] : clientOpcodes[random() % clientOpcodes.size()];
+        incomingHex.push_back(sOpcodeTables.getHexValueForVersionId(versionId, internalId));
+        outgoingIds.push_back(internalId);
+    }
+
+    uint64_t oldChecksum = 0;
+    const double oldIncomingTime = measure(rounds, incomingHex.size(), [&]()
+    {
+        for (const uint16_t hex : incomingHex)
+            oldChecksum += oldGetInternalIdForHex(hex, versionId);
+    });
+
+    uint64_t newChecksum = 0;
+    const double newIncomingTime = measure(rounds, incomingHex.size(), [&]()
+    {
+        for (const uint16_t hex : incomingHex)
+            newChecksum += sOpcodeTables.getInternalIdForHex(hex, versionId);
+    });
+
+    const double oldOutgoingTime = measure(rounds, outgoingIds.size(), [&]()
+    {
+        for (const uint32_t internalId : outgoingIds)
+            oldChecksum += oldGetHexValueForVersionId(versionId, internalId);
+    });
+
+    const double newOutgoingTime = measure(rounds, outgoingIds.size(), [&]()
+    {
+        for (const uint32_t internalId : outgoingIds)
+            newChecksum += sOpcodeTables.getHexValueForVersionId(versionId, internalId);
+    });
+
+    printf("%u rounds of %u packets, %u opcodes in %s\n", rounds, static_cast<uint32_t>(incomingHex.size()),
+        static_cast<uint32_t>(oldVersionHexTable[versionId].size()), sOpcodeTables.getNameForVersionId(versionId).c_str());
+    printf("incoming hex to internal id: scan %.1f ns, index %.1f ns per packet\n", oldIncomingTime, newIncomingTime);
+    printf("outgoing internal id to hex: map %.1f ns, index %.1f ns per packet\n", oldOutgoingTime, newOutgoingTime);
+
+    sOpcodeTables.finalize();
+
+    return oldChecksum == newChecksum ? 0 : 1;
+}
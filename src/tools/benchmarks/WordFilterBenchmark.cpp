@@ -0,0 +1,145 @@
+/*
+Copyright (c) 2014-2021 AscEmu Team <http://www.ascemu.org>
+This file is released under the MIT license. See README-MIT for more information.
+*/
+
+// Filters chat messages and character names with a fixed table of 400 words.
+// "find/replace" is the old filter, one std::string::find/replace loop per table row,
+// "WordMatcher" is one pass of the compiled automaton. The table has no blocking words,
+// so both always scan the whole message.
+//
+// usage: word_filter_benchmark [rounds]
+
+#include "Management/WordMatcher.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+#include <string>
+#include <vector>
+
+namespace
+{
+    struct WordFilterRow
+    {
+        std::string word;
+        std::string wordReplace;
+    };
+
+    const char* const syllables[] = { "gol", "dar", "spa", "mix", "zer", "bot", "wow", "lfg", "kek", "ork" };
+
+    std::list<WordFilterRow> buildTable()
+    {
+        std::list<WordFilterRow> table;
+        for (uint32_t i = 0; i < 400; ++i)
+        {
+            std::string word = syllables[i % 10];
+            word += syllables[(i / 10) % 10];
+            if (i >= 100)
+                word += std::to_string(i / 100);
+            table.push_back({ word, "***" });
+        }
+
+        return table;
+    }
+
+    bool oldFilterChat(std::list<WordFilterRow> const& table, std::string& chatMessage)
+    {
+        for (const auto& row : table)
+        {
+            size_t pos = 0;
+            while ((pos = chatMessage.find(row.word, pos)) != std::string::npos)
+            {
+                chatMessage.replace(pos, row.word.length(), row.wordReplace);
+                pos += row.wordReplace.length();
+            }
+        }
+
+        return false;
+    }
+
+    bool oldIsNameAllowed(std::list<WordFilterRow> const& table, std::string const& name)
+    {
+        for (const auto& row : table)
+        {
+            if (name.find(row.word) != std::string::npos)
+                return false;
+        }
+
+        return true;
+    }
+
+    template <typename Filter>
+    double measure(uint32_t rounds, Filter filter)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < rounds; ++i)
+            filter(i);
+
+        return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / rounds;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const uint32_t rounds = argc > 1 ? static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10)) : 50000;
+    if (rounds == 0)
+    {
+        printf("usage: %s [rounds]\n", argv[0]);
+        return 1;
+    }
+
+    const std::list<WordFilterRow> table = buildTable();
+
+    WordMatcher matcher;
+    for (const auto& row : table)
+        matcher.addWord(row.word, row.wordReplace);
+    matcher.build();
+
+    const std::vector<std::string> messages =
+    {
+        "anyone up for a heroic run? need a healer and one more dps, pst",
+        "selling goldar0 cheap, whisper me for prices before the auction house resets",
+        "lfg kekork3 tonight, bring your own flasks and food please",
+        "that last boss was brutal, three wipes before we figured out the adds",
+    };
+
+    const std::vector<std::string> names = { "Arthas", "Goldar", "Spamix", "Kekork", "Jaina", "Thrall" };
+
+    size_t oldChanged = 0;
+    const double oldChatTime = measure(rounds, [&](uint32_t round)
+    {
+        std::string message = messages[round % messages.size()];
+        oldFilterChat(table, message);
+        oldChanged += message != messages[round % messages.size()];
+    });
+
+    size_t newChanged = 0;
+    const double newChatTime = measure(rounds, [&](uint32_t round)
+    {
+        std::string message = messages[round % messages.size()];
+        matcher.isBlockedOrReplaceWords(message);
+        newChanged += message != messages[round % messages.size()];
+    });
+
+    size_t oldRejected = 0;
+    const double oldNameTime = measure(rounds, [&](uint32_t round)
+    {
+        oldRejected += !oldIsNameAllowed(table, names[round % names.size()]);
+    });
+
+    size_t newRejected = 0;
+    const double newNameTime = measure(rounds, [&](uint32_t round)
+    {
+        newRejected += matcher.containsWord(names[round % names.size()]);
+    });
+
+    printf("%u rounds, %u words in the table\n", rounds, static_cast<uint32_t>(matcher.getWordCount()));
+    printf("chat  find/replace: %10.1f ns per message, %u changed\n", oldChatTime, static_cast<uint32_t>(oldChanged));
+    printf("chat  WordMatcher:  %10.1f ns per message, %u changed\n", newChatTime, static_cast<uint32_t>(newChanged));
+    printf("names find:         %10.1f ns per name, %u rejected\n", oldNameTime, static_cast<uint32_t>(oldRejected));
+    printf("names WordMatcher:  %10.1f ns per name, %u rejected (case-insensitive)\n", newNameTime, static_cast<uint32_t>(newRejected));
+
+    return 0;
+}
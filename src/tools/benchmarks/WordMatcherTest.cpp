@@ -0,0 +1,119 @@
+/*
+Copyright (c) 2014-2021 AscEmu Team <http://www.ascemu.org>
+This file is released under the MIT license. See README-MIT for more information.
+*/
+
+// Pins the matching rules of WordMatcher, the chat and character name filters depend on them.
+// The old filters searched every table row on its own and were case sensitive, the cases below
+// document where WordMatcher gives a different result on purpose.
+
+#include "Management/WordMatcher.h"
+
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    uint32_t failures = 0;
+
+    WordMatcher buildMatcher(std::vector<std::pair<std::string, std::string>> const& words)
+    {
+        WordMatcher matcher;
+        for (const auto& word : words)
+            matcher.addWord(word.first, word.second);
+
+        matcher.build();
+        return matcher;
+    }
+
+    void expectReplaced(const char* name, WordMatcher const& matcher, std::string text, std::string const& expected)
+    {
+        const bool isBlocked = matcher.isBlockedOrReplaceWords(text);
+        if (isBlocked || text != expected)
+        {
+            printf("FAILED %s: got \"%s\"%s, expected \"%s\"\n", name, text.c_str(), isBlocked ? " (blocked)" : "", expected.c_str());
+            ++failures;
+        }
+    }
+
+    void expectBlocked(const char* name, WordMatcher const& matcher, std::string text)
+    {
+        if (!matcher.isBlockedOrReplaceWords(text))
+        {
+            printf("FAILED %s: \"%s\" was not blocked\n", name, text.c_str());
+            ++failures;
+        }
+    }
+
+    void expectContains(const char* name, WordMatcher const& matcher, std::string const& text, bool expected)
+    {
+        if (matcher.containsWord(text) != expected)
+        {
+            printf("FAILED %s: containsWord(\"%s\") is not %s\n", name, text.c_str(), expected ? "true" : "false");
+            ++failures;
+        }
+    }
+}
+
+int main()
+{
+    // an empty table leaves every text alone
+    const WordMatcher emptyMatcher = buildMatcher({});
+    expectReplaced("empty table", emptyMatcher, "nothing to see", "nothing to see");
+    expectContains("empty table name", emptyMatcher, "anyname", false);
+
+    // case is ignored for latin, latin-1, greek and cyrillic letters, the old filter only matched the exact case
+    const WordMatcher caseMatcher = buildMatcher({ { "noob", "friend" }, { "ärger", "spass" }, { "привет", "hello" } });
+    expectReplaced("latin case", caseMatcher, "NoOb go home", "friend go home");
+    expectReplaced("latin-1 case", caseMatcher, "kein ÄRGER", "kein spass");
+    expectReplaced("cyrillic case", caseMatcher, "ПРИВЕТ all", "hello all");
+    expectContains("character name case", caseMatcher, "xXNOOBXx", true);
+
+    // every occurrence is replaced, the replacement itself is not searched again
+    const WordMatcher repeatMatcher = buildMatcher({ { "a", "aa" } });
+    expectReplaced("repeated word", repeatMatcher, "banana", "baanaanaa");
+
+    // words ending inside another word are found through the failure links
+    const WordMatcher suffixMatcher = buildMatcher({ { "he", "1" }, { "she", "2" }, { "hers", "3" } });
+    expectReplaced("word inside word", suffixMatcher, "ahem", "a1m");
+
+    // overlapping words: the earlier start wins, the overlapped words are dropped
+    expectReplaced("earlier start wins", suffixMatcher, "ushers", "u2rs");
+
+    // same start: the longer word wins
+    const WordMatcher lengthMatcher = buildMatcher({ { "ab", "X" }, { "abc", "Y" } });
+    expectReplaced("longer word wins", lengthMatcher, "abcd abx", "Yd Xx");
+
+    // a word that is a suffix of another one is covered by the longer match
+    const WordMatcher coverMatcher = buildMatcher({ { "cd", "1" }, { "bcd", "2" } });
+    expectReplaced("suffix covered", coverMatcher, "abcde", "a2e");
+
+    // a shorter word ending at the same position is still replaced when the longer one overlaps an earlier match
+    const WordMatcher shorterMatcher = buildMatcher({ { "ab", "1" }, { "bcd", "2" }, { "cd", "3" } });
+    expectReplaced("shorter word after overlap", shorterMatcher, "abcd", "13");
+
+    // the first table row of a word wins
+    const WordMatcher duplicateMatcher = buildMatcher({ { "gold", "first" }, { "GOLD", "second" } });
+    expectReplaced("first row wins", duplicateMatcher, "buy gold", "buy first");
+
+    // a blocking word (empty replacement) blocks the text no matter where it is or what else matches
+    const WordMatcher blockMatcher = buildMatcher({ { "spam", "" }, { "cheap", "nice" } });
+    expectBlocked("blocking word", blockMatcher, "cheap SPAM here");
+    expectBlocked("blocking word inside word", blockMatcher, "antispammer");
+    expectReplaced("no blocking word", blockMatcher, "cheap eggs", "nice eggs");
+
+    // invalid UTF-8 is matched byte by byte and copied unchanged
+    const WordMatcher byteMatcher = buildMatcher({ { "x", "y" } });
+    expectReplaced("invalid utf-8", byteMatcher, "\xC3x\xFFx", "\xC3y\xFFy");
+
+    if (failures != 0)
+    {
+        printf("%u checks failed\n", failures);
+        return 1;
+    }
+
+    printf("all checks passed\n");
+    return 0;
+}
@@ -437,6 +437,7 @@ public:
     bool HandleReloadQuestsCommand(const char* /*args*/, WorldSession* m_session);
     bool HandleReloadTeleportCoordsCommand(const char* /*args*/, WorldSession* m_session);
     bool HandleReloadWorldbroadcastCommand(const char* /*args*/, WorldSession* m_session);
+    bool HandleReloadWordFilterCommand(const char* /*args*/, WorldSession* m_session);
     bool HandleReloadWorldmapInfoCommand(const char* /*args*/, WorldSession* m_session);
     bool HandleReloadWorldstringTablesCommand(const char* /*args*/, WorldSession* m_session);
     bool HandleReloadZoneguardsCommand(const char* /*args*/, WorldSession* m_session);
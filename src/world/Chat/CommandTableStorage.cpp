@@ -670,6 +670,7 @@ void CommandTableStorage::Init()
         { "quests",             'z', &ChatHandler::HandleReloadQuestsCommand,               "Reload quests table",                          nullptr },
         { "spell_teleport_coords",'z', &ChatHandler::HandleReloadTeleportCoordsCommand,     "Reload teleport_coords table",                 nullptr },
         { "worldbroadcast",     'z', &ChatHandler::HandleReloadWorldbroadcastCommand,       "Reload worldbroadcast table",                  nullptr },
+        { "wordfilter",         'z', &ChatHandler::HandleReloadWordFilterCommand,           "Reload wordfilter tables",                     nullptr },
         { "worldmap_info",      'z', &ChatHandler::HandleReloadWorldmapInfoCommand,         "Reload worldmap_info table",                   nullptr },
         { "worldstring_tables", 'z', &ChatHandler::HandleReloadWorldstringTablesCommand,    "Reload worldstring_tables table",              nullptr },
         { "zoneguards",         'z', &ChatHandler::HandleReloadZoneguardsCommand,           "Reload zoneguards table",                      nullptr },
@@ -417,6 +417,16 @@ bool ChatHandler::HandleReloadWorldbroadcastCommand(const char* /*args*/, WorldS
     return true;
 }
 
+//.server reload wordfilter
+bool ChatHandler::HandleReloadWordFilterCommand(const char* /*args*/, WorldSession* m_session)
+{
+    auto startTime = Util::TimeNow();
+    sMySQLStore.loadWordFilterCharacterNames();
+    sMySQLStore.loadWordFilterChat();
+    GreenSystemMessage(m_session, "WorldDB 'wordfilter_character_names' and 'wordfilter_chat' tables reloaded in %u ms", static_cast<uint32_t>(Util::GetTimeDifferenceToNow(startTime)));
+    return true;
+}
+
 //.server reload worldmap_info
 bool ChatHandler::HandleReloadWorldmapInfoCommand(const char* /*args*/, WorldSession* m_session)
 {
@@ -141,6 +141,7 @@ void AuctionHouse::loadAuctionsFromDB()
         auction->isRemoved = false;
 
         auctions.insert(std::unordered_map<uint32_t, Auction*>::value_type(auction->Id, auction));
+        auctionIndex.addAuction(auction, auction->Id, pItem->getItemProperties());
     }
     while (result->NextRow());
     delete result;
@@ -148,7 +149,8 @@ void AuctionHouse::loadAuctionsFromDB()
 
 void AuctionHouse::updateAuctions()
 {
-    std::lock_guard<std::mutex> guard(auctionLock);
+    // only marks expired auctions, they leave the map and the index in updateDeletionQueue
+    std::shared_lock<std::shared_mutex> guard(auctionLock);
 
     removalLock.Acquire();
 
@@ -158,6 +160,10 @@ void AuctionHouse::updateAuctions()
         auto auction = itr->second;
         ++itr;
 
+        // already queued by a buyout or cancel
+        if (auction->isRemoved)
+            continue;
+
         if (time >= auction->expireTime)
         {
             if (auction->highestBidderGuid.getGuidLow() == 0)
@@ -267,6 +273,7 @@ void AuctionHouse::removeAuction(Auction* auction)
     // Remove the auction from the hashmap.
     auctionLock.lock();
     auctions.erase(auction->Id);
+    auctionIndex.removeAuction(auction->Id, auction->auctionItem->getItemProperties());
     auctionLock.unlock();
 
     // Destroy the item from memory (it still remains in the db)
@@ -280,16 +287,17 @@ void AuctionHouse::removeAuction(Auction* auction)
 
 void AuctionHouse::addAuction(Auction* auction)
 {
-    std::lock_guard<std::mutex> guard(auctionLock);
+    std::lock_guard<std::shared_mutex> guard(auctionLock);
 
     auctions.insert(std::unordered_map<uint32_t, Auction*>::value_type(auction->Id, auction));
+    auctionIndex.addAuction(auction, auction->Id, auction->auctionItem->getItemProperties());
 
     sLogger.debug("AuctionHouse : %u: Add auction %u, expire@ %u.", auctionHouseEntryDbc->id, auction->Id, auction->expireTime);
 }
 
 Auction* AuctionHouse::getAuction(uint32_t id)
 {
-    std::lock_guard<std::mutex> guard(auctionLock);
+    std::shared_lock<std::shared_mutex> guard(auctionLock);
 
     const auto auctionsMap = auctions.find(id);
     const auto auction = auctionsMap == auctions.end() ? nullptr : auctionsMap->second;
@@ -299,13 +307,14 @@ Auction* AuctionHouse::getAuction(uint32_t id)
 
 void AuctionHouse::queueDeletion(Auction* auction, uint32_t reasonType)
 {
-    if (auction->isRemoved)
-        return;
-
-    auction->isRemoved = true;
-    auction->removedType = reasonType;
+    // the expiry scan of updateAuctions checks and queues under the same lock
     removalLock.Acquire();
-    removalList.push_back(auction);
+    if (!auction->isRemoved)
+    {
+        auction->isRemoved = true;
+        auction->removedType = reasonType;
+        removalList.push_back(auction);
+    }
     removalLock.Release();
 }
 
@@ -313,7 +322,7 @@ void AuctionHouse::sendOwnerListPacket(Player* player, WorldPacket* /*packet*/)
 {
     std::vector<AuctionPacketList> auctionPacketList{};
 
-    std::lock_guard<std::mutex> guard(auctionLock);
+    std::shared_lock<std::shared_mutex> guard(auctionLock);
 
     for (auto& itr : auctions)
     {
@@ -327,12 +336,14 @@ void AuctionHouse::sendOwnerListPacket(Player* player, WorldPacket* /*packet*/)
         }
     }
 
+    guard.unlock();
+
     player->SendPacket(SmsgAuctionOwnerListResult(static_cast<uint32_t>(auctionPacketList.size()), auctionPacketList, static_cast<uint32_t>(auctionPacketList.size())).serialise().get());
 }
 
 void AuctionHouse::updateOwner(uint32_t oldGuid, uint32_t newGuid)
 {
-    std::lock_guard<std::mutex> guard(auctionLock);
+    std::lock_guard<std::shared_mutex> guard(auctionLock);
 
     for (auto& itr : auctions)
     {
@@ -352,7 +363,7 @@ void AuctionHouse::sendBidListPacket(Player* player, WorldPacket* /*packet*/)
 {
     std::vector<AuctionPacketList> auctionPacketList{};
 
-    std::lock_guard<std::mutex> guard(auctionLock);
+    std::shared_lock<std::shared_mutex> guard(auctionLock);
 
     for (auto itr = auctions.begin(); itr != auctions.end(); ++itr)
     {
@@ -366,6 +377,8 @@ void AuctionHouse::sendBidListPacket(Player* player, WorldPacket* /*packet*/)
         }
     }
 
+    guard.unlock();
+
     player->SendPacket(SmsgAuctionBidderListResult(static_cast<uint32_t>(auctionPacketList.size()), auctionPacketList, static_cast<uint32_t>(auctionPacketList.size()), 300).serialise().get());
 }
 
@@ -427,85 +440,66 @@ void AuctionHouse::sendAuctionList(Player* player, AscEmu::Packets::CmsgAuctionL
     uint32_t count = 0;
     uint32_t totalcount = 0;
 
-    // convert auction string to lowercase for faster parsing.
-    if (srlPacket.searchedName.length() > 0)
-    {
-        for (uint32_t j = 0; j < srlPacket.searchedName.length(); ++j)
-            srlPacket.searchedName[j] = static_cast<char>(tolower(srlPacket.searchedName[j]));
-    }
-
-    std::lock_guard<std::mutex> guard(auctionLock);
-
-    for (auto& auction : auctions)
-    {
-        if (auction.second->isRemoved)
-            continue;
-
-        ItemProperties const* proto = auction.second->auctionItem->getItemProperties();
-
-        // Check the auction for parameters
-
-        // inventory type
-        if (srlPacket.auctionSlotId != 0xffffffff && srlPacket.auctionSlotId != proto->InventoryType)
-            continue;
-
-        // class
-        if (srlPacket.auctionMainCategory != 0xffffffff && srlPacket.auctionMainCategory != proto->Class)
-            continue;
+    AuctionSearchFilter filter;
 
-        // subclass
-        if (srlPacket.auctionSubCategory != 0xffffffff && srlPacket.auctionSubCategory != proto->SubClass)
-            continue;
+    // convert auction string to lowercase for faster parsing.
+    filter.name = srlPacket.searchedName;
+    for (auto& character : filter.name)
+        character = static_cast<char>(tolower(character));
 
-        // this is going to hurt. - name
-        std::string proto_lower = proto->lowercase_name;
-        if (srlPacket.searchedName.length() > 0 && !AscEmu::Util::Strings::contains(srlPacket.searchedName, proto_lower))
-            continue;
+    filter.inventoryType = srlPacket.auctionSlotId;
+    filter.itemClass = srlPacket.auctionMainCategory;
+    filter.itemSubClass = srlPacket.auctionSubCategory;
+    filter.quality = srlPacket.quality;
+    filter.levelMin = srlPacket.levelMin;
+    filter.levelMax = srlPacket.levelMax;
 
-        // rarity
-        if (srlPacket.quality != 0xffffffff && srlPacket.quality > proto->Quality)
-            continue;
+    std::shared_lock<std::shared_mutex> guard(auctionLock);
 
-        // level range check - lower boundary
-        if (srlPacket.levelMin && proto->RequiredLevel < srlPacket.levelMin)
-            continue;
+    auctionIndex.search(filter, [&](Auction* auction)
+    {
+        if (auction->isRemoved)
+            return true;
 
-        // level range check - high boundary
-        if (srlPacket.levelMax && proto->RequiredLevel > srlPacket.levelMax)
-            continue;
+        ItemProperties const* proto = auction->auctionItem->getItemProperties();
 
         // usable check - this will hurt too :(
         if (srlPacket.usable)
         {
             // allowed class
             if (proto->AllowableClass && !(player->getClassMask() & proto->AllowableClass))
-                continue;
+                return true;
 
             if (proto->RequiredLevel && proto->RequiredLevel > player->getLevel())
-                continue;
+                return true;
 
             if (proto->AllowableRace && !(player->getRaceMask() & proto->AllowableRace))
-                continue;
+                return true;
 
             if (proto->Class == 4 && proto->SubClass && !(player->GetArmorProficiency() & (((uint32_t)(1)) << proto->SubClass)))
-                continue;
+                return true;
 
             if (proto->Class == 2 && proto->SubClass && !(player->GetWeaponProficiency() & (((uint32_t)(1)) << proto->SubClass)))
-                continue;
+                return true;
 
             if (proto->RequiredSkill && (!player->_HasSkillLine(proto->RequiredSkill) || proto->RequiredSkillRank > player->_GetSkillLineCurrent(proto->RequiredSkill, true)))
-                continue;
+                return true;
         }
 
         if (count < 50 && totalcount >= srlPacket.listFrom)
         {
             ++count;
 
-            auctionPacketList.push_back(auction.second->getListMember());
+            auctionPacketList.push_back(auction->getListMember());
         }
 
         ++totalcount;
-    }
+
+        // the total count is not sent, so the search can stop once the page is full
+        return count < 50;
+    });
+
+    guard.unlock();
 
     player->SendPacket(SmsgAuctionListResult(static_cast<uint32_t>(auctionPacketList.size()), auctionPacketList, static_cast<uint32_t>(auctionPacketList.size()), 300).serialise().get());
 }
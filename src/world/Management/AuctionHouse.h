@@ -8,6 +8,10 @@ This file is released under the MIT license. See README-MIT for more information
 #include "Storage/DBC/DBCStructures.hpp"
 #include "WorldConf.h"
 #include "Item.h"
+#include "AuctionHouseIndex.hpp"
+
+#include <atomic>
+#include <shared_mutex>
 
 namespace AscEmu::Packets
 {
@@ -130,7 +134,8 @@ struct Auction
     uint64_t getAuctionOutBid() const;
 #endif
 
-    bool isRemoved;
+    // set by updateAuctions and queueDeletion while searches read it
+    std::atomic<bool> isRemoved;
     uint32_t removedType;
 
     AuctionPacketList getListMember();
@@ -162,8 +167,14 @@ public:
     void sendAuctionList(Player* player, AscEmu::Packets::CmsgAuctionListItems srlPacket);
 
 private:
-    std::mutex auctionLock;
+    // Searches, the owner and bid lists and the expiry scan of updateAuctions share the lock. Adding an auction
+    // and removing it in updateDeletionQueue take it exclusively while the map and auctionIndex change, so they
+    // wait for running searches and block new ones for one index update. Searches are not lock-free: a removed
+    // auction and its item are deleted right after the index update and bids change the auction in place,
+    // so a copy-on-write index would also need deferred deletion of auctions and items.
+    std::shared_mutex auctionLock;
     std::unordered_map<uint32_t, Auction*> auctions;
+    AuctionHouseIndex auctionIndex;
 
     Mutex removalLock;
     std::list<Auction*> removalList;
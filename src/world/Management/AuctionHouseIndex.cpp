@@ -0,0 +1,238 @@
+/*
+Copyright (c) 2014-2021 AscEmu Team <http://www.ascemu.org>
+This file is released under the MIT license. See README-MIT for more information.
+*/
+
+#include "AuctionHouseIndex.hpp"
+#include "Management/ItemPrototype.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+    uint64_t getSubClassKey(uint32_t itemClass, uint32_t itemSubClass)
+    {
+        return (static_cast<uint64_t>(itemClass) << 32) | itemSubClass;
+    }
+}
+
+uint64_t AuctionHouseIndex::getOrderKey(uint32_t auctionId, ItemProperties const* properties)
+{
+    return (static_cast<uint64_t>(properties->RequiredLevel) << 32) | auctionId;
+}
+
+uint32_t AuctionHouseIndex::getTrigram(std::string const& string, size_t offset)
+{
+    return (static_cast<uint32_t>(static_cast<uint8_t>(string[offset])) << 16)
+        | (static_cast<uint32_t>(static_cast<uint8_t>(string[offset + 1])) << 8)
+        | static_cast<uint8_t>(string[offset + 2]);
+}
+
+void AuctionHouseIndex::addToBucket(std::unordered_map<uint64_t, LevelOrderedAuctions>& buckets, uint64_t bucketKey, uint64_t orderKey, IndexedAuction const& indexedAuction)
+{
+    buckets[bucketKey].emplace(orderKey, indexedAuction);
+}
+
+void AuctionHouseIndex::removeFromBucket(std::unordered_map<uint64_t, LevelOrderedAuctions>& buckets, uint64_t bucketKey, uint64_t orderKey)
+{
+    const auto bucket = buckets.find(bucketKey);
+    if (bucket == buckets.end())
+        return;
+
+    bucket->second.erase(orderKey);
+    if (bucket->second.empty())
+        buckets.erase(bucket);
+}
+
+void AuctionHouseIndex::addAuction(Auction* auction, uint32_t auctionId, ItemProperties const* properties)
+{
+    const uint64_t orderKey = getOrderKey(auctionId, properties);
+    const uint32_t itemEntry = properties->ItemId;
+    const IndexedAuction indexedAuction = { auction, properties };
+
+    if (!m_auctions.emplace(orderKey, indexedAuction).second)
+        return;
+
+    addToBucket(m_byInventoryType, properties->InventoryType, orderKey, indexedAuction);
+    addToBucket(m_byClass, properties->Class, orderKey, indexedAuction);
+    addToBucket(m_bySubClass, getSubClassKey(properties->Class, properties->SubClass), orderKey, indexedAuction);
+
+    // the name is only indexed once for all auctions of the same item
+    if (m_byItemEntry.find(itemEntry) == m_byItemEntry.end())
+        addItemName(itemEntry, properties->lowercase_name);
+
+    addToBucket(m_byItemEntry, itemEntry, orderKey, indexedAuction);
+}
+
+void AuctionHouseIndex::removeAuction(uint32_t auctionId, ItemProperties const* properties)
+{
+    const uint64_t orderKey = getOrderKey(auctionId, properties);
+    const uint32_t itemEntry = properties->ItemId;
+
+    if (m_auctions.erase(orderKey) == 0)
+        return;
+
+    removeFromBucket(m_byInventoryType, properties->InventoryType, orderKey);
+    removeFromBucket(m_byClass, properties->Class, orderKey);
+    removeFromBucket(m_bySubClass, getSubClassKey(properties->Class, properties->SubClass), orderKey);
+    removeFromBucket(m_byItemEntry, itemEntry, orderKey);
+
+    if (m_byItemEntry.find(itemEntry) == m_byItemEntry.end())
+        removeItemName(itemEntry, properties->lowercase_name);
+}
+
+void AuctionHouseIndex::addItemName(uint32_t itemEntry, std::string const& lowercaseName)
+{
+    for (size_t i = 0; i + 3 <= lowercaseName.length(); ++i)
+        m_nameTrigrams[getTrigram(lowercaseName, i)].insert(itemEntry);
+}
+
+void AuctionHouseIndex::removeItemName(uint32_t itemEntry, std::string const& lowercaseName)
+{
+    for (size_t i = 0; i + 3 <= lowercaseName.length(); ++i)
+    {
+        const auto itemEntries = m_nameTrigrams.find(getTrigram(lowercaseName, i));
+        if (itemEntries == m_nameTrigrams.end())
+            continue;
+
+        itemEntries->second.erase(itemEntry);
+        if (itemEntries->second.empty())
+            m_nameTrigrams.erase(itemEntries);
+    }
+}
+
+bool AuctionHouseIndex::matchesFilter(ItemProperties const* properties, AuctionSearchFilter const& filter)
+{
+    if (filter.inventoryType != AuctionSearchFilter::Any && filter.inventoryType != properties->InventoryType)
+        return false;
+
+    if (filter.itemClass != AuctionSearchFilter::Any && filter.itemClass != properties->Class)
+        return false;
+
+    if (filter.itemSubClass != AuctionSearchFilter::Any && filter.itemSubClass != properties->SubClass)
+        return false;
+
+    if (filter.quality != AuctionSearchFilter::Any && filter.quality > properties->Quality)
+        return false;
+
+    if (filter.levelMin && properties->RequiredLevel < filter.levelMin)
+        return false;
+
+    if (filter.levelMax && properties->RequiredLevel > filter.levelMax)
+        return false;
+
+    return true;
+}
+
+void AuctionHouseIndex::search(AuctionSearchFilter const& filter, std::function<bool(Auction*)> const& callback) const
+{
+    if (!filter.name.empty())
+    {
+        searchByName(filter, callback);
+        return;
+    }
+
+    // use the smallest bucket the filter allows
+    LevelOrderedAuctions const* candidates = &m_auctions;
+    const auto selectBucket = [&candidates](std::unordered_map<uint64_t, LevelOrderedAuctions> const& buckets, uint64_t bucketKey)
+    {
+        const auto bucket = buckets.find(bucketKey);
+        if (bucket == buckets.end())
+            return false;
+
+        if (bucket->second.size() < candidates->size())
+            candidates = &bucket->second;
+
+        return true;
+    };
+
+    if (filter.itemClass != AuctionSearchFilter::Any)
+    {
+        const bool found = filter.itemSubClass != AuctionSearchFilter::Any
+            ? selectBucket(m_bySubClass, getSubClassKey(filter.itemClass, filter.itemSubClass))
+            : selectBucket(m_byClass, filter.itemClass);
+
+        if (!found)
+            return;
+    }
+
+    if (filter.inventoryType != AuctionSearchFilter::Any && !selectBucket(m_byInventoryType, filter.inventoryType))
+        return;
+
+    if (filter.levelMin && filter.levelMax && filter.levelMin > filter.levelMax)
+        return;
+
+    // buckets are ordered by level, so the level range limits the part which is iterated
+    auto itr = filter.levelMin ? candidates->lower_bound(static_cast<uint64_t>(filter.levelMin) << 32) : candidates->begin();
+    const auto end = filter.levelMax ? candidates->lower_bound(static_cast<uint64_t>(filter.levelMax + 1) << 32) : candidates->end();
+
+    for (; itr != end; ++itr)
+    {
+        if (!matchesFilter(itr->second.properties, filter))
+            continue;
+
+        if (!callback(itr->second.auction))
+            return;
+    }
+}
+
+void AuctionHouseIndex::searchByName(AuctionSearchFilter const& filter, std::function<bool(Auction*)> const& callback) const
+{
+    // all auctions of an item share its properties, so the filter is checked once per item
+    typedef std::pair<LevelOrderedAuctions::const_iterator, LevelOrderedAuctions::const_iterator> AuctionRange;
+    std::vector<AuctionRange> itemAuctions;
+
+    const auto addIfNameMatches = [&](uint32_t itemEntry)
+    {
+        const auto auctions = m_byItemEntry.find(itemEntry);
+        if (auctions == m_byItemEntry.end() || auctions->second.empty())
+            return;
+
+        ItemProperties const* properties = auctions->second.begin()->second.properties;
+        if (properties->lowercase_name.find(filter.name) != std::string::npos && matchesFilter(properties, filter))
+            itemAuctions.emplace_back(auctions->second.begin(), auctions->second.end());
+    };
+
+    if (filter.name.length() < 3)
+    {
+        for (const auto& auctions : m_byItemEntry)
+            addIfNameMatches(auctions.first);
+    }
+    else
+    {
+        // every trigram of the searched name has to be in the item name, the rarest one gives the fewest candidates
+        std::unordered_set<uint32_t> const* rarestTrigram = nullptr;
+        for (size_t i = 0; i + 3 <= filter.name.length(); ++i)
+        {
+            const auto trigramEntries = m_nameTrigrams.find(getTrigram(filter.name, i));
+            if (trigramEntries == m_nameTrigrams.end())
+                return;
+
+            if (rarestTrigram == nullptr || trigramEntries->second.size() < rarestTrigram->size())
+                rarestTrigram = &trigramEntries->second;
+        }
+
+        for (const auto itemEntry : *rarestTrigram)
+            addIfNameMatches(itemEntry);
+    }
+
+    // merge the ordered auctions of the items, a full page stops the search without touching the rest
+    const auto isLater = [](AuctionRange const& a, AuctionRange const& b) { return a.first->first > b.first->first; };
+    std::make_heap(itemAuctions.begin(), itemAuctions.end(), isLater);
+
+    while (!itemAuctions.empty())
+    {
+        std::pop_heap(itemAuctions.begin(), itemAuctions.end(), isLater);
+        AuctionRange& next = itemAuctions.back();
+
+        Auction* auction = next.first->second.auction;
+        if (++next.first == next.second)
+            itemAuctions.pop_back();
+        else
+            std::push_heap(itemAuctions.begin(), itemAuctions.end(), isLater);
+
+        if (!callback(auction))
+            return;
+    }
+}
@@ -0,0 +1,84 @@
+/*
+Copyright (c) 2014-2021 AscEmu Team <http://www.ascemu.org>
+This file is released under the MIT license. See README-MIT for more information.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+struct Auction;
+struct ItemProperties;
+
+struct AuctionSearchFilter
+{
+    static constexpr uint32_t Any = 0xffffffff;
+
+    // lowercase, empty matches all names
+    std::string name;
+
+    uint32_t inventoryType = Any;
+    uint32_t itemClass = Any;
+    uint32_t itemSubClass = Any;
+
+    // minimum quality
+    uint32_t quality = Any;
+
+    // 0 means no boundary
+    uint32_t levelMin = 0;
+    uint32_t levelMax = 0;
+};
+
+// Secondary indexes over the auctions of one auction house.
+// Auctions are bucketed by inventory type, class and subclass, every bucket is ordered by required level
+// and item names are indexed by their trigrams. The index is not synchronised, AuctionHouse guards it with auctionLock.
+// It keeps the item properties next to the auction, searches never touch the auctioned items.
+class AuctionHouseIndex
+{
+public:
+
+    // properties are the ones of the auctioned item, removeAuction has to get the same ones
+    void addAuction(Auction* auction, uint32_t auctionId, ItemProperties const* properties);
+    void removeAuction(uint32_t auctionId, ItemProperties const* properties);
+
+    // Calls the callback for every auction matching the filter ordered by required level, stops when the callback returns false
+    void search(AuctionSearchFilter const& filter, std::function<bool(Auction*)> const& callback) const;
+
+private:
+
+    struct IndexedAuction
+    {
+        Auction* auction;
+        ItemProperties const* properties;
+    };
+
+    // key is required level << 32 | auction id, so buckets are iterated by level
+    typedef std::map<uint64_t, IndexedAuction> LevelOrderedAuctions;
+
+    static uint64_t getOrderKey(uint32_t auctionId, ItemProperties const* properties);
+    static uint32_t getTrigram(std::string const& string, size_t offset);
+
+    static void addToBucket(std::unordered_map<uint64_t, LevelOrderedAuctions>& buckets, uint64_t bucketKey, uint64_t orderKey, IndexedAuction const& indexedAuction);
+    static void removeFromBucket(std::unordered_map<uint64_t, LevelOrderedAuctions>& buckets, uint64_t bucketKey, uint64_t orderKey);
+
+    void addItemName(uint32_t itemEntry, std::string const& lowercaseName);
+    void removeItemName(uint32_t itemEntry, std::string const& lowercaseName);
+
+    void searchByName(AuctionSearchFilter const& filter, std::function<bool(Auction*)> const& callback) const;
+    static bool matchesFilter(ItemProperties const* properties, AuctionSearchFilter const& filter);
+
+    LevelOrderedAuctions m_auctions;
+
+    std::unordered_map<uint64_t, LevelOrderedAuctions> m_byInventoryType;
+    std::unordered_map<uint64_t, LevelOrderedAuctions> m_byClass;
+    std::unordered_map<uint64_t, LevelOrderedAuctions> m_bySubClass;
+    std::unordered_map<uint64_t, LevelOrderedAuctions> m_byItemEntry;
+
+    // trigram of the lowercase item name -> item entries currently on sale
+    std::unordered_map<uint32_t, std::unordered_set<uint32_t>> m_nameTrigrams;
+};
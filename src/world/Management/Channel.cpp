@@ -770,20 +770,22 @@ Channel::~Channel()
 
 void Channel::SendToAll(WorldPacket* data)
 {
+    SharedWorldPacket sharedPacket;
     m_lock.Acquire();
     for (MemberMap::iterator itr = m_members.begin(); itr != m_members.end(); ++itr)
-        itr->first->SendPacket(data);
+        itr->first->SendBroadcastPacket(data, sharedPacket);
 
     m_lock.Release();
 }
 
 void Channel::SendToAll(WorldPacket* data, Player* plr)
 {
+    SharedWorldPacket sharedPacket;
     m_lock.Acquire();
     for (MemberMap::iterator itr = m_members.begin(); itr != m_members.end(); ++itr)
     {
         if (itr->first != plr)
-            itr->first->SendPacket(data);
+            itr->first->SendBroadcastPacket(data, sharedPacket);
     }
 
     m_lock.Release();
@@ -351,15 +351,18 @@ Item* Container::GetItem(int16 slot)
         return 0;
 }
 
-void Container::SaveBagToDB(int8 slot, bool first, QueryBuffer* buf)
+uint32 Container::SaveBagToDB(int8 slot, bool first, QueryBuffer* buf)
 {
-    SaveToDB(INVENTORY_SLOT_NOT_SET, slot, first, buf);
+    uint32 savedItems = SaveToDB(INVENTORY_SLOT_NOT_SET, slot, first, buf) ? 1 : 0;
 
     for (uint32 i = 0; i < m_itemProperties->ContainerSlots; ++i)
     {
         if (m_Slot[i] && !((m_Slot[i]->getItemProperties()->Flags) & 2))
         {
-            m_Slot[i]->SaveToDB(slot, static_cast<int8>(i), first, buf);
+            if (m_Slot[i]->SaveToDB(slot, static_cast<int8>(i), first, buf))
+                ++savedItems;
         }
     }
+
+    return savedItems;
 }
@@ -62,7 +62,8 @@ public:
         Item* SafeRemoveAndRetreiveItemFromSlot(int16 slot, bool destroy);  /// doesn't destroy item from memory
         bool SafeFullRemoveItemFromSlot(int16 slot);                        /// destroys item fully
 
-        void SaveBagToDB(int8 slot, bool first, QueryBuffer* buf);
+        // returns the number of written items including the bag
+        uint32 SaveBagToDB(int8 slot, bool first, QueryBuffer* buf);
 
 protected:
 
@@ -28,7 +28,7 @@ This file is released under the MIT license. See README-MIT for more information
 using namespace AscEmu::Packets;
 
 Guild::Guild() : m_id(0), m_leaderGuid(0), m_createdDate(0), m_bankMoney(0),
-    m_level(1), m_experience(0), m_todayExperience(0), mAccountsNumber(0),
+    m_level(1), m_experience(0), m_todayExperience(0), m_isDirty(false), mAccountsNumber(0),
     mEventLog(nullptr), mBankEventLog{ nullptr }, mNewsLog(nullptr)
 {
     memset(&mBankEventLog, 0, (MAX_GUILD_BANK_TABS + 1) * sizeof(GuildLogHolder*));
@@ -209,10 +209,16 @@ void Guild::disband()
     sGuildMgr.removeGuild(m_id);
 }
 
-void Guild::saveGuildToDB()
+void Guild::saveGuildToDB(QueryBuffer* buf)
 {
-    CharacterDatabase.Execute("UPDATE guilds SET guildLevel = '%u', guildExperience = '%llu', todayExperience = '%llu' WHERE guildId = %u",
-        static_cast<uint32_t>(getLevel()), getExperience(), getTodayExperience(), getId());
+    if (buf)
+        buf->AddQuery("UPDATE guilds SET guildLevel = '%u', guildExperience = '%llu', todayExperience = '%llu' WHERE guildId = %u",
+            static_cast<uint32_t>(getLevel()), getExperience(), getTodayExperience(), getId());
+    else
+        CharacterDatabase.Execute("UPDATE guilds SET guildLevel = '%u', guildExperience = '%llu', todayExperience = '%llu' WHERE guildId = %u",
+            static_cast<uint32_t>(getLevel()), getExperience(), getTodayExperience(), getId());
+
+    m_isDirty = false;
 }
 
 void Guild::updateMemberData(Player* player, uint8_t dataid, uint32_t value)
@@ -905,7 +911,8 @@ void Guild::handleMemberLogout(WorldSession* session)
     }
     broadcastEvent(GE_SIGNED_OFF, player->getGuid(), { player->getName() });
 
-    saveGuildToDB();
+    if (isDirty())
+        saveGuildToDB();
 }
 
 void Guild::handleDisband(WorldSession* session)
@@ -2107,6 +2114,8 @@ void Guild::giveXP(uint32_t xp, Player* source)
     if (xp == 0)
         return;
 
+    m_isDirty = true;
+
     uint32_t oldLevel = getLevel();
 
     while (getExperience() >= sGuildMgr.getXPForGuildLevel(getLevel()) && getLevel() < 25)
@@ -2168,6 +2177,9 @@ void Guild::sendGuildReputationWeeklyCap(WorldSession* session, uint32_t reputat
 
 void Guild::resetTimes(bool weekly)
 {
+    if (m_todayExperience)
+        m_isDirty = true;
+
     m_todayExperience = 0;
     for (GuildMembersStore::const_iterator itr = _guildMembersStore.begin(); itr != _guildMembersStore.end(); ++itr)
     {
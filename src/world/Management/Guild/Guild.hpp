@@ -24,6 +24,7 @@ This file is released under the MIT license. See README-MIT for more information
 
 class Player;
 class EmblemInfo;
+class QueryBuffer;
 
 typedef std::vector<GuildBankRightsAndSlots> GuildBankRightsAndSlotsVec;
 
@@ -45,6 +46,8 @@ protected:
     uint64_t m_experience;
     uint64_t m_todayExperience;
 
+    bool m_isDirty;                             // level or experience changed since the last saveGuildToDB
+
 public:
 
     uint32_t getId() const { return m_id; }
@@ -187,7 +190,9 @@ public:
     bool create(Player* pLeader, std::string const& name);
     void disband();
 
-    void saveGuildToDB();
+    // writes level and experience, with a buffer the query is executed in its transaction
+    void saveGuildToDB(QueryBuffer* buf = nullptr);
+    bool isDirty() const { return m_isDirty; }
 
     void handleRoster(WorldSession* session = nullptr);
     void handleQuery(WorldSession* session);
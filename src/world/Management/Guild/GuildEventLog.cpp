@@ -25,8 +25,8 @@ GuildEventLogEntry::~GuildEventLogEntry()
 
 void GuildEventLogEntry::saveGuildLogToDB() const
 {
-    CharacterDatabase.Execute("DELETE FROM guild_logs WHERE guildId = %u AND logGuid = %u", mGuildId, mGuid);
-    CharacterDatabase.Execute("INSERT INTO guild_logs VALUES(%u, %u, %u, %u, %u, %u, %llu)",
+    // one statement, the log guid of a full log is reused by the next entry (see GuildLogHolder::getNextGUID)
+    CharacterDatabase.Execute("REPLACE INTO guild_logs VALUES(%u, %u, %u, %u, %u, %u, %llu)",
         mGuildId, mGuid, uint8_t(mEventType), mPlayerGuid1, mPlayerGuid2, (uint32_t)mNewRank, mTimestamp);
 }
 
@@ -18,6 +18,8 @@ GuildMgr& GuildMgr::getInstance()
 
 void GuildMgr::finalize()
 {
+    saveGuilds();
+
     for (auto itr : GuildStore)
         delete itr.second;
 }
@@ -33,16 +35,53 @@ void GuildMgr::update(uint32_t /*diff*/)
     if (time(nullptr) >= lastSave)
     {
         lastSave = static_cast<uint32_t>(time(nullptr)) + worldConfig.guild.saveInterval;
-        sGuildMgr.saveGuilds();
+        queueDirtyGuilds();
     }
+
+    savePendingGuilds(worldConfig.guild.saveBatchSize);
 }
 
 void GuildMgr::saveGuilds()
 {
-#if VERSION_STRING >= Cata
-    for (GuildContainer::iterator itr = GuildStore.begin(); itr != GuildStore.end(); ++itr)
-        itr->second->saveGuildToDB();
-#endif
+    queueDirtyGuilds();
+    savePendingGuilds(0);
+}
+
+void GuildMgr::queueDirtyGuilds()
+{
+    // a guild queued twice is written once, saveGuildToDB clears its dirty flag
+    for (GuildContainer::const_iterator itr = GuildStore.begin(); itr != GuildStore.end(); ++itr)
+    {
+        if (itr->second->isDirty())
+            m_pendingSaves.push_back(itr->first);
+    }
+}
+
+void GuildMgr::savePendingGuilds(uint32_t maxGuilds)
+{
+    if (m_pendingSaves.empty())
+        return;
+
+    // one transaction for all guilds of this update
+    QueryBuffer* buf = new QueryBuffer;
+
+    uint32_t savedGuilds = 0;
+    while (!m_pendingSaves.empty() && (maxGuilds == 0 || savedGuilds < maxGuilds))
+    {
+        Guild* guild = getGuildById(m_pendingSaves.front());
+        m_pendingSaves.pop_front();
+
+        if (guild == nullptr || !guild->isDirty())
+            continue;
+
+        guild->saveGuildToDB(buf);
+        ++savedGuilds;
+    }
+
+    if (buf->getQueryCount() > 0)
+        CharacterDatabase.AddQueryBuffer(buf);
+    else
+        delete buf;
 }
 
 void GuildMgr::addGuild(Guild* guild)
@@ -7,6 +7,8 @@ This file is released under the MIT license. See README-MIT for more information
 
 #include "Guild.hpp"
 
+#include <deque>
+
 class SERVER_DECL GuildMgr
 {
     private:
@@ -25,6 +27,8 @@ class SERVER_DECL GuildMgr
         GuildMgr& operator=(GuildMgr const&) = delete;
 
         void update(uint32_t diff);
+
+        // writes every guild with unsaved changes now
         void saveGuilds();
 
         void addGuild(Guild* guild);
@@ -53,6 +57,13 @@ class SERVER_DECL GuildMgr
         uint32_t lastSave = 0;
         bool firstSave = false;
 
+    private:
+
+        void queueDirtyGuilds();
+        void savePendingGuilds(uint32_t maxGuilds);
+
+        std::deque<uint32_t> m_pendingSaves;            // guild ids, written over the following updates
+
     protected:
 
         typedef std::unordered_map<uint32_t, Guild*> GuildContainer;
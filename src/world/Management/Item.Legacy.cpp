@@ -84,6 +84,8 @@ Item::Item()
         OnUseSpellIDs[i] = 0;
 
     m_isDirty = false;
+    m_queuedWriteOwnerGuid = 0;
+    m_hasQueuedWrite = false;
 }
 
 Item::~Item()
@@ -205,6 +207,9 @@ void Item::LoadFromDB(Field* fields, Player* plr, bool light)
 
     ApplyRandomProperties(false);
 
+    // the enchantments added above are already part of the stored row
+    m_isDirty = false;
+
     // Charter stuff
     if (getEntry() == CharterEntry::Guild)
     {
@@ -306,33 +311,18 @@ void Item::ApplyRandomProperties(bool apply)
     }
 }
 
-void Item::SaveToDB(int8 containerslot, int8 slot, bool firstsave, QueryBuffer* buf)
+bool Item::SaveToDB(int8 containerslot, int8 slot, bool firstsave, QueryBuffer* buf)
 {
     if (!m_isDirty && !firstsave)
-        return;
+        return false;
 
     uint64 GiftCreatorGUID = getGiftCreatorGuid();
     uint64 CreatorGUID = getCreatorGuid();
 
     std::stringstream ss;
-    ss << "DELETE FROM playeritems WHERE guid = " << getGuidLow() << ";";
-
-    if (firstsave)
-    {
-        CharacterDatabase.WaitExecute(ss.str().c_str());
-    }
-    else
-    {
-        if (buf == nullptr)
-            CharacterDatabase.Execute(ss.str().c_str());
-        else
-            buf->AddQueryNA(ss.str().c_str());
-    }
-
-
-    ss.rdbuf()->str("");
 
-    ss << "INSERT INTO playeritems VALUES(";
+    // guid is the primary key, so the row replaces the previously saved one
+    ss << "REPLACE INTO playeritems VALUES(";
 
     ss << getOwnerGuidLow() << ",";
     ss << getGuidLow() << ",";
@@ -395,6 +385,8 @@ void Item::SaveToDB(int8 containerslot, int8 slot, bool firstsave, QueryBuffer*
     ss << text;
     ss << "')";
 
+    // a buffer is queued on the writer of the player owning the item
+    const uint32 shardKey = getWriteShardKey();
     if (firstsave)
     {
         CharacterDatabase.WaitExecute(ss.str().c_str());
@@ -402,12 +394,13 @@ void Item::SaveToDB(int8 containerslot, int8 slot, bool firstsave, QueryBuffer*
     else
     {
         if (buf == nullptr)
-            CharacterDatabase.Execute(ss.str().c_str());
+            CharacterDatabase.ExecuteNA(shardKey, ss.str().c_str());
         else
             buf->AddQueryNA(ss.str().c_str());
     }
 
     m_isDirty = false;
+    return true;
 }
 
 void Item::DeleteFromDB()
@@ -425,7 +418,18 @@ void Item::DeleteFromDB()
         }
     }
 
-    CharacterDatabase.Execute("DELETE FROM playeritems WHERE guid = %u", getGuidLow());
+    CharacterDatabase.Execute(getWriteShardKey(), "DELETE FROM playeritems WHERE guid = %u", getGuidLow());
+}
+
+uint32 Item::getWriteShardKey()
+{
+    const uint32 ownerGuid = getOwnerGuidLow();
+    if (m_hasQueuedWrite && m_queuedWriteOwnerGuid != ownerGuid)
+        CharacterDatabase.waitForWrites(m_queuedWriteOwnerGuid);
+
+    m_queuedWriteOwnerGuid = ownerGuid;
+    m_hasQueuedWrite = true;
+    return ownerGuid;
 }
 
 void Item::DeleteMe()
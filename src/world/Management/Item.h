@@ -317,7 +317,8 @@ public:
 
         // DB Serialization
         void LoadFromDB(Field* fields, Player* plr, bool light);
-        void SaveToDB(int8 containerslot, int8 slot, bool firstsave, QueryBuffer* buf);
+        // returns false if the item was not changed since the last save
+        bool SaveToDB(int8 containerslot, int8 slot, bool firstsave, QueryBuffer* buf);
         bool LoadAuctionItemFromDB(uint64 guid);
         void DeleteFromDB();
         void DeleteMe();
@@ -476,6 +477,12 @@ public:
         /// Enchant type 3 spellids, like engineering gadgets appliable to items.
         uint32 OnUseSpellIDs[3];
         std::string text;
+
+        /// Writes of the row are keyed by its owner. A row which changed its owner waits
+        /// for the writes still queued for the previous one, they would overwrite it otherwise.
+        uint32 getWriteShardKey();
+        uint32 m_queuedWriteOwnerGuid;
+        bool m_hasQueuedWrite;
 };
 
 //\todo move these functions to ItemProperties/Player class.
@@ -3263,9 +3263,10 @@ void ItemInterface::mLoadItemsFromDatabase(QueryResult* result)
 }
 
 /// Item saving
-void ItemInterface::mSaveItemsToDatabase(bool first, QueryBuffer* buf)
+uint32 ItemInterface::mSaveItemsToDatabase(bool first, QueryBuffer* buf)
 {
     int16 x;
+    uint32 savedItems = 0;
 
     for (x = EQUIPMENT_SLOT_START; x < CURRENCYTOKEN_SLOT_END; ++x)
     {
@@ -3273,11 +3274,36 @@ void ItemInterface::mSaveItemsToDatabase(bool first, QueryBuffer* buf)
         {
             if (IsBagSlot(x) && GetInventoryItem(x)->isContainer())
             {
-                static_cast<Container*>(GetInventoryItem(x))->SaveBagToDB(static_cast<int8>(x), first, buf);
+                savedItems += static_cast<Container*>(GetInventoryItem(x))->SaveBagToDB(static_cast<int8>(x), first, buf);
             }
             else
             {
-                GetInventoryItem(x)->SaveToDB(INVENTORY_SLOT_NOT_SET, static_cast<int8>(x), first, buf);
+                if (GetInventoryItem(x)->SaveToDB(INVENTORY_SLOT_NOT_SET, static_cast<int8>(x), first, buf))
+                    ++savedItems;
+            }
+        }
+    }
+
+    return savedItems;
+}
+
+void ItemInterface::setItemsDirty()
+{
+    for (int16 x = EQUIPMENT_SLOT_START; x < CURRENCYTOKEN_SLOT_END; ++x)
+    {
+        Item* item = GetInventoryItem(x);
+        if (item == nullptr)
+            continue;
+
+        item->m_isDirty = true;
+
+        if (IsBagSlot(x) && item->isContainer())
+        {
+            Container* container = static_cast<Container*>(item);
+            for (uint32 i = 0; i < container->getItemProperties()->ContainerSlots; ++i)
+            {
+                if (Item* containedItem = container->GetItem(static_cast<int16>(i)))
+                    containedItem->m_isDirty = true;
             }
         }
     }
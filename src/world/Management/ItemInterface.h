@@ -100,7 +100,10 @@ class SERVER_DECL ItemInterface
         void m_DestroyForPlayer();
 
         void mLoadItemsFromDatabase(QueryResult* result);
-        void mSaveItemsToDatabase(bool first, QueryBuffer* buf);
+        // returns the number of written items, unchanged items are skipped
+        uint32 mSaveItemsToDatabase(bool first, QueryBuffer* buf);
+        // the next save writes all items saved by mSaveItemsToDatabase
+        void setItemsDirty();
 
         Item* GetInventoryItem(int16 slot);
         Item* GetInventoryItem(int8 ContainerSlot, int16 slot);
@@ -0,0 +1,361 @@
+/*
+Copyright (c) 2014-2021 AscEmu Team <http://www.ascemu.org>
+This file is released under the MIT license. See README-MIT for more information.
+*/
+
+#include "LFGMatcher.hpp"
+#include "LFG.hpp"
+#include "LFGMgr.hpp"
+#include "Log.hpp"
+#include "Threading/AEWorkerPool.h"
+
+#include <algorithm>
+#include <functional>
+
+using AscEmu::Threading::AEWorkerPool;
+
+namespace
+{
+    uint8_t getRoleMaskIndex(uint8_t tanks, uint8_t healers, uint8_t dps)
+    {
+        return static_cast<uint8_t>(tanks * 8 + healers * 4 + dps);
+    }
+}
+
+size_t LfgCompatibilityKeyHash::operator()(LfgCompatibilityKey const& key) const
+{
+    size_t seed = 0;
+    for (const auto ticket : key.tickets)
+        seed ^= std::hash<uint32_t>()(ticket) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+
+    return seed;
+}
+
+LfgMatcher::LfgMatcher() = default;
+
+LfgMatcher::~LfgMatcher()
+{
+    finalize();
+}
+
+void LfgMatcher::initialize()
+{
+    if (m_workerPool)
+        return;
+
+    m_workerPool = std::make_unique<AEWorkerPool>("LfgMatcher", static_cast<uint16_t>(1));
+}
+
+void LfgMatcher::finalize()
+{
+    if (!m_workerPool)
+        return;
+
+    // waits for a running job
+    m_workerPool->shutdown();
+    m_workerPool = nullptr;
+
+    m_job = nullptr;
+    m_compatibleMap.clear();
+}
+
+void LfgMatcher::submit(std::unique_ptr<LfgMatchJob> job)
+{
+    if (!m_workerPool || m_job)
+        return;
+
+    m_job = std::move(job);
+
+    LfgMatchJob* runningJob = m_job.get();
+    m_workerPool->enqueue([this, runningJob]() { run(*runningJob); });
+}
+
+std::unique_ptr<LfgMatchJob> LfgMatcher::takeFinishedJob()
+{
+    if (!m_job || !m_job->isDone())
+        return nullptr;
+
+    return std::move(m_job);
+}
+
+LfgRoleMask LfgMatcher::getPlayerRoleMask(uint8_t roles)
+{
+    LfgRoleMask roleMask = 0;
+    if (roles & ROLE_TANK)
+        roleMask |= 1 << getRoleMaskIndex(1, 0, 0);
+    if (roles & ROLE_HEALER)
+        roleMask |= 1 << getRoleMaskIndex(0, 1, 0);
+    if (roles & ROLE_DAMAGE)
+        roleMask |= 1 << getRoleMaskIndex(0, 0, 1);
+
+    return roleMask;
+}
+
+LfgRoleMask LfgMatcher::combineRoleMasks(LfgRoleMask first, LfgRoleMask second)
+{
+    LfgRoleMask roleMask = 0;
+    for (uint8_t i = 0; i < 16; ++i)
+    {
+        if (!(first & (1 << i)))
+            continue;
+
+        for (uint8_t j = 0; j < 16; ++j)
+        {
+            if (!(second & (1 << j)))
+                continue;
+
+            const uint8_t tanks = (i >> 3) + (j >> 3);
+            const uint8_t healers = ((i >> 2) & 1) + ((j >> 2) & 1);
+            const uint8_t dps = (i & 3) + (j & 3);
+            if (tanks <= LFG_TANKS_NEEDED && healers <= LFG_HEALERS_NEEDED && dps <= LFG_DPS_NEEDED)
+                roleMask |= 1 << getRoleMaskIndex(tanks, healers, dps);
+        }
+    }
+
+    return roleMask;
+}
+
+void LfgMatcher::run(LfgMatchJob& job)
+{
+    const auto startTime = std::chrono::steady_clock::now();
+    const auto deadline = job.timeBudget.count() ? startTime + job.timeBudget : std::chrono::steady_clock::time_point::max();
+
+    for (const auto& key : job.incompatibleSets)
+        m_compatibleMap[key] = false;
+
+    removeTickets(job.removedTickets);
+
+    if (m_compatibleMap.size() > MAX_CACHED_ANSWERS)
+        m_compatibleMap.clear();
+
+    job.rolesNeeded.resize(job.entries.size());
+
+    // entries which are part of a formed group, shared by all queues as an entry is only queued once
+    std::vector<bool> matched(job.entries.size(), false);
+
+    for (const auto& queue : job.queues)
+    {
+        matchQueue(job, queue, matched, deadline);
+        if (job.budgetExceeded)
+            break;
+    }
+
+    job.duration = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count());
+    job.m_done.store(true, std::memory_order_release);
+}
+
+// Each new entry is combined with the current queue in queue order, an entry which fits to the group found so far
+// stays in it until the group is full or the queue ends
+void LfgMatcher::matchQueue(LfgMatchJob& job, LfgMatchQueue const& queue, std::vector<bool>& matched, std::chrono::steady_clock::time_point deadline)
+{
+    std::vector<uint16_t> currentSlots = queue.currentSlots;
+
+    for (const uint16_t newSlot : queue.newSlots)
+    {
+        if (std::chrono::steady_clock::now() >= deadline)
+        {
+            // the remaining entries stay new and are checked by the next job
+            job.budgetExceeded = true;
+            return;
+        }
+
+        if (matched[newSlot])
+            continue;
+
+        LfgMatchOutcome outcome;
+        outcome.queueId = queue.queueId;
+        outcome.guid = job.entries[newSlot].guid;
+        outcome.ticket = job.entries[newSlot].ticket;
+
+        uint16_t check[LFG_MATCH_GROUP_SIZE];
+        uint8_t count = 0;
+        uint8_t numPlayers = job.entries[newSlot].playerCount;
+        check[count++] = newSlot;
+
+        bool found = false;
+        if (checkCompatibility(job, check, count))
+        {
+            found = numPlayers == LFG_MATCH_GROUP_SIZE;
+
+            for (auto itr = currentSlots.begin(); itr != currentSlots.end() && !found && count < LFG_MATCH_GROUP_SIZE; ++itr)
+            {
+                const uint16_t slot = *itr;
+                if (matched[slot] || slot == newSlot)
+                    continue;
+
+                check[count++] = slot;
+                if (!checkCompatibility(job, check, count))
+                {
+                    --count;
+                    continue;
+                }
+
+                numPlayers += job.entries[slot].playerCount;
+                found = numPlayers == LFG_MATCH_GROUP_SIZE;
+            }
+        }
+
+        if (found)
+        {
+            outcome.dungeons.set();
+            for (uint8_t i = 0; i < count; ++i)
+            {
+                matched[check[i]] = true;
+                outcome.queues.push_back(job.entries[check[i]].guid);
+                outcome.dungeons &= job.entries[check[i]].dungeons;
+            }
+        }
+        else if (std::find(currentSlots.begin(), currentSlots.end(), newSlot) == currentSlots.end())
+        {
+            currentSlots.push_back(newSlot);
+        }
+
+        job.outcomes.push_back(std::move(outcome));
+    }
+}
+
+bool LfgMatcher::checkCompatibility(LfgMatchJob& job, uint16_t const* slots, uint8_t count)
+{
+    if (count == 0 || count > LFG_MATCH_GROUP_SIZE)
+        return false;
+
+    if (count == 1 && !job.entries[slots[0]].isGroup)
+        return true;
+
+    const LfgCompatibilityKey key = makeKey(job, slots, count);
+    const auto cached = m_compatibleMap.find(key);
+    if (cached != m_compatibleMap.end())
+        return cached->second;
+
+    // Check all-but-new compatibilities (New, A, B, C, D) --> check(A, B, C, D)
+    if (count > 2 && !checkCompatibility(job, slots + 1, count - 1))
+    {
+        m_compatibleMap[key] = false;
+        return false;
+    }
+
+    uint8_t numPlayers = 0;
+    uint8_t numLfgGroups = 0;
+    for (uint8_t i = 0; i < count; ++i)
+    {
+        const LfgMatchEntry& entry = job.entries[slots[i]];
+        numPlayers += entry.playerCount;
+        if (entry.isLfgGroup)
+            ++numLfgGroups;
+    }
+
+    // Single group with less than MAXGROUPSIZE - Compatibles
+    if (count == 1 && numPlayers != LFG_MATCH_GROUP_SIZE)
+        return true;
+
+    // Do not match - groups already in a lfgDungeon or too much players
+    if (numLfgGroups > 1 || numPlayers > LFG_MATCH_GROUP_SIZE)
+    {
+        m_compatibleMap[key] = false;
+        return false;
+    }
+
+    // Player in multiple queues or offline, both can change until the next job so the answer is not cached
+    for (uint8_t i = 0; i < count; ++i)
+    {
+        const LfgMatchEntry& entry = job.entries[slots[i]];
+        if (!entry.isOnline)
+            return false;
+
+        for (uint8_t j = i + 1; j < count; ++j)
+        {
+            const LfgMatchEntry& other = job.entries[slots[j]];
+            for (uint8_t p = 0; p < entry.playerCount; ++p)
+                for (uint8_t q = 0; q < other.playerCount; ++q)
+                    if (entry.players[p].guid == other.players[q].guid)
+                        return false;
+        }
+    }
+
+    LfgRoleMask roleMask = LFG_EMPTY_ROLE_MASK;
+    LfgDungeonMask dungeons = job.entries[slots[0]].dungeons;
+    for (uint8_t i = 0; i < count && roleMask; ++i)
+    {
+        roleMask = combineRoleMasks(roleMask, job.entries[slots[i]].roleMask);
+        dungeons &= job.entries[slots[i]].dungeons;
+    }
+
+    const bool compatible = roleMask != 0 && dungeons.any();
+    m_compatibleMap[key] = compatible;
+
+    if (compatible && numPlayers != LFG_MATCH_GROUP_SIZE)
+        updateRolesNeeded(job, slots, count);
+
+    return compatible;
+}
+
+// Roles the compatible but incomplete group still needs, shown in the queue status of its members
+void LfgMatcher::updateRolesNeeded(LfgMatchJob& job, uint16_t const* slots, uint8_t count)
+{
+    LfgRolesNeeded rolesNeeded;
+    rolesNeeded.isSet = true;
+    rolesNeeded.tanks = LFG_TANKS_NEEDED;
+    rolesNeeded.healers = LFG_HEALERS_NEEDED;
+    rolesNeeded.dps = LFG_DPS_NEEDED;
+
+    for (uint8_t i = 0; i < count; ++i)
+    {
+        const LfgMatchEntry& entry = job.entries[slots[i]];
+        for (uint8_t p = 0; p < entry.playerCount; ++p)
+        {
+            const uint8_t roles = entry.players[p].roles;
+            if ((roles & ROLE_TANK) && rolesNeeded.tanks > 0)
+                --rolesNeeded.tanks;
+            else if ((roles & ROLE_HEALER) && rolesNeeded.healers > 0)
+                --rolesNeeded.healers;
+            else if ((roles & ROLE_DAMAGE) && rolesNeeded.dps > 0)
+                --rolesNeeded.dps;
+        }
+    }
+
+    for (uint8_t i = 0; i < count; ++i)
+        job.rolesNeeded[slots[i]] = rolesNeeded;
+}
+
+void LfgMatcher::removeTickets(std::vector<uint32_t> const& tickets)
+{
+    if (tickets.empty() || m_compatibleMap.empty())
+        return;
+
+    std::vector<uint32_t> sortedTickets = tickets;
+    std::sort(sortedTickets.begin(), sortedTickets.end());
+
+    for (auto itr = m_compatibleMap.begin(); itr != m_compatibleMap.end();)
+    {
+        const auto& keyTickets = itr->first.tickets;
+        const bool isRemoved = std::any_of(keyTickets.begin(), keyTickets.end(), [&sortedTickets](uint32_t ticket)
+        {
+            return ticket != 0 && std::binary_search(sortedTickets.begin(), sortedTickets.end(), ticket);
+        });
+
+        if (isRemoved)
+            itr = m_compatibleMap.erase(itr);
+        else
+            ++itr;
+    }
+}
+
+LfgCompatibilityKey LfgMatcher::makeKey(LfgMatchJob const& job, uint16_t const* slots, uint8_t count)
+{
+    std::array<uint32_t, LFG_MATCH_GROUP_SIZE> tickets;
+    for (uint8_t i = 0; i < count; ++i)
+        tickets[i] = job.entries[slots[i]].ticket;
+
+    return makeKey(tickets.data(), count);
+}
+
+LfgCompatibilityKey LfgMatcher::makeKey(uint32_t const* tickets, uint8_t count)
+{
+    LfgCompatibilityKey key;
+    key.tickets.fill(0);
+
+    std::copy(tickets, tickets + count, key.tickets.begin());
+
+    std::sort(key.tickets.begin(), key.tickets.begin() + count);
+    return key;
+}
@@ -0,0 +1,160 @@
+/*
+Copyright (c) 2014-2021 AscEmu Team <http://www.ascemu.org>
+This file is released under the MIT license. See README-MIT for more information.
+*/
+
+#pragma once
+
+#include "WorldConf.h"
+#include "Macros/LFGMacros.hpp"
+
+#include <array>
+#include <atomic>
+#include <bitset>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace AscEmu::Threading
+{
+    class AEWorkerPool;
+}
+
+static constexpr uint8_t LFG_MATCH_GROUP_SIZE = 5;
+
+// Indexed by dungeon id
+typedef std::bitset<MAX_DUNGEONS> LfgDungeonMask;
+
+// Role compositions a queue entry can fill. Bit (tanks * 8 + healers * 4 + dps) is set when the players
+// can take 0-1 tanks, 0-1 healers and 0-3 dps with one role each.
+typedef uint16_t LfgRoleMask;
+
+// Mask of an entry without players, no role is taken yet
+static constexpr LfgRoleMask LFG_EMPTY_ROLE_MASK = 1;
+
+struct LfgMatchPlayer
+{
+    uint64_t guid;
+    uint8_t roles;
+};
+
+// A queued player or group, copied from the queue by the world thread
+struct LfgMatchEntry
+{
+    uint64_t guid;
+    uint32_t ticket;                                       ///< LfgQueueInfo::ticket, stable while the entry is queued
+    uint8_t playerCount;
+    std::array<LfgMatchPlayer, LFG_MATCH_GROUP_SIZE> players;
+    bool isGroup;
+    bool isLfgGroup;                                       ///< Group already in a lfg dungeon
+    bool isOnline;                                         ///< Every player is online
+    LfgRoleMask roleMask;
+    LfgDungeonMask dungeons;                               ///< Selected dungeons none of the players is locked for
+};
+
+struct LfgRolesNeeded
+{
+    bool isSet = false;
+    uint8_t tanks = 0;
+    uint8_t healers = 0;
+    uint8_t dps = 0;
+};
+
+// One new queue entry checked against the current queue
+struct LfgMatchOutcome
+{
+    uint8_t queueId;
+    uint64_t guid;
+    uint32_t ticket;
+    std::vector<uint64_t> queues;                          ///< Entries of the formed group, empty if no group was found
+    LfgDungeonMask dungeons;                               ///< Dungeons every member of the formed group can enter
+};
+
+struct LfgMatchQueue
+{
+    uint8_t queueId;
+    std::vector<uint16_t> newSlots;                        ///< Indices into LfgMatchJob::entries
+    std::vector<uint16_t> currentSlots;
+};
+
+// Sorted tickets of a set of queue entries, unused positions are 0
+struct LfgCompatibilityKey
+{
+    std::array<uint32_t, LFG_MATCH_GROUP_SIZE> tickets;
+
+    bool operator==(LfgCompatibilityKey const& other) const { return tickets == other.tickets; }
+};
+
+struct LfgCompatibilityKeyHash
+{
+    size_t operator()(LfgCompatibilityKey const& key) const;
+};
+
+class LfgMatchJob
+{
+    friend class LfgMatcher;
+
+public:
+    std::vector<LfgMatchEntry> entries;
+    std::vector<LfgMatchQueue> queues;
+    std::vector<uint32_t> removedTickets;                  ///< Tickets which left the queue since the last job
+    std::vector<LfgCompatibilityKey> incompatibleSets;     ///< Found groups the world thread could not turn into a proposal
+    std::chrono::milliseconds timeBudget{ 0 };
+
+    // results, valid once isDone() returned true
+    std::vector<LfgMatchOutcome> outcomes;                 ///< In the order the world thread has to apply them
+    std::vector<LfgRolesNeeded> rolesNeeded;               ///< Indexed like entries
+    bool budgetExceeded = false;
+    uint64_t duration = 0;                                 ///< us
+
+    bool isDone() const { return m_done.load(std::memory_order_acquire); }
+
+private:
+    std::atomic<bool> m_done{ false };
+};
+
+// Finds groups for the dungeon finder queue on a worker thread.
+// LfgMgr hands over a copy of the queues and applies the found groups on a later world update,
+// the compatibility cache is only used by the worker.
+class LfgMatcher
+{
+public:
+    LfgMatcher();
+    ~LfgMatcher();
+
+    void initialize();
+    void finalize();
+
+    // a job was submitted and its result was not taken yet
+    bool isBusy() const { return m_job != nullptr; }
+
+    void submit(std::unique_ptr<LfgMatchJob> job);
+
+    // returns the submitted job once the worker is done with it
+    std::unique_ptr<LfgMatchJob> takeFinishedJob();
+
+    static LfgRoleMask getPlayerRoleMask(uint8_t roles);
+    static LfgRoleMask combineRoleMasks(LfgRoleMask first, LfgRoleMask second);
+
+    // count has to be at most LFG_MATCH_GROUP_SIZE
+    static LfgCompatibilityKey makeKey(uint32_t const* tickets, uint8_t count);
+
+private:
+    // one job over a queue of 2000 players stores about 330k answers, a smaller cache is cleared before the next job uses it
+    static constexpr size_t MAX_CACHED_ANSWERS = 500000;
+
+    void run(LfgMatchJob& job);
+    void matchQueue(LfgMatchJob& job, LfgMatchQueue const& queue, std::vector<bool>& matched, std::chrono::steady_clock::time_point deadline);
+    bool checkCompatibility(LfgMatchJob& job, uint16_t const* slots, uint8_t count);
+    void updateRolesNeeded(LfgMatchJob& job, uint16_t const* slots, uint8_t count);
+    void removeTickets(std::vector<uint32_t> const& tickets);
+
+    static LfgCompatibilityKey makeKey(LfgMatchJob const& job, uint16_t const* slots, uint8_t count);
+
+    std::unique_ptr<AscEmu::Threading::AEWorkerPool> m_workerPool;
+    std::unique_ptr<LfgMatchJob> m_job;
+
+    std::unordered_map<LfgCompatibilityKey, bool, LfgCompatibilityKeyHash> m_compatibleMap;
+};
@@ -48,6 +48,9 @@ void LfgMgr::initialize()
         m_NumWaitTimeTank = 0;
         m_NumWaitTimeHealer = 0;
         m_NumWaitTimeDps = 0;
+        m_nextQueueTicket = 1;
+
+        m_matcher.initialize();
 
 #if VERSION_STRING < Cata
         // Initialize dungeon cache
@@ -66,6 +69,8 @@ void LfgMgr::initialize()
 
 void LfgMgr::finalize()
 {
+    m_matcher.finalize();
+
     for (LfgRewardMap::iterator itr = m_RewardMap.begin(); itr != m_RewardMap.end(); ++itr)
     {
         delete itr->second;
@@ -243,74 +248,15 @@ void LfgMgr::Update(uint32 diff)
         }
     }
 
+    // Groups found by the matcher since the last update, the queues may have changed in the meantime
+    if (std::unique_ptr<LfgMatchJob> job = m_matcher.takeFinishedJob())
+        ApplyMatchJob(*job);
+
     // Check if a proposal can be formed with the new groups being added
-    for (LfgGuidListMap::iterator it = m_newToQueue.begin(); it != m_newToQueue.end(); ++it)
+    if (!m_matcher.isBusy())
     {
-        uint8 queueId = it->first;
-        LfgGuidList& newToQueue = it->second;
-        LfgGuidList& currentQueue = m_currentQueue[queueId];
-        LfgGuidList firstNew;
-        while (!newToQueue.empty())
-        {
-            uint64 frontguid = newToQueue.front();
-            sLogger.debug("Update: QueueId %u: checking %u newToQueue(%u), currentQueue(%u)", queueId, frontguid, uint32(newToQueue.size()), uint32(currentQueue.size()));
-            firstNew.push_back(frontguid);
-            newToQueue.pop_front();
-
-            LfgGuidList temporalList = currentQueue;
-            if (LfgProposal* pProposal = FindNewGroups(firstNew, temporalList)) // Group found!
-            {
-                // Remove groups in the proposal from new and current queues (not from queue map)
-                for (LfgGuidList::const_iterator itQueue = pProposal->queues.begin(); itQueue != pProposal->queues.end(); ++itQueue)
-                {
-                    currentQueue.remove(*itQueue);
-                    newToQueue.remove(*itQueue);
-                }
-
-                m_Proposals[++m_lfgProposalId] = pProposal;
-
-                uint64 guid = 0;
-                for (LfgProposalPlayerMap::const_iterator itPlayers = pProposal->players.begin(); itPlayers != pProposal->players.end(); ++itPlayers)
-                {
-                    guid = itPlayers->first;
-                    SetState(guid, LFG_STATE_PROPOSAL);
-
-                    WoWGuid wowGuid;
-                    wowGuid.Init(itPlayers->first);
-
-                    if (Player* player = sObjectMgr.GetPlayer(wowGuid.getGuidLowPart()))
-                    {
-                        Group* grp = player->getGroup();
-                        if (grp)
-                        {
-                            uint64 gguid = grp->GetGUID();
-                            SetState(gguid, LFG_STATE_PROPOSAL);
-                            player->GetSession()->sendLfgUpdateParty(LfgUpdateData(LFG_UPDATETYPE_PROPOSAL_BEGIN, GetSelectedDungeons(guid), GetComment(guid)));
-                        }
-                        else
-                        {
-                            player->GetSession()->sendLfgUpdatePlayer(LfgUpdateData(LFG_UPDATETYPE_PROPOSAL_BEGIN, GetSelectedDungeons(guid), GetComment(guid)));
-                        }
-
-                        player->GetSession()->sendLfgUpdateProposal(m_lfgProposalId, pProposal);
-                    }
-                }
-
-                if (pProposal->state == LFG_PROPOSAL_SUCCESS)
-                {
-                    UpdateProposal(m_lfgProposalId, guid, true);
-                }
-            }
-            else
-            {
-                if (std::find(currentQueue.begin(), currentQueue.end(), frontguid) == currentQueue.end()) //already in queue?
-                {
-                    currentQueue.push_back(frontguid);         // Lfg group not found, add this group to the queue.
-                }
-            }
-
-            firstNew.clear();
-        }
+        if (std::unique_ptr<LfgMatchJob> job = CreateMatchJob())
+            m_matcher.submit(std::move(job));
     }
 
     // Update all players status queue info
@@ -404,11 +350,12 @@ bool LfgMgr::RemoveFromQueue(uint64 guid)
         it->second.remove(guid);
     }
 
-    RemoveFromCompatibles(guid);
-
     LfgQueueInfoMap::iterator it = m_QueueInfoMap.find(guid);
     if (it != m_QueueInfoMap.end())
     {
+        // Cached compatibilities of the entry are removed by the matcher
+        m_removedTickets.push_back(it->second->ticket);
+
         delete it->second;
         m_QueueInfoMap.erase(it);
         sLogger.debug("%u removed", guid);
@@ -717,6 +664,7 @@ void LfgMgr::Join(Player* player, uint8 roles, const LfgDungeonSet& selectedDung
         // Queue player
         LfgQueueInfo* pqInfo = new LfgQueueInfo();
         pqInfo->joinTime = time_t(time(NULL));
+        pqInfo->ticket = m_nextQueueTicket++;
         pqInfo->roles[player->getGuid()] = roles;
         pqInfo->dungeons = dungeons;
         if (roles & ROLE_TANK)
@@ -840,144 +788,253 @@ void LfgMgr::OfferContinue(Group* grp)
     }
 }
 
-LfgProposal* LfgMgr::FindNewGroups(LfgGuidList& check, LfgGuidList& all)
+std::unique_ptr<LfgMatchJob> LfgMgr::CreateMatchJob()
 {
-    sLogger.debug("(%s) - all(%s)", ConcatenateGuids(check).c_str(), ConcatenateGuids(all).c_str());
+    bool hasNewEntries = false;
+    for (LfgGuidListMap::const_iterator it = m_newToQueue.begin(); it != m_newToQueue.end() && !hasNewEntries; ++it)
+        hasNewEntries = !it->second.empty();
 
-    LfgProposal* pProposal = nullptr;
-    if (check.empty() || check.size() > 5 || !CheckCompatibility(check, pProposal))
-    {
+    if (!hasNewEntries)
         return nullptr;
-    }
 
-    // Try to match with queued groups
-    while (!pProposal && !all.empty())
-    {
-        check.push_back(all.front());
-        all.pop_front();
-        pProposal = FindNewGroups(check, all);
-        check.pop_back();
-    }
-    return pProposal;
-}
+    std::unique_ptr<LfgMatchJob> job = std::make_unique<LfgMatchJob>();
+    job->timeBudget = std::chrono::milliseconds(worldConfig.performance.lfgMatchTimeBudget);
 
-bool LfgMgr::CheckCompatibility(LfgGuidList check, LfgProposal*& pProposal)
-{
-    if (pProposal)                                         // Do not check anything if we already have a proposal
+    std::unordered_map<uint64, int32> slots;               // -1 for entries which are listed but not queued
+    std::vector<uint64> notQueued;
+
+    // Copies everything the matcher needs to know about a queue entry and returns its slot in the job
+    const auto getSlot = [this, &job, &slots, &notQueued](uint64 guid) -> int32
     {
-        return false;
-    }
+        const auto itSlot = slots.find(guid);
+        if (itSlot != slots.end())
+            return itSlot->second;
 
-    std::string strGuids = ConcatenateGuids(check);
+        LfgQueueInfoMap::const_iterator itQueue = m_QueueInfoMap.find(guid);
+        if (itQueue == m_QueueInfoMap.end() || !itQueue->second || GetState(guid) != LFG_STATE_QUEUED || job->entries.size() > UINT16_MAX)
+        {
+            sLogger.debug("%u is not queued but listed as queued!", guid);
+            notQueued.push_back(guid);
+            slots[guid] = -1;
+            return -1;
+        }
 
-    if (check.size() > 5 || check.empty())
-    {
-        sLogger.debug("(%s): Size wrong - Not compatibles", strGuids.c_str());
-        return false;
-    }
+        const LfgQueueInfo* queue = itQueue->second;
+
+        LfgMatchEntry entry;
+        entry.guid = guid;
+        entry.ticket = queue->ticket;
+        entry.playerCount = static_cast<uint8>(std::min<size_t>(queue->roles.size(), UINT8_MAX));
+        entry.isOnline = true;
+        entry.roleMask = LFG_EMPTY_ROLE_MASK;
+
+        for (LfgDungeonSet::const_iterator itDungeon = queue->dungeons.begin(); itDungeon != queue->dungeons.end(); ++itDungeon)
+            if (*itDungeon < MAX_DUNGEONS)
+                entry.dungeons.set(*itDungeon);
 
-    if (check.size() == 1)
-    {
         WoWGuid wowGuid;
-        wowGuid.Init(check.front());
+        wowGuid.Init(guid);
 
-        if (wowGuid.isPlayer())
+        entry.isGroup = wowGuid.isGroup();
+        entry.isLfgGroup = false;
+        if (entry.isGroup)
         {
-            return true;
+            if (Group* grp = sObjectMgr.GetGroupById(wowGuid.getGuidLowPart()))
+                entry.isLfgGroup = grp->isLFGGroup();
         }
+
+        uint8 numPlayers = 0;
+        for (LfgRolesMap::const_iterator itRoles = queue->roles.begin(); itRoles != queue->roles.end(); ++itRoles)
+        {
+            if (numPlayers < LFG_MATCH_GROUP_SIZE)
+            {
+                entry.players[numPlayers].guid = itRoles->first;
+                entry.players[numPlayers].roles = itRoles->second;
+                ++numPlayers;
+            }
+
+            entry.roleMask = LfgMatcher::combineRoleMasks(entry.roleMask, LfgMatcher::getPlayerRoleMask(itRoles->second));
+
+            WoWGuid playerGuid;
+            playerGuid.Init(itRoles->first);
+
+            if (!sObjectMgr.GetPlayer(playerGuid.getGuidLowPart()))
+                entry.isOnline = false;
+
+            const LfgLockMap& lockMap = GetLockedDungeons(itRoles->first);
+            for (LfgLockMap::const_iterator itLock = lockMap.begin(); itLock != lockMap.end(); ++itLock)
+            {
+                uint32 dungeonId = (itLock->first & 0x00FFFFFF); // Compare dungeon ids
+                if (dungeonId < MAX_DUNGEONS)
+                    entry.dungeons.reset(dungeonId);
+            }
+        }
+
+        const int32 slot = static_cast<int32>(job->entries.size());
+        job->entries.push_back(entry);
+        slots[guid] = slot;
+        return slot;
+    };
+
+    for (LfgGuidListMap::const_iterator it = m_newToQueue.begin(); it != m_newToQueue.end(); ++it)
+    {
+        if (it->second.empty())
+            continue;
+
+        LfgMatchQueue queue;
+        queue.queueId = it->first;
+
+        for (LfgGuidList::const_iterator itGuid = it->second.begin(); itGuid != it->second.end(); ++itGuid)
+        {
+            const int32 slot = getSlot(*itGuid);
+            if (slot >= 0)
+                queue.newSlots.push_back(static_cast<uint16>(slot));
+        }
+
+        const LfgGuidList& currentQueue = m_currentQueue[it->first];
+        for (LfgGuidList::const_iterator itGuid = currentQueue.begin(); itGuid != currentQueue.end(); ++itGuid)
+        {
+            const int32 slot = getSlot(*itGuid);
+            if (slot >= 0)
+                queue.currentSlots.push_back(static_cast<uint16>(slot));
+        }
+
+        job->queues.push_back(std::move(queue));
     }
 
-    // Previously cached?
-    LfgAnswer answer = GetCompatibles(strGuids);
-    if (answer != LFG_ANSWER_PENDING)
+    for (std::vector<uint64>::const_iterator it = notQueued.begin(); it != notQueued.end(); ++it)
+        RemoveFromQueue(*it);
+
+    job->removedTickets.swap(m_removedTickets);
+    job->incompatibleSets.swap(m_incompatibleSets);
+
+    return job;
+}
+
+void LfgMgr::ApplyMatchJob(LfgMatchJob& job)
+{
+    sLogger.debug("Matcher checked %u of %u queue entries in %llu us", uint32(job.outcomes.size()), uint32(job.entries.size()), static_cast<unsigned long long>(job.duration));
+
+    for (size_t i = 0; i < job.entries.size(); ++i)
     {
-        sLogger.debug("(%s) compatibles (cached): %d", strGuids.c_str(), answer);
-        return answer == LFG_ANSWER_AGREE ? true : false;
+        const LfgRolesNeeded& rolesNeeded = job.rolesNeeded[i];
+        if (!rolesNeeded.isSet)
+            continue;
+
+        LfgQueueInfoMap::iterator itQueue = m_QueueInfoMap.find(job.entries[i].guid);
+        if (itQueue == m_QueueInfoMap.end() || itQueue->second->ticket != job.entries[i].ticket)
+            continue;
+
+        itQueue->second->tanks = rolesNeeded.tanks;
+        itQueue->second->healers = rolesNeeded.healers;
+        itQueue->second->dps = rolesNeeded.dps;
     }
 
-    // Check all but new compatiblitity
-    if (check.size() > 2)
+    for (std::vector<LfgMatchOutcome>::const_iterator itOutcome = job.outcomes.begin(); itOutcome != job.outcomes.end(); ++itOutcome)
     {
-        uint64 frontGuid = check.front();
-        check.pop_front();
+        const LfgMatchOutcome& outcome = *itOutcome;
+        uint8 queueId = outcome.queueId;
+        LfgGuidList& newToQueue = m_newToQueue[queueId];
+        LfgGuidList& currentQueue = m_currentQueue[queueId];
+
+        // Left (and maybe joined again) while the matcher was running
+        LfgQueueInfoMap::const_iterator itQueue = m_QueueInfoMap.find(outcome.guid);
+        if (itQueue == m_QueueInfoMap.end() || itQueue->second->ticket != outcome.ticket)
+            continue;
 
-        // Check all-but-new compatibilities (New, A, B, C, D) --> check(A, B, C, D)
-        if (!CheckCompatibility(check, pProposal))          // Group not compatible
+        newToQueue.remove(outcome.guid);
+
+        if (outcome.queues.empty())
         {
-            sLogger.debug("(%s) not compatibles (%s not compatibles)", strGuids.c_str(), ConcatenateGuids(check).c_str());
-            SetCompatibles(strGuids, false);
-            return false;
+            if (std::find(currentQueue.begin(), currentQueue.end(), outcome.guid) == currentQueue.end()) //already in queue?
+            {
+                currentQueue.push_back(outcome.guid);         // Lfg group not found, add this group to the queue.
+            }
+
+            continue;
         }
-        check.push_front(frontGuid);
-        // all-but-new compatibles, now check with new
-    }
 
-    uint8 numPlayers = 0;
-    uint8 numLfgGroups = 0;
-    uint32 groupLowGuid = 0;
-    LfgQueueInfoMap pqInfoMap;
-    for (LfgGuidList::const_iterator it = check.begin(); it != check.end() && numLfgGroups < 2 && numPlayers <= 5; ++it)
-    {
-        uint64 guid = (*it);
-        LfgQueueInfoMap::iterator itQueue = m_QueueInfoMap.find(guid);
-        if (itQueue == m_QueueInfoMap.end() || GetState(guid) != LFG_STATE_QUEUED)
+        LfgProposal* pProposal = CreateProposal(outcome);
+        if (!pProposal)
         {
-            sLogger.debug("%u is not queued but listed as queued!", (*it));
-            RemoveFromQueue(guid);
-            return false;
+            // A member of the group changed since the queues were copied or the group does not fit,
+            // check again with the next job. Groups which do not fit are not found again, see SetIncompatibles
+            AddToQueue(outcome.guid, queueId);
+            continue;
         }
-        pqInfoMap[guid] = itQueue->second;
-        numPlayers += static_cast<uint8>(itQueue->second->roles.size());
 
-        WoWGuid wowGuid;
-        wowGuid.Init(guid);
+        // Remove groups in the proposal from new and current queues (not from queue map)
+        for (LfgGuidList::const_iterator itQueueGuid = pProposal->queues.begin(); itQueueGuid != pProposal->queues.end(); ++itQueueGuid)
+        {
+            currentQueue.remove(*itQueueGuid);
+            newToQueue.remove(*itQueueGuid);
+        }
 
-        if (wowGuid.isGroup())
+        m_Proposals[++m_lfgProposalId] = pProposal;
+
+        uint64 guid = 0;
+        for (LfgProposalPlayerMap::const_iterator itPlayers = pProposal->players.begin(); itPlayers != pProposal->players.end(); ++itPlayers)
         {
-            uint32 lowGuid = wowGuid.getGuidLowPart();
-            if (Group* grp = sObjectMgr.GetGroupById(lowGuid))  //MAy Check these
+            guid = itPlayers->first;
+            SetState(guid, LFG_STATE_PROPOSAL);
+
+            WoWGuid wowGuid;
+            wowGuid.Init(itPlayers->first);
+
+            if (Player* player = sObjectMgr.GetPlayer(wowGuid.getGuidLowPart()))
             {
-                if (grp->isLFGGroup())
+                Group* grp = player->getGroup();
+                if (grp)
                 {
-                    if (!numLfgGroups)
-                    {
-                        groupLowGuid = lowGuid;
-                    }
-
-                    ++numLfgGroups;
+                    uint64 gguid = grp->GetGUID();
+                    SetState(gguid, LFG_STATE_PROPOSAL);
+                    player->GetSession()->sendLfgUpdateParty(LfgUpdateData(LFG_UPDATETYPE_PROPOSAL_BEGIN, GetSelectedDungeons(guid), GetComment(guid)));
                 }
+                else
+                {
+                    player->GetSession()->sendLfgUpdatePlayer(LfgUpdateData(LFG_UPDATETYPE_PROPOSAL_BEGIN, GetSelectedDungeons(guid), GetComment(guid)));
+                }
+
+                player->GetSession()->sendLfgUpdateProposal(m_lfgProposalId, pProposal);
             }
         }
-    }
 
-    if (check.size() == 1 && numPlayers != 5)   // Single group with less than MAXGROUPSIZE - Compatibles
-    {
-        return true;
+        if (pProposal->state == LFG_PROPOSAL_SUCCESS)
+        {
+            UpdateProposal(m_lfgProposalId, guid, true);
+        }
     }
+}
 
-    // Do not match - groups already in a lfgDungeon or too much players
-    if (numLfgGroups > 1 || numPlayers > 5)
+LfgProposal* LfgMgr::CreateProposal(const LfgMatchOutcome& outcome)
+{
+    uint32 groupLowGuid = 0;
+    LfgRolesMap rolesMap;
+    uint64 leader = 0;
+    for (std::vector<uint64>::const_iterator it = outcome.queues.begin(); it != outcome.queues.end(); ++it)
     {
-        SetCompatibles(strGuids, false);
-        if (numLfgGroups > 1)
+        uint64 guid = (*it);
+        LfgQueueInfoMap::const_iterator itQueue = m_QueueInfoMap.find(guid);
+        if (itQueue == m_QueueInfoMap.end() || GetState(guid) != LFG_STATE_QUEUED)
         {
-            sLogger.debug("(%s) More than one Lfggroup (%u)", strGuids.c_str(), numLfgGroups);
+            sLogger.debug("%u left the queue before the proposal was created", guid);
+            return nullptr;
         }
-        else
+
+        WoWGuid wowGuid;
+        wowGuid.Init(guid);
+
+        if (wowGuid.isGroup() && !groupLowGuid)
         {
-            sLogger.debug("(%s) Too much players (%u)", strGuids.c_str(), numPlayers);
+            uint32 lowGuid = wowGuid.getGuidLowPart();
+            if (Group* grp = sObjectMgr.GetGroupById(lowGuid))
+            {
+                if (grp->isLFGGroup())
+                    groupLowGuid = lowGuid;
+            }
         }
 
-        return false;
-    }
-
-    //////////////////////////////////////////////////////////////////////////////////////////
-    // Player checks
-    LfgRolesMap rolesMap;
-    uint64 leader = 0;
-    for (LfgQueueInfoMap::const_iterator it = pqInfoMap.begin(); it != pqInfoMap.end(); ++it)
-    {
-        for (LfgRolesMap::const_iterator itRoles = it->second->roles.begin(); itRoles != it->second->roles.end(); ++itRoles)
+        for (LfgRolesMap::const_iterator itRoles = itQueue->second->roles.begin(); itRoles != itQueue->second->roles.end(); ++itRoles)
         {
             // Assign new leader
             if (itRoles->second & ROLE_LEADER && (!leader || Util::getRandomUInt(1)))
@@ -989,145 +1046,58 @@ bool LfgMgr::CheckCompatibility(LfgGuidList check, LfgProposal*& pProposal)
         }
     }
 
-    if (rolesMap.size() != numPlayers)                     // Player in multiples queues!
-        return false;
-
     PlayerSet players;
     for (LfgRolesMap::const_iterator it = rolesMap.begin(); it != rolesMap.end(); ++it)
     {
         WoWGuid wowGuid;
         wowGuid.Init(it->first);
 
-        if (Player* player = sObjectMgr.GetPlayer(wowGuid.getGuidLowPart()))
-        {
-            //for (PlayerSet::const_iterator itPlayer = players.begin(); itPlayer != players.end() && player; ++itPlayer)
-            //{
-            //    // Do not form a group with ignoring candidates
-            //}
-
-            players.insert(player);
-        }
-        else
+        Player* player = sObjectMgr.GetPlayer(wowGuid.getGuidLowPart());
+        if (!player)
         {
-            sLogger.debug("(%s) Warning! %u offline! Marking as not compatibles!", strGuids.c_str(), it->first);
+            sLogger.debug("%u went offline before the proposal was created, marking the group as not compatible", it->first);
+            SetIncompatibles(outcome);
+            return nullptr;
         }
+
+        players.insert(player);
     }
 
-    // if we dont have the same ammount of players then we have self ignoring candidates or different faction groups
-    // otherwise check if roles are compatible
-    if (players.size() != numPlayers || !CheckGroupRoles(rolesMap))
+    // The matcher only knows that the roles fit, CheckGroupRoles picks one role for each player
+    if (players.size() != LFG_MATCH_GROUP_SIZE || !CheckGroupRoles(rolesMap))
     {
-        if (players.size() == numPlayers)
-        {
-            sLogger.debug("(%s) Roles not compatible", strGuids.c_str());
-        }
-
-        SetCompatibles(strGuids, false);
-        return false;
+        SetIncompatibles(outcome);
+        return nullptr;
     }
-    //////////////////////////////////////////////////////////////////////////////////////////
-    // Selected Dungeon checks
-    // Check if there are any compatible dungeon from the selected dungeons
-    LfgDungeonSet compatibleDungeons;
 
-    LfgQueueInfoMap::const_iterator itFirst = pqInfoMap.begin();
-    for (LfgDungeonSet::const_iterator itDungeon = itFirst->second->dungeons.begin(); itDungeon != itFirst->second->dungeons.end(); ++itDungeon)
+    LfgDungeonSet compatibleDungeons;
+    for (uint32 dungeonId = 0; dungeonId < MAX_DUNGEONS; ++dungeonId)
     {
-        LfgQueueInfoMap::const_iterator itOther = itFirst;
-        ++itOther;
-        while (itOther != pqInfoMap.end() && itOther->second->dungeons.find(*itDungeon) != itOther->second->dungeons.end())
-        {
-            ++itOther;
-        }
-
-        if (itOther == pqInfoMap.end())
-        {
-            compatibleDungeons.insert(*itDungeon);
-        }
+        if (outcome.dungeons.test(dungeonId))
+            compatibleDungeons.insert(dungeonId);
     }
-    LfgLockPartyMap lockMap;
-    GetCompatibleDungeons(compatibleDungeons, players, lockMap);
 
     if (compatibleDungeons.empty())
     {
-        SetCompatibles(strGuids, false);
-        return false;
+        SetIncompatibles(outcome);
+        return nullptr;
     }
-    SetCompatibles(strGuids, true);
-
-    //////////////////////////////////////////////////////////////////////////////////////////
-    // Group is compatible, if we have MAXGROUPSIZE members then match is found
-    if (numPlayers != 5)
-    {
-        sLogger.debug("(%s) Compatibles but not match. Players(%u)", strGuids.c_str(), numPlayers);
-        uint8 Tanks_Needed = LFG_TANKS_NEEDED;
-        uint8 Healers_Needed = LFG_HEALERS_NEEDED;
-        uint8 Dps_Needed = LFG_DPS_NEEDED;
-        for (LfgQueueInfoMap::const_iterator itQueue = pqInfoMap.begin(); itQueue != pqInfoMap.end(); ++itQueue)
-        {
-            LfgQueueInfo* queue = itQueue->second;
-            for (LfgRolesMap::const_iterator itPlayer = queue->roles.begin(); itPlayer != queue->roles.end(); ++itPlayer)
-            {
-                uint8 roles = itPlayer->second;
-                if ((roles & ROLE_TANK) && Tanks_Needed > 0)
-                    --Tanks_Needed;
-                else if ((roles & ROLE_HEALER) && Healers_Needed > 0)
-                    --Healers_Needed;
-                else if ((roles & ROLE_DAMAGE) && Dps_Needed > 0)
-                    --Dps_Needed;
-            }
-        }
-        for (PlayerSet::const_iterator itPlayers = players.begin(); itPlayers != players.end(); ++itPlayers)
-        {
-            for (LfgQueueInfoMap::const_iterator itQueue = pqInfoMap.begin(); itQueue != pqInfoMap.end(); ++itQueue)
-            {
-                LfgQueueInfo* queue = itQueue->second;
-                if (!queue)
-                    continue;
 
-                for (LfgRolesMap::const_iterator itPlayer = queue->roles.begin(); itPlayer != queue->roles.end(); ++itPlayer)
-                {
-                    WoWGuid wowGuid;
-                    wowGuid.Init(itPlayer->first);
-
-                    if (*itPlayers == sObjectMgr.GetPlayer(wowGuid.getGuidLowPart()))
-                    {
-                        queue->tanks = Tanks_Needed;
-                        queue->healers = Healers_Needed;
-                        queue->dps = Dps_Needed;
-                    }
-                }
-            }
-        }
-        return true;
-    }
-    sLogger.debug("(%s) MATCH! Group formed", strGuids.c_str());
+    sLogger.debug("%u MATCH! Group formed", outcome.guid);
 
     // GROUP FORMED!
 
     // Select a random dungeon from the compatible list
     // Create a new proposal
-    pProposal = new LfgProposal(SelectRandomContainerElement(compatibleDungeons));
+    LfgProposal* pProposal = new LfgProposal(SelectRandomContainerElement(compatibleDungeons));
     pProposal->cancelTime = time_t(time(NULL)) + LFG_TIME_PROPOSAL;
     pProposal->state = LFG_PROPOSAL_INITIATING;
-    pProposal->queues = check;
+    pProposal->queues.assign(outcome.queues.begin(), outcome.queues.end());
     pProposal->groupLowGuid = groupLowGuid;
-
-    // Assign new roles to players and assign new leader
-    PlayerSet::const_iterator itPlayers = players.begin();
-    /*
-    if (!leader)
-    {
-    uint8 pos = 1;
-    for (uint8 i = 0; i < pos; ++i)
-    ++itPlayers;
-    leader = (*itPlayers)->GetGUID();
-    }
-    */
     pProposal->leader = leader;
 
     uint8 numAccept = 0;
-    for (itPlayers = players.begin(); itPlayers != players.end(); ++itPlayers)
+    for (PlayerSet::const_iterator itPlayers = players.begin(); itPlayers != players.end(); ++itPlayers)
     {
         uint64 guid = (*itPlayers)->getGuid();
         LfgProposalPlayer* ppPlayer = new LfgProposalPlayer();
@@ -1146,7 +1116,26 @@ bool LfgMgr::CheckCompatibility(LfgGuidList check, LfgProposal*& pProposal)
     if (numAccept == 5)
         pProposal->state = LFG_PROPOSAL_SUCCESS;
 
-    return true;
+    return pProposal;
+}
+
+// Without it the matcher would find the same group again with the next job
+void LfgMgr::SetIncompatibles(const LfgMatchOutcome& outcome)
+{
+    if (outcome.queues.size() > LFG_MATCH_GROUP_SIZE)
+        return;
+
+    uint32 tickets[LFG_MATCH_GROUP_SIZE];
+    for (size_t i = 0; i < outcome.queues.size(); ++i)
+    {
+        LfgQueueInfoMap::const_iterator itQueue = m_QueueInfoMap.find(outcome.queues[i]);
+        if (itQueue == m_QueueInfoMap.end())
+            return;
+
+        tickets[i] = itQueue->second->ticket;
+    }
+
+    m_incompatibleSets.push_back(LfgMatcher::makeKey(tickets, static_cast<uint8>(outcome.queues.size())));
 }
 
 void LfgMgr::UpdateRoleCheck(uint64 gguid, uint64 guid /* = 0 */, uint8 roles /* = ROLE_NONE */)
@@ -1235,6 +1224,7 @@ void LfgMgr::UpdateRoleCheck(uint64 gguid, uint64 guid /* = 0 */, uint8 roles /*
         SetState(gguid, LFG_STATE_QUEUED);
         LfgQueueInfo* pqInfo = new LfgQueueInfo();
         pqInfo->joinTime = time_t(time(NULL));
+        pqInfo->ticket = m_nextQueueTicket++;
         pqInfo->roles = roleCheck->roles;
         pqInfo->dungeons = roleCheck->dungeons;
 
@@ -1268,36 +1258,6 @@ void LfgMgr::UpdateRoleCheck(uint64 gguid, uint64 guid /* = 0 */, uint8 roles /*
     }
 }
 
-void LfgMgr::RemoveFromCompatibles(uint64 guid)
-{
-    std::stringstream out;
-    out << guid;
-    std::string strGuid = out.str();
-
-    sLogger.debug("Removing %u", guid);
-    for (LfgCompatibleMap::iterator itNext = m_CompatibleMap.begin(); itNext != m_CompatibleMap.end();)
-    {
-        LfgCompatibleMap::iterator it = itNext++;
-        if (it->first.find(strGuid) != std::string::npos)  // Found, remove it
-            m_CompatibleMap.erase(it);
-    }
-}
-
-void LfgMgr::SetCompatibles(std::string key, bool compatibles)
-{
-    m_CompatibleMap[key] = LfgAnswer(compatibles);
-}
-
-LfgAnswer LfgMgr::GetCompatibles(std::string key)
-{
-    LfgAnswer answer = LFG_ANSWER_PENDING;
-    LfgCompatibleMap::iterator it = m_CompatibleMap.find(key);
-    if (it != m_CompatibleMap.end())
-        answer = it->second;
-
-    return answer;
-}
-
 void LfgMgr::GetCompatibleDungeons(LfgDungeonSet& dungeons, const PlayerSet& players, LfgLockPartyMap& lockMap)
 {
     lockMap.clear();
@@ -2201,19 +2161,6 @@ LfgType LfgMgr::GetDungeonType(uint32 dungeonId)
 #endif
 }
 
-std::string LfgMgr::ConcatenateGuids(LfgGuidList check)
-{
-    if (check.empty())
-        return "";
-
-    std::ostringstream o;
-    LfgGuidList::const_iterator it = check.begin();
-    o << (*it);
-    for (++it; it != check.end(); ++it)
-        o << '|' << (*it);
-    return o.str();
-}
-
 LfgState LfgMgr::GetState(uint64 guid)
 {
     sLogger.debug("%u", guid);
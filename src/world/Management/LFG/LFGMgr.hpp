@@ -6,6 +6,7 @@ This file is released under the MIT license. See README-MIT for more information
 #pragma once
 
 #include "LFG.hpp"
+#include "LFGMatcher.hpp"
 #include "Server/Definitions.h"
 #include <list>
 #include "Server/EventableObject.h"
@@ -123,7 +124,6 @@ typedef std::set<Player*> PlayerSet;
 typedef std::list<Player*> LfgPlayerList;
 typedef std::multimap<uint32, LfgReward const*> LfgRewardMap;
 typedef std::pair<LfgRewardMap::const_iterator, LfgRewardMap::const_iterator> LfgRewardMapBounds;
-typedef std::map<std::string, LfgAnswer> LfgCompatibleMap;
 typedef std::map<uint64, LfgDungeonSet> LfgDungeonMap;
 typedef std::map<uint64, uint8> LfgRolesMap;
 typedef std::map<uint64, LfgAnswer> LfgAnswerMap;
@@ -183,8 +183,9 @@ struct LfgReward
 /// Stores player or group queue info
 struct LfgQueueInfo
 {
-    LfgQueueInfo(): joinTime(0), tanks(LFG_TANKS_NEEDED), healers(LFG_HEALERS_NEEDED), dps(LFG_DPS_NEEDED) {};
+    LfgQueueInfo(): joinTime(0), ticket(0), tanks(LFG_TANKS_NEEDED), healers(LFG_HEALERS_NEEDED), dps(LFG_DPS_NEEDED) {};
     time_t joinTime;                                       ///< Player queue join time (to calculate wait times)
+    uint32 ticket;                                         ///< Compatibility cache id, unique while queued
     uint8 tanks;                                           ///< Tanks needed
     uint8 healers;                                         ///< Healers needed
     uint8 dps;                                             ///< Dps needed
@@ -323,18 +324,16 @@ class LfgMgr : EventableObject
         void RemoveProposal(LfgProposalMap::iterator itProposal, LfgUpdateType type);
 
         // Group Matching
-        LfgProposal* FindNewGroups(LfgGuidList& check, LfgGuidList& all);
+        std::unique_ptr<LfgMatchJob> CreateMatchJob();
+        void ApplyMatchJob(LfgMatchJob& job);
+        LfgProposal* CreateProposal(const LfgMatchOutcome& outcome);
+        void SetIncompatibles(const LfgMatchOutcome& outcome);
         bool CheckGroupRoles(LfgRolesMap &groles, bool removeLeaderFlag = true);
-        bool CheckCompatibility(LfgGuidList check, LfgProposal*& pProposal);
         void GetCompatibleDungeons(LfgDungeonSet& dungeons, const PlayerSet& players, LfgLockPartyMap& lockMap);
-        void SetCompatibles(std::string concatenatedGuids, bool compatibles);
-        LfgAnswer GetCompatibles(std::string concatenatedGuids);
-        void RemoveFromCompatibles(uint64 guid);
 
         // Generic
         const LfgDungeonSet& GetDungeonsByRandom(uint32 randomdungeon);
         LfgType GetDungeonType(uint32 dungeon);
-        std::string ConcatenateGuids(LfgGuidList check);
 
         // General variables
         bool m_update;                                     ///< Doing an update?
@@ -355,7 +354,10 @@ class LfgMgr : EventableObject
         LfgQueueInfoMap m_QueueInfoMap;                    ///< Queued groups
         LfgGuidListMap m_currentQueue;                     ///< Ordered list. Used to find groups
         LfgGuidListMap m_newToQueue;                       ///< New groups to add to queue
-        LfgCompatibleMap m_CompatibleMap;                  ///< Compatible dungeons
+        LfgMatcher m_matcher;                              ///< Finds groups on its own thread
+        uint32 m_nextQueueTicket;                          ///< Next LfgQueueInfo::ticket
+        std::vector<uint32> m_removedTickets;              ///< Tickets left the queue, removed from the compatibility cache by the next match job
+        std::vector<LfgCompatibilityKey> m_incompatibleSets; ///< Found groups without proposal, cached as not compatible by the next match job
         LfgGuidList m_teleport;                            ///< Players being teleported
         // Rolecheck - Proposal - Vote Kicks
         LfgRoleCheckMap m_RoleChecks;                      ///< Current Role checks
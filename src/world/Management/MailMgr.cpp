@@ -78,13 +78,16 @@ void Mailbox::CleanupExpiredMessages()
 
 void MailSystem::SaveMessageToSQL(MailMessage* message)
 {
+    // a returned message gets a new id, so the rows of a message id always stay with one receiver
+    const uint32 shardKey = static_cast<uint32>(message->player_guid);
+
     std::stringstream ss;
 
     ss << "DELETE FROM mailbox WHERE message_id = ";
     ss << message->message_id;
     ss << ";";
 
-    CharacterDatabase.ExecuteNA(ss.str().c_str());
+    CharacterDatabase.ExecuteNA(shardKey, ss.str().c_str());
 
     ss.rdbuf()->str("");
 
@@ -109,7 +112,7 @@ void MailSystem::SaveMessageToSQL(MailMessage* message)
         << message->checked_flag << ","
         << message->deleted_flag << ");";
 
-    CharacterDatabase.ExecuteNA(ss.str().c_str());
+    CharacterDatabase.ExecuteNA(shardKey, ss.str().c_str());
 }
 
 void MailSystem::RemoveMessageIfDeleted(uint32 message_id, Player* plr)
@@ -78,9 +78,11 @@ void QuestLogEntry::loadFromDB(Field* fields)
     }
 
     m_state = fields[12].GetUInt32();
+
+    m_savedRowHash = std::hash<std::string>()(getSaveQuery());
 }
 
-void QuestLogEntry::saveToDB(QueryBuffer* queryBuffer)
+std::string QuestLogEntry::getSaveQuery() const
 {
     std::stringstream ss;
 
@@ -95,10 +97,25 @@ void QuestLogEntry::saveToDB(QueryBuffer* queryBuffer)
 
     ss << "," << m_state << ");";
 
+    return ss.str();
+}
+
+bool QuestLogEntry::saveToDB(QueryBuffer* queryBuffer)
+{
+    const std::string query = getSaveQuery();
+
+    // nothing changed since the entry was loaded or saved the last time
+    const size_t rowHash = std::hash<std::string>()(query);
+    if (rowHash == m_savedRowHash)
+        return false;
+
     if (queryBuffer == nullptr)
-        CharacterDatabase.Execute(ss.str().c_str());
+        CharacterDatabase.Execute(query.c_str());
     else
-        queryBuffer->AddQueryStr(ss.str());
+        queryBuffer->AddQueryStr(query);
+
+    m_savedRowHash = rowHash;
+    return true;
 }
 
 uint8_t QuestLogEntry::getSlot() const { return m_slot; }
@@ -31,7 +31,10 @@ public:
     void initPlayerData();
 
     void loadFromDB(Field* fields);
-    void saveToDB(QueryBuffer* queryBuffer);
+    // returns false if the entry did not change since it was loaded or saved
+    bool saveToDB(QueryBuffer* queryBuffer);
+    // the next saveToDB writes the entry even if it did not change
+    void clearSavedRow() { m_savedRowHash = 0; }
 
     uint8_t getSlot() const;
     void setSlot(uint8_t slot);
@@ -64,6 +67,10 @@ public:
 
 private:
 
+    std::string getSaveQuery() const;
+
+    size_t m_savedRowHash = 0;
+
     uint8_t m_slot = 0;
     uint32_t m_state = 0;
     uint32_t m_mobcount[4] = {0};
@@ -0,0 +1,288 @@
+/*
+Copyright (c) 2014-2021 AscEmu Team <http://www.ascemu.org>
+This file is released under the MIT license. See README-MIT for more information.
+*/
+
+#include "Management/WordMatcher.h"
+
+#include <algorithm>
+#include <deque>
+
+void WordMatcher::addWord(std::string const& word, std::string const& replacement)
+{
+    if (m_buildEdges.empty())
+    {
+        m_nodes.resize(1);
+        m_buildEdges.resize(1);
+    }
+
+    uint32_t node = 0;
+    uint32_t length = 0;
+
+    size_t position = 0;
+    while (position < word.size())
+    {
+        uint32_t codePoint;
+        position += readCodePoint(word, position, codePoint);
+        codePoint = foldCase(codePoint);
+        ++length;
+
+        const auto itr = m_buildEdges[node].find(codePoint);
+        if (itr != m_buildEdges[node].end())
+        {
+            node = itr->second;
+            continue;
+        }
+
+        const uint32_t nextNode = static_cast<uint32_t>(m_nodes.size());
+        m_nodes.emplace_back();
+        m_buildEdges.emplace_back();
+        m_buildEdges[node][codePoint] = nextNode;
+        node = nextNode;
+    }
+
+    // the first entry of a word wins, like the first match in the table did before
+    if (length == 0 || m_nodes[node].word != -1)
+        return;
+
+    m_nodes[node].word = static_cast<int32_t>(m_words.size());
+    m_nodes[node].hasBlockingWord = replacement.empty();
+    m_words.push_back({ replacement, length, replacement.empty() });
+}
+
+void WordMatcher::build()
+{
+    if (m_nodes.empty())
+        m_nodes.resize(1);
+
+    m_edges.clear();
+    for (size_t node = 0; node < m_buildEdges.size(); ++node)
+    {
+        m_nodes[node].firstEdge = static_cast<uint32_t>(m_edges.size());
+        m_nodes[node].edgeCount = static_cast<uint32_t>(m_buildEdges[node].size());
+
+        // std::map keeps them sorted for the binary search
+        for (const auto& edge : m_buildEdges[node])
+            m_edges.push_back({ edge.first, edge.second });
+    }
+
+    m_buildEdges.clear();
+    m_buildEdges.shrink_to_fit();
+
+    // breadth first, the failure node of a node is always less deep than the node
+    std::deque<uint32_t> queue;
+    for (uint32_t i = 0; i < m_nodes[0].edgeCount; ++i)
+        queue.push_back(m_edges[m_nodes[0].firstEdge + i].node);
+
+    while (!queue.empty())
+    {
+        const uint32_t node = queue.front();
+        queue.pop_front();
+
+        for (uint32_t i = 0; i < m_nodes[node].edgeCount; ++i)
+        {
+            const Edge edge = m_edges[m_nodes[node].firstEdge + i];
+
+            uint32_t failure = m_nodes[node].failure;
+            m_nodes[edge.node].failure = getNextNode(failure, edge.codePoint);
+
+            Node& child = m_nodes[edge.node];
+            Node const& failureNode = m_nodes[child.failure];
+            child.output = failureNode.word != -1 ? child.failure : failureNode.output;
+            child.hasBlockingWord = child.hasBlockingWord || failureNode.hasBlockingWord;
+
+            queue.push_back(edge.node);
+        }
+    }
+}
+
+bool WordMatcher::containsWord(std::string const& text) const
+{
+    if (m_words.empty())
+        return false;
+
+    uint32_t node = 0;
+    size_t position = 0;
+    while (position < text.size())
+    {
+        uint32_t codePoint;
+        position += readCodePoint(text, position, codePoint);
+
+        node = getNextNode(node, foldCase(codePoint));
+        if (m_nodes[node].word != -1 || m_nodes[node].output != 0)
+            return true;
+    }
+
+    return false;
+}
+
+bool WordMatcher::isBlockedOrReplaceWords(std::string& text) const
+{
+    if (m_words.empty())
+        return false;
+
+    struct Match
+    {
+        uint32_t start;                         // code points
+        uint32_t word;
+    };
+
+    std::vector<Match> matches;
+    std::vector<size_t> offsets;                // byte offset of each code point
+    offsets.reserve(text.size() + 1);
+
+    uint32_t node = 0;
+    size_t position = 0;
+    while (position < text.size())
+    {
+        offsets.push_back(position);
+
+        uint32_t codePoint;
+        position += readCodePoint(text, position, codePoint);
+
+        node = getNextNode(node, foldCase(codePoint));
+
+        Node const& current = m_nodes[node];
+        if (current.hasBlockingWord)
+            return true;
+
+        // every word ending here, shorter ones can still be replaced when the longest one overlaps an earlier match
+        const uint32_t end = static_cast<uint32_t>(offsets.size());
+        for (uint32_t wordNode = current.word != -1 ? node : current.output; wordNode != 0; wordNode = m_nodes[wordNode].output)
+        {
+            const int32_t word = m_nodes[wordNode].word;
+            matches.push_back({ end - m_words[word].length, static_cast<uint32_t>(word) });
+        }
+    }
+
+    if (matches.empty())
+        return false;
+
+    offsets.push_back(text.size());
+
+    std::sort(matches.begin(), matches.end(), [this](Match const& first, Match const& second)
+    {
+        if (first.start != second.start)
+            return first.start < second.start;
+
+        return m_words[first.word].length > m_words[second.word].length;
+    });
+
+    std::string result;
+    result.reserve(text.size());
+
+    uint32_t copiedUntil = 0;
+    for (const auto& match : matches)
+    {
+        if (match.start < copiedUntil)
+            continue;
+
+        result.append(text, offsets[copiedUntil], offsets[match.start] - offsets[copiedUntil]);
+        result.append(m_words[match.word].replacement);
+        copiedUntil = match.start + m_words[match.word].length;
+    }
+
+    result.append(text, offsets[copiedUntil], std::string::npos);
+    text.swap(result);
+
+    return false;
+}
+
+uint32_t WordMatcher::foldCase(uint32_t codePoint)
+{
+    // latin
+    if (codePoint >= 'A' && codePoint <= 'Z')
+        return codePoint + 32;
+
+    if (codePoint < 0xC0)
+        return codePoint;
+
+    // latin-1 supplement, without the multiplication sign
+    if (codePoint <= 0xDE && codePoint != 0xD7)
+        return codePoint + 32;
+
+    // greek, 0x3A2 is not assigned
+    if (codePoint >= 0x391 && codePoint <= 0x3A9 && codePoint != 0x3A2)
+        return codePoint + 32;
+
+    // cyrillic
+    if (codePoint >= 0x400 && codePoint <= 0x40F)
+        return codePoint + 80;
+
+    if (codePoint >= 0x410 && codePoint <= 0x42F)
+        return codePoint + 32;
+
+    return codePoint;
+}
+
+size_t WordMatcher::readCodePoint(std::string const& text, size_t position, uint32_t& codePoint)
+{
+    const uint8_t lead = static_cast<uint8_t>(text[position]);
+
+    size_t length;
+    if (lead < 0x80)
+    {
+        codePoint = lead;
+        return 1;
+    }
+
+    if ((lead & 0xE0) == 0xC0)
+    {
+        length = 2;
+        codePoint = lead & 0x1F;
+    }
+    else if ((lead & 0xF0) == 0xE0)
+    {
+        length = 3;
+        codePoint = lead & 0x0F;
+    }
+    else if ((lead & 0xF8) == 0xF0)
+    {
+        length = 4;
+        codePoint = lead & 0x07;
+    }
+    else
+    {
+        codePoint = lead;
+        return 1;
+    }
+
+    if (position + length > text.size())
+    {
+        codePoint = lead;
+        return 1;
+    }
+
+    for (size_t i = 1; i < length; ++i)
+    {
+        const uint8_t byte = static_cast<uint8_t>(text[position + i]);
+        if ((byte & 0xC0) != 0x80)
+        {
+            codePoint = lead;
+            return 1;
+        }
+
+        codePoint = (codePoint << 6) | (byte & 0x3F);
+    }
+
+    return length;
+}
+
+uint32_t WordMatcher::getNextNode(uint32_t node, uint32_t codePoint) const
+{
+    for (;;)
+    {
+        Node const& current = m_nodes[node];
+
+        const auto begin = m_edges.begin() + current.firstEdge;
+        const auto end = begin + current.edgeCount;
+        const auto edge = std::lower_bound(begin, end, codePoint, [](Edge const& edge, uint32_t value) { return edge.codePoint < value; });
+        if (edge != end && edge->codePoint == codePoint)
+            return edge->node;
+
+        if (node == 0)
+            return 0;
+
+        node = current.failure;
+    }
+}
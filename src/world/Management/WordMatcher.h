@@ -0,0 +1,72 @@
+/*
+Copyright (c) 2014-2021 AscEmu Team <http://www.ascemu.org>
+This file is released under the MIT license. See README-MIT for more information.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+// Finds all words of a filter table in one pass over a text (Aho-Corasick automaton).
+// Matching works on UTF-8 code points and ignores the case of latin, greek and cyrillic letters.
+// Built once when the table is loaded and not changed afterwards, so all map threads can use it without a lock.
+class WordMatcher
+{
+public:
+
+    // an empty replacement blocks the whole text
+    void addWord(std::string const& word, std::string const& replacement);
+
+    // has to be called after the last addWord
+    void build();
+
+    size_t getWordCount() const { return m_words.size(); }
+
+    bool containsWord(std::string const& text) const;
+
+    // Returns true when the text contains a blocking word. Otherwise every found word is replaced,
+    // a word starting earlier or a longer word at the same position wins over overlapping ones.
+    bool isBlockedOrReplaceWords(std::string& text) const;
+
+private:
+
+    struct Word
+    {
+        std::string replacement;
+        uint32_t length;                        // code points
+        bool isBlocking;
+    };
+
+    struct Node
+    {
+        uint32_t firstEdge = 0;
+        uint32_t edgeCount = 0;
+        uint32_t failure = 0;
+        uint32_t output = 0;                    // next node on the failure links with a word, 0 when there is none
+        int32_t word = -1;                      // word ending in this node
+        bool hasBlockingWord = false;           // any word ending in this node is blocking
+    };
+
+    struct Edge
+    {
+        uint32_t codePoint;
+        uint32_t node;
+    };
+
+    static uint32_t foldCase(uint32_t codePoint);
+
+    // invalid sequences are read as single bytes
+    static size_t readCodePoint(std::string const& text, size_t position, uint32_t& codePoint);
+
+    uint32_t getNextNode(uint32_t node, uint32_t codePoint) const;
+
+    std::vector<Word> m_words;
+    std::vector<Node> m_nodes;
+    std::vector<Edge> m_edges;                  // sorted by code point per node
+
+    // transitions while the words are added, cleared by build
+    std::vector<std::map<uint32_t, uint32_t>> m_buildEdges;
+};
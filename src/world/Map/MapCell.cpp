@@ -52,6 +52,7 @@ void MapCell::Init(uint32 x, uint32 y, MapMgr* mapmgr)
     _unloadpending = false;
     _objects.clear();
     objects_iterator = _objects.begin();
+    _ClearVisibilityArrays();
 }
 
 void MapCell::AddObject(Object* obj)
@@ -65,7 +66,15 @@ void MapCell::AddObject(Object* obj)
             CancelPendingUnload();
     }
 
-    _objects.insert(obj);
+    if (_objects.insert(obj).second)
+    {
+        obj->setMapCellVisibilityIndex(static_cast<uint32_t>(_visibilityObjects.size()));
+        _visibilityObjects.push_back(obj);
+        _visibilityPositionX.push_back(0.0f);
+        _visibilityPositionY.push_back(0.0f);
+        _visibilityUnlimited.push_back(0);
+        UpdateObjectPosition(obj);
+    }
 }
 
 void MapCell::RemoveObject(Object* obj)
@@ -78,7 +87,56 @@ void MapCell::RemoveObject(Object* obj)
     if (objects_iterator != _objects.end() && (*objects_iterator) == obj)
         ++objects_iterator;
 
-    _objects.erase(obj);
+    if (_objects.erase(obj) == 0)
+        return;
+
+    // swap with the last entry to keep the arrays packed
+    const uint32_t index = obj->getMapCellVisibilityIndex();
+    if (index < _visibilityObjects.size() && _visibilityObjects[index] == obj)
+    {
+        const size_t last = _visibilityObjects.size() - 1;
+        if (index != last)
+        {
+            _visibilityObjects[index] = _visibilityObjects[last];
+            _visibilityPositionX[index] = _visibilityPositionX[last];
+            _visibilityPositionY[index] = _visibilityPositionY[last];
+            _visibilityUnlimited[index] = _visibilityUnlimited[last];
+            _visibilityObjects[index]->setMapCellVisibilityIndex(index);
+        }
+
+        _visibilityObjects.pop_back();
+        _visibilityPositionX.pop_back();
+        _visibilityPositionY.pop_back();
+        _visibilityUnlimited.pop_back();
+    }
+
+    obj->setMapCellVisibilityIndex(uint32_t(-1));
+}
+
+void MapCell::UpdateObjectPosition(Object* obj)
+{
+    const uint32_t index = obj->getMapCellVisibilityIndex();
+    if (index >= _visibilityObjects.size() || _visibilityObjects[index] != obj)
+        return;
+
+    _visibilityPositionX[index] = obj->GetPositionX();
+    _visibilityPositionY[index] = obj->GetPositionY();
+
+    // see MapMgr::GetUpdateDistance, GameObject overrides can be changed by command so this is refreshed on every move
+    bool unlimited = obj->isPlayer() || obj->GetTypeFromGUID() == HIGHGUID_TYPE_TRANSPORTER;
+    if (!unlimited && obj->isGameObject())
+        unlimited = (static_cast<GameObject*>(obj)->GetOverrides() & GAMEOBJECT_INFVIS) != 0;
+
+    _visibilityUnlimited[index] = unlimited ? 1 : 0;
+}
+
+void MapCell::_ClearVisibilityArrays()
+{
+    // objects might be deleted already, their index is reset by the next AddObject
+    _visibilityObjects.clear();
+    _visibilityPositionX.clear();
+    _visibilityPositionY.clear();
+    _visibilityUnlimited.clear();
 }
 
 void MapCell::SetActivity(bool state)
@@ -198,6 +256,7 @@ void MapCell::RemoveObjects()
         delete obj;
     }
     _objects.clear();
+    _ClearVisibilityArrays();
     _corpses.clear();
     _playerCount = 0;
     _loaded = false;
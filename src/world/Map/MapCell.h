@@ -33,6 +33,16 @@ public:
     inline ObjectSet::iterator Begin() { return _objects.begin(); }
     inline ObjectSet::iterator End() { return _objects.end(); }
 
+    // Visibility arrays, same content as _objects but stored flat for fast range checks.
+    // Positions are refreshed by MapMgr::ChangeObjectLocation and lag behind by at most the visibility update distance.
+    void UpdateObjectPosition(Object* obj);
+    inline size_t GetVisibilityCount() const { return _visibilityObjects.size(); }
+    inline Object* GetVisibilityObject(size_t index) const { return _visibilityObjects[index]; }
+    inline float GetVisibilityPositionX(size_t index) const { return _visibilityPositionX[index]; }
+    inline float GetVisibilityPositionY(size_t index) const { return _visibilityPositionY[index]; }
+    // true if the object can be in range without respecting the update distance (players, transporters, GAMEOBJECT_INFVIS)
+    inline bool HasUnlimitedVisibility(size_t index) const { return _visibilityUnlimited[index] != 0; }
+
     // State Related
     void SetActivity(bool state);
 
@@ -63,6 +73,14 @@ private:
     uint16_t _x;
     uint16_t _y;
     ObjectSet _objects;
+
+    std::vector<Object*> _visibilityObjects;
+    std::vector<float> _visibilityPositionX;
+    std::vector<float> _visibilityPositionY;
+    std::vector<uint8_t> _visibilityUnlimited;
+
+    void _ClearVisibilityArrays();
+
     bool _active;
     bool _loaded;
     bool _unloadpending;
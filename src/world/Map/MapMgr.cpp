@@ -48,6 +48,8 @@
 #include "Server/Packets/SmsgDefenseMessage.h"
 
 #include "shared/WoWGuid.h"
+#include "Map/MapScheduler.h"
+#include "Server/UpdateProfiler.h"
 
 using namespace AscEmu::Packets;
 
@@ -55,7 +57,7 @@ Arcemu::Utility::TLSObject<MapMgr*> t_currentMapContext;
 
 extern bool bServerShutdown;
 
-MapMgr::MapMgr(Map* map, uint32 mapId, uint32 instanceid) : CellHandler<MapCell>(map), _mapId(mapId), eventHolder(instanceid), worldstateshandler(mapId)
+MapMgr::MapMgr(Map* map, uint32 mapId, uint32 instanceid) : CellHandler<MapCell>(map), _mapId(mapId), m_movementRelay(this), eventHolder(instanceid), worldstateshandler(mapId)
 {
     _terrain = new TerrainHolder(mapId);
     _shutdown = false;
@@ -102,6 +104,11 @@ MapMgr::MapMgr(Map* map, uint32 mapId, uint32 instanceid) : CellHandler<MapCell>
     _processQueue.clear();
     Sessions.clear();
 
+    memset(m_phaseTimes, 0, sizeof(m_phaseTimes));
+    m_phaseTimeLoops = 0;
+    memset(m_updatePhaseTimes, 0, sizeof(m_updatePhaseTimes));
+    m_updateProfile = sUpdateProfiler.addMap(mapId, instanceid);
+
     activeGameObjects.clear();
     activeCreatures.clear();
     creature_iterator = activeCreatures.begin();
@@ -119,6 +126,7 @@ MapMgr::~MapMgr()
 {
     _shutdown = true;
     sEventMgr.RemoveEvents(this);
+    sUpdateProfiler.removeMap(m_updateProfile);
     if (ScriptInterface != nullptr)
     {
         delete ScriptInterface;
@@ -690,6 +698,10 @@ void MapMgr::ChangeObjectLocation(Object* obj)
             }
         }
     }
+    else
+    {
+        objCell->UpdateObjectPosition(obj);
+    }
 
     // Update in-range set for new objects
     uint32 endX = cellX + cellNumber;
@@ -753,16 +765,26 @@ void MapMgr::UpdateInRangeSet(Object* obj, Player* plObj, MapCell* cell, ByteBuf
     int count;
     bool cansee, isvisible;
 
-    auto iter = cell->Begin();
-    while (iter != cell->End())
-    {
-        // Prevent undefined behaviour (related to transports) -Appled
-        if (cell->_objects.empty())
-            break;
+    // Objects further away than the update distance plus the distance they can move unnoticed are skipped
+    // before touching them, unless GetUpdateDistance could return an unlimited range for them.
+    const float objX = obj->GetPositionX();
+    const float objY = obj->GetPositionY();
+    const float skipDistance = std::sqrt(m_UpdateDistance) + worldConfig.performance.visibilityUpdateDistance;
+    const float skipDistanceSq = skipDistance * skipDistance;
+    const bool objUnlimited = obj->isGameObject() && (static_cast<GameObject*>(obj)->GetOverrides() & GAMEOBJECT_INFVIS);
 
-        Object* curObj = *iter;
-        ++iter;
+    // Indexed loop, the cell can change while creation data is built (related to transports) -Appled
+    for (size_t index = 0; index < cell->GetVisibilityCount(); ++index)
+    {
+        if (!objUnlimited && !cell->HasUnlimitedVisibility(index))
+        {
+            const float deltaX = cell->GetVisibilityPositionX(index) - objX;
+            const float deltaY = cell->GetVisibilityPositionY(index) - objY;
+            if (deltaX * deltaX + deltaY * deltaY > skipDistanceSq)
+                continue;
+        }
 
+        Object* curObj = cell->GetVisibilityObject(index);
         if (curObj == nullptr)
             continue;
 
@@ -1429,6 +1451,25 @@ bool MapMgr::runThread()
 }
 
 bool MapMgr::Do()
+{
+    beginUpdates();
+
+    for (;;)
+    {
+        const uint32 exec_start = Util::getMSTime();
+
+        if (!updateOnce())
+            break;
+
+        const uint32 exec_time = Util::getMSTime() - exec_start;
+        if (exec_time < 20)  //mapmgr update period 20
+            Arcemu::Sleep(20 - exec_time);
+    }
+
+    return endUpdates();
+}
+
+void MapMgr::beginUpdates()
 {
 #ifdef WIN32
     threadid = GetCurrentThreadId();
@@ -1438,9 +1479,10 @@ bool MapMgr::Do()
 
     thread_running = true;
     ThreadState = THREADSTATE_BUSY;
-    SetThreadName("Map mgr - M%u|I%u", this->_mapId, this->m_instanceID);
 
-    uint32 last_exec = Util::getMSTime();
+    // a scheduler worker runs many maps, it keeps its own name
+    if (!sMapScheduler.isEnabled())
+        SetThreadName("Map mgr - M%u|I%u", this->_mapId, this->m_instanceID);
 
     // Create Instance script
     LoadInstanceScript();
@@ -1467,39 +1509,42 @@ bool MapMgr::Do()
     sObjectMgr.LoadCorpses(this);
     worldstateshandler.InitWorldStates(sObjectMgr.GetWorldStatesForMap(_mapId));
     worldstateshandler.setObserver(this);
+}
 
-    while (GetThreadState() != THREADSTATE_TERMINATE && !_shutdown)
-    {
-        uint32 exec_start = Util::getMSTime();
+bool MapMgr::updateOnce()
+{
+    if (GetThreadState() == THREADSTATE_TERMINATE || _shutdown)
+        return false;
 
-        //////////////////////////////////////////////////////////////////////////////////////////
-        //first push to world new objects
-        m_objectinsertlock.Acquire();
+    t_currentMapContext.set(this);
 
-        if (m_objectinsertpool.size())
-        {
-            for (auto o : m_objectinsertpool)
-                o->PushToWorld(this);
+    //////////////////////////////////////////////////////////////////////////////////////////
+    //first push to world new objects
+    m_objectinsertlock.Acquire();
 
-            m_objectinsertpool.clear();
-        }
+    if (m_objectinsertpool.size())
+    {
+        for (auto o : m_objectinsertpool)
+            o->PushToWorld(this);
 
-        m_objectinsertlock.Release();
-        //////////////////////////////////////////////////////////////////////////////////////////
+        m_objectinsertpool.clear();
+    }
 
-        //Now update sessions of this map + objects
-        _PerformObjectDuties();
+    m_objectinsertlock.Release();
+    //////////////////////////////////////////////////////////////////////////////////////////
 
-        last_exec = Util::getMSTime();
-        uint32 exec_time = last_exec - exec_start;
-        if (exec_time < 20)  //mapmgr update period 20
-            Arcemu::Sleep(20 - exec_time);
+    //Now update sessions of this map + objects
+    _PerformObjectDuties();
 
-        // Check if we have to die :P
-        if (InactiveMoveTime && UNIXTIME >= InactiveMoveTime)
-            break;
-    }
+    // Check if we have to die :P
+    if (InactiveMoveTime && UNIXTIME >= InactiveMoveTime)
+        return false;
 
+    return true;
+}
+
+bool MapMgr::endUpdates()
+{
     // Teleport any left-over players out.
     TeleportPlayers();
 
@@ -1636,9 +1681,13 @@ void MapMgr::_PerformObjectDuties()
     if (difftime > 500)
         difftime = 500;
 
+    PhaseTimePoint phaseStart = std::chrono::steady_clock::now();
+    memset(m_updatePhaseTimes, 0, sizeof(m_updatePhaseTimes));
+
     // Update any events.
     // we make update of events before objects so in case there are 0 timediff events they do not get deleted after update but on next server update loop
     eventHolder.Update(difftime);
+    _AddPhaseTime(MAP_UPDATE_PHASE_EVENTS, phaseStart);
 
     // Update Transporters
     {
@@ -1655,6 +1704,7 @@ void MapMgr::_PerformObjectDuties()
         }
         lastTransportUpdate = mstime;
     }
+    _AddPhaseTime(MAP_UPDATE_PHASE_TRANSPORTS, phaseStart);
 
     // Update creatures.
     {
@@ -1684,6 +1734,7 @@ void MapMgr::_PerformObjectDuties()
 
         lastUnitUpdate = mstime;
     }
+    _AddPhaseTime(MAP_UPDATE_PHASE_UNITS, phaseStart);
 
     // Dynamic objects are updated every 100ms
     // We take the pointer, increment, and update in this order because during the update the DynamicObject might get deleted,
@@ -1701,6 +1752,7 @@ void MapMgr::_PerformObjectDuties()
 
         lastDynamicObjectUpdate = mstime;
     }
+    _AddPhaseTime(MAP_UPDATE_PHASE_DYNAMICOBJECTS, phaseStart);
 
     // Update gameobjects only every 200ms
     difftime = mstime - lastGameobjectUpdate;
@@ -1716,6 +1768,7 @@ void MapMgr::_PerformObjectDuties()
 
         lastGameobjectUpdate = mstime;
     }
+    _AddPhaseTime(MAP_UPDATE_PHASE_GAMEOBJECTS, phaseStart);
 
     // Sessions are updated on every second loop
     if (mLoopCounter % 2)
@@ -1755,8 +1808,53 @@ void MapMgr::_PerformObjectDuties()
         }
     }
 
+    m_movementRelay.flush();
+
+    _AddPhaseTime(MAP_UPDATE_PHASE_SESSIONS, phaseStart);
+
     // Finally, A9 Building/Distribution
     _UpdateObjects();
+    _AddPhaseTime(MAP_UPDATE_PHASE_OBJECTUPDATES, phaseStart);
+
+    if (m_updateProfile != nullptr)
+    {
+        uint32 updateTime = 0;
+        for (const uint32 phaseTime : m_updatePhaseTimes)
+            updateTime += phaseTime;
+
+        m_updateProfile->addUpdate(m_updatePhaseTimes, updateTime);
+    }
+
+    _LogPhaseTimes();
+}
+
+void MapMgr::_AddPhaseTime(MapUpdatePhase phase, PhaseTimePoint& start)
+{
+    const PhaseTimePoint now = std::chrono::steady_clock::now();
+    const uint64 phaseTime = std::chrono::duration_cast<std::chrono::microseconds>(now - start).count();
+    m_phaseTimes[phase] += phaseTime;
+    m_updatePhaseTimes[phase] += static_cast<uint32>(phaseTime);
+    start = now;
+}
+
+void MapMgr::_LogPhaseTimes()
+{
+    const uint32 interval = worldConfig.performance.mapUpdateTimingInterval;
+    if (interval == 0 || ++m_phaseTimeLoops < interval)
+        return;
+
+    sLogger.debug("MapMgr : Map %u (instance %u) average update times over %u loops in us - events %u, transports %u, units %u, dynamic objects %u, gameobjects %u, sessions %u, object updates %u",
+        _mapId, m_instanceID, m_phaseTimeLoops,
+        static_cast<uint32>(m_phaseTimes[MAP_UPDATE_PHASE_EVENTS] / m_phaseTimeLoops),
+        static_cast<uint32>(m_phaseTimes[MAP_UPDATE_PHASE_TRANSPORTS] / m_phaseTimeLoops),
+        static_cast<uint32>(m_phaseTimes[MAP_UPDATE_PHASE_UNITS] / m_phaseTimeLoops),
+        static_cast<uint32>(m_phaseTimes[MAP_UPDATE_PHASE_DYNAMICOBJECTS] / m_phaseTimeLoops),
+        static_cast<uint32>(m_phaseTimes[MAP_UPDATE_PHASE_GAMEOBJECTS] / m_phaseTimeLoops),
+        static_cast<uint32>(m_phaseTimes[MAP_UPDATE_PHASE_SESSIONS] / m_phaseTimeLoops),
+        static_cast<uint32>(m_phaseTimes[MAP_UPDATE_PHASE_OBJECTUPDATES] / m_phaseTimeLoops));
+
+    memset(m_phaseTimes, 0, sizeof(m_phaseTimes));
+    m_phaseTimeLoops = 0;
 }
 
 void MapMgr::EventCorpseDespawn(uint64 guid)
@@ -2112,6 +2210,17 @@ Player* MapMgr::GetPlayer(uint32 guid)
     return itr != m_PlayerStorage.end() ? itr->second : nullptr;
 }
 
+void MapMgr::relayMovement(Unit* mover, WorldPacket& packet, bool isHeartbeat)
+{
+    if (!worldConfig.performance.enableMovementBatching)
+    {
+        mover->SendMessageToSet(&packet, false);
+        return;
+    }
+
+    m_movementRelay.relay(mover, packet, isHeartbeat);
+}
+
 void MapMgr::AddCombatInProgress(uint64 guid)
 {
     _combatProgress.insert(guid);
@@ -2209,12 +2318,13 @@ void MapMgr::SendPvPCaptureMessage(int32 ZoneMask, uint32 ZoneId, const char* Me
 
 void MapMgr::SendPacketToAllPlayers(WorldPacket* packet) const
 {
+    SharedWorldPacket sharedPacket;
     for (const auto& itr : m_PlayerStorage)
     {
         Player* p = itr.second;
 
         if (p->GetSession() != nullptr)
-            p->GetSession()->SendPacket(packet);
+            p->GetSession()->SendBroadcastPacket(packet, sharedPacket);
     }
 }
 
@@ -6,6 +6,7 @@ This file is released under the MIT license. See README-MIT for more information
 #pragma once
 
 #include "Map/MapManagementGlobals.hpp"
+#include "Map/MovementRelay.h"
 #include "MapCell.h"
 #include "CellHandler.h"
 #include "Management/WorldStatesHandler.h"
@@ -16,6 +17,9 @@ This file is released under the MIT license. See README-MIT for more information
 #include "Objects/CObjectFactory.h"
 #include "Server/EventableObject.h"
 
+#include <chrono>
+#include <memory>
+
 namespace Arcemu
 {
     namespace Utility
@@ -44,6 +48,7 @@ class Summon;
 class DynamicObject;
 class Unit;
 class CreatureGroup;
+class MapUpdateProfile;
 
 extern Arcemu::Utility::TLSObject<MapMgr*> t_currentMapContext;
 
@@ -134,6 +139,10 @@ public:
     PlayerStorageMap m_PlayerStorage;
     Player* GetPlayer(uint32 guid);
 
+    // Sends a movement packet of mover to the players around it.
+    // With Performance.MovementBatching they are collected and sent once per map update.
+    void relayMovement(Unit* mover, WorldPacket& packet, bool isHeartbeat);
+
     // Local (mapmgr) storage of combats in progress
     CombatProgressMap _combatProgress;
     void AddCombatInProgress(uint64 guid);
@@ -147,6 +156,13 @@ public:
     bool runThread() override;
     bool Do();
 
+    // Steps of Do, also called by the MapScheduler workers.
+    // updateOnce runs one map update and returns false when the map has to stop,
+    // endUpdates may delete the map.
+    void beginUpdates();
+    bool updateOnce();
+    bool endUpdates();
+
     MapMgr(Map* map, uint32 mapid, uint32 instanceid);
     ~MapMgr();
 
@@ -259,6 +275,11 @@ private:
     float GetUpdateDistance(Object* curObj, Object* obj, Player* plObj);
     void OutOfMapBoundariesTeleport(Object* object);
 
+    // Update phase timings, written to the debug log every Performance.MapUpdateTimingInterval updates
+    typedef std::chrono::steady_clock::time_point PhaseTimePoint;
+    void _AddPhaseTime(MapUpdatePhase phase, PhaseTimePoint& start);
+    void _LogPhaseTimes();
+
 public:
     /// Distance a Player can "see" other objects and receive updates from them (!! ALREADY dist*dist !!)
     float m_UpdateDistance;
@@ -269,9 +290,19 @@ private:
     UpdateQueue _updates;
     PUpdateQueue _processQueue;
 
+    uint64 m_phaseTimes[MAP_UPDATE_PHASE_COUNT];
+    uint32 m_phaseTimeLoops;
+
+    // Phase times of the current update, handed to the update profiler
+    uint32 m_updatePhaseTimes[MAP_UPDATE_PHASE_COUNT];
+    std::shared_ptr<MapUpdateProfile> m_updateProfile;
+
     // Sessions
     std::set<WorldSession*> Sessions;
 
+    // Movement packets received from the sessions, sent after the sessions are updated
+    MovementRelay m_movementRelay;
+
     // Map Information
     MySQLStructure::MapInfo const* pMapInfo;
     uint32 m_instanceID;
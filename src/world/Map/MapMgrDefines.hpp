@@ -17,6 +17,18 @@ enum MapMgrTimers
     MMUPDATE_COUNT          = 5
 };
 
+enum MapUpdatePhase
+{
+    MAP_UPDATE_PHASE_EVENTS         = 0,
+    MAP_UPDATE_PHASE_TRANSPORTS     = 1,
+    MAP_UPDATE_PHASE_UNITS          = 2,
+    MAP_UPDATE_PHASE_DYNAMICOBJECTS = 3,
+    MAP_UPDATE_PHASE_GAMEOBJECTS    = 4,
+    MAP_UPDATE_PHASE_SESSIONS       = 5,
+    MAP_UPDATE_PHASE_OBJECTUPDATES  = 6,
+    MAP_UPDATE_PHASE_COUNT          = 7
+};
+
 enum ObjectActiveState
 {
     OBJECT_STATE_NONE       = 0,
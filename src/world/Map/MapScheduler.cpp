@@ -0,0 +1,217 @@
+/*
+Copyright (c) 2014-2021 AscEmu Team <http://www.ascemu.org>
+This file is released under the MIT license. See README-MIT for more information.
+*/
+
+#include "StdAfx.h"
+#include "MapScheduler.h"
+#include "Map/MapMgr.h"
+#include "Server/World.h"
+
+#include <algorithm>
+#include <cstdio>
+
+MapScheduler& MapScheduler::getInstance()
+{
+    static MapScheduler mInstance;
+    return mInstance;
+}
+
+void MapScheduler::initialize()
+{
+    if (!worldConfig.performance.enableMapScheduler || !m_workers.empty())
+        return;
+
+    uint32_t threadCount = worldConfig.performance.mapSchedulerThreads;
+    if (threadCount == 0)
+        threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+
+    m_shutdownRequested = false;
+    m_startTime = std::chrono::steady_clock::now();
+
+    m_workers.reserve(threadCount);
+    for (uint32_t i = 0; i < threadCount; ++i)
+        m_workers.emplace_back(&MapScheduler::workerRunner, this, i);
+
+    sLogger.info("MapScheduler : Started %u workers", threadCount);
+}
+
+void MapScheduler::finalize()
+{
+    if (m_workers.empty())
+        return;
+
+    {
+        std::unique_lock<std::mutex> lock(m_lock);
+
+        // maps are only removed from m_entries before they finish, every listed map still exists
+        for (const auto& entry : m_entries)
+            entry->mapMgr->SetThreadState(THREADSTATE_TERMINATE);
+
+        m_finishedCondition.wait(lock, [this] { return m_entries.empty(); });
+
+        m_shutdownRequested = true;
+    }
+
+    m_condition.notify_all();
+
+    for (auto& worker : m_workers)
+        worker.join();
+
+    m_workers.clear();
+}
+
+void MapScheduler::addMap(MapMgr* mapMgr)
+{
+    if (m_workers.empty())
+    {
+        ThreadPool.ExecuteTask(mapMgr);
+        return;
+    }
+
+    // KillThread waits for the map to finish, also before its first update
+    mapMgr->thread_running = true;
+
+    auto entry = std::make_shared<MapSchedulerEntry>();
+    entry->mapMgr = mapMgr;
+    entry->mapId = mapMgr->GetMapId();
+    entry->instanceId = mapMgr->GetInstanceID();
+    entry->dueTime = std::chrono::steady_clock::now();
+
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        m_entries.push_back(entry);
+        m_runQueue.push(entry);
+    }
+
+    m_condition.notify_one();
+}
+
+std::vector<std::string> MapScheduler::getReport(size_t maxMaps)
+{
+    std::vector<std::string> lines;
+    if (m_workers.empty())
+    {
+        lines.emplace_back("The map scheduler is disabled (Performance.MapScheduler), every map runs on its own thread.");
+        return lines;
+    }
+
+    char text[256];
+
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    const auto runTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_startTime).count();
+    const float load = runTime > 0 ? 100.0f * m_busyTime / (static_cast<float>(runTime) * m_workers.size()) : 0.0f;
+
+    snprintf(text, sizeof(text), "Map scheduler: %u workers, %u maps, %.1f%% worker load since start",
+        static_cast<uint32_t>(m_workers.size()), static_cast<uint32_t>(m_entries.size()), load);
+    lines.emplace_back(text);
+
+    std::vector<std::shared_ptr<MapSchedulerEntry>> entries = m_entries;
+    const size_t count = std::min(maxMaps, entries.size());
+    std::partial_sort(entries.begin(), entries.begin() + count, entries.end(), [](std::shared_ptr<MapSchedulerEntry> const& first, std::shared_ptr<MapSchedulerEntry> const& second)
+    {
+        return first->busyTime > second->busyTime;
+    });
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        const MapSchedulerEntry& entry = *entries[i];
+        const uint64_t updates = std::max<uint64_t>(entry.updateCount, 1);
+
+        snprintf(text, sizeof(text), "Map %u (instance %u): %u players, %.1f%% of the update time, %llu updates, %.2fms average, %.2fms max, %llu over budget, %.2fms average delay",
+            entry.mapId, entry.instanceId, entry.playerCount, m_busyTime ? 100.0f * entry.busyTime / m_busyTime : 0.0f,
+            static_cast<unsigned long long>(entry.updateCount), entry.busyTime / 1000.0f / updates, entry.maxUpdateTime / 1000.0f,
+            static_cast<unsigned long long>(entry.overBudgetCount), entry.totalDelay / 1000.0f / updates);
+        lines.emplace_back(text);
+    }
+
+    return lines;
+}
+
+void MapScheduler::workerRunner(uint32_t workerId)
+{
+    SetThreadName("Map Scheduler %u", workerId);
+
+    std::unique_lock<std::mutex> lock(m_lock);
+    while (!m_shutdownRequested)
+    {
+        if (m_runQueue.empty())
+        {
+            m_condition.wait(lock);
+            continue;
+        }
+
+        const std::shared_ptr<MapSchedulerEntry> entry = m_runQueue.top();
+        if (entry->dueTime > std::chrono::steady_clock::now())
+        {
+            m_condition.wait_until(lock, entry->dueTime);
+            continue;
+        }
+
+        m_runQueue.pop();
+
+        lock.unlock();
+        const bool isRunning = updateMap(*entry);
+        lock.lock();
+
+        if (isRunning)
+        {
+            m_runQueue.push(entry);
+
+            // a worker waiting for a later map has to take this one first
+            if (m_runQueue.top() == entry)
+                m_condition.notify_one();
+
+            continue;
+        }
+
+        m_entries.erase(std::remove(m_entries.begin(), m_entries.end(), entry), m_entries.end());
+
+        // teleports the players out and may delete the map, the lock is not held as it calls into the instance manager
+        lock.unlock();
+        entry->mapMgr->endUpdates();
+        lock.lock();
+
+        m_finishedCondition.notify_all();
+    }
+}
+
+bool MapScheduler::updateMap(MapSchedulerEntry& entry)
+{
+    MapMgr* mapMgr = entry.mapMgr;
+
+    // loads the spawns of the map, not counted as update time
+    if (!entry.isStarted)
+    {
+        mapMgr->beginUpdates();
+        entry.isStarted = true;
+    }
+
+    const auto startTime = std::chrono::steady_clock::now();
+    const bool isRunning = mapMgr->updateOnce();
+    const auto endTime = std::chrono::steady_clock::now();
+
+    const uint64_t updateTime = std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count();
+    const uint64_t delay = std::chrono::duration_cast<std::chrono::microseconds>(startTime - entry.dueTime).count();
+    const uint32_t playerCount = isRunning ? mapMgr->GetPlayerCount() : 0;
+
+    const uint32_t interval = playerCount != 0 ? UPDATE_INTERVAL : worldConfig.performance.mapSchedulerIdleInterval;
+
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    entry.playerCount = playerCount;
+    ++entry.updateCount;
+    entry.busyTime += updateTime;
+    entry.totalDelay += delay;
+    entry.maxUpdateTime = std::max(entry.maxUpdateTime, updateTime);
+    if (updateTime > UPDATE_INTERVAL * 1000)
+        ++entry.overBudgetCount;
+
+    m_busyTime += updateTime;
+
+    // same as the old map thread: the next update starts 20ms after the start of this one, or right away if it took longer
+    entry.dueTime = std::max(startTime + std::chrono::milliseconds(interval), endTime);
+
+    return isRunning;
+}
@@ -0,0 +1,105 @@
+/*
+Copyright (c) 2014-2021 AscEmu Team <http://www.ascemu.org>
+This file is released under the MIT license. See README-MIT for more information.
+*/
+
+#pragma once
+
+#include "CommonTypes.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+class MapMgr;
+
+// A map instance run by the scheduler. Guarded by MapScheduler::m_lock, except mapMgr which only the worker
+// running the update uses.
+struct MapSchedulerEntry
+{
+    MapMgr* mapMgr = nullptr;
+    uint32_t mapId = 0;
+    uint32_t instanceId = 0;
+
+    bool isStarted = false;
+    std::chrono::steady_clock::time_point dueTime;
+
+    uint32_t playerCount = 0;
+    uint64_t updateCount = 0;
+    uint64_t overBudgetCount = 0;
+    uint64_t busyTime = 0;                      // us
+    uint64_t maxUpdateTime = 0;                 // us
+    uint64_t totalDelay = 0;                    // us an update started after its due time
+};
+
+// Runs the updates of all map instances on a fixed number of worker threads.
+// Each worker takes the map with the earliest due time from the run queue, updates it once and queues it again,
+// 20ms after the start of the update or 'Performance.MapSchedulerIdleInterval' ms for maps without players.
+// When disabled every map runs on its own thread of the ThreadPool.
+class SERVER_DECL MapScheduler
+{
+private:
+
+    MapScheduler() = default;
+    ~MapScheduler() = default;
+
+public:
+
+    static MapScheduler& getInstance();
+
+    MapScheduler(MapScheduler&&) = delete;
+    MapScheduler(MapScheduler const&) = delete;
+    MapScheduler& operator=(MapScheduler&&) = delete;
+    MapScheduler& operator=(MapScheduler const&) = delete;
+
+    // an update longer than this delays the next update of the map
+    static constexpr uint32_t UPDATE_INTERVAL = 20;     // ms
+
+    void initialize();
+
+    // stops all maps and waits until they are finished, then stops the workers
+    void finalize();
+
+    bool isEnabled() const { return !m_workers.empty(); }
+
+    // starts the updates of a new map instance
+    void addMap(MapMgr* mapMgr);
+
+    // load of the workers and the maps with the highest share of the update time
+    std::vector<std::string> getReport(size_t maxMaps);
+
+private:
+
+    struct DueTimeCompare
+    {
+        bool operator()(std::shared_ptr<MapSchedulerEntry> const& first, std::shared_ptr<MapSchedulerEntry> const& second) const
+        {
+            return first->dueTime > second->dueTime;
+        }
+    };
+
+    void workerRunner(uint32_t workerId);
+
+    // returns false when the map stopped
+    bool updateMap(MapSchedulerEntry& entry);
+
+    std::vector<std::thread> m_workers;
+
+    std::mutex m_lock;
+    std::condition_variable m_condition;
+    std::condition_variable m_finishedCondition;
+    std::priority_queue<std::shared_ptr<MapSchedulerEntry>, std::vector<std::shared_ptr<MapSchedulerEntry>>, DueTimeCompare> m_runQueue;
+    std::vector<std::shared_ptr<MapSchedulerEntry>> m_entries;
+    bool m_shutdownRequested = false;
+
+    std::chrono::steady_clock::time_point m_startTime;
+    uint64_t m_busyTime = 0;                    // us, all maps since the start
+};
+
+#define sMapScheduler MapScheduler::getInstance()
@@ -193,15 +193,8 @@ class SERVER_DECL MapScriptInterface
         void DeleteGameObject(GameObject* ptr);
         void DeleteCreature(Creature* ptr);
 
-        MapScriptInterface & operator=(MapScriptInterface & msi)
-        {
-            if (this != &msi)
-            {
-                this->mapMgr = msi.mapMgr;
-            }
-
-            return *this;
-        }
+        // mapMgr is a reference, assigning it would copy the whole map
+        MapScriptInterface & operator=(MapScriptInterface const& msi) = delete;
 
     private:
 
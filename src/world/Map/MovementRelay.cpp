@@ -0,0 +1,151 @@
+/*
+Copyright (c) 2014-2021 AscEmu Team <http://www.ascemu.org>
+This file is released under the MIT license. See README-MIT for more information.
+*/
+
+#include "MovementRelay.h"
+#include "Map/MapMgr.h"
+#include "Server/World.h"
+#include "Server/WorldSession.h"
+#include "Units/Players/Player.h"
+#include "Util.hpp"
+
+std::atomic<uint64_t> MovementRelay::s_relayedPackets{ 0 };
+std::atomic<uint64_t> MovementRelay::s_socketWrites{ 0 };
+std::atomic<uint64_t> MovementRelay::s_throttledPackets{ 0 };
+std::atomic<uint64_t> MovementRelay::s_throttledBytes{ 0 };
+
+namespace
+{
+    // size of the server packet header up to WotLK, only used for the statistics
+    const uint32_t packetHeaderSize = 4;
+
+    // how often heartbeat times of observers and movers which are gone are dropped
+    const uint32_t heartbeatCleanupInterval = 10000;
+}
+
+void MovementRelay::relay(Unit* mover, WorldPacket& packet, bool isHeartbeat)
+{
+    if (!mover->IsInWorld())
+        return;
+
+    const uint32_t now = Util::getMSTime();
+    const uint32_t moverPhase = mover->GetPhase();
+    Player* const moverPlayer = mover->ToPlayer();
+    const bool gmInvisible = moverPlayer != nullptr && moverPlayer->m_isGmInvisible;
+
+    SharedWorldPacket sharedPacket;
+
+    for (const auto& itr : mover->getInRangePlayersSet())
+    {
+        if (!itr)
+            continue;
+
+        Player* observer = static_cast<Player*>(itr);
+        if (observer->GetSession() == nullptr || (observer->GetPhase() & moverPhase) == 0)
+            continue;
+
+        // same checks as Player::SendMessageToSet
+        if (moverPlayer != nullptr)
+        {
+            if (gmInvisible && observer->GetSession()->GetPermissionCount() <= 0)
+                continue;
+
+            if (!observer->IsVisible(mover->getGuid()))
+                continue;
+        }
+
+        if (isHeartbeat && !shouldSendHeartbeat(observer->getGuid(), mover->getGuid(), observer->getDistanceSq(mover), now))
+        {
+            ++s_throttledPackets;
+            s_throttledBytes += packet.size() + packetHeaderSize;
+            continue;
+        }
+
+        if (sharedPacket == nullptr)
+            sharedPacket = std::make_shared<const WorldPacket>(packet);
+
+        m_batches[observer->getGuidLow()].packets.push_back(sharedPacket);
+        ++s_relayedPackets;
+    }
+}
+
+void MovementRelay::flush()
+{
+    for (auto itr = m_batches.begin(); itr != m_batches.end();)
+    {
+        std::vector<SharedWorldPacket>& packets = itr->second.packets;
+        if (packets.empty())
+        {
+            ++itr;
+            continue;
+        }
+
+        // the observer may have left the map while the sessions were updated
+        Player* observer = m_mapMgr->GetPlayer(itr->first);
+        if (observer == nullptr || observer->GetSession() == nullptr)
+        {
+            itr = m_batches.erase(itr);
+            continue;
+        }
+
+        if (packets.size() == 1)
+            observer->GetSession()->SendSharedPacket(packets.front());
+        else
+            observer->GetSession()->SendSharedPackets(packets);
+
+        ++s_socketWrites;
+
+        // the vector is kept for the next update
+        packets.clear();
+        ++itr;
+    }
+
+    const uint32_t now = Util::getMSTime();
+    if (now - m_lastCleanupTime >= heartbeatCleanupInterval)
+    {
+        removeOldHeartbeats(now);
+        m_lastCleanupTime = now;
+    }
+}
+
+MovementRelayStatistics MovementRelay::getStatistics()
+{
+    MovementRelayStatistics statistics;
+    statistics.relayedPackets = s_relayedPackets;
+    statistics.socketWrites = s_socketWrites;
+    statistics.throttledPackets = s_throttledPackets;
+    statistics.throttledBytes = s_throttledBytes;
+    return statistics;
+}
+
+bool MovementRelay::shouldSendHeartbeat(uint64_t observerGuid, uint64_t moverGuid, float distanceSq, uint32_t now)
+{
+    const float nearDistance = worldConfig.performance.movementNearDistance;
+    if (distanceSq <= nearDistance * nearDistance)
+        return true;
+
+    const float farDistance = worldConfig.performance.movementFarDistance;
+    const uint32_t interval = distanceSq <= farDistance * farDistance ? worldConfig.performance.movementMidInterval : worldConfig.performance.movementFarInterval;
+
+    uint32_t& lastHeartbeat = m_lastHeartbeats[{ observerGuid, moverGuid }];
+    if (lastHeartbeat != 0 && now - lastHeartbeat < interval)
+        return false;
+
+    lastHeartbeat = now;
+    return true;
+}
+
+void MovementRelay::removeOldHeartbeats(uint32_t now)
+{
+    // a heartbeat older than the far interval is sent again anyway, the entry has no effect anymore
+    const uint32_t maxAge = std::max(worldConfig.performance.movementMidInterval, worldConfig.performance.movementFarInterval);
+
+    for (auto itr = m_lastHeartbeats.begin(); itr != m_lastHeartbeats.end();)
+    {
+        if (now - itr->second >= maxAge)
+            itr = m_lastHeartbeats.erase(itr);
+        else
+            ++itr;
+    }
+}
@@ -0,0 +1,74 @@
+/*
+Copyright (c) 2014-2021 AscEmu Team <http://www.ascemu.org>
+This file is released under the MIT license. See README-MIT for more information.
+*/
+
+#pragma once
+
+#include "WorldPacket.h"
+
+#include <atomic>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+class MapMgr;
+class Unit;
+
+struct MovementRelayStatistics
+{
+    uint64_t relayedPackets = 0;                // movement packets queued for an observer
+    uint64_t socketWrites = 0;                  // batches handed to the sockets, one write per observer and flush
+    uint64_t throttledPackets = 0;              // heartbeats not sent to far away observers
+    uint64_t throttledBytes = 0;
+};
+
+// Collects the movement packets a map receives during one update and sends them with one socket write per observer.
+// Heartbeats of movers far away from an observer are sent less often, the client keeps moving them on their
+// last known movement flags. Every other movement packet (start, stop, jump, facing, ...) is always sent.
+class MovementRelay
+{
+public:
+    explicit MovementRelay(MapMgr* mapMgr) : m_mapMgr(mapMgr), m_lastCleanupTime(0) {}
+
+    void relay(Unit* mover, WorldPacket& packet, bool isHeartbeat);
+
+    // sends the collected packets, called by the map thread after the sessions are updated
+    void flush();
+
+    static MovementRelayStatistics getStatistics();
+
+private:
+    struct ObserverBatch
+    {
+        std::vector<SharedWorldPacket> packets;
+    };
+
+    struct HeartbeatKey
+    {
+        uint64_t observerGuid;
+        uint64_t moverGuid;
+
+        bool operator==(HeartbeatKey const& other) const { return observerGuid == other.observerGuid && moverGuid == other.moverGuid; }
+    };
+
+    struct HeartbeatKeyHash
+    {
+        size_t operator()(HeartbeatKey const& key) const { return std::hash<uint64_t>()(key.observerGuid * 31 + key.moverGuid); }
+    };
+
+    // returns false when the heartbeat is dropped for this observer
+    bool shouldSendHeartbeat(uint64_t observerGuid, uint64_t moverGuid, float distanceSq, uint32_t now);
+    void removeOldHeartbeats(uint32_t now);
+
+    MapMgr* m_mapMgr;
+
+    std::unordered_map<uint32_t, ObserverBatch> m_batches;     // observer guid low, all observers are players of this map
+    std::unordered_map<HeartbeatKey, uint32_t, HeartbeatKeyHash> m_lastHeartbeats;
+    uint32_t m_lastCleanupTime;
+
+    static std::atomic<uint64_t> s_relayedPackets;
+    static std::atomic<uint64_t> s_socketWrites;
+    static std::atomic<uint64_t> s_throttledPackets;
+    static std::atomic<uint64_t> s_throttledBytes;
+};
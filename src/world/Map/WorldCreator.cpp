@@ -24,6 +24,7 @@
 #include "Server/MainServerDefines.h"
 #include "InstanceDefines.hpp"
 #include "MapMgr.h"
+#include "MapScheduler.h"
 #include "WorldCreator.h"
 #include "Server/Packets/SmsgUpdateLastInstance.h"
 #include "Server/Packets/SmsgUpdateInstanceOwnership.h"
@@ -650,7 +651,7 @@ MapMgr* InstanceMgr::_CreateInstance(uint32_t mapid, uint32_t instanceid)
     ARCEMU_ASSERT(newMap != nullptr);
 
     // Scheduling the new map for running
-    ThreadPool.ExecuteTask(newMap);
+    sMapScheduler.addMap(newMap);
     m_singleMaps[mapid] = newMap;
 
     return newMap;
@@ -670,7 +671,7 @@ MapMgr* InstanceMgr::_CreateInstance(Instance* in)
     in->m_mapMgr->iInstanceMode = in->m_difficulty;
     in->m_mapMgr->InactiveMoveTime = 60 + UNIXTIME;
 
-    ThreadPool.ExecuteTask(in->m_mapMgr);
+    sMapScheduler.addMap(in->m_mapMgr);
     return in->m_mapMgr;
 }
 
@@ -1040,7 +1041,7 @@ MapMgr* InstanceMgr::CreateBattlegroundInstance(uint32_t mapid)
     m_instances[mapid]->insert(std::make_pair(instance->m_instanceId, instance));
 
     m_mapLock.Release();
-    ThreadPool.ExecuteTask(mapMgr);
+    sMapScheduler.addMap(mapMgr);
 
     return mapMgr;
 }
@@ -1080,7 +1081,7 @@ MapMgr* InstanceMgr::CreateInstance(uint32_t /*instanceType*/, uint32_t mapid)
     m_instances[mapid]->insert(std::make_pair(instance->m_instanceId, instance));
 
     m_mapLock.Release();
-    ThreadPool.ExecuteTask(mapMgr);
+    sMapScheduler.addMap(mapMgr);
 
     return mapMgr;
 }
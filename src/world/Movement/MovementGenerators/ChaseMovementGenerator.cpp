@@ -100,6 +100,8 @@ bool ChaseMovementGenerator::update(Unit* owner, uint32_t diff)
     {
         owner->stopMoving();
         _lastTargetPosition.reset();
+        if (_path)
+            _path->cancelAsyncPath();
         if (Creature* cOwner = owner->ToCreature())
             cOwner->GetAIInterface()->setCannotReachTarget(false);
         return true;
@@ -143,6 +145,15 @@ bool ChaseMovementGenerator::update(Unit* owner, uint32_t diff)
         doMovementInform(owner, target);
     }
 
+    // the path requested on an earlier tick has to arrive before we consider the next one
+    if (_path && _path->isPathPending())
+    {
+        if (!_path->updateAsyncPath())
+            return true;
+
+        launchPath(owner, target, maxTarget);
+    }
+
     // if the target moved, we have to consider whether to adjust
     if (!_lastTargetPosition || target->GetPosition() != _lastTargetPosition.value() || mutualChase != _mutualChase)
     {
@@ -168,19 +179,18 @@ bool ChaseMovementGenerator::update(Unit* owner, uint32_t diff)
                 _path = std::make_unique<PathGenerator>(owner);
 
             float x, y, z;
-            bool shortenPath;
             // if we want to move toward the target and there's no fixed angle...
             if (moveToward && !angle)
             {
                 // ...we'll pathfind to the center, then shorten the path
                 target->getPosition(x, y, z);
-                shortenPath = true;
+                _shortenPath = true;
             }
             else
             {
                 // otherwise, we fall back to nearpoint finding
                 target->getNearPoint(owner, x, y, z, (moveToward ? maxTarget : minTarget) - hitboxSum, angle ? target->toAbsoluteAngle(angle->RelativeAngle) : target->getAbsoluteAngle(owner));
-                shortenPath = false;
+                _shortenPath = false;
             }
 
             if (owner->isHovering())
@@ -188,50 +198,58 @@ bool ChaseMovementGenerator::update(Unit* owner, uint32_t diff)
 
             bool forcedest = owner->canFly() || owner->isInWater();
 
-            bool success = _path->calculatePath(x, y, z, forcedest);
-            if (!success || (_path->getPathType() & (PATHFIND_NOPATH /* | PATHFIND_INCOMPLETE*/)))
-            {
-                if (cOwner)
-                    cOwner->GetAIInterface()->setCannotReachTarget(true);
-                owner->stopMoving();
-                return true;
-            }
+            // the path is launched on a later tick when it is calculated by the pathfinding service
+            if (_path->calculatePathAsync(x, y, z, forcedest, PATHFINDING_PRIORITY_HIGH))
+                launchPath(owner, target, maxTarget);
+        }
+    }
 
-            if (shortenPath)
-                _path->shortenPathUntilDist(positionToVector3(target->GetPosition()), maxTarget);
+    // and then, finally, we're done for the tick
+    return true;
+}
 
-            if (cOwner)
-                cOwner->GetAIInterface()->setCannotReachTarget(false);
+void ChaseMovementGenerator::launchPath(Unit* owner, Unit* target, float maxTarget)
+{
+    Creature* const cOwner = owner->ToCreature();
 
-            bool walk = false;
-            if (cOwner && !cOwner->isPet())
-            {
-                switch (cOwner->getMovementTemplate().getChase())
-                {
-                    case CreatureChaseMovementType::CanWalk:
-                        walk = owner->isWalking();
-                        break;
-                    case CreatureChaseMovementType::AlwaysWalk:
-                        walk = true;
-                        break;
-                    default:
-                        break;
-                }
-            }
+    if (_path->getPathType() & (PATHFIND_NOPATH /* | PATHFIND_INCOMPLETE*/))
+    {
+        if (cOwner)
+            cOwner->GetAIInterface()->setCannotReachTarget(true);
+        owner->stopMoving();
+        return;
+    }
 
-            owner->addUnitStateFlag(UNIT_STATE_CHASE_MOVE);
-            addFlag(MOVEMENTGENERATOR_FLAG_INFORM_ENABLED);
+    if (_shortenPath)
+        _path->shortenPathUntilDist(positionToVector3(target->GetPosition()), maxTarget);
 
-            MovementNew::MoveSplineInit init(owner);
-            init.MovebyPath(_path->getPath());
-            init.SetWalk(walk);
-            init.SetFacing(target);
-            init.Launch();
+    if (cOwner)
+        cOwner->GetAIInterface()->setCannotReachTarget(false);
+
+    bool walk = false;
+    if (cOwner && !cOwner->isPet())
+    {
+        switch (cOwner->getMovementTemplate().getChase())
+        {
+            case CreatureChaseMovementType::CanWalk:
+                walk = owner->isWalking();
+                break;
+            case CreatureChaseMovementType::AlwaysWalk:
+                walk = true;
+                break;
+            default:
+                break;
         }
     }
 
-    // and then, finally, we're done for the tick
-    return true;
+    owner->addUnitStateFlag(UNIT_STATE_CHASE_MOVE);
+    addFlag(MOVEMENTGENERATOR_FLAG_INFORM_ENABLED);
+
+    MovementNew::MoveSplineInit init(owner);
+    init.MovebyPath(_path->getPath());
+    init.SetWalk(walk);
+    init.SetFacing(target);
+    init.Launch();
 }
 
 void ChaseMovementGenerator::deactivate(Unit* owner)
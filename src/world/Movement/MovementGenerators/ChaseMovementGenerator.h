@@ -29,6 +29,9 @@ public:
     void unitSpeedChanged() override { _lastTargetPosition.reset(); }
 
 private:
+    // moves along the calculated path, or stops if it does not reach the target
+    void launchPath(Unit* owner, Unit* target, float maxTarget);
+
     static constexpr uint32 RANGE_CHECK_INTERVAL = 100; // time (ms) until we attempt to recalculate
 
     Optional<ChaseRange> const _range;
@@ -39,4 +42,5 @@ private:
     SmallTimeTracker _rangeCheckTimer;
     bool _movingTowards = true;
     bool _mutualChase = true;
+    bool _shortenPath = false;
 };
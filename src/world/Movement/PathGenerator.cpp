@@ -4,6 +4,7 @@ This file is released under the MIT license. See README-MIT for more information
 */
 
 #include "PathGenerator.h"
+#include "PathfindingService.h"
 #include "Map/Map.h"
 #include "Map/MapMgr.h"
 #include "Units/Creatures/Creature.h"
@@ -33,6 +34,23 @@ PathGenerator::PathGenerator(Object* owner) :
     createFilter();
 }
 
+PathGenerator::PathGenerator(dtNavMesh const* navMesh, dtNavMeshQuery const* navMeshQuery, PathfindingRequest const& request) :
+    _polyLength(0), _type(PATHFIND_BLANK), _useStraightPath(request.useStraightPath),
+    _forceDestination(request.forceDestination), _pointPathLimit(request.pointPathLimit), _useRaycast(false),
+    _startPosition(request.startPosition), _endPosition(request.endPosition), _actualEndPosition(request.endPosition),
+    _source(nullptr), _navMesh(navMesh), _navMeshQuery(navMeshQuery)
+{
+    memset(_pathPolyRefs, 0, sizeof(_pathPolyRefs));
+
+    _filter.setIncludeFlags(request.includeFlags);
+    _filter.setExcludeFlags(request.excludeFlags);
+}
+
+PathGenerator::~PathGenerator()
+{
+    cancelAsyncPath();
+}
+
 bool PathGenerator::calculatePath(float destX, float destY, float destZ, bool forceDest)
 {
     float x, y, z;
@@ -63,6 +81,179 @@ bool PathGenerator::calculatePath(float destX, float destY, float destZ, bool fo
     return true;
 }
 
+bool PathGenerator::calculatePathAsync(float destX, float destY, float destZ, bool forceDest, PathfindingPriority priority)
+{
+    cancelAsyncPath();
+
+    if (!sPathfindingService.isEnabled())
+        return calculatePath(destX, destY, destZ, forceDest);
+
+    float x, y, z;
+    _source->getPosition(x, y, z);
+
+    G3D::Vector3 dest(destX, destY, destZ);
+    setEndPosition(dest);
+
+    G3D::Vector3 start(x, y, z);
+    setStartPosition(start);
+
+    _forceDestination = forceDest;
+
+    Unit* _sourceUnit = _source->ToUnit();
+    if (!_navMesh || !_navMeshQuery || (_sourceUnit && _sourceUnit->hasUnitStateFlag(UNIT_STATE_IGNORE_PATHFINDING)) ||
+        !haveTile(start) || !haveTile(dest))
+    {
+        buildShortcut();
+        _type = PathType(PATHFIND_NORMAL | PATHFIND_NOT_USING_PATH);
+        return true;
+    }
+
+    updateFilter();
+
+    // swimming and flying paths depend on the terrain, raycasts are cheap enough for the map thread
+    Creature* _sourceCreature = _source->ToCreature();
+    if (_useRaycast || (_sourceCreature && ((_sourceCreature->canSwim() && _sourceCreature->isInWater()) || (_sourceCreature->canFly() && _sourceCreature->IsFlying()))))
+    {
+        buildPolyPath(start, dest);
+        return true;
+    }
+
+    PathfindingRequest request;
+    request.mapId = _source->GetMapId();
+    request.startPosition = start;
+    request.endPosition = dest;
+    request.includeFlags = _filter.getIncludeFlags();
+    request.excludeFlags = _filter.getExcludeFlags();
+    request.useStraightPath = _useStraightPath;
+    request.forceDestination = _forceDestination;
+    request.pointPathLimit = _pointPathLimit;
+    request.priority = priority;
+
+    _pendingJob = sPathfindingService.submit(request);
+    if (!_pendingJob)
+        return calculatePath(destX, destY, destZ, forceDest);
+
+    return false;
+}
+
+bool PathGenerator::updateAsyncPath()
+{
+    if (!_pendingJob)
+        return true;
+
+    if (!_pendingJob->isDone())
+        return false;
+
+    std::shared_ptr<PathfindingJob> job = std::move(_pendingJob);
+    _pendingJob = nullptr;
+
+    PathfindingResult const& result = job->getResult();
+
+    // a tile can be reloaded between the worker finishing and this update, its polys get a new salt then
+    bool hasStalePoly = false;
+    for (const dtPolyRef polyRef : result.polyRefs)
+    {
+        if (!_navMesh || !_navMesh->isValidPolyRef(polyRef))
+        {
+            hasStalePoly = true;
+            break;
+        }
+    }
+
+    if (!result.isNavMeshPath || hasStalePoly)
+    {
+        calculatePath(_endPosition.x, _endPosition.y, _endPosition.z, _forceDestination);
+        return true;
+    }
+
+    _type = result.type;
+    _pathPoints = result.points;
+    setActualEndPosition(result.actualEndPosition);
+
+    _polyLength = std::min<uint32_t>(static_cast<uint32_t>(result.polyRefs.size()), MAX_PATH_LENGTH);
+    std::copy(result.polyRefs.begin(), result.polyRefs.begin() + _polyLength, _pathPolyRefs);
+
+    // the workers only know the navmesh, the heights are adjusted here
+    normalizePath();
+    return true;
+}
+
+void PathGenerator::cancelAsyncPath()
+{
+    if (!_pendingJob)
+        return;
+
+    sPathfindingService.cancel(_pendingJob);
+    _pendingJob = nullptr;
+}
+
+bool PathGenerator::buildNavMeshPath(PathfindingPolyCache& cache, uint32_t mapId, uint32_t navMeshGeneration)
+{
+    // the tile might have been unloaded since the request was queued
+    if (!haveTile(_startPosition) || !haveTile(_endPosition))
+        return false;
+
+    float distToStartPoly, distToEndPoly;
+    float startPoint[VERTEX_SIZE] = {_startPosition.y, _startPosition.z, _startPosition.x};
+    float endPoint[VERTEX_SIZE] = {_endPosition.y, _endPosition.z, _endPosition.x};
+
+    dtPolyRef startPoly = getPolyByLocation(startPoint, &distToStartPoly);
+    dtPolyRef endPoly = getPolyByLocation(endPoint, &distToEndPoly);
+
+    // holes in the mesh and positions far from it are handled by buildPolyPath, it needs the terrain of the map
+    if (startPoly == INVALID_POLYREF || endPoly == INVALID_POLYREF || distToStartPoly > 7.0f || distToEndPoly > 7.0f)
+        return false;
+
+    _type = PATHFIND_NORMAL;
+
+    if (startPoly == endPoly)
+    {
+        _pathPolyRefs[0] = startPoly;
+        _polyLength = 1;
+
+        buildPointPath(startPoint, endPoint);
+        return true;
+    }
+
+    PathfindingPolyCacheKey cacheKey{ mapId, startPoly, endPoly, _filter.getIncludeFlags(), _filter.getExcludeFlags() };
+    if (!cache.find(cacheKey, navMeshGeneration, _pathPolyRefs, _polyLength))
+    {
+        dtStatus dtResult = _navMeshQuery->findPath(
+                        startPoly,          // start polygon
+                        endPoly,            // end polygon
+                        startPoint,         // start position
+                        endPoint,           // end position
+                        &_filter,           // polygon search filter
+                        _pathPolyRefs,      // [out] path
+                        (int*)&_polyLength,
+            MAX_POINT_PATH_LENGTH);         // max number of polygons in output path
+
+        if (!_polyLength || dtStatusFailed(dtResult))
+        {
+            buildShortcut();
+            _type = PATHFIND_NOPATH;
+            return true;
+        }
+
+        cache.store(cacheKey, navMeshGeneration, _pathPolyRefs, _polyLength);
+    }
+
+    if (_pathPolyRefs[_polyLength - 1] != endPoly)
+        _type = PATHFIND_INCOMPLETE;
+
+    buildPointPath(startPoint, endPoint);
+    return true;
+}
+
+void PathGenerator::getNavMeshPathResult(PathfindingResult& result) const
+{
+    result.isNavMeshPath = true;
+    result.type = _type;
+    result.polyRefs.assign(_pathPolyRefs, _pathPolyRefs + _polyLength);
+    result.points = _pathPoints;
+    result.actualEndPosition = _actualEndPosition;
+}
+
 dtPolyRef PathGenerator::getPathPolyByPosition(dtPolyRef const* polyPath, uint32_t polyPathSize, float const* point, float* distance) const
 {
     if (!polyPath || !polyPathSize)
@@ -582,6 +773,10 @@ void PathGenerator::buildPointPath(const float *startPoint, const float *endPoin
 
 void PathGenerator::normalizePath()
 {
+    // pathfinding workers have no source, updateAsyncPath normalizes their paths
+    if (!_source)
+        return;
+
     for (uint32_t i = 0; i < _pathPoints.size(); ++i)
         _source->updateAllowedPositionZ(_pathPoints[i].x, _pathPoints[i].y, _pathPoints[i].z);
 }
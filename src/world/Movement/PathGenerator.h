@@ -11,8 +11,14 @@ This file is released under the MIT license. See README-MIT for more information
 #include "Movement/Spline/MoveSplineInitArgs.h"
 #include <G3D/Vector3.h>
 
+#include <memory>
+
 class Unit;
 class Object;
+class PathfindingJob;
+class PathfindingPolyCache;
+struct PathfindingRequest;
+struct PathfindingResult;
 
 enum PathType
 {
@@ -28,15 +34,36 @@ enum PathType
     PATHFIND_FARFROMPOLY       = PATHFIND_FARFROMPOLY_START | PATHFIND_FARFROMPOLY_END, // start or end positions are far from the mmap poligon
 };
 
+enum PathfindingPriority : uint8_t
+{
+    PATHFINDING_PRIORITY_HIGH   = 0,    // chase and flee, the unit stands still until the path arrives
+    PATHFINDING_PRIORITY_NORMAL = 1,    // follow
+    PATHFINDING_PRIORITY_LOW    = 2,    // random and waypoint movement
+    PATHFINDING_PRIORITY_COUNT  = 3
+};
+
 class SERVER_DECL PathGenerator
 {
+    friend class PathfindingService;
+
+
 public:
     explicit PathGenerator(Object* owner);
-    ~PathGenerator() = default;
+    ~PathGenerator();
 
     // Calculate the path from owner to given destination
     // return: true if new path was calculated, false otherwise (no change needed)
     bool calculatePath(float destX, float destY, float destZ, bool forceDest = false);
+
+    // Like calculatePath, but the navmesh part is calculated by the pathfinding service
+    // return: true if the path was calculated right away (no mmaps, swimming, flying, service disabled),
+    //         false if it is pending and has to be picked up with updateAsyncPath on a later tick
+    bool calculatePathAsync(float destX, float destY, float destZ, bool forceDest = false, PathfindingPriority priority = PATHFINDING_PRIORITY_NORMAL);
+
+    // return: true once the pending path is applied to this generator
+    bool updateAsyncPath();
+    bool isPathPending() const { return _pendingJob != nullptr; }
+    void cancelAsyncPath();
     bool isInvalidDestinationZ(Unit const* target) const;
 
     // option setters - use optional
@@ -78,6 +105,13 @@ private:
 
     dtQueryFilter _filter;                      // use single filter for all movements, update it when needed
 
+    std::shared_ptr<PathfindingJob> _pendingJob; // path requested by calculatePathAsync
+
+    // used by the pathfinding workers, _source is not set and only the navmesh is used
+    PathGenerator(dtNavMesh const* navMesh, dtNavMeshQuery const* navMeshQuery, PathfindingRequest const& request);
+    bool buildNavMeshPath(PathfindingPolyCache& cache, uint32_t mapId, uint32_t navMeshGeneration);
+    void getNavMeshPathResult(PathfindingResult& result) const;
+
     void setStartPosition(G3D::Vector3 const& point) { _startPosition = point; }
     void setEndPosition(G3D::Vector3 const& point) { _actualEndPosition = point; _endPosition = point; }
     void setActualEndPosition(G3D::Vector3 const& point) { _actualEndPosition = point; }
@@ -0,0 +1,313 @@
+/*
+Copyright (c) 2014-2021 AscEmu Team <http://www.ascemu.org>
+This file is released under the MIT license. See README-MIT for more information.
+*/
+
+#include "PathfindingService.h"
+#include "MMapFactory.h"
+#include "MMapManager.h"
+#include "Log.hpp"
+#include "Threading/AEWorkerPool.h"
+
+#include <cmath>
+#include <functional>
+#include <shared_mutex>
+
+using AscEmu::Threading::AEWorkerPool;
+
+namespace
+{
+    int32_t quantizePosition(float value)
+    {
+        return static_cast<int32_t>(std::floor(value * 2.0f));
+    }
+
+    void hashCombine(size_t& seed, size_t value)
+    {
+        seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// PathfindingRequestKey
+PathfindingRequestKey::PathfindingRequestKey(PathfindingRequest const& request) :
+    mapId(request.mapId), includeFlags(request.includeFlags), excludeFlags(request.excludeFlags),
+    pointPathLimit(request.pointPathLimit), useStraightPath(request.useStraightPath), forceDestination(request.forceDestination)
+{
+    for (uint8_t i = 0; i < 3; ++i)
+    {
+        start[i] = quantizePosition(request.startPosition[i]);
+        end[i] = quantizePosition(request.endPosition[i]);
+    }
+}
+
+bool PathfindingRequestKey::operator==(PathfindingRequestKey const& other) const
+{
+    return mapId == other.mapId
+        && start[0] == other.start[0] && start[1] == other.start[1] && start[2] == other.start[2]
+        && end[0] == other.end[0] && end[1] == other.end[1] && end[2] == other.end[2]
+        && includeFlags == other.includeFlags && excludeFlags == other.excludeFlags
+        && pointPathLimit == other.pointPathLimit
+        && useStraightPath == other.useStraightPath && forceDestination == other.forceDestination;
+}
+
+size_t PathfindingRequestKeyHash::operator()(PathfindingRequestKey const& key) const
+{
+    size_t seed = std::hash<uint32_t>()(key.mapId);
+    for (uint8_t i = 0; i < 3; ++i)
+    {
+        hashCombine(seed, std::hash<int32_t>()(key.start[i]));
+        hashCombine(seed, std::hash<int32_t>()(key.end[i]));
+    }
+
+    hashCombine(seed, std::hash<uint32_t>()(static_cast<uint32_t>(key.includeFlags) << 16 | key.excludeFlags));
+    hashCombine(seed, std::hash<uint32_t>()(key.pointPathLimit << 2 | (key.useStraightPath ? 2 : 0) | (key.forceDestination ? 1 : 0)));
+    return seed;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// PathfindingPolyCache
+size_t PathfindingPolyCacheKeyHash::operator()(PathfindingPolyCacheKey const& key) const
+{
+    size_t seed = std::hash<uint32_t>()(key.mapId);
+    hashCombine(seed, std::hash<dtPolyRef>()(key.startPoly));
+    hashCombine(seed, std::hash<dtPolyRef>()(key.endPoly));
+    hashCombine(seed, std::hash<uint32_t>()(static_cast<uint32_t>(key.includeFlags) << 16 | key.excludeFlags));
+    return seed;
+}
+
+bool PathfindingPolyCache::find(PathfindingPolyCacheKey const& key, uint32_t navMeshGeneration, dtPolyRef* polyRefs, uint32_t& polyLength)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    const auto itr = m_entries.find(key);
+    if (itr == m_entries.end())
+    {
+        ++m_misses;
+        return false;
+    }
+
+    // tiles changed since the path was found, its poly refs may point into an unloaded tile
+    if (itr->second.navMeshGeneration != navMeshGeneration || itr->second.expireTime < std::chrono::steady_clock::now())
+    {
+        m_entries.erase(itr);
+        ++m_misses;
+        return false;
+    }
+
+    polyLength = static_cast<uint32_t>(itr->second.polyRefs.size());
+    std::copy(itr->second.polyRefs.begin(), itr->second.polyRefs.end(), polyRefs);
+
+    ++m_hits;
+    return true;
+}
+
+void PathfindingPolyCache::store(PathfindingPolyCacheKey const& key, uint32_t navMeshGeneration, dtPolyRef const* polyRefs, uint32_t polyLength)
+{
+    const auto now = std::chrono::steady_clock::now();
+
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    if (m_entries.size() >= MAX_ENTRIES)
+    {
+        removeExpiredEntries(now);
+
+        // everything is still fresh, start over instead of tracking the age of each entry
+        if (m_entries.size() >= MAX_ENTRIES)
+            m_entries.clear();
+    }
+
+    Entry& entry = m_entries[key];
+    entry.polyRefs.assign(polyRefs, polyRefs + polyLength);
+    entry.navMeshGeneration = navMeshGeneration;
+    entry.expireTime = now + std::chrono::milliseconds(ENTRY_LIFETIME);
+}
+
+void PathfindingPolyCache::removeExpiredEntries(std::chrono::steady_clock::time_point now)
+{
+    for (auto itr = m_entries.begin(); itr != m_entries.end();)
+    {
+        if (itr->second.expireTime < now)
+            itr = m_entries.erase(itr);
+        else
+            ++itr;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// PathfindingService
+PathfindingService& PathfindingService::getInstance()
+{
+    static PathfindingService mInstance;
+    return mInstance;
+}
+
+void PathfindingService::initialize(uint32_t threadCount)
+{
+    if (threadCount == 0 || m_workerPool)
+        return;
+
+    m_workerPool = std::make_unique<AEWorkerPool>("PathfindingPool", static_cast<uint16_t>(threadCount));
+    sLogger.info("PathfindingService : Started %u pathfinding threads", threadCount);
+}
+
+void PathfindingService::finalize()
+{
+    if (!m_workerPool)
+        return;
+
+    // queued jobs are still processed, they only hold references to the jobs of this service
+    m_workerPool->shutdown();
+    m_workerPool = nullptr;
+
+    std::lock_guard<std::mutex> guard(m_queueLock);
+    for (auto& queue : m_queues)
+        queue.clear();
+
+    m_pendingJobs.clear();
+    m_queueSize = 0;
+}
+
+std::shared_ptr<PathfindingJob> PathfindingService::submit(PathfindingRequest const& request)
+{
+    if (!m_workerPool)
+        return nullptr;
+
+    auto job = std::make_shared<PathfindingJob>(request);
+
+    {
+        std::lock_guard<std::mutex> guard(m_queueLock);
+
+        const auto itr = m_pendingJobs.find(job->m_key);
+        if (itr != m_pendingJobs.end())
+        {
+            ++itr->second->m_waiters;
+            ++m_mergedRequests;
+            return itr->second;
+        }
+
+        m_pendingJobs.emplace(job->m_key, job);
+        m_queues[request.priority < PATHFINDING_PRIORITY_COUNT ? request.priority : PATHFINDING_PRIORITY_LOW].push_back(job);
+
+        ++m_queueSize;
+        if (m_queueSize > m_maxQueueSize)
+            m_maxQueueSize = m_queueSize;
+    }
+
+    // every queued job gets one pool job, the pool job takes whichever request has the highest priority by then
+    m_workerPool->enqueue([this]() { processNextJob(); });
+    return job;
+}
+
+void PathfindingService::cancel(std::shared_ptr<PathfindingJob> const& job)
+{
+    if (!job || job->isDone())
+        return;
+
+    std::lock_guard<std::mutex> guard(m_queueLock);
+
+    if (job->m_waiters == 0 || --job->m_waiters != 0)
+        return;
+
+    // queued jobs without waiters are skipped by popJob
+    const auto itr = m_pendingJobs.find(job->m_key);
+    if (itr != m_pendingJobs.end() && itr->second == job)
+        m_pendingJobs.erase(itr);
+
+    ++m_cancelledJobs;
+}
+
+PathfindingStatistics PathfindingService::getStatistics()
+{
+    PathfindingStatistics statistics;
+    statistics.completedJobs = m_completedJobs;
+    statistics.mergedRequests = m_mergedRequests;
+    statistics.cancelledJobs = m_cancelledJobs;
+    statistics.fallbackJobs = m_fallbackJobs;
+    statistics.cacheHits = m_polyCache.getHits();
+    statistics.cacheMisses = m_polyCache.getMisses();
+    statistics.averageLatency = statistics.completedJobs ? m_totalLatency / statistics.completedJobs : 0;
+    statistics.maxLatency = m_maxLatency;
+
+    std::lock_guard<std::mutex> guard(m_queueLock);
+    statistics.queueSize = m_queueSize;
+    statistics.maxQueueSize = m_maxQueueSize;
+
+    return statistics;
+}
+
+std::shared_ptr<PathfindingJob> PathfindingService::popJob()
+{
+    std::lock_guard<std::mutex> guard(m_queueLock);
+
+    for (auto& queue : m_queues)
+    {
+        if (queue.empty())
+            continue;
+
+        std::shared_ptr<PathfindingJob> job = std::move(queue.front());
+        queue.pop_front();
+        --m_queueSize;
+
+        if (job->m_waiters == 0)
+            return nullptr;
+
+        return job;
+    }
+
+    return nullptr;
+}
+
+void PathfindingService::processNextJob()
+{
+    std::shared_ptr<PathfindingJob> job = popJob();
+    if (!job)
+        return;
+
+    calculateJob(*job);
+    completeJob(*job);
+}
+
+void PathfindingService::calculateJob(PathfindingJob& job)
+{
+    MMAP::MMapManager* mmap = MMAP::MMapFactory::createOrGetMMapManager();
+
+    // keeps the map threads from adding or removing tiles while we walk the mesh
+    std::shared_lock<std::shared_mutex> tileGuard(mmap->getTileLock());
+
+    dtNavMesh const* navMesh = mmap->GetNavMesh(job.m_request.mapId);
+    dtNavMeshQuery const* navMeshQuery = mmap->GetWorkerNavMeshQuery(job.m_request.mapId);
+    if (!navMesh || !navMeshQuery)
+        return;
+
+    PathGenerator generator(navMesh, navMeshQuery, job.m_request);
+    if (!generator.buildNavMeshPath(m_polyCache, job.m_request.mapId, mmap->getNavMeshGeneration()))
+        return;
+
+    generator.getNavMeshPathResult(job.m_result);
+}
+
+void PathfindingService::completeJob(PathfindingJob& job)
+{
+    if (!job.m_result.isNavMeshPath)
+        ++m_fallbackJobs;
+
+    {
+        std::lock_guard<std::mutex> guard(m_queueLock);
+
+        const auto itr = m_pendingJobs.find(job.m_key);
+        if (itr != m_pendingJobs.end() && itr->second.get() == &job)
+            m_pendingJobs.erase(itr);
+    }
+
+    job.m_done.store(true, std::memory_order_release);
+
+    const uint64_t latency = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - job.m_submitTime).count());
+    m_totalLatency += latency;
+    ++m_completedJobs;
+
+    uint64_t maxLatency = m_maxLatency;
+    while (latency > maxLatency && !m_maxLatency.compare_exchange_weak(maxLatency, latency))
+    {
+    }
+}
@@ -0,0 +1,219 @@
+/*
+Copyright (c) 2014-2021 AscEmu Team <http://www.ascemu.org>
+This file is released under the MIT license. See README-MIT for more information.
+*/
+
+#pragma once
+
+#include "Macros/AIInterfaceMacros.hpp"
+#include "Movement/PathGenerator.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace AscEmu::Threading
+{
+    class AEWorkerPool;
+}
+
+struct PathfindingRequest
+{
+    uint32_t mapId = 0;
+    G3D::Vector3 startPosition;
+    G3D::Vector3 endPosition;
+    uint16_t includeFlags = 0;
+    uint16_t excludeFlags = 0;
+    bool useStraightPath = false;
+    bool forceDestination = false;
+    uint32_t pointPathLimit = MAX_POINT_PATH_LENGTH;
+    PathfindingPriority priority = PATHFINDING_PRIORITY_NORMAL;
+};
+
+struct PathfindingResult
+{
+    // false when the path depends on terrain data (holes in the mesh, positions far from it, unloaded tiles),
+    // the requesting PathGenerator builds it on the map thread then
+    bool isNavMeshPath = false;
+
+    PathType type = PATHFIND_BLANK;
+    std::vector<dtPolyRef> polyRefs;
+    MovementNew::PointsArray points;            // not normalized yet, see PathGenerator::updateAsyncPath
+    G3D::Vector3 actualEndPosition;
+};
+
+// Requests with start and end positions in the same half yard are calculated once
+struct PathfindingRequestKey
+{
+    uint32_t mapId;
+    int32_t start[3];
+    int32_t end[3];
+    uint16_t includeFlags;
+    uint16_t excludeFlags;
+    uint32_t pointPathLimit;
+    bool useStraightPath;
+    bool forceDestination;
+
+    explicit PathfindingRequestKey(PathfindingRequest const& request);
+
+    bool operator==(PathfindingRequestKey const& other) const;
+};
+
+struct PathfindingRequestKeyHash
+{
+    size_t operator()(PathfindingRequestKey const& key) const;
+};
+
+// A request shared by every PathGenerator which asked for the same path before it was calculated
+class PathfindingJob
+{
+    friend class PathfindingService;
+
+public:
+    explicit PathfindingJob(PathfindingRequest const& request) : m_request(request), m_key(request), m_submitTime(std::chrono::steady_clock::now()) {}
+
+    bool isDone() const { return m_done.load(std::memory_order_acquire); }
+
+    // only valid once isDone() returned true
+    PathfindingResult const& getResult() const { return m_result; }
+
+private:
+    PathfindingRequest m_request;
+    PathfindingRequestKey m_key;
+    PathfindingResult m_result;
+
+    std::chrono::steady_clock::time_point m_submitTime;
+    uint32_t m_waiters = 1;                     // guarded by PathfindingService::m_queueLock
+
+    std::atomic<bool> m_done{ false };
+};
+
+struct PathfindingPolyCacheKey
+{
+    uint32_t mapId;
+    dtPolyRef startPoly;
+    dtPolyRef endPoly;
+    uint16_t includeFlags;
+    uint16_t excludeFlags;
+
+    bool operator==(PathfindingPolyCacheKey const& other) const
+    {
+        return mapId == other.mapId && startPoly == other.startPoly && endPoly == other.endPoly
+            && includeFlags == other.includeFlags && excludeFlags == other.excludeFlags;
+    }
+};
+
+struct PathfindingPolyCacheKeyHash
+{
+    size_t operator()(PathfindingPolyCacheKey const& key) const;
+};
+
+// Recently found poly paths, a unit chasing a target asks for the same start and end polygon many times in a row
+class PathfindingPolyCache
+{
+public:
+    static constexpr uint32_t ENTRY_LIFETIME = 2000;    // ms
+    static constexpr size_t MAX_ENTRIES = 4096;
+
+    bool find(PathfindingPolyCacheKey const& key, uint32_t navMeshGeneration, dtPolyRef* polyRefs, uint32_t& polyLength);
+    void store(PathfindingPolyCacheKey const& key, uint32_t navMeshGeneration, dtPolyRef const* polyRefs, uint32_t polyLength);
+
+    uint64_t getHits() const { return m_hits; }
+    uint64_t getMisses() const { return m_misses; }
+
+private:
+    struct Entry
+    {
+        std::vector<dtPolyRef> polyRefs;
+        uint32_t navMeshGeneration;
+        std::chrono::steady_clock::time_point expireTime;
+    };
+
+    void removeExpiredEntries(std::chrono::steady_clock::time_point now);
+
+    std::mutex m_lock;
+    std::unordered_map<PathfindingPolyCacheKey, Entry, PathfindingPolyCacheKeyHash> m_entries;
+
+    std::atomic<uint64_t> m_hits{ 0 };
+    std::atomic<uint64_t> m_misses{ 0 };
+};
+
+struct PathfindingStatistics
+{
+    uint64_t completedJobs = 0;
+    uint64_t mergedRequests = 0;                // requests answered by a job queued for another unit
+    uint64_t cancelledJobs = 0;
+    uint64_t fallbackJobs = 0;                  // jobs handed back to the map thread
+    uint64_t cacheHits = 0;
+    uint64_t cacheMisses = 0;
+
+    size_t queueSize = 0;
+    size_t maxQueueSize = 0;
+
+    uint64_t averageLatency = 0;                // us from submit until the result is ready
+    uint64_t maxLatency = 0;                    // us
+};
+
+// Calculates paths of moving units on worker threads.
+// Movement generators submit a request through PathGenerator::calculatePathAsync and apply the result on a later tick.
+// Requests for the same path are calculated once, higher priorities are calculated first.
+class SERVER_DECL PathfindingService
+{
+private:
+
+    PathfindingService() = default;
+    ~PathfindingService() = default;
+
+public:
+
+    static PathfindingService& getInstance();
+
+    PathfindingService(PathfindingService&&) = delete;
+    PathfindingService(PathfindingService const&) = delete;
+    PathfindingService& operator=(PathfindingService&&) = delete;
+    PathfindingService& operator=(PathfindingService const&) = delete;
+
+    void initialize(uint32_t threadCount);
+    void finalize();
+
+    // when disabled every path is calculated on the map thread
+    bool isEnabled() const { return m_workerPool != nullptr; }
+
+    std::shared_ptr<PathfindingJob> submit(PathfindingRequest const& request);
+
+    // the job is dropped if no one else waits for it, the result of a running job is discarded
+    void cancel(std::shared_ptr<PathfindingJob> const& job);
+
+    PathfindingStatistics getStatistics();
+
+private:
+
+    std::shared_ptr<PathfindingJob> popJob();
+    void processNextJob();
+    void calculateJob(PathfindingJob& job);
+    void completeJob(PathfindingJob& job);
+
+    std::unique_ptr<AscEmu::Threading::AEWorkerPool> m_workerPool;
+
+    std::mutex m_queueLock;
+    std::deque<std::shared_ptr<PathfindingJob>> m_queues[PATHFINDING_PRIORITY_COUNT];
+    std::unordered_map<PathfindingRequestKey, std::shared_ptr<PathfindingJob>, PathfindingRequestKeyHash> m_pendingJobs;
+    size_t m_queueSize = 0;
+    size_t m_maxQueueSize = 0;
+
+    PathfindingPolyCache m_polyCache;
+
+    std::atomic<uint64_t> m_completedJobs{ 0 };
+    std::atomic<uint64_t> m_mergedRequests{ 0 };
+    std::atomic<uint64_t> m_cancelledJobs{ 0 };
+    std::atomic<uint64_t> m_fallbackJobs{ 0 };
+    std::atomic<uint64_t> m_totalLatency{ 0 };
+    std::atomic<uint64_t> m_maxLatency{ 0 };
+};
+
+#define sPathfindingService PathfindingService::getInstance()
@@ -0,0 +1,175 @@
+/*
+Copyright (c) 2014-2021 AscEmu Team <http://www.ascemu.org>
+This file is released under the MIT license. See README-MIT for more information.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <unordered_map>
+#include <vector>
+
+class Object;
+
+// Objects in range of an object, stored in one array with a hashed index for membership checks and removal.
+// A removal while the set is iterated leaves an empty slot which the iteration skips,
+// the array is compacted once the last View of the set is gone.
+class InRangeSet
+{
+public:
+    class Iterator
+    {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef Object* value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef Object* const* pointer;
+        typedef Object* reference;
+
+        Iterator(std::vector<Object*> const* objects, size_t index, size_t end) : m_objects(objects), m_index(index), m_end(end) { skipEmptySlots(); }
+
+        // by value, the array may grow while the object is in use
+        Object* operator*() const { return (*m_objects)[m_index]; }
+
+        Iterator& operator++()
+        {
+            ++m_index;
+            skipEmptySlots();
+            return *this;
+        }
+
+        bool operator==(Iterator const& other) const { return m_index == other.m_index; }
+        bool operator!=(Iterator const& other) const { return m_index != other.m_index; }
+
+    private:
+        void skipEmptySlots()
+        {
+            while (m_index < m_end && (*m_objects)[m_index] == nullptr)
+                ++m_index;
+        }
+
+        std::vector<Object*> const* m_objects;
+        size_t m_index;
+        size_t m_end;
+    };
+
+    // Iterates the objects of the set without copying them. Objects removed from the set meanwhile are skipped,
+    // objects added meanwhile are not visited.
+    class View
+    {
+    public:
+        explicit View(InRangeSet& set) : m_set(&set), m_end(set.m_objects.size()) { ++set.m_views; }
+        ~View()
+        {
+            if (m_set != nullptr)
+                m_set->releaseView();
+        }
+
+        View(View&& other) noexcept : m_set(other.m_set), m_end(other.m_end) { other.m_set = nullptr; }
+        View(View const&) = delete;
+        View& operator=(View const&) = delete;
+        View& operator=(View&&) = delete;
+
+        Iterator begin() const { return Iterator(&m_set->m_objects, 0, m_end); }
+        Iterator end() const { return Iterator(&m_set->m_objects, m_end, m_end); }
+
+        size_t size() const { return m_set->size(); }
+        bool empty() const { return m_set->empty(); }
+
+    private:
+        InRangeSet* m_set;
+        size_t m_end;
+    };
+
+    View view() { return View(*this); }
+
+    bool contains(Object* object) const { return m_index.find(object) != m_index.end(); }
+    size_t size() const { return m_index.size(); }
+    bool empty() const { return m_index.empty(); }
+
+    // returns false if the object is already in the set
+    bool insert(Object* object)
+    {
+        if (!m_index.emplace(object, static_cast<uint32_t>(m_objects.size())).second)
+            return false;
+
+        m_objects.push_back(object);
+        return true;
+    }
+
+    // returns false if the object is not in the set
+    bool erase(Object* object)
+    {
+        const auto itr = m_index.find(object);
+        if (itr == m_index.end())
+            return false;
+
+        const uint32_t slot = itr->second;
+        m_index.erase(itr);
+
+        if (m_views != 0)
+        {
+            m_objects[slot] = nullptr;
+            m_hasEmptySlots = true;
+            return true;
+        }
+
+        // the last object takes the slot
+        Object* lastObject = m_objects.back();
+        m_objects.pop_back();
+        if (lastObject != object)
+        {
+            m_objects[slot] = lastObject;
+            m_index[lastObject] = slot;
+        }
+
+        return true;
+    }
+
+    void clear()
+    {
+        m_index.clear();
+
+        if (m_views != 0)
+        {
+            std::fill(m_objects.begin(), m_objects.end(), nullptr);
+            m_hasEmptySlots = true;
+            return;
+        }
+
+        m_objects.clear();
+    }
+
+private:
+    void releaseView()
+    {
+        if (--m_views == 0 && m_hasEmptySlots)
+            compact();
+    }
+
+    void compact()
+    {
+        uint32_t slot = 0;
+        for (Object* object : m_objects)
+        {
+            if (object == nullptr)
+                continue;
+
+            m_objects[slot] = object;
+            m_index[object] = slot;
+            ++slot;
+        }
+
+        m_objects.resize(slot);
+        m_hasEmptySlots = false;
+    }
+
+    std::vector<Object*> m_objects;
+    std::unordered_map<Object*, uint32_t> m_index;     // slot in m_objects
+
+    uint32_t m_views = 0;
+    bool m_hasEmptySlots = false;
+};
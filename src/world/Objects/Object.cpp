@@ -1385,29 +1385,26 @@ void Object::addToInRangeObjects(Object* pObj)
         sLogger.failure("We are in range of ourselves!");
 
     if (pObj->isPlayer())
-        mInRangePlayersSet.push_back(pObj);
+        mInRangePlayersSet.insert(pObj);
 
-    mInRangeObjectsSet.push_back(pObj);
+    mInRangeObjectsSet.insert(pObj);
 }
 
 void Object::removeSelfFromInrangeSets()
 {
-    for (const auto& itr : mInRangeObjectsSet)
-    {
-        if (itr)
-            itr->removeObjectFromInRangeObjectsSet(this);
-    }
+    for (const auto& itr : mInRangeObjectsSet.view())
+        itr->removeObjectFromInRangeObjectsSet(this);
 }
 
 // Objects
-std::vector<Object*> Object::getInRangeObjectsSet()
+InRangeSet::View Object::getInRangeObjectsSet()
 {
-    return mInRangeObjectsSet;
+    return mInRangeObjectsSet.view();
 }
 
 bool Object::hasInRangeObjects()
 {
-    return mInRangeObjectsSet.size() > 0;
+    return !mInRangeObjectsSet.empty();
 }
 
 size_t Object::getInRangeObjectsCount()
@@ -1417,16 +1414,7 @@ size_t Object::getInRangeObjectsCount()
 
 bool Object::isObjectInInRangeObjectsSet(Object* pObj)
 {
-    // Do not use std::find here - if something is added to or removed from the in range vector at the same time
-    // the std::find causes a crash because vector iterator is out of range.
-    // Tested with transports and gameobjects -Appled
-    for (const auto& inRangeObj : mInRangeObjectsSet)
-    {
-        if (inRangeObj == pObj)
-            return true;
-    }
-
-    return false;
+    return mInRangeObjectsSet.contains(pObj);
 }
 
 void Object::removeObjectFromInRangeObjectsSet(Object* pObj)
@@ -1434,17 +1422,17 @@ void Object::removeObjectFromInRangeObjectsSet(Object* pObj)
     ARCEMU_ASSERT(pObj != nullptr);
 
     if (pObj->isPlayer())
-        mInRangePlayersSet.erase(std::remove(mInRangePlayersSet.begin(), mInRangePlayersSet.end(), pObj), mInRangePlayersSet.end());
+        mInRangePlayersSet.erase(pObj);
 
-    mInRangeObjectsSet.erase(std::remove(mInRangeObjectsSet.begin(), mInRangeObjectsSet.end(), pObj), mInRangeObjectsSet.end());
+    mInRangeObjectsSet.erase(pObj);
 
     onRemoveInRangeObject(pObj);
 }
 
 // Players
-std::vector<Object*> Object::getInRangePlayersSet()
+InRangeSet::View Object::getInRangePlayersSet()
 {
-    return mInRangePlayersSet;
+    return mInRangePlayersSet.view();
 }
 
 size_t Object::getInRangePlayersCount()
@@ -1453,41 +1441,33 @@ size_t Object::getInRangePlayersCount()
 }
 
 // Opposite Faction
-std::vector<Object*> Object::getInRangeOppositeFactionSet()
+InRangeSet::View Object::getInRangeOppositeFactionSet()
 {
-    return mInRangeOppositeFactionSet;
+    return mInRangeOppositeFactionSet.view();
 }
 
 bool Object::isObjectInInRangeOppositeFactionSet(Object* pObj)
 {
-    auto it = std::find(mInRangeOppositeFactionSet.begin(), mInRangeOppositeFactionSet.end(), pObj);
-    return it != mInRangeOppositeFactionSet.end();
+    return mInRangeOppositeFactionSet.contains(pObj);
 }
 
 void Object::updateInRangeOppositeFactionSet()
 {
     mInRangeOppositeFactionSet.clear();
 
-    for (const auto& itr : mInRangeObjectsSet)
+    for (const auto& itr : mInRangeObjectsSet.view())
     {
-        if (itr)
+        if (itr->isCreatureOrPlayer() || itr->isGameObject())
         {
-            if (itr->isCreatureOrPlayer() || itr->isGameObject())
+            if (isHostile(this, itr))
             {
-                if (isHostile(this, itr))
-                {
-                    if (!itr->isObjectInInRangeOppositeFactionSet(this))
-                        itr->mInRangeOppositeFactionSet.push_back(this);
-                    if (!isObjectInInRangeOppositeFactionSet(itr))
-                        mInRangeOppositeFactionSet.push_back(itr);
-                }
-                else
-                {
-                    if (itr->isObjectInInRangeOppositeFactionSet(this))
-                        itr->mInRangeOppositeFactionSet.erase(std::remove(itr->mInRangeOppositeFactionSet.begin(), itr->mInRangeOppositeFactionSet.end(), this), itr->mInRangeOppositeFactionSet.end());
-                    if (isObjectInInRangeOppositeFactionSet(itr))
-                        mInRangeOppositeFactionSet.erase(std::remove(mInRangeOppositeFactionSet.begin(), mInRangeOppositeFactionSet.end(), itr), mInRangeOppositeFactionSet.end());
-                }
+                itr->mInRangeOppositeFactionSet.insert(this);
+                mInRangeOppositeFactionSet.insert(itr);
+            }
+            else
+            {
+                itr->mInRangeOppositeFactionSet.erase(this);
+                mInRangeOppositeFactionSet.erase(itr);
             }
         }
     }
@@ -1495,52 +1475,42 @@ void Object::updateInRangeOppositeFactionSet()
 
 void Object::addInRangeOppositeFaction(Object* obj)
 {
-    mInRangeOppositeFactionSet.push_back(obj);
+    mInRangeOppositeFactionSet.insert(obj);
 }
 
 void Object::removeObjectFromInRangeOppositeFactionSet(Object* obj)
 {
-    mInRangeOppositeFactionSet.erase(std::remove(mInRangeOppositeFactionSet.begin(), mInRangeOppositeFactionSet.end(), obj), mInRangeOppositeFactionSet.end());
+    mInRangeOppositeFactionSet.erase(obj);
 }
 
 // Same Faction
-std::vector<Object*> Object::getInRangeSameFactionSet()
+InRangeSet::View Object::getInRangeSameFactionSet()
 {
-    return mInRangeSameFactionSet;
+    return mInRangeSameFactionSet.view();
 }
 
 bool Object::isObjectInInRangeSameFactionSet(Object* pObj)
 {
-    auto it = std::find(mInRangeSameFactionSet.begin(), mInRangeSameFactionSet.end(), pObj);
-    return it != mInRangeSameFactionSet.end();
+    return mInRangeSameFactionSet.contains(pObj);
 }
 
 void Object::updateInRangeSameFactionSet()
 {
     mInRangeSameFactionSet.clear();
 
-    for (const auto& itr : mInRangeObjectsSet)
+    for (const auto& itr : mInRangeObjectsSet.view())
     {
-        if (itr)
+        if (itr->isCreatureOrPlayer() || itr->isGameObject())
         {
-            if (itr->isCreatureOrPlayer() || itr->isGameObject())
+            if (isFriendly(this, itr))
             {
-                if (isFriendly(this, itr))
-                {
-                    if (!itr->isObjectInInRangeSameFactionSet(this))
-                        itr->mInRangeSameFactionSet.push_back(this);
-
-                    if (!isObjectInInRangeOppositeFactionSet(itr))
-                        mInRangeSameFactionSet.push_back(itr);
-                }
-                else
-                {
-                    if (itr->isObjectInInRangeSameFactionSet(this))
-                        itr->mInRangeSameFactionSet.erase(std::remove(itr->mInRangeSameFactionSet.begin(), itr->mInRangeSameFactionSet.end(), this), itr->mInRangeSameFactionSet.end());
-
-                    if (isObjectInInRangeSameFactionSet(itr))
-                        mInRangeSameFactionSet.erase(std::remove(mInRangeSameFactionSet.begin(), mInRangeSameFactionSet.end(), itr), mInRangeSameFactionSet.end());
-                }
+                itr->mInRangeSameFactionSet.insert(this);
+                mInRangeSameFactionSet.insert(itr);
+            }
+            else
+            {
+                itr->mInRangeSameFactionSet.erase(this);
+                mInRangeSameFactionSet.erase(itr);
             }
         }
     }
@@ -1548,12 +1518,12 @@ void Object::updateInRangeSameFactionSet()
 
 void Object::addInRangeSameFaction(Object* obj)
 {
-    mInRangeSameFactionSet.push_back(obj);
+    mInRangeSameFactionSet.insert(obj);
 }
 
 void Object::removeObjectFromInRangeSameFactionSet(Object* obj)
 {
-    mInRangeSameFactionSet.erase(std::remove(mInRangeSameFactionSet.begin(), mInRangeSameFactionSet.end(), obj), mInRangeSameFactionSet.end());
+    mInRangeSameFactionSet.erase(obj);
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -1589,6 +1559,7 @@ Object::Object() : m_position(0, 0, 0, 0), m_spawnLocation(0, 0, 0, 0)
 
     m_mapMgr = nullptr;
     m_mapCell_x = m_mapCell_y = uint32(-1);
+    m_mapCellVisibilityIndex = uint32(-1);
 
     m_factionTemplate = nullptr;
     m_factionEntry = nullptr;
@@ -3161,7 +3132,8 @@ bool Object::SetPosition(float newX, float newY, float newZ, float newOrientatio
 
     //if (m_position.x != newX || m_position.y != newY)
     //updateMap = true;
-    if (m_lastMapUpdatePosition.Distance2DSq({ newX, newY }) > 4.0f) /* 2.0f */
+    const float visibilityUpdateDistance = worldConfig.performance.visibilityUpdateDistance;
+    if (m_lastMapUpdatePosition.Distance2DSq({ newX, newY }) > visibilityUpdateDistance * visibilityUpdateDistance)
         updateMap = true;
 
     m_position.ChangeCoords({ newX, newY, newZ, newOrientation });
@@ -3802,7 +3774,7 @@ void Object::OutPacketToSet(uint16 Opcode, uint16 Len, const void* Data, bool /*
         return;
 
     // We are on Object level, which means we can't send it to ourselves so we only send to Players inrange
-    for (const auto& itr : mInRangePlayersSet)
+    for (const auto& itr : mInRangePlayersSet.view())
     {
         if (itr)
             itr->OutPacket(Opcode, Len, Data);
@@ -3815,17 +3787,18 @@ void Object::SendMessageToSet(WorldPacket* data, bool /*bToSelf*/, bool /*myteam
         return;
 
     uint32 myphase = GetPhase();
-    for (const auto& itr : mInRangePlayersSet)
+    SharedWorldPacket sharedPacket;
+    for (const auto& itr : mInRangePlayersSet.view())
     {
         if (itr && (itr->GetPhase() & myphase) != 0)
-            itr->SendPacket(data);
+            static_cast<Player*>(itr)->SendBroadcastPacket(data, sharedPacket);
     }
 }
 
 void Object::SendCreatureChatMessageInRange(Creature* creature, uint32_t textId, Unit* target/* = nullptr*/)
 {
     uint32 myphase = GetPhase();
-    for (const auto& itr : mInRangePlayersSet)
+    for (const auto& itr : mInRangePlayersSet.view())
     {
         Object* object = itr;
         if (object && (object->GetPhase() & myphase) != 0)
@@ -28,6 +28,7 @@
 #include "CommonTypes.hpp"
 #include "Server/EventableObject.h"
 #include "Server/IUpdatable.h"
+#include "Objects/InRangeSet.h"
 
 #include <set>
 #include <map>
@@ -245,10 +246,10 @@ public:
     //////////////////////////////////////////////////////////////////////////////////////////
     // InRange sets
 private:
-    std::vector<Object*> mInRangeObjectsSet;
-    std::vector<Object*> mInRangePlayersSet;
-    std::vector<Object*> mInRangeOppositeFactionSet;
-    std::vector<Object*> mInRangeSameFactionSet;
+    InRangeSet mInRangeObjectsSet;
+    InRangeSet mInRangePlayersSet;
+    InRangeSet mInRangeOppositeFactionSet;
+    InRangeSet mInRangeSameFactionSet;
 
 public:
     // general
@@ -258,8 +259,11 @@ public:
 
     void removeSelfFromInrangeSets();
 
+    // The getInRange...Set functions return a view of the set instead of a copy, iterate it directly.
+    // Objects leaving the range while it is iterated are skipped, see InRangeSet.
+
     // Objects
-    std::vector<Object*> getInRangeObjectsSet();
+    InRangeSet::View getInRangeObjectsSet();
 
     bool hasInRangeObjects();
     size_t getInRangeObjectsCount();
@@ -268,13 +272,13 @@ public:
     void removeObjectFromInRangeObjectsSet(Object* pObj);
 
     // Players
-    std::vector<Object*> getInRangePlayersSet();
+    InRangeSet::View getInRangePlayersSet();
 
     size_t getInRangePlayersCount();
 
 
     // Opposite Faction
-    std::vector<Object*> getInRangeOppositeFactionSet();
+    InRangeSet::View getInRangeOppositeFactionSet();
 
     bool isObjectInInRangeOppositeFactionSet(Object* pObj);
     void updateInRangeOppositeFactionSet();
@@ -283,7 +287,7 @@ public:
     void removeObjectFromInRangeOppositeFactionSet(Object* obj);
 
     // same faction
-    std::vector<Object*> getInRangeSameFactionSet();
+    InRangeSet::View getInRangeSameFactionSet();
 
     bool isObjectInInRangeSameFactionSet(Object* pObj);
     void updateInRangeSameFactionSet();
@@ -443,6 +447,9 @@ public:
     uint32 GetMapCellY() { return m_mapCell_y; }
         // Only for MapMgr use
         void SetMapCell(MapCell* cell);
+        // Only for MapCell use - slot in the visibility arrays of the current cell
+        uint32 getMapCellVisibilityIndex() const { return m_mapCellVisibilityIndex; }
+        void setMapCellVisibilityIndex(uint32 index) { m_mapCellVisibilityIndex = index; }
         // Only for MapMgr use
         MapMgr* GetMapMgr() const { return m_mapMgr; }
 
@@ -695,6 +702,7 @@ public:
         MapMgr* m_mapMgr;
         // Current map cell row and column
         uint32 m_mapCell_x, m_mapCell_y;
+        uint32 m_mapCellVisibilityIndex;
 
         // Main Function called by isInFront();
         bool inArc(float Position1X, float Position1Y, float FOV, float Orientation, float Position2X, float Position2Y);
@@ -0,0 +1,37 @@
+/*
+Copyright (c) 2014-2021 AscEmu Team <http://www.ascemu.org>
+This file is released under the MIT license. See README-MIT for more information.
+*/
+
+#include "CharacterDatabaseStatements.hpp"
+#include "Database/Database.h"
+
+void registerCharacterDatabaseStatements(Database& characterDatabase)
+{
+    // 95 columns of the characters table
+    characterDatabase.registerPreparedStatement(CHAR_REP_CHARACTER, "REPLACE INTO characters VALUES ("
+        "?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, "
+        "?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, "
+        "?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, "
+        "?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, "
+        "?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)");
+
+    characterDatabase.registerPreparedStatement(CHAR_SEL_CHARACTER_LOGIN, "SELECT * FROM characters WHERE guid = ? AND login_flags = ?");
+    characterDatabase.registerPreparedStatement(CHAR_SEL_CHARACTER_TUTORIALS, "SELECT * FROM tutorials WHERE playerId = ?");
+    characterDatabase.registerPreparedStatement(CHAR_SEL_CHARACTER_COOLDOWNS, "SELECT cooldown_type, cooldown_misc, cooldown_expire_time, cooldown_spellid, cooldown_itemid FROM playercooldowns WHERE player_guid = ?");
+    characterDatabase.registerPreparedStatement(CHAR_SEL_CHARACTER_QUESTLOG, "SELECT * FROM questlog WHERE player_guid = ?");
+    characterDatabase.registerPreparedStatement(CHAR_SEL_CHARACTER_ITEMS, "SELECT * FROM playeritems WHERE ownerguid = ? ORDER BY containerslot ASC");
+    characterDatabase.registerPreparedStatement(CHAR_SEL_CHARACTER_PETS, "SELECT * FROM playerpets WHERE ownerguid = ? ORDER BY petnumber");
+    characterDatabase.registerPreparedStatement(CHAR_SEL_CHARACTER_SUMMON_SPELLS, "SELECT * FROM playersummonspells where ownerguid = ? ORDER BY entryid");
+    characterDatabase.registerPreparedStatement(CHAR_SEL_CHARACTER_MAILBOX, "SELECT * FROM mailbox WHERE player_guid = ?");
+    characterDatabase.registerPreparedStatement(CHAR_SEL_CHARACTER_FRIENDS, "SELECT friend_guid, note FROM social_friends WHERE character_guid = ?");
+    characterDatabase.registerPreparedStatement(CHAR_SEL_CHARACTER_FRIENDS_FOR, "SELECT character_guid FROM social_friends WHERE friend_guid = ?");
+    characterDatabase.registerPreparedStatement(CHAR_SEL_CHARACTER_IGNORES, "SELECT ignore_guid FROM social_ignores WHERE character_guid = ?");
+    characterDatabase.registerPreparedStatement(CHAR_SEL_CHARACTER_EQUIPMENT_SETS, "SELECT * FROM equipmentsets WHERE ownerguid = ?");
+    characterDatabase.registerPreparedStatement(CHAR_SEL_CHARACTER_REPUTATIONS, "SELECT faction, flag, basestanding, standing FROM playerreputations WHERE guid = ?");
+    characterDatabase.registerPreparedStatement(CHAR_SEL_CHARACTER_SPELLS, "SELECT SpellID FROM playerspells WHERE GUID = ?");
+    characterDatabase.registerPreparedStatement(CHAR_SEL_CHARACTER_DELETED_SPELLS, "SELECT SpellID FROM playerdeletedspells WHERE GUID = ?");
+    characterDatabase.registerPreparedStatement(CHAR_SEL_CHARACTER_SKILLS, "SELECT SkillID, CurrentValue, MaximumValue FROM playerskills WHERE GUID = ?");
+    characterDatabase.registerPreparedStatement(CHAR_SEL_CHARACTER_ACHIEVEMENTS, "SELECT achievement, date FROM character_achievement WHERE guid = ?");
+    characterDatabase.registerPreparedStatement(CHAR_SEL_CHARACTER_ACHIEVEMENT_PROGRESS, "SELECT criteria, counter, date FROM character_achievement_progress WHERE guid = ?");
+}
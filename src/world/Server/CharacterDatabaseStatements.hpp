@@ -0,0 +1,41 @@
+/*
+Copyright (c) 2014-2021 AscEmu Team <http://www.ascemu.org>
+This file is released under the MIT license. See README-MIT for more information.
+*/
+
+#pragma once
+
+#include <cstdint>
+
+class Database;
+
+// Prepared statements of the character database, see registerCharacterDatabaseStatements for the queries
+enum CharacterDatabaseStatements : uint32_t
+{
+    // Player::SaveToDB
+    CHAR_REP_CHARACTER,
+
+    // Player::LoadFromDB, same order as PlayerQuery
+    CHAR_SEL_CHARACTER_LOGIN,
+    CHAR_SEL_CHARACTER_TUTORIALS,
+    CHAR_SEL_CHARACTER_COOLDOWNS,
+    CHAR_SEL_CHARACTER_QUESTLOG,
+    CHAR_SEL_CHARACTER_ITEMS,
+    CHAR_SEL_CHARACTER_PETS,
+    CHAR_SEL_CHARACTER_SUMMON_SPELLS,
+    CHAR_SEL_CHARACTER_MAILBOX,
+    CHAR_SEL_CHARACTER_FRIENDS,
+    CHAR_SEL_CHARACTER_FRIENDS_FOR,
+    CHAR_SEL_CHARACTER_IGNORES,
+    CHAR_SEL_CHARACTER_EQUIPMENT_SETS,
+    CHAR_SEL_CHARACTER_REPUTATIONS,
+    CHAR_SEL_CHARACTER_SPELLS,
+    CHAR_SEL_CHARACTER_DELETED_SPELLS,
+    CHAR_SEL_CHARACTER_SKILLS,
+    CHAR_SEL_CHARACTER_ACHIEVEMENTS,
+    CHAR_SEL_CHARACTER_ACHIEVEMENT_PROGRESS,
+
+    MAX_CHARACTER_DATABASE_STATEMENTS
+};
+
+void registerCharacterDatabaseStatements(Database& characterDatabase);
@@ -15,6 +15,10 @@ This file is released under the MIT license. See README-MIT for more information
 #include "Server/World.h"
 #include "Server/World.Legacy.h"
 #include "Objects/ObjectMgr.h"
+#include "Movement/PathfindingService.h"
+#include "Map/MovementRelay.h"
+#include "Server/UpdateProfiler.h"
+#include "Map/MapScheduler.h"
 
 
 bool handleSendChatAnnounceCommand(BaseConsole* baseConsole, int argumentCount, std::string consoleInput, bool /*isWebClient*/)
@@ -152,6 +156,26 @@ bool handleServerInfoCommand(BaseConsole* baseConsole, int /*argumentCount*/, st
         baseConsole->Write("RAM Usage: %4.2f MB\r\n", sWorld.getRAMUsage());
         baseConsole->Write("SQL Query Cache Size (World): %u queries delayed\r\n", WorldDatabase.GetQueueSize());
         baseConsole->Write("SQL Query Cache Size (Character): %u queries delayed\r\n", CharacterDatabase.GetQueueSize());
+
+        if (worldConfig.performance.enableMovementBatching)
+        {
+            const MovementRelayStatistics statistics = MovementRelay::getStatistics();
+            baseConsole->Write("Movement Relay: %llu packets in %llu socket writes, %llu heartbeats (%llu bytes) throttled\r\n",
+                static_cast<unsigned long long>(statistics.relayedPackets), static_cast<unsigned long long>(statistics.socketWrites),
+                static_cast<unsigned long long>(statistics.throttledPackets), static_cast<unsigned long long>(statistics.throttledBytes));
+        }
+
+        if (sPathfindingService.isEnabled())
+        {
+            const PathfindingStatistics statistics = sPathfindingService.getStatistics();
+            baseConsole->Write("Pathfinding Queue: %u queued (max %u), %llu done, %llu merged, %llu cancelled, %llu map thread fallbacks\r\n",
+                static_cast<uint32_t>(statistics.queueSize), static_cast<uint32_t>(statistics.maxQueueSize), static_cast<unsigned long long>(statistics.completedJobs),
+                static_cast<unsigned long long>(statistics.mergedRequests), static_cast<unsigned long long>(statistics.cancelledJobs),
+                static_cast<unsigned long long>(statistics.fallbackJobs));
+            baseConsole->Write("Pathfinding Latency: %.3fms average, %.3fms max, poly path cache %llu hits / %llu misses\r\n",
+                statistics.averageLatency / 1000.0f, statistics.maxLatency / 1000.0f, static_cast<unsigned long long>(statistics.cacheHits),
+                static_cast<unsigned long long>(statistics.cacheMisses));
+        }
     }
 
     sSocketMgr.ShowStatus();
@@ -159,6 +183,53 @@ bool handleServerInfoCommand(BaseConsole* baseConsole, int /*argumentCount*/, st
     return true;
 }
 
+bool handleProfileCommand(BaseConsole* baseConsole, int /*argumentCount*/, std::string consoleInput, bool /*isWebClient*/)
+{
+    int maxOpcodes = 10;
+    if (!consoleInput.empty())
+        maxOpcodes = std::max(atoi(consoleInput.c_str()), 0);
+
+    for (const auto& line : sUpdateProfiler.getReport(static_cast<size_t>(maxOpcodes)))
+        baseConsole->Write("%s\r\n", line.c_str());
+
+    return true;
+}
+
+bool handleMapLoadCommand(BaseConsole* baseConsole, int /*argumentCount*/, std::string consoleInput, bool /*isWebClient*/)
+{
+    int maxMaps = 20;
+    if (!consoleInput.empty())
+        maxMaps = std::max(atoi(consoleInput.c_str()), 0);
+
+    for (const auto& line : sMapScheduler.getReport(static_cast<size_t>(maxMaps)))
+        baseConsole->Write("%s\r\n", line.c_str());
+
+    return true;
+}
+
+bool handleDatabasePoolCommand(BaseConsole* baseConsole, int /*argumentCount*/, std::string /*consoleInput*/, bool /*isWebClient*/)
+{
+    Database* databases[] = { Database_World, Database_Character };
+    for (Database* database : databases)
+    {
+        const DatabasePoolStatistics statistics = database->getPoolStatistics();
+        const uint64_t waitCount = std::max<uint64_t>(statistics.waitCount, 1);
+        const uint64_t writeCount = std::max<uint64_t>(statistics.keyedWriteCount + statistics.barrierWriteCount, 1);
+
+        baseConsole->Write("%s: %u of %u connections busy, %u callers waiting, %u writes and %u async queries queued\r\n",
+            database->GetDatabaseName().c_str(), statistics.busyConnections, statistics.connectionCount, statistics.waitingCallers,
+            statistics.pendingWrites, statistics.pendingAsyncQueries);
+        baseConsole->Write("    %llu of %llu requests waited for a connection, %.2fms average, %.2fms max\r\n",
+            static_cast<unsigned long long>(statistics.waitCount), static_cast<unsigned long long>(statistics.acquireCount),
+            statistics.totalWaitTime / 1000.0f / waitCount, statistics.maxWaitTime / 1000.0f);
+        baseConsole->Write("    %llu writes by shard key, %llu writes without key (%.1f%%) stopped all writers\r\n",
+            static_cast<unsigned long long>(statistics.keyedWriteCount), static_cast<unsigned long long>(statistics.barrierWriteCount),
+            statistics.barrierWriteCount * 100.0f / writeCount);
+    }
+
+    return true;
+}
+
 bool handleOnlineGmsCommand(BaseConsole* baseConsole, int /*argumentCount*/, std::string /*consoleInput*/, bool /*isWebClient*/)
 {
     baseConsole->Write("There are the following GM's online on this server: \r\n");
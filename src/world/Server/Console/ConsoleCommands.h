@@ -14,6 +14,9 @@ bool handleCreateAccountCommand(BaseConsole* baseConsole, int argumentCount, std
 bool handleAccountPermission(BaseConsole* baseConsole, int argumentCount, std::string consoleInput, bool isWebClient);
 bool handleCancelShutdownCommand(BaseConsole* baseConsole, int /*argumentCount*/, std::string /*consoleInput*/, bool isWebClient);
 bool handleServerInfoCommand(BaseConsole* baseConsole, int /*argumentCount*/, std::string /*consoleInput*/, bool isWebClient);
+bool handleProfileCommand(BaseConsole* baseConsole, int /*argumentCount*/, std::string consoleInput, bool isWebClient);
+bool handleMapLoadCommand(BaseConsole* baseConsole, int /*argumentCount*/, std::string consoleInput, bool isWebClient);
+bool handleDatabasePoolCommand(BaseConsole* baseConsole, int /*argumentCount*/, std::string /*consoleInput*/, bool isWebClient);
 bool handleOnlineGmsCommand(BaseConsole* baseConsole, int /*argumentCount*/, std::string /*consoleInput*/, bool isWebClient);
 bool handleKickPlayerCommand(BaseConsole* baseConsole, int argumentCount, std::string consoleInput, bool isWebClient);
 bool handleMotdCommand(BaseConsole* baseConsole, int argumentCount, std::string consoleInput, bool isWebClient);
@@ -135,6 +135,9 @@ static ConsoleCommand Commands[] =
     { &handleCreateAccountCommand,      "createaccount",    2,  "<accountname> <password>",             "Creates an account X with password y" },
     { &handleCancelShutdownCommand,     "cancel",           0,  "None",                                 "Cancels a pending shutdown." },
     { &handleServerInfoCommand,         "info",             0,  "None",                                 "Return current Server information." },
+    { &handleProfileCommand,            "profile",          1,  "[opcode count]",                       "Shows update times of all maps and the slowest opcode handlers." },
+    { &handleMapLoadCommand,            "maps",             1,  "[map count]",                          "Shows the map scheduler load and the update time share of each map." },
+    { &handleDatabasePoolCommand,       "database",         0,  "None",                                 "Shows the connection use and waiting queries of the databases." },
     { &handleOnlineGmsCommand,          "gms",              0,  "None",                                 "Shows online GMs." },
     { &handleKickPlayerCommand,         "kick",             2,  "<player name> [reason]",               "Kicks player <player name> for optional reason [reason]." },
     { &handleMotdCommand,               "getmotd",          0,  "None",                                 "View the current MOTD" },
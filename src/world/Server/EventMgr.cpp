@@ -22,6 +22,131 @@
 #include "StdAfx.h"
 #include "EventMgr.h"
 
+#include <mutex>
+
+namespace
+{
+    // Free list of TimedEvent sized blocks. Events are released on the map thread that executed them,
+    // so every thread keeps a small cache and only exchanges batches with the shared list.
+    class TimedEventPool
+    {
+    public:
+
+        union Block
+        {
+            Block* next;
+            alignas(TimedEvent) unsigned char storage[sizeof(TimedEvent)];
+        };
+
+        static constexpr size_t chunkSize = 512;
+        static constexpr size_t batchSize = 256;
+        static constexpr size_t threadCacheSize = batchSize * 2;
+
+        struct ThreadCache
+        {
+            Block* head = nullptr;
+            size_t count = 0;
+
+            ~ThreadCache();
+        };
+
+        static TimedEventPool& getInstance()
+        {
+            // never destroyed, thread caches return their blocks on thread exit
+            static TimedEventPool* pool = new TimedEventPool;
+            return *pool;
+        }
+
+        static ThreadCache& getThreadCache()
+        {
+            static thread_local ThreadCache cache;
+            return cache;
+        }
+
+        void* allocate()
+        {
+            ThreadCache& cache = getThreadCache();
+            if (cache.head == nullptr)
+                refill(cache);
+
+            Block* block = cache.head;
+            cache.head = block->next;
+            --cache.count;
+            return block;
+        }
+
+        void release(void* pointer)
+        {
+            ThreadCache& cache = getThreadCache();
+
+            Block* block = static_cast<Block*>(pointer);
+            block->next = cache.head;
+            cache.head = block;
+
+            if (++cache.count > threadCacheSize)
+                flush(cache, batchSize);
+        }
+
+        void flush(ThreadCache& cache, size_t count)
+        {
+            if (cache.head == nullptr)
+                return;
+
+            Block* first = cache.head;
+            Block* last = first;
+            size_t moved = 1;
+            while (moved < count && last->next != nullptr)
+            {
+                last = last->next;
+                ++moved;
+            }
+
+            cache.head = last->next;
+            cache.count -= moved;
+
+            std::lock_guard<std::mutex> guard(m_mutex);
+            last->next = m_freeList;
+            m_freeList = first;
+        }
+
+    private:
+
+        void refill(ThreadCache& cache)
+        {
+            std::lock_guard<std::mutex> guard(m_mutex);
+
+            if (m_freeList == nullptr)
+            {
+                // chunks are kept for the lifetime of the process
+                Block* chunk = new Block[chunkSize];
+                for (size_t i = 0; i < chunkSize - 1; ++i)
+                    chunk[i].next = &chunk[i + 1];
+
+                chunk[chunkSize - 1].next = nullptr;
+                m_freeList = chunk;
+            }
+
+            while (m_freeList != nullptr && cache.count < batchSize)
+            {
+                Block* block = m_freeList;
+                m_freeList = block->next;
+
+                block->next = cache.head;
+                cache.head = block;
+                ++cache.count;
+            }
+        }
+
+        std::mutex m_mutex;
+        Block* m_freeList = nullptr;
+    };
+
+    TimedEventPool::ThreadCache::~ThreadCache()
+    {
+        TimedEventPool::getInstance().flush(*this, count);
+    }
+}
+
 EventMgr& EventMgr::getInstance()
 {
     static EventMgr mInstance;
@@ -32,3 +157,14 @@ TimedEvent* TimedEvent::Allocate(void* object, CallbackBase* callback, uint32 fl
 {
     return new TimedEvent(object, callback, flags, time, repeat, 0);
 }
+
+void* TimedEvent::operator new(size_t /*size*/)
+{
+    return TimedEventPool::getInstance().allocate();
+}
+
+void TimedEvent::operator delete(void* pointer)
+{
+    if (pointer != nullptr)
+        TimedEventPool::getInstance().release(pointer);
+}
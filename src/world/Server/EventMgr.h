@@ -22,6 +22,7 @@
 #define EVENTMGR_H
 
 #include "CallBack.h"
+#include <atomic>
 #include <map>
 
 enum EventTypes
@@ -261,14 +262,23 @@ struct SERVER_DECL TimedEvent
     uint32 eventType;
     uint16 eventFlag;
     time_t msTime;
+    /// time left when the event was (re)scheduled, use EventableObject::event_GetTimeLeft for the current value
     time_t currTime;
     uint16 repeats;
     bool deleted;
     int instanceId;
     std::atomic<unsigned long> ref;
 
+    /// set by EventableObjectHolder, 0 while the event waits in the insert pool
+    std::atomic<uint64_t> expireTime{ 0 };
+    std::atomic<uint32_t> scheduleId{ 0 };
+
     static TimedEvent* Allocate(void* object, CallbackBase* callback, uint32 flags, time_t time, uint32 repeat);
 
+    /// TimedEvents are taken from a pool, they are created and released far too often for the default allocator
+    static void* operator new(size_t size);
+    static void operator delete(void* pointer);
+
 
     void DecRef()
     {
@@ -185,6 +185,10 @@ void EventableObject::event_ModifyTimeLeft(uint32 EventType, time_t TimeLeft, bo
             if (unconditioned)
                 itr->second->currTime = TimeLeft;
             else itr->second->currTime = (TimeLeft > itr->second->msTime) ? itr->second->msTime : TimeLeft;
+
+            if (m_holder != nullptr && !itr->second->deleted)
+                m_holder->AddEvent(itr->second);
+
             ++itr;
         }
         while (itr != m_events.upper_bound(EventType));
@@ -213,7 +217,7 @@ bool EventableObject::event_GetTimeLeft(uint32 EventType, time_t* Time)
                 continue;
             }
 
-            *Time = (uint32)itr->second->currTime;
+            *Time = (uint32)(m_holder != nullptr ? m_holder->GetTimeLeft(itr->second) : itr->second->currTime);
             m_lock.Release();
             return true;
 
@@ -263,6 +267,10 @@ void EventableObject::event_ModifyTimeAndTimeLeft(uint32 EventType, time_t Time)
         do
         {
             itr->second->currTime = itr->second->msTime = Time;
+
+            if (m_holder != nullptr && !itr->second->deleted)
+                m_holder->AddEvent(itr->second);
+
             ++itr;
         }
         while (itr != m_events.upper_bound(EventType));
@@ -302,8 +310,11 @@ bool EventableObject::event_HasEvent(uint32 EventType)
     return ret;
 }
 
-EventableObjectHolder::EventableObjectHolder(int32 instance_id) : mInstanceId(instance_id)
+EventableObjectHolder::EventableObjectHolder(int32 instance_id) : mInstanceId(instance_id), m_wheelEntryCount(0), m_wheelTime(0), m_isUpdating(false), m_updateEndTime(0)
 {
+    for (uint32 level = 0; level < WHEEL_LEVELS; ++level)
+        m_wheel[level].resize(getLevelMask(level) + 1);
+
     m_insertPool.clear();
     sEventMgr.AddEventHolder(this, instance_id);
 }
@@ -313,16 +324,24 @@ EventableObjectHolder::~EventableObjectHolder()
     sEventMgr.RemoveEventHolder(this);
 
     m_insertPoolLock.Acquire();
-    EventList::iterator insertPoolItr = m_insertPool.begin();
+    InsertableQueue::iterator insertPoolItr = m_insertPool.begin();
     for (; insertPoolItr != m_insertPool.end(); ++insertPoolItr)
         (*insertPoolItr)->DecRef();
     m_insertPoolLock.Release();
 
     /* decrement events reference count */
     m_lock.Acquire();
-    EventList::iterator itr = m_events.begin();
-    for (; itr != m_events.end(); ++itr)
-        (*itr)->DecRef();
+    for (uint32 level = 0; level < WHEEL_LEVELS; ++level)
+    {
+        for (auto& slot : m_wheel[level])
+        {
+            for (auto& entry : slot)
+                entry.event->DecRef();
+
+            slot.clear();
+        }
+    }
+    m_wheelEntryCount = 0;
     m_lock.Release();
 }
 
@@ -332,92 +351,205 @@ void EventableObjectHolder::Update(time_t time_difference)
 
     /* Insert any pending objects in the insert pool. */
     m_insertPoolLock.Acquire();
-    InsertableQueue::iterator iqi;
-    InsertableQueue::iterator iq2 = m_insertPool.begin();
-    while (iq2 != m_insertPool.end())
-    {
-        iqi = iq2++;
-        if ((*iqi)->deleted || (*iqi)->instanceId != mInstanceId)
-            (*iqi)->DecRef();
-        else
-            m_events.push_back((*iqi));
-
-        m_insertPool.erase(iqi);
-    }
+    InsertableQueue pendingEvents;
+    pendingEvents.swap(m_insertPool);
     m_insertPoolLock.Release();
 
-    /* Now we can proceed normally. */
-    EventList::iterator itr = m_events.begin();
-    EventList::iterator it2;
-    TimedEvent* ev;
+    for (auto ev : pendingEvents)
+        _ScheduleEvent(ev);
 
-    while (itr != m_events.end())
+    if (time_difference > 0)
     {
-        it2 = itr++;
+        m_isUpdating = true;
+        m_updateEndTime = m_wheelTime + time_difference;
 
-        if ((*it2)->instanceId != mInstanceId || (*it2)->deleted)
+        while (m_wheelTime < m_updateEndTime)
         {
+            // nothing left to expire, skip the remaining ticks
+            if (m_wheelEntryCount == 0)
+            {
+                m_wheelTime = m_updateEndTime;
+                break;
+            }
 
-            (*it2)->DecRef();
+            const uint64 tick = ++m_wheelTime;
 
-            // remove from this list.
-            m_events.erase(it2);
+            // move the entries of the coarser levels down before the slot of this tick is executed
+            if ((tick & getLevelMask(0)) == 0)
+            {
+                uint32 level = 1;
+                while (level < WHEEL_LEVELS - 1 && ((tick >> getLevelShift(level)) & getLevelMask(level)) == 0)
+                    ++level;
 
-            continue;
+                for (; level > 0; --level)
+                    _CascadeSlot(level);
+            }
+
+            _ExecuteSlot();
         }
 
-        // Event Update Procedure
-        ev = *it2;
+        m_isUpdating = false;
+    }
 
-        if (ev->currTime <= time_difference)
-        {
-            // execute the callback
-            if (ev->eventFlag & EVENT_FLAG_DELETES_OBJECT)
-            {
-                m_events.erase(it2);
-                ev->deleted = true;
-                ev->cb->execute();
-                ev->DecRef();
-                continue;
-            }
-            else
-                ev->cb->execute();
+    m_lock.Release();
+}
 
-            // check if the event is expired now.
-            if (ev->repeats && --ev->repeats == 0)
-            {
-                // Event expired :>
+time_t EventableObjectHolder::GetTimeLeft(TimedEvent* ev) const
+{
+    const uint64 expireTime = ev->expireTime;
 
-                /* remove the event from the object */
-                /*obj = (EventableObject*)ev->obj;
-                obj->event_RemoveByPointer(ev);*/
+    // still waiting in the insert pool
+    if (expireTime == 0)
+        return ev->currTime;
 
-                /* remove the event from here */
-                ev->deleted = true;
-                ev->DecRef();
-                m_events.erase(it2);
+    const uint64 now = m_wheelTime;
+    return expireTime > now ? static_cast<time_t>(expireTime - now) : 0;
+}
 
-                continue;
-            }
-            else if (ev->deleted)
-            {
-                // event is now deleted
-                ev->DecRef(); //this was added on "addevent"
-                m_events.erase(it2);
-                continue;
-            }
+void EventableObjectHolder::_ScheduleEvent(TimedEvent* ev)
+{
+    if (ev->deleted || ev->instanceId != mInstanceId)
+    {
+        ev->DecRef();
+        return;
+    }
+
+    const uint64 baseTime = m_isUpdating ? m_updateEndTime : m_wheelTime.load();
+    uint64 expireTime = baseTime + (ev->currTime > 0 ? static_cast<uint64>(ev->currTime) : 0);
+
+    // an event runs at most once per update
+    if (expireTime <= baseTime)
+        expireTime = baseTime + 1;
+
+    ev->expireTime = expireTime;
+
+    WheelEntry entry;
+    entry.event = ev;
+    entry.scheduleId = ++ev->scheduleId;
+
+    _InsertEntry(entry, expireTime);
+    ++m_wheelEntryCount;
+}
+
+void EventableObjectHolder::_InsertEntry(WheelEntry const& entry, uint64 expireTime)
+{
+    const uint64 now = m_wheelTime;
+    uint64 delta = expireTime > now ? expireTime - now : 0;
+
+    // events beyond the range of the wheel are parked in the last slot and cascade again from there
+    if (delta >= (uint64(1) << WHEEL_RANGE_BITS))
+    {
+        delta = (uint64(1) << WHEEL_RANGE_BITS) - 1;
+        expireTime = now + delta;
+    }
 
-            // event has to repeat again, reset the timer
-            ev->currTime = ev->msTime;
+    uint32 level = 0;
+    while (level < WHEEL_LEVELS - 1 && delta >= (uint64(1) << getLevelShift(level + 1)))
+        ++level;
+
+    const uint64 index = (expireTime >> getLevelShift(level)) & getLevelMask(level);
+    m_wheel[level][index].push_back(entry);
+}
+
+bool EventableObjectHolder::_IsOutdated(WheelEntry const& entry) const
+{
+    return entry.event->deleted || entry.event->instanceId != mInstanceId || entry.event->scheduleId != entry.scheduleId || entry.event->expireTime == 0;
+}
+
+void EventableObjectHolder::_MarkPending(TimedEvent* ev)
+{
+    // the event can still be linked in a wheel that is updated right now, the new schedule id drops
+    // that entry instead of executing it with the cleared expire time
+    ++ev->scheduleId;
+    ev->expireTime = 0;
+}
+
+void EventableObjectHolder::_CascadeSlot(uint32 level)
+{
+    const uint64 index = (m_wheelTime >> getLevelShift(level)) & getLevelMask(level);
+
+    WheelSlot entries;
+    entries.swap(m_wheel[level][index]);
+
+    for (auto& entry : entries)
+    {
+        if (_IsOutdated(entry))
+        {
+            entry.event->DecRef();
+            --m_wheelEntryCount;
+            continue;
         }
-        else
+
+        _InsertEntry(entry, entry.event->expireTime);
+    }
+}
+
+void EventableObjectHolder::_ExecuteSlot()
+{
+    WheelSlot& slot = m_wheel[0][m_wheelTime & getLevelMask(0)];
+    if (slot.empty())
+        return;
+
+    // callbacks add new events, take the entries out of the wheel before executing them
+    WheelSlot entries;
+    entries.swap(slot);
+
+    for (auto& entry : entries)
+    {
+        if (_IsOutdated(entry))
+        {
+            entry.event->DecRef();
+            --m_wheelEntryCount;
+            continue;
+        }
+
+        if (entry.event->expireTime > m_wheelTime)
         {
-            // event is still "waiting", subtract time difference
-            ev->currTime -= time_difference;
+            _InsertEntry(entry, entry.event->expireTime);
+            continue;
         }
+
+        --m_wheelEntryCount;
+        _ExecuteEvent(entry.event);
     }
 
-    m_lock.Release();
+    // keep the capacity of the slot
+    entries.clear();
+    if (slot.empty())
+        slot.swap(entries);
+}
+
+void EventableObjectHolder::_ExecuteEvent(TimedEvent* ev)
+{
+    // execute the callback
+    if (ev->eventFlag & EVENT_FLAG_DELETES_OBJECT)
+    {
+        ev->deleted = true;
+        ev->cb->execute();
+        ev->DecRef();
+        return;
+    }
+
+    ev->cb->execute();
+
+    // check if the event is expired now.
+    if (ev->repeats && --ev->repeats == 0)
+    {
+        // Event expired :>
+        ev->deleted = true;
+        ev->DecRef();
+        return;
+    }
+    else if (ev->deleted)
+    {
+        // event is now deleted
+        ev->DecRef(); //this was added on "addevent"
+        return;
+    }
+
+    // event has to repeat again, reset the timer
+    ev->currTime = ev->msTime;
+    _ScheduleEvent(ev);
 }
 
 void EventableObject::event_Relocate()
@@ -431,6 +563,13 @@ void EventableObject::event_Relocate()
         // whee, we changed event holder :>
         // doing this will change the instanceid on all the events, as well as add to the new holder.
 
+        // the new holder schedules the events by their time left, its clock is not the one of the old holder
+        if (m_holder != nullptr)
+        {
+            for (EventMap::iterator itr = m_events.begin(); itr != m_events.end(); ++itr)
+                itr->second->currTime = m_holder->GetTimeLeft(itr->second);
+        }
+
         //If nh is NULL then we were removed from world. There's no reason to be added to WORLD_INSTANCE EventMgr, let's just wait till something will add us again to world.
         if (nh == NULL)
         {
@@ -475,12 +614,13 @@ void EventableObjectHolder::AddEvent(TimedEvent* ev)
     if (!m_lock.AttemptAcquire())
     {
         m_insertPoolLock.Acquire();
+        _MarkPending(ev);
         m_insertPool.push_back(ev);
         m_insertPoolLock.Release();
     }
     else
     {
-        m_events.push_back(ev);
+        _ScheduleEvent(ev);
         m_lock.Release();
     }
 }
@@ -493,21 +633,16 @@ void EventableObjectHolder::AddObject(EventableObject* obj)
         // The other thread is obviously occupied. We have to use an insert pool here, otherwise
         // if 2 threads relocate at once we'll hit a deadlock situation.
         m_insertPoolLock.Acquire();
-        EventMap::iterator it2;
 
         for (EventMap::iterator itr = obj->m_events.begin(); itr != obj->m_events.end(); ++itr)
         {
             // ignore deleted events (shouldn't be any in here, actually)
             if (itr->second->deleted)
-            {
-                /*it2 = itr++;
-                itr->second->DecRef();
-                obj->m_events.erase(it2);*/
                 continue;
-            }
 
             itr->second->IncRef();
             itr->second->instanceId = mInstanceId;
+            _MarkPending(itr->second);
             m_insertPool.push_back(itr->second);
         }
 
@@ -527,7 +662,7 @@ void EventableObjectHolder::AddObject(EventableObject* obj)
 
             itr->second->IncRef();
             itr->second->instanceId = mInstanceId;
-            m_events.push_back(itr->second);
+            _ScheduleEvent(itr->second);
         }
         m_lock.Release();
     }
@@ -23,8 +23,10 @@
 
 #include "EventMgr.h"
 #include "../shared/Util.hpp"
+#include <atomic>
 #include <list>
 #include <set>
+#include <vector>
 
 class EventableObjectHolder;
 
@@ -91,6 +93,8 @@ typedef std::set<EventableObject*> EventableObjectSet;
 /// from one holder to another (changing maps / instances).
 /// EventableObjectHolder also updates all the timed events in all of its objects when its
 /// update function is called.
+/// Events are kept in a hierarchical timing wheel with a resolution of 1ms, an update only touches
+/// the events that expire (or move down to a finer level of the wheel) during its time difference.
 //////////////////////////////////////////////////////////////////////////////////////////
 class EventableObjectHolder
 {
@@ -101,16 +105,55 @@ class EventableObjectHolder
 
         void Update(time_t time_difference);
 
+        /// schedules the event to run ev->currTime ms from now, an event already scheduled in this holder is moved
         void AddEvent(TimedEvent* ev);
         void AddObject(EventableObject* obj);
 
+        /// time in ms until the event is executed by this holder
+        time_t GetTimeLeft(TimedEvent* ev) const;
+
         uint32 GetInstanceID() { return mInstanceId; }
 
     protected:
 
+        static const uint32 WHEEL_LEVELS = 4;
+        static const uint32 WHEEL_LEVEL_0_BITS = 8;
+        static const uint32 WHEEL_LEVEL_BITS = 6;
+        static const uint32 WHEEL_RANGE_BITS = WHEEL_LEVEL_0_BITS + (WHEEL_LEVELS - 1) * WHEEL_LEVEL_BITS;
+
+        /// an entry is outdated when the event was scheduled again after it had been added
+        struct WheelEntry
+        {
+            TimedEvent* event;
+            uint32 scheduleId;
+        };
+        typedef std::vector<WheelEntry> WheelSlot;
+
+        static uint32 getLevelShift(uint32 level) { return level == 0 ? 0 : WHEEL_LEVEL_0_BITS + (level - 1) * WHEEL_LEVEL_BITS; }
+        static uint32 getLevelMask(uint32 level) { return level == 0 ? (1u << WHEEL_LEVEL_0_BITS) - 1 : (1u << WHEEL_LEVEL_BITS) - 1; }
+
+        // m_lock must be held by the caller
+        void _ScheduleEvent(TimedEvent* ev);
+        void _InsertEntry(WheelEntry const& entry, uint64 expireTime);
+        bool _IsOutdated(WheelEntry const& entry) const;
+
+        /// called without m_lock for events going to the insert pool, any entry left in a wheel is dropped
+        static void _MarkPending(TimedEvent* ev);
+        void _CascadeSlot(uint32 level);
+        void _ExecuteSlot();
+        void _ExecuteEvent(TimedEvent* ev);
+
         int32 mInstanceId;
         Mutex m_lock;
-        EventList m_events;
+
+        std::vector<WheelSlot> m_wheel[WHEEL_LEVELS];
+        size_t m_wheelEntryCount;
+        /// only advanced by the updating thread, GetTimeLeft reads it from other threads
+        std::atomic<uint64> m_wheelTime;
+
+        /// events scheduled during an update are timed from its end, like they always were
+        bool m_isUpdating;
+        uint64 m_updateEndTime;
 
         Mutex m_insertPoolLock;
         typedef std::list<TimedEvent*> InsertableQueue;
@@ -26,6 +26,7 @@
 #include "Server/Console/ConsoleThread.h"
 #include "Server/MainServerDefines.h"
 #include "Server/Master.h"
+#include "Server/CharacterDatabaseStatements.hpp"
 #include "Server/BroadcastMgr.h"
 #include "Storage/DayWatcherThread.h"
 #include "Management/Channel.h"
@@ -33,6 +34,9 @@
 #include "Management/AddonMgr.h"
 #include "Management/AuctionMgr.h"
 #include "Spell/SpellTarget.h"
+#include "Movement/PathfindingService.h"
+#include "Server/UpdateProfiler.h"
+#include "Map/MapScheduler.h"
 #include "Util.hpp"
 #include "Database/DatabaseUpdater.hpp"
 #include "Packets/SmsgServerMessage.h"
@@ -243,6 +247,9 @@ bool Master::Run(int /*argc*/, char** /*argv*/)
 
     sLogger.setMinimumMessageType(static_cast<AscEmu::Logging::MessageType>(worldConfig.logger.minimumMessageType));
 
+    if (!worldConfig.logger.enableAsyncWrites)
+        sLogger.stopAsyncWriter();
+
     OpenCheatLogFiles();
 
     if (!_StartDB())
@@ -256,6 +263,12 @@ bool Master::Run(int /*argc*/, char** /*argv*/)
 
     checkRequiredDirs();
 
+    if (worldConfig.terrainCollision.isPathfindingEnabled)
+        sPathfindingService.initialize(worldConfig.performance.pathfindingThreads);
+
+    sUpdateProfiler.initialize();
+    sMapScheduler.initialize();
+
     const std::string charDbName = worldConfig.charDb.dbName;
     DatabaseUpdater::initBaseIfNeeded(charDbName, "character", CharacterDatabase);
     DatabaseUpdater::checkAndApplyDBUpdatesIfNeeded("character", CharacterDatabase);
@@ -389,6 +402,9 @@ bool Master::Run(int /*argc*/, char** /*argv*/)
     bServerShutdown = true;
     ThreadPool.Shutdown();
 
+    sLogger.info("MapScheduler : Stopping all maps...");
+    sMapScheduler.finalize();
+
     delete ls;
 
     sWorld.logoutAllPlayers();
@@ -407,6 +423,12 @@ bool Master::Run(int /*argc*/, char** /*argv*/)
     sLogger.info("LootMgr : ~LootMgr()");
     sLootMgr.finalize();
 
+    sLogger.info("PathfindingService : ~PathfindingService()");
+    sPathfindingService.finalize();
+
+    sLogger.info("UpdateProfiler : ~UpdateProfiler()");
+    sUpdateProfiler.finalize();
+
     sLogger.info("World : ~World()");
     sWorld.finalize();
 
@@ -550,6 +572,7 @@ bool Master::_StartDB()
     cdb_result = !cdb_result ? cdb_result : worldConfig.charDb.port != 0;
 
     Database_Character = Database::CreateDatabaseInterface();
+    CharacterDatabase.setWriterCount(worldConfig.performance.characterDatabaseWriters);
 
     if (cdb_result == false)
     {
@@ -565,6 +588,9 @@ bool Master::_StartDB()
         return false;
     }
 
+    registerCharacterDatabaseStatements(CharacterDatabase);
+    CharacterDatabase.startAsyncQueryWorkers(worldConfig.performance.asyncQueryThreads);
+
     return true;
 }
 
@@ -844,7 +870,11 @@ void Master::ShutdownThreadPools(bool listnersockcreate)
 void Master::StartNetworkSubsystem()
 {
     sLogger.info("Network : Starting subsystem...");
+#ifdef CONFIG_USE_EPOLL
+    sSocketMgr.initialize(worldConfig.listen.networkThreads, worldConfig.listen.reusePort);
+#else
     sSocketMgr.initialize();
+#endif
 }
 
 void Master::ShutdownLootSystem()
@@ -9,6 +9,7 @@ This file is released under the MIT license. See README-MIT for more information
 //          happening here ;)
 
 #include "OpcodeTable.hpp"
+#include <limits>
 
 OpcodeTables& OpcodeTables::getInstance()
 {
@@ -20,11 +21,23 @@ void OpcodeTables::initialize()
 {
     std::cout << "OpcodeTables preparing version specific tables." << std::endl;
 
-    // fill vector
-    for (const auto opcodeStore : multiversionOpcodeStore)
-    {   
+    const uint32_t maxInternalId = multiversionOpcodeStore.empty() ? 0 : multiversionOpcodeStore.rbegin()->first;
+
+    for (auto hexIndex = 0; hexIndex < MAX_VERSION_INDEX; ++hexIndex)
+    {
+        _hexToInternalId[hexIndex].assign(std::numeric_limits<uint16_t>::max() + 1, 0);
+        _internalIdToHex[hexIndex].assign(maxInternalId + 1, 0);
+    }
+
+    // fill tables, walk backwards so a hex value used by several internal ids maps to the lowest one
+    for (auto opcodeStore = multiversionOpcodeStore.rbegin(); opcodeStore != multiversionOpcodeStore.rend(); ++opcodeStore)
+    {
         for (auto hexIndex = 0; hexIndex < MAX_VERSION_INDEX; ++hexIndex)
-            _versionHexTable[hexIndex].emplace_back(opcodeStore.second.hexValues[hexIndex], opcodeStore.first);
+        {
+            const uint16_t hexValue = opcodeStore->second.hexValues[hexIndex];
+            _hexToInternalId[hexIndex][hexValue] = opcodeStore->first;
+            _internalIdToHex[hexIndex][opcodeStore->first] = hexValue;
+        }
     }
 
     sizeOfHexTables();
@@ -33,5 +46,8 @@ void OpcodeTables::initialize()
 void OpcodeTables::finalize()
 {
     for (auto hexIndex = 0; hexIndex < MAX_VERSION_INDEX; ++hexIndex)
-        _versionHexTable[hexIndex].clear();
+    {
+        _hexToInternalId[hexIndex].clear();
+        _internalIdToHex[hexIndex].clear();
+    }
 }
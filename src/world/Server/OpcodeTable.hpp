@@ -94,7 +94,7 @@ class SERVER_DECL OpcodeTables
         {
             for (auto versionId = 0; versionId < MAX_VERSION_INDEX; ++versionId)
                 std::cout << "Size of hex store for version [" << getNameForVersionId(versionId) << "]: "
-                        << _versionHexTable[versionId].size() << std::endl;
+                        << _internalIdToHex[versionId].size() << std::endl;
         }
 
         uint32_t getInternalIdForHex(uint16_t hex, int versionId = -1)
@@ -102,9 +102,9 @@ class SERVER_DECL OpcodeTables
             if (versionId == -1 || versionId >= MAX_VERSION_INDEX)
                 versionId = getVersionIdForAEVersion();
 
-            for (const auto table : _versionHexTable[versionId])
-                if (table.hexValue == hex)
-                    return table.internalId;
+            const auto& hexTable = _hexToInternalId[versionId];
+            if (hex < hexTable.size())
+                return hexTable[hex];
 
             return 0;
         }
@@ -133,24 +133,19 @@ class SERVER_DECL OpcodeTables
         {
             if (versionId >= 0 && versionId < MAX_VERSION_INDEX)
             {
-                auto multiversionTable = multiversionOpcodeStore.find(internalId);
-                if (multiversionTable != multiversionOpcodeStore.end())
-                    return multiversionTable->second.hexValues[versionId];
+                const auto& idTable = _internalIdToHex[versionId];
+                if (internalId < idTable.size())
+                    return idTable[internalId];
             }
 
             return 0;
         }
 
-        struct HexToId
-        {
-            HexToId(uint16_t hex, uint32_t intId) :
-                hexValue(hex), internalId(intId){}
-
-            uint16_t hexValue;
-            uint32_t internalId;
-        };
-
-        std::vector<HexToId> _versionHexTable[MAX_VERSION_INDEX];
+        // Direct indexed lookup tables, filled once in initialize()
+        // hex value -> internal id, one entry for every possible uint16_t hex value
+        std::vector<uint32_t> _hexToInternalId[MAX_VERSION_INDEX];
+        // internal id -> hex value
+        std::vector<uint16_t> _internalIdToHex[MAX_VERSION_INDEX];
 };
 
 #define sOpcodeTables OpcodeTables::getInstance()
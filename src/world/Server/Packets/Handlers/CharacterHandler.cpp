@@ -185,13 +185,15 @@ void WorldSession::handlePlayerLoginOpcode(WorldPacket& recvPacket)
 
     sLogger.debug("Received CMSG_PLAYER_LOGIN %u (guidLow)", srlPacket.guid.getGuidLow());
 
-    if (sObjectMgr.GetPlayer(srlPacket.guid.getGuidLow()) != nullptr || m_loggingInPlayer || _player)
+    if (sObjectMgr.GetPlayer(srlPacket.guid.getGuidLow()) != nullptr || m_loggingInPlayer || _player || m_isPlayerLoginPending)
     {
         SendPacket(SmsgCharacterLoginFailed(E_CHAR_LOGIN_DUPLICATE_CHARACTER).serialise().get());
         return;
     }
 
-    const auto query = new AsyncQuery(new SQLClassCallbackP0<WorldSession>(this, &WorldSession::loadPlayerFromDBProc));
+    // the session may be gone when the query is done, the callback looks it up by account
+    m_isPlayerLoginPending = true;
+    const auto query = new AsyncQuery(new SQLClassCallbackP1<World, uint32_t>(&sWorld, &World::loadPlayerFromDBProcForId, GetAccountId()));
     query->AddQuery("SELECT guid,class FROM characters WHERE guid = %u AND login_flags = %u",
         srlPacket.guid.getGuidLow(), static_cast<uint32_t>(LOGIN_NO_FLAG));
     CharacterDatabase.QueueAsyncQuery(query);
@@ -256,6 +258,12 @@ void WorldSession::handleCharRenameOpcode(WorldPacket& recvPacket)
 
 void WorldSession::loadPlayerFromDBProc(QueryResultVector& results)
 {
+    // a new session of the account did not request this login
+    if (!m_isPlayerLoginPending)
+        return;
+
+    m_isPlayerLoginPending = false;
+
     if (results.empty())
     {
         SendPacket(SmsgCharacterLoginFailed(E_CHAR_LOGIN_NO_CHARACTER).serialise().get());
@@ -379,27 +387,29 @@ uint8_t WorldSession::deleteCharacter(WoWGuid guid)
         if (corpse)
             CharacterDatabase.Execute("DELETE FROM corpses WHERE guid = %u", corpse->getGuidLow());
 
-        CharacterDatabase.Execute("DELETE FROM playeritems WHERE ownerguid=%u", guid.getGuidLow());
+        // rows of the character are queued on its writer, behind its last saves
+        CharacterDatabase.Execute(guid.getGuidLow(), "DELETE FROM playeritems WHERE ownerguid=%u", guid.getGuidLow());
         CharacterDatabase.Execute("DELETE FROM gm_tickets WHERE playerguid = %u", guid.getGuidLow());
-        CharacterDatabase.Execute("DELETE FROM playerpets WHERE ownerguid = %u", guid.getGuidLow());
-        CharacterDatabase.Execute("DELETE FROM playerpetspells WHERE ownerguid = %u", guid.getGuidLow());
-        CharacterDatabase.Execute("DELETE FROM tutorials WHERE playerId = %u", guid.getGuidLow());
-        CharacterDatabase.Execute("DELETE FROM questlog WHERE player_guid = %u", guid.getGuidLow());
-        CharacterDatabase.Execute("DELETE FROM playercooldowns WHERE player_guid = %u", guid.getGuidLow());
-        CharacterDatabase.Execute("DELETE FROM mailbox WHERE player_guid = %u", guid.getGuidLow());
+        CharacterDatabase.Execute(guid.getGuidLow(), "DELETE FROM playerpets WHERE ownerguid = %u", guid.getGuidLow());
+        CharacterDatabase.Execute(guid.getGuidLow(), "DELETE FROM playerpetspells WHERE ownerguid = %u", guid.getGuidLow());
+        CharacterDatabase.Execute(guid.getGuidLow(), "DELETE FROM tutorials WHERE playerId = %u", guid.getGuidLow());
+        CharacterDatabase.Execute(guid.getGuidLow(), "DELETE FROM questlog WHERE player_guid = %u", guid.getGuidLow());
+        CharacterDatabase.Execute(guid.getGuidLow(), "DELETE FROM playercooldowns WHERE player_guid = %u", guid.getGuidLow());
+        CharacterDatabase.Execute(guid.getGuidLow(), "DELETE FROM mailbox WHERE player_guid = %u", guid.getGuidLow());
+        // friend and ignore rows of other characters are written by their own saves
         CharacterDatabase.Execute("DELETE FROM social_friends WHERE character_guid = %u OR friend_guid = %u",
             guid.getGuidLow(), guid.getGuidLow());
         CharacterDatabase.Execute("DELETE FROM social_ignores WHERE character_guid = %u OR ignore_guid = %u",
             guid.getGuidLow(), guid.getGuidLow());
-        CharacterDatabase.Execute("DELETE FROM character_achievement WHERE guid = %u AND achievement NOT IN "
+        CharacterDatabase.Execute(guid.getGuidLow(), "DELETE FROM character_achievement WHERE guid = %u AND achievement NOT IN "
             "(457, 467, 466, 465, 464, 463, 462, 461, 460, 459, 458, 1404, 1405, 1406, 1407, 1408, 1409, 1410, 1411, 1412, "
             "1413, 1415, 1414, 1416, 1417, 1418, 1419, 1420, 1421, 1422, 1423, 1424, 1425, 1426, 1427, 1463, 1400, 456, 1402)",
             guid.getGuidLow());
-        CharacterDatabase.Execute("DELETE FROM character_achievement_progress WHERE guid = %u", guid.getGuidLow());
-        CharacterDatabase.Execute("DELETE FROM playerspells WHERE GUID = %u", guid.getGuidLow());
-        CharacterDatabase.Execute("DELETE FROM playerdeletedspells WHERE GUID = %u", guid.getGuidLow());
-        CharacterDatabase.Execute("DELETE FROM playerreputations WHERE guid = %u", guid.getGuidLow());
-        CharacterDatabase.Execute("DELETE FROM playerskills WHERE GUID = %u", guid.getGuidLow());
+        CharacterDatabase.Execute(guid.getGuidLow(), "DELETE FROM character_achievement_progress WHERE guid = %u", guid.getGuidLow());
+        CharacterDatabase.Execute(guid.getGuidLow(), "DELETE FROM playerspells WHERE GUID = %u", guid.getGuidLow());
+        CharacterDatabase.Execute(guid.getGuidLow(), "DELETE FROM playerdeletedspells WHERE GUID = %u", guid.getGuidLow());
+        CharacterDatabase.Execute(guid.getGuidLow(), "DELETE FROM playerreputations WHERE guid = %u", guid.getGuidLow());
+        CharacterDatabase.Execute(guid.getGuidLow(), "DELETE FROM playerskills WHERE GUID = %u", guid.getGuidLow());
 
         sObjectMgr.DeletePlayerInfo(guid.getGuidLow());
         return E_CHAR_DELETE_SUCCESS;
@@ -419,7 +419,7 @@ void WorldSession::handleTakeItemOpcode(WorldPacket& recvPacket)
         sMailSystem.SendAutomatedMessage(MAIL_TYPE_NORMAL, answerSender, answerReceiver, subject, "", answerCodMoney, 0, 0, MAIL_STATIONERY_TEST1, MAIL_CHECK_MASK_COD_PAYMENT);
 
         mailMessage->cod = 0;
-        CharacterDatabase.Execute("UPDATE mailbox SET cod = 0 WHERE message_id = %u", mailMessage->message_id);
+        CharacterDatabase.Execute(static_cast<uint32_t>(mailMessage->player_guid), "UPDATE mailbox SET cod = 0 WHERE message_id = %u", mailMessage->message_id);
     }
 }
 
@@ -555,7 +555,7 @@ void WorldSession::handleSendMailOpcode(WorldPacket& recvPacket)
     // charge and save gold
     _player->modCoinage(-static_cast<int32_t>(cost));
 
-    CharacterDatabase.Execute("UPDATE characters SET gold = %u WHERE guid = %u", _player->getCoinage(), _player->m_playerInfo->guid);
+    CharacterDatabase.Execute(_player->getGuidLow(), "UPDATE characters SET gold = %u WHERE guid = %u", _player->getCoinage(), _player->m_playerInfo->guid);
 
     SendPacket(SmsgSendMailResult(0, MAIL_RES_MAIL_SENT, MAIL_OK).serialise().get());
 }
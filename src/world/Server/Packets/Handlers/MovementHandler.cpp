@@ -388,13 +388,11 @@ void WorldSession::handleMovementOpcodes(WorldPacket& recvData)
 
     WorldPacket data(SMSG_PLAYER_MOVE, recvData.size());
     data << sessionMovementInfo;
-    mover->SendMessageToSet(&data, false);
 
 #elif VERSION_STRING == WotLK
 
     WorldPacket data(opcode, recvData.size());
     data << sessionMovementInfo;
-    mover->SendMessageToSet(&data, false);
 
 #else
 
@@ -404,9 +402,14 @@ void WorldSession::handleMovementOpcodes(WorldPacket& recvData)
 
     WorldPacket data(opcode, recvData.size());
     data << sessionMovementInfo;
-    mover->SendMessageToSet(&data, false);
 
 #endif
+
+    // the map sends it with the other moves of this update, heartbeats less often to far away players
+    if (mover->GetMapMgr() != nullptr)
+        mover->GetMapMgr()->relayMovement(mover, data, opcode == MSG_MOVE_HEARTBEAT);
+    else
+        mover->SendMessageToSet(&data, false);
 }
 
 void WorldSession::handleAcknowledgementOpcodes(WorldPacket& recvPacket)
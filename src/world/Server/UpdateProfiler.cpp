@@ -0,0 +1,236 @@
+/*
+Copyright (c) 2014-2021 AscEmu Team <http://www.ascemu.org>
+This file is released under the MIT license. See README-MIT for more information.
+*/
+
+#include "UpdateProfiler.h"
+#include "Log.hpp"
+#include "Server/OpcodeTable.hpp"
+#include "Server/Opcodes.hpp"
+#include "Server/World.h"
+#include "Util.hpp"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace
+{
+    const char* const phaseNames[MAP_UPDATE_PHASE_COUNT] =
+    {
+        "events",
+        "transports",
+        "units",
+        "dynamic objects",
+        "gameobjects",
+        "sessions",
+        "object updates"
+    };
+
+    std::string formatSummary(UpdateTimeSummary const& summary)
+    {
+        char text[64];
+        snprintf(text, sizeof(text), "%.2f / %.2f / %.2f", summary.p50 / 1000.0f, summary.p99 / 1000.0f, summary.max / 1000.0f);
+        return text;
+    }
+}
+
+UpdateTimeSummary UpdateTimeSamples::getSummary() const
+{
+    UpdateTimeSummary summary;
+
+    const uint32_t count = std::min(m_count.load(std::memory_order_acquire), SAMPLE_COUNT);
+    if (count == 0)
+        return summary;
+
+    std::vector<uint32_t> samples(count);
+    for (uint32_t i = 0; i < count; ++i)
+        samples[i] = m_samples[i].load(std::memory_order_relaxed);
+
+    std::sort(samples.begin(), samples.end());
+
+    summary.samples = count;
+    summary.p50 = samples[(count - 1) / 2];
+    summary.p99 = samples[(count - 1) * 99 / 100];
+    summary.max = samples.back();
+    return summary;
+}
+
+void MapUpdateProfile::addUpdate(uint32_t const* phaseTimes, uint32_t updateTime)
+{
+    for (uint8_t phase = 0; phase < MAP_UPDATE_PHASE_COUNT; ++phase)
+        m_phaseTimes[phase].add(phaseTimes[phase]);
+
+    m_updateTimes.add(updateTime);
+
+    m_updateCount.fetch_add(1, std::memory_order_relaxed);
+    if (updateTime > UPDATE_BUDGET)
+        m_overBudgetCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+UpdateProfiler& UpdateProfiler::getInstance()
+{
+    static UpdateProfiler mInstance;
+    return mInstance;
+}
+
+void UpdateProfiler::initialize()
+{
+    m_isEnabled = worldConfig.performance.enableUpdateProfiler;
+    if (!m_isEnabled)
+        return;
+
+    // kept until the process ends, sessions may still be updated after finalize
+    if (m_opcodeTimes == nullptr)
+        m_opcodeTimes = std::make_unique<OpcodeTimes[]>(NUM_OPCODES);
+
+    m_dumpTimer = 0;
+}
+
+void UpdateProfiler::finalize()
+{
+    if (m_isEnabled && worldConfig.performance.profilerDumpInterval != 0)
+        writeDump();
+}
+
+std::shared_ptr<MapUpdateProfile> UpdateProfiler::addMap(uint32_t mapId, uint32_t instanceId)
+{
+    if (!m_isEnabled)
+        return nullptr;
+
+    auto profile = std::make_shared<MapUpdateProfile>(mapId, instanceId);
+
+    std::lock_guard<std::mutex> guard(m_mapsLock);
+    m_maps.push_back(profile);
+
+    return profile;
+}
+
+void UpdateProfiler::removeMap(std::shared_ptr<MapUpdateProfile> const& profile)
+{
+    if (profile == nullptr)
+        return;
+
+    std::lock_guard<std::mutex> guard(m_mapsLock);
+    m_maps.erase(std::remove(m_maps.begin(), m_maps.end(), profile), m_maps.end());
+}
+
+void UpdateProfiler::addOpcodeTime(uint32_t opcode, uint32_t duration)
+{
+    if (m_opcodeTimes == nullptr || opcode >= NUM_OPCODES)
+        return;
+
+    OpcodeTimes& times = m_opcodeTimes[opcode];
+    times.count.fetch_add(1, std::memory_order_relaxed);
+    times.totalTime.fetch_add(duration, std::memory_order_relaxed);
+
+    uint32_t maxTime = times.maxTime.load(std::memory_order_relaxed);
+    while (duration > maxTime && !times.maxTime.compare_exchange_weak(maxTime, duration, std::memory_order_relaxed))
+    {
+    }
+}
+
+std::vector<std::string> UpdateProfiler::getReport(size_t maxOpcodes)
+{
+    std::vector<std::string> lines;
+    if (!m_isEnabled)
+    {
+        lines.emplace_back("The update profiler is disabled (Performance.UpdateProfiler).");
+        return lines;
+    }
+
+    char text[512];
+
+    std::vector<std::shared_ptr<MapUpdateProfile>> maps;
+    {
+        std::lock_guard<std::mutex> guard(m_mapsLock);
+        maps = m_maps;
+    }
+
+    std::sort(maps.begin(), maps.end(), [](std::shared_ptr<MapUpdateProfile> const& first, std::shared_ptr<MapUpdateProfile> const& second)
+    {
+        return first->getMapId() != second->getMapId() ? first->getMapId() < second->getMapId() : first->getInstanceId() < second->getInstanceId();
+    });
+
+    snprintf(text, sizeof(text), "Map updates: p50 / p99 / max in ms of the last %u updates, updates longer than %ums", UpdateTimeSamples::SAMPLE_COUNT, MapUpdateProfile::UPDATE_BUDGET / 1000);
+    lines.emplace_back(text);
+
+    for (const auto& map : maps)
+    {
+        snprintf(text, sizeof(text), "Map %u (instance %u): %llu updates, %llu over budget, update %s", map->getMapId(), map->getInstanceId(),
+            static_cast<unsigned long long>(map->getUpdateCount()), static_cast<unsigned long long>(map->getOverBudgetCount()),
+            formatSummary(map->getUpdateTimes().getSummary()).c_str());
+        lines.emplace_back(text);
+
+        std::string phases = "   ";
+        for (uint8_t phase = 0; phase < MAP_UPDATE_PHASE_COUNT; ++phase)
+        {
+            phases += phase == 0 ? " " : ", ";
+            phases += phaseNames[phase];
+            phases += " ";
+            phases += formatSummary(map->getPhaseTimes(static_cast<MapUpdatePhase>(phase)).getSummary());
+        }
+        lines.push_back(phases);
+    }
+
+    if (m_opcodeTimes == nullptr || maxOpcodes == 0)
+        return lines;
+
+    std::vector<std::pair<uint64_t, uint32_t>> opcodes;
+    for (uint32_t opcode = 0; opcode < NUM_OPCODES; ++opcode)
+    {
+        const uint64_t totalTime = m_opcodeTimes[opcode].totalTime.load(std::memory_order_relaxed);
+        if (totalTime != 0)
+            opcodes.emplace_back(totalTime, opcode);
+    }
+
+    const size_t count = std::min(maxOpcodes, opcodes.size());
+    std::partial_sort(opcodes.begin(), opcodes.begin() + count, opcodes.end(), std::greater<std::pair<uint64_t, uint32_t>>());
+
+    snprintf(text, sizeof(text), "Opcode handlers: %u of %u by total time", static_cast<uint32_t>(count), static_cast<uint32_t>(opcodes.size()));
+    lines.emplace_back(text);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        const OpcodeTimes& times = m_opcodeTimes[opcodes[i].second];
+        const uint64_t calls = std::max<uint64_t>(times.count.load(std::memory_order_relaxed), 1);
+
+        snprintf(text, sizeof(text), "    %s: %llu calls, %.2fms total, %lluus average, %uus max", sOpcodeTables.getNameForInternalId(opcodes[i].second).c_str(),
+            static_cast<unsigned long long>(calls), opcodes[i].first / 1000.0f, static_cast<unsigned long long>(opcodes[i].first / calls),
+            times.maxTime.load(std::memory_order_relaxed));
+        lines.emplace_back(text);
+    }
+
+    return lines;
+}
+
+void UpdateProfiler::update(uint32_t diff)
+{
+    const uint32_t interval = worldConfig.performance.profilerDumpInterval * 1000;
+    if (!m_isEnabled || interval == 0)
+        return;
+
+    m_dumpTimer += diff;
+    if (m_dumpTimer < interval)
+        return;
+
+    m_dumpTimer = 0;
+    writeDump();
+}
+
+void UpdateProfiler::writeDump()
+{
+    const std::string fileName = worldConfig.logger.extendedLogsDir + "profiler.log";
+
+    FILE* file = fopen(fileName.c_str(), "a");
+    if (file == nullptr)
+    {
+        sLogger.failure("UpdateProfiler : Could not open %s", fileName.c_str());
+        return;
+    }
+
+    fprintf(file, "=================[%s]=================\n", Util::GetCurrentDateTimeString().c_str());
+    for (const auto& line : getReport(25))
+        fprintf(file, "%s\n", line.c_str());
+
+    fclose(file);
+}
@@ -0,0 +1,135 @@
+/*
+Copyright (c) 2014-2021 AscEmu Team <http://www.ascemu.org>
+This file is released under the MIT license. See README-MIT for more information.
+*/
+
+#pragma once
+
+#include "CommonTypes.hpp"
+#include "Map/MapMgrDefines.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+struct UpdateTimeSummary
+{
+    uint32_t samples = 0;
+    uint32_t p50 = 0;                           // us
+    uint32_t p99 = 0;                           // us
+    uint32_t max = 0;                           // us
+};
+
+// Durations of the last SAMPLE_COUNT updates.
+// Written by one thread, read by the console or the dump without a lock, a reader may see one sample of the next update.
+class UpdateTimeSamples
+{
+public:
+    static constexpr uint32_t SAMPLE_COUNT = 512;
+
+    void add(uint32_t duration)
+    {
+        const uint32_t index = m_count.load(std::memory_order_relaxed);
+        m_samples[index % SAMPLE_COUNT].store(duration, std::memory_order_relaxed);
+        m_count.store(index + 1, std::memory_order_release);
+    }
+
+    UpdateTimeSummary getSummary() const;
+
+private:
+    std::array<std::atomic<uint32_t>, SAMPLE_COUNT> m_samples{};
+    std::atomic<uint32_t> m_count{ 0 };
+};
+
+// Update times of one map instance, written by its map thread
+class MapUpdateProfile
+{
+public:
+    // the map thread sleeps until 20ms have passed, a longer update delays the next one
+    static constexpr uint32_t UPDATE_BUDGET = 20000;    // us
+
+    MapUpdateProfile(uint32_t mapId, uint32_t instanceId) : m_mapId(mapId), m_instanceId(instanceId) {}
+
+    void addUpdate(uint32_t const* phaseTimes, uint32_t updateTime);
+
+    uint32_t getMapId() const { return m_mapId; }
+    uint32_t getInstanceId() const { return m_instanceId; }
+
+    uint64_t getUpdateCount() const { return m_updateCount; }
+    uint64_t getOverBudgetCount() const { return m_overBudgetCount; }
+
+    UpdateTimeSamples const& getUpdateTimes() const { return m_updateTimes; }
+    UpdateTimeSamples const& getPhaseTimes(MapUpdatePhase phase) const { return m_phaseTimes[phase]; }
+
+private:
+    uint32_t m_mapId;
+    uint32_t m_instanceId;
+
+    UpdateTimeSamples m_updateTimes;
+    UpdateTimeSamples m_phaseTimes[MAP_UPDATE_PHASE_COUNT];
+
+    std::atomic<uint64_t> m_updateCount{ 0 };
+    std::atomic<uint64_t> m_overBudgetCount{ 0 };
+};
+
+// Collects update times of all maps and the time spent in each opcode handler.
+// Everything is recorded with relaxed atomics on the updating thread, the report is built on request
+// by the console command "profile" or every Performance.ProfilerDumpInterval seconds into profiler.log.
+class SERVER_DECL UpdateProfiler
+{
+private:
+
+    UpdateProfiler() = default;
+    ~UpdateProfiler() = default;
+
+public:
+
+    static UpdateProfiler& getInstance();
+
+    UpdateProfiler(UpdateProfiler&&) = delete;
+    UpdateProfiler(UpdateProfiler const&) = delete;
+    UpdateProfiler& operator=(UpdateProfiler&&) = delete;
+    UpdateProfiler& operator=(UpdateProfiler const&) = delete;
+
+    void initialize();
+    void finalize();
+
+    bool isEnabled() const { return m_isEnabled; }
+
+    std::shared_ptr<MapUpdateProfile> addMap(uint32_t mapId, uint32_t instanceId);
+    void removeMap(std::shared_ptr<MapUpdateProfile> const& profile);
+
+    // opcode is the internal id, see OpcodeTables::getInternalIdForHex
+    void addOpcodeTime(uint32_t opcode, uint32_t duration);
+
+    std::vector<std::string> getReport(size_t maxOpcodes);
+
+    // writes the report to profiler.log when the dump interval has passed, called by the world thread
+    void update(uint32_t diff);
+
+private:
+
+    struct OpcodeTimes
+    {
+        std::atomic<uint64_t> count{ 0 };
+        std::atomic<uint64_t> totalTime{ 0 };  // us
+        std::atomic<uint32_t> maxTime{ 0 };    // us
+    };
+
+    void writeDump();
+
+    bool m_isEnabled = false;
+
+    std::mutex m_mapsLock;
+    std::vector<std::shared_ptr<MapUpdateProfile>> m_maps;
+
+    std::unique_ptr<OpcodeTimes[]> m_opcodeTimes;
+
+    uint32_t m_dumpTimer = 0;
+};
+
+#define sUpdateProfiler UpdateProfiler::getInstance()
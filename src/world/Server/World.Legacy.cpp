@@ -270,7 +270,7 @@ bool CharacterLoaderThread::runThread()
         // Get a single connection to maintain for the whole process.
         DatabaseConnection* con = CharacterDatabase.GetFreeConnection();
 
-        con->Busy.Release();
+        CharacterDatabase.releaseConnection(con);
 
         cond.Wait(LOAD_THREAD_SLEEP * 1000);
 
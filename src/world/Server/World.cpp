@@ -19,6 +19,8 @@ This file is released under the MIT license. See README-MIT for more information
 #include "Management/ChannelMgr.h"
 #include "WorldSocket.h"
 #include "Storage/MySQLDataStore.hpp"
+#include "Storage/MySQLTableLoader.hpp"
+#include "Storage/WorldDatabaseSnapshot.hpp"
 #include <CrashHandler.h>
 #include "Server/MainServerDefines.h"
 //#include "Config/Config.h"
@@ -35,6 +37,8 @@ This file is released under the MIT license. See README-MIT for more information
 #include "OpcodeTable.hpp"
 #include "Units/Creatures/CreatureGroups.h"
 #include "Movement/WaypointManager.h"
+#include "Server/UpdateProfiler.h"
+#include "MMapFactory.h"
 
 #if VERSION_STRING == Cata
 #include "GameCata/Management/GuildFinderMgr.h"
@@ -330,6 +334,13 @@ void World::loadAccountDataProcForId(QueryResultVector& results, uint32_t accoun
         worldSession->loadAccountDataProc(results[0].result);
 }
 
+void World::loadPlayerFromDBProcForId(QueryResultVector& results, uint32_t accountId)
+{
+    WorldSession* worldSession = getSessionByAccountId(accountId);
+    if (worldSession != nullptr)
+        worldSession->loadPlayerFromDBProc(results);
+}
+
 size_t World::getSessionCount()
 {
     std::lock_guard<std::mutex> guard(mSessionLock);
@@ -600,18 +611,20 @@ void World::sendAreaTriggerMessage(const std::string& message, WorldSession* sen
 
 void World::sendGlobalMessage(WorldPacket* worldPacket, WorldSession* sendToSelf /*nullptr*/, int32_t team /*-1*/)
 {
+    SharedWorldPacket sharedPacket;
     std::lock_guard<std::mutex> guard(mSessionLock);
 
     for (auto activeSessions = mActiveSessionMapStore.begin(); activeSessions != mActiveSessionMapStore.end(); ++activeSessions)
     {
         if (activeSessions->second->GetPlayer() && activeSessions->second->GetPlayer()->IsInWorld()
             && activeSessions->second != sendToSelf && (team == -1 || activeSessions->second->GetPlayer()->GetTeam() == static_cast<uint32_t>(team)))
-            activeSessions->second->SendPacket(worldPacket);
+            activeSessions->second->SendBroadcastPacket(worldPacket, sharedPacket);
     }
 }
 
 void World::sendZoneMessage(WorldPacket* worldPacket, uint32_t zoneId, WorldSession* sendToSelf /*nullptr*/)
 {
+    SharedWorldPacket sharedPacket;
     std::lock_guard<std::mutex> guard(mSessionLock);
 
     for (auto activeSessions = mActiveSessionMapStore.begin(); activeSessions != mActiveSessionMapStore.end(); ++activeSessions)
@@ -619,13 +632,14 @@ void World::sendZoneMessage(WorldPacket* worldPacket, uint32_t zoneId, WorldSess
         if (activeSessions->second->GetPlayer() && activeSessions->second->GetPlayer()->IsInWorld() && activeSessions->second != sendToSelf)
         {
             if (activeSessions->second->GetPlayer()->GetZoneId() == zoneId)
-                activeSessions->second->SendPacket(worldPacket);
+                activeSessions->second->SendBroadcastPacket(worldPacket, sharedPacket);
         }
     }
 }
 
 void World::sendInstanceMessage(WorldPacket* worldPacket, uint32_t instanceId, WorldSession* sendToSelf /*nullptr*/)
 {
+    SharedWorldPacket sharedPacket;
     std::lock_guard<std::mutex> guard(mSessionLock);
 
     for (auto activeSessions = mActiveSessionMapStore.begin(); activeSessions != mActiveSessionMapStore.end(); ++activeSessions)
@@ -633,7 +647,7 @@ void World::sendInstanceMessage(WorldPacket* worldPacket, uint32_t instanceId, W
         if (activeSessions->second->GetPlayer() && activeSessions->second->GetPlayer()->IsInWorld() && activeSessions->second != sendToSelf)
         {
             if (activeSessions->second->GetPlayer()->GetInstanceID() == static_cast<int32>(instanceId))
-                activeSessions->second->SendPacket(worldPacket);
+                activeSessions->second->SendBroadcastPacket(worldPacket, sharedPacket);
         }
     }
 }
@@ -702,6 +716,16 @@ bool World::setInitialWorldSettings()
         sLogger.info("GameObjectModel : Loading GameObject models...");
         std::string vmapPath = worldConfig.server.dataDir + "vmaps";
         LoadGameObjectModelList(vmapPath);
+
+        // map threads look up their mmap data while other maps load theirs
+        std::vector<uint32_t> mapIds;
+        for (uint32_t i = 0; i < sMapStore.GetNumRows(); ++i)
+        {
+            if (auto mapEntry = sMapStore.LookupEntry(i))
+                mapIds.push_back(mapEntry->id);
+        }
+
+        MMAP::MMapFactory::createOrGetMMapManager()->InitializeThreadUnsafe(mapIds);
     }
 
     loadMySQLStores();
@@ -789,74 +813,92 @@ bool World::loadDbcDb2Stores()
 
 void World::loadMySQLStores()
 {
+    if (worldConfig.performance.enableWorldDatabaseSnapshot)
+        sWorldDatabaseSnapshot.open(worldConfig.server.dataDir + "world_database.snapshot");
+
     sMySQLStore.loadAdditionalTableConfig();
 
-    sMySQLStore.loadItemPagesTable();
-    sMySQLStore.loadItemPropertiesTable();
-    sMySQLStore.loadCreaturePropertiesMovementTable();
-    sMySQLStore.loadCreaturePropertiesTable();
-    sMySQLStore.loadGameObjectPropertiesTable();
-    sMySQLStore.loadQuestPropertiesTable();
-    sMySQLStore.loadGameObjectQuestItemBindingTable();
-    sMySQLStore.loadGameObjectQuestPickupBindingTable();
-
-    sMySQLStore.loadCreatureDifficultyTable();
-    sMySQLStore.loadDisplayBoundingBoxesTable();
-    sMySQLStore.loadVendorRestrictionsTable();
-
-    sMySQLStore.loadNpcTextTable();
-    sMySQLStore.loadNpcScriptTextTable();
-    sMySQLStore.loadGossipMenuOptionTable();
-    sMySQLStore.loadGraveyardsTable();
-    sMySQLStore.loadTeleportCoordsTable();
-    sMySQLStore.loadFishingTable();
-    sMySQLStore.loadWorldMapInfoTable();
-    sMySQLStore.loadZoneGuardsTable();
-    sMySQLStore.loadBattleMastersTable();
-    sMySQLStore.loadTotemDisplayIdsTable();
-    sMySQLStore.loadSpellClickSpellsTable();
-
-    sMySQLStore.loadWorldStringsTable();
-    sMySQLStore.loadPointsOfInterestTable();
-    sMySQLStore.loadItemSetLinkedSetBonusTable();
-    sMySQLStore.loadCreatureInitialEquipmentTable();
-
-    sMySQLStore.loadPlayerCreateInfoTable();
-    sMySQLStore.loadPlayerCreateInfoSkillsTable();
-    sMySQLStore.loadPlayerCreateInfoSpellsTable();
-    sMySQLStore.loadPlayerCreateInfoItemsTable();
-    sMySQLStore.loadPlayerXpToLevelTable();
-
-    sMySQLStore.loadSpellOverrideTable();
-
-    sMySQLStore.loadNpcGossipTextIdTable();
-    sMySQLStore.loadPetLevelAbilitiesTable();
-    sMySQLStore.loadBroadcastTable();
-
-    sMySQLStore.loadAreaTriggerTable();
-    sMySQLStore.loadWordFilterCharacterNames();
-    sMySQLStore.loadWordFilterChat();
-
-    sMySQLStore.loadLocalesCreature();
-    sMySQLStore.loadLocalesGameobject();
-    sMySQLStore.loadLocalesGossipMenuOption();
-    sMySQLStore.loadLocalesItem();
-    sMySQLStore.loadLocalesItemPages();
-    sMySQLStore.loadLocalesNpcScriptText();
-    sMySQLStore.loadLocalesNpcText();
-    sMySQLStore.loadLocalesQuest();
-    sMySQLStore.loadLocalesWorldbroadcast();
-    sMySQLStore.loadLocalesWorldmapInfo();
-    sMySQLStore.loadLocalesWorldStringTable();
-
-    sMySQLStore.loadCreatureAiTextTable();
-    //sMySQLStore.loadDefaultPetSpellsTable();      Zyres 2017/07/16 not used
-    sMySQLStore.loadProfessionDiscoveriesTable();
-
-    sMySQLStore.loadTransportDataTable();
-    sMySQLStore.loadTransportEntrys();
-    sMySQLStore.loadGossipMenuItemsTable();
-    sMySQLStore.loadRecallTable();
+    MySQLTableLoader tableLoader;
+
+#define ADD_TABLE(name, ...) tableLoader.addTable(#name, []() { sMySQLStore.load##name(); }, { __VA_ARGS__ })
+
+    ADD_TABLE(ItemPagesTable);
+    ADD_TABLE(ItemPropertiesTable, "ItemPagesTable");
+    ADD_TABLE(CreaturePropertiesMovementTable);
+    ADD_TABLE(CreaturePropertiesTable, "CreaturePropertiesMovementTable");
+    ADD_TABLE(GameObjectPropertiesTable, "ItemPropertiesTable");
+    ADD_TABLE(QuestPropertiesTable, "CreaturePropertiesTable", "GameObjectPropertiesTable");
+    ADD_TABLE(GameObjectQuestItemBindingTable, "GameObjectPropertiesTable", "QuestPropertiesTable");
+    // both bindings modify the gameobject properties
+    ADD_TABLE(GameObjectQuestPickupBindingTable, "GameObjectQuestItemBindingTable");
+
+    ADD_TABLE(CreatureDifficultyTable);
+    ADD_TABLE(DisplayBoundingBoxesTable);
+    ADD_TABLE(VendorRestrictionsTable);
+
+    ADD_TABLE(NpcTextTable);
+    ADD_TABLE(NpcScriptTextTable);
+    ADD_TABLE(GossipMenuOptionTable);
+    ADD_TABLE(GraveyardsTable);
+    ADD_TABLE(TeleportCoordsTable);
+    ADD_TABLE(FishingTable);
+    ADD_TABLE(WorldMapInfoTable);
+    ADD_TABLE(ZoneGuardsTable);
+    ADD_TABLE(BattleMastersTable);
+    ADD_TABLE(TotemDisplayIdsTable);
+    ADD_TABLE(SpellClickSpellsTable);
+
+    ADD_TABLE(WorldStringsTable);
+    ADD_TABLE(PointsOfInterestTable);
+    ADD_TABLE(ItemSetLinkedSetBonusTable);
+    ADD_TABLE(CreatureInitialEquipmentTable, "CreaturePropertiesTable", "ItemPropertiesTable");
+
+    // all player create info tables fill the same store
+    ADD_TABLE(PlayerCreateInfoTable);
+    ADD_TABLE(PlayerCreateInfoSkillsTable, "PlayerCreateInfoTable");
+    ADD_TABLE(PlayerCreateInfoSpellsTable, "PlayerCreateInfoSkillsTable");
+    ADD_TABLE(PlayerCreateInfoItemsTable, "PlayerCreateInfoSpellsTable", "ItemPropertiesTable");
+    ADD_TABLE(PlayerXpToLevelTable);
+
+    ADD_TABLE(SpellOverrideTable);
+
+    ADD_TABLE(NpcGossipTextIdTable, "CreaturePropertiesTable");
+    ADD_TABLE(PetLevelAbilitiesTable);
+    ADD_TABLE(BroadcastTable);
+
+    ADD_TABLE(AreaTriggerTable);
+    ADD_TABLE(WordFilterCharacterNames);
+    ADD_TABLE(WordFilterChat);
+
+    ADD_TABLE(LocalesCreature, "CreaturePropertiesTable");
+    ADD_TABLE(LocalesGameobject, "GameObjectPropertiesTable");
+    ADD_TABLE(LocalesGossipMenuOption, "GossipMenuOptionTable");
+    ADD_TABLE(LocalesItem, "ItemPropertiesTable");
+    ADD_TABLE(LocalesItemPages, "ItemPagesTable");
+    ADD_TABLE(LocalesNpcScriptText, "NpcScriptTextTable");
+    ADD_TABLE(LocalesNpcText, "NpcTextTable");
+    ADD_TABLE(LocalesQuest, "QuestPropertiesTable");
+    ADD_TABLE(LocalesWorldbroadcast, "BroadcastTable");
+    ADD_TABLE(LocalesWorldmapInfo, "WorldMapInfoTable");
+    ADD_TABLE(LocalesWorldStringTable, "WorldStringsTable");
+
+    ADD_TABLE(CreatureAiTextTable);
+    //ADD_TABLE(DefaultPetSpellsTable);      Zyres 2017/07/16 not used
+    ADD_TABLE(ProfessionDiscoveriesTable);
+
+    ADD_TABLE(TransportDataTable, "GameObjectPropertiesTable");
+    ADD_TABLE(TransportEntrys);
+    ADD_TABLE(GossipMenuItemsTable);
+    ADD_TABLE(RecallTable);
+
+#undef ADD_TABLE
+
+    // the world database threads keep one connection each, every loader thread needs another one
+    uint32_t loaderThreads = worldConfig.performance.startupLoadThreads;
+    if (loaderThreads == 0)
+        loaderThreads = worldConfig.worldDb.connections > 2 ? worldConfig.worldDb.connections - 2 : 1;
+
+    tableLoader.load(loaderThreads);
 
     sFormationMgr->loadCreatureFormations();
     sWaypointMgr->load();
@@ -918,6 +960,9 @@ void World::loadMySQLTablesByTask()
 
     tl.wait();
 
+    // spawns are the last tables taken from the snapshot
+    sWorldDatabaseSnapshot.close();
+
     MAKE_TASK2(LootMgr, loadAndGenerateLoot, 0);
     MAKE_TASK2(LootMgr, loadAndGenerateLoot, 1);
     MAKE_TASK2(LootMgr, loadAndGenerateLoot, 2);
@@ -967,12 +1012,16 @@ void World::logEntitySize()
 
 void World::Update(unsigned long timePassed)
 {
+    CharacterDatabase.processAsyncQueryCallbacks();
+
     sLfgMgr.Update(static_cast<uint32_t>(timePassed));
     mEventableObjectHolder->Update(static_cast<uint32_t>(timePassed));
     sAuctionMgr.Update();
     updateQueuedSessions(static_cast<uint32_t>(timePassed));
 
     sGuildMgr.update(static_cast<uint32>(timePassed));
+
+    sUpdateProfiler.update(static_cast<uint32_t>(timePassed));
 }
 
 void World::saveAllPlayersToDb()
@@ -980,6 +1029,7 @@ void World::saveAllPlayersToDb()
     sLogger.info("Saving all players to database...");
 
     uint32_t count = 0;
+    PlayerSaveStatistics saveStatistics;
 
     sObjectMgr._playerslock.lock();
 
@@ -989,24 +1039,31 @@ void World::saveAllPlayersToDb()
         {
             auto startTime = Util::TimeNow();
             itr->second->SaveToDB(false);
-            sLogger.info("Saved player `%s` (level %u) in %u ms.", itr->second->getName().c_str(), itr->second->getLevel(), static_cast<uint32_t>(Util::GetTimeDifferenceToNow(startTime)));
+            saveStatistics.add(itr->second->getLastSaveStatistics());
+            sLogger.info("Saved player `%s` (level %u) with %u rows in %u ms.", itr->second->getName().c_str(), itr->second->getLevel(), itr->second->getLastSaveStatistics().getTotal(), static_cast<uint32_t>(Util::GetTimeDifferenceToNow(startTime)));
             ++count;
         }
     }
 
     sObjectMgr._playerslock.unlock();
-    sLogger.info("Saved %u players.", count);
+    sLogger.info("Saved %u players with %u rows.", count, saveStatistics.getTotal());
+    sLogger.info("Rows per table: character %u, items %u, spells %u, skills %u, quests %u, reputations %u, cooldowns %u, pets %u, other %u",
+        saveStatistics.rows[PLAYER_SAVE_TABLE_CHARACTER], saveStatistics.rows[PLAYER_SAVE_TABLE_ITEMS], saveStatistics.rows[PLAYER_SAVE_TABLE_SPELLS],
+        saveStatistics.rows[PLAYER_SAVE_TABLE_SKILLS], saveStatistics.rows[PLAYER_SAVE_TABLE_QUESTS], saveStatistics.rows[PLAYER_SAVE_TABLE_REPUTATIONS],
+        saveStatistics.rows[PLAYER_SAVE_TABLE_COOLDOWNS], saveStatistics.rows[PLAYER_SAVE_TABLE_PETS], saveStatistics.rows[PLAYER_SAVE_TABLE_OTHER]);
 }
 
 void World::playSoundToAllPlayers(uint32_t soundId)
 {
+    const auto packet = AscEmu::Packets::SmsgPlaySound(soundId).serialise();
+
     std::lock_guard<std::mutex> guard(mSessionLock);
 
     for (activeSessionMap::iterator itr = mActiveSessionMapStore.begin(); itr != mActiveSessionMapStore.end(); ++itr)
     {
         WorldSession* worldSession = itr->second;
         if ((worldSession->GetPlayer() != nullptr) && worldSession->GetPlayer()->IsInWorld())
-            worldSession->SendPacket(AscEmu::Packets::SmsgPlaySound(soundId).serialise().get());
+            worldSession->SendPacket(packet.get());
     }
 }
 
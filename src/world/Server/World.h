@@ -117,6 +117,7 @@ class SERVER_DECL World : public EventableObject, public IUpdatable
 
         void sendCharacterEnumToAccountSession(QueryResultVector& results, uint32_t accountId);
         void loadAccountDataProcForId(QueryResultVector& results, uint32_t accountId);
+        void loadPlayerFromDBProcForId(QueryResultVector& results, uint32_t accountId);
 
         size_t getSessionCount();
 
@@ -34,6 +34,8 @@ WorldConfig::WorldConfig(): mFloatRates{}, mIntRates{}
 
     // world.conf - Listen Config
     listen.listenPort = 8129;
+    listen.networkThreads = 1;
+    listen.reusePort = false;
 
     // world.conf - Logger Settings
     logger.extendedLogsDir = "./";
@@ -44,6 +46,7 @@ WorldConfig::WorldConfig(): mFloatRates{}, mIntRates{}
     logger.enablePlayerLog = false;
     logger.enableTimeStamp = false;
     logger.enableSqlBanLog = false;
+    logger.enableAsyncWrites = true;
 
     // world.conf - Server Settings
     server.playerLimit = 100;
@@ -105,6 +108,7 @@ WorldConfig::WorldConfig(): mFloatRates{}, mIntRates{}
     guild.newsLogCount = 0;
     guild.bankLogCount = 0;
     guild.saveInterval = 300;
+    guild.saveBatchSize = 50;
 
     // world.conf - Announce Settings
     announce.enableGmAdminTag = true;
@@ -217,6 +221,26 @@ WorldConfig::WorldConfig(): mFloatRates{}, mIntRates{}
     limit.maxArenaPoints = 5000;
     limit.disconnectPlayerForExceedingLimits = false;
     limit.broadcastMessageToGmOnExceeding = true;
+
+    // world.conf - Performance settings
+    performance.mapUpdateTimingInterval = 0;
+    performance.visibilityUpdateDistance = 2.0f;
+    performance.startupLoadThreads = 0;
+    performance.enableWorldDatabaseSnapshot = false;
+    performance.pathfindingThreads = 2;
+    performance.enableMovementBatching = true;
+    performance.movementNearDistance = 30.0f;
+    performance.movementFarDistance = 60.0f;
+    performance.movementMidInterval = 1000;
+    performance.movementFarInterval = 2000;
+    performance.lfgMatchTimeBudget = 25;
+    performance.enableUpdateProfiler = true;
+    performance.profilerDumpInterval = 0;
+    performance.enableMapScheduler = true;
+    performance.mapSchedulerThreads = 0;
+    performance.mapSchedulerIdleInterval = 100;
+    performance.asyncQueryThreads = 2;
+    performance.characterDatabaseWriters = 1;
 }
 
 WorldConfig::~WorldConfig() = default;
@@ -267,6 +291,8 @@ void WorldConfig::loadWorldConfigValues(bool reload /*false*/)
     // world.conf - Listen Config
     ARCEMU_ASSERT(Config.MainConfig.tryGetString("Listen", "Host", &listen.listenHost));
     ARCEMU_ASSERT(Config.MainConfig.tryGetInt("Listen", "WorldServerPort", &listen.listenPort));
+    ARCEMU_ASSERT(Config.MainConfig.tryGetInt("Listen", "NetworkThreads", &listen.networkThreads));
+    ARCEMU_ASSERT(Config.MainConfig.tryGetBool("Listen", "ReusePort", &listen.reusePort));
 
     // world.conf - Logger Settings
     ARCEMU_ASSERT(Config.MainConfig.tryGetInt("Logger", "MinimumMessageType", &logger.minimumMessageType));
@@ -281,6 +307,7 @@ void WorldConfig::loadWorldConfigValues(bool reload /*false*/)
     ARCEMU_ASSERT(Config.MainConfig.tryGetBool("Logger", "EnablePlayerLog", &logger.enablePlayerLog));
     ARCEMU_ASSERT(Config.MainConfig.tryGetBool("Logger", "EnableTimeStamp", &logger.enableTimeStamp));
     ARCEMU_ASSERT(Config.MainConfig.tryGetBool("Logger", "EnableSqlBanLog", &logger.enableSqlBanLog));
+    ARCEMU_ASSERT(Config.MainConfig.tryGetBool("Logger", "EnableAsyncWrites", &logger.enableAsyncWrites));
 
     // world.conf - Server Settings
     ARCEMU_ASSERT(Config.MainConfig.tryGetInt("Server", "PlayerLimit", &server.playerLimit));
@@ -380,6 +407,7 @@ void WorldConfig::loadWorldConfigValues(bool reload /*false*/)
     ARCEMU_ASSERT(Config.MainConfig.tryGetInt("Guild", "NewsLogCount", &guild.newsLogCount));
     ARCEMU_ASSERT(Config.MainConfig.tryGetInt("Guild", "BankLogCount", &guild.bankLogCount));
     ARCEMU_ASSERT(Config.MainConfig.tryGetInt("Guild", "SaveInterval", &guild.saveInterval));
+    ARCEMU_ASSERT(Config.MainConfig.tryGetInt("Guild", "SaveBatchSize", &guild.saveBatchSize));
 
     // world.conf - Announce Settings
     ARCEMU_ASSERT(Config.MainConfig.tryGetString("Announce", "Tag", &announce.announceTag));
@@ -546,6 +574,35 @@ void WorldConfig::loadWorldConfigValues(bool reload /*false*/)
     ARCEMU_ASSERT(Config.MainConfig.tryGetInt("Limits", "Arena", &limit.maxArenaPoints));
     ARCEMU_ASSERT(Config.MainConfig.tryGetBool("Limits", "Disconnect", &limit.disconnectPlayerForExceedingLimits));
     ARCEMU_ASSERT(Config.MainConfig.tryGetBool("Limits", "BroadcastGMs", &limit.broadcastMessageToGmOnExceeding));
+
+    // world.conf - Performance settings
+    ARCEMU_ASSERT(Config.MainConfig.tryGetInt("Performance", "MapUpdateTimingInterval", &performance.mapUpdateTimingInterval));
+    ARCEMU_ASSERT(Config.MainConfig.tryGetFloat("Performance", "VisibilityUpdateDistance", &performance.visibilityUpdateDistance));
+    if (performance.visibilityUpdateDistance < 0.0f)
+        performance.visibilityUpdateDistance = 0.0f;
+    ARCEMU_ASSERT(Config.MainConfig.tryGetInt("Performance", "StartupLoadThreads", &performance.startupLoadThreads));
+    ARCEMU_ASSERT(Config.MainConfig.tryGetBool("Performance", "WorldDatabaseSnapshot", &performance.enableWorldDatabaseSnapshot));
+    ARCEMU_ASSERT(Config.MainConfig.tryGetInt("Performance", "PathfindingThreads", &performance.pathfindingThreads));
+    ARCEMU_ASSERT(Config.MainConfig.tryGetBool("Performance", "MovementBatching", &performance.enableMovementBatching));
+    ARCEMU_ASSERT(Config.MainConfig.tryGetFloat("Performance", "MovementNearDistance", &performance.movementNearDistance));
+    ARCEMU_ASSERT(Config.MainConfig.tryGetFloat("Performance", "MovementFarDistance", &performance.movementFarDistance));
+    if (performance.movementFarDistance < performance.movementNearDistance)
+        performance.movementFarDistance = performance.movementNearDistance;
+    ARCEMU_ASSERT(Config.MainConfig.tryGetInt("Performance", "MovementMidInterval", &performance.movementMidInterval));
+    ARCEMU_ASSERT(Config.MainConfig.tryGetInt("Performance", "MovementFarInterval", &performance.movementFarInterval));
+    ARCEMU_ASSERT(Config.MainConfig.tryGetInt("Performance", "LfgMatchTimeBudget", &performance.lfgMatchTimeBudget));
+    ARCEMU_ASSERT(Config.MainConfig.tryGetBool("Performance", "UpdateProfiler", &performance.enableUpdateProfiler));
+    ARCEMU_ASSERT(Config.MainConfig.tryGetInt("Performance", "ProfilerDumpInterval", &performance.profilerDumpInterval));
+    ARCEMU_ASSERT(Config.MainConfig.tryGetBool("Performance", "MapScheduler", &performance.enableMapScheduler));
+    ARCEMU_ASSERT(Config.MainConfig.tryGetInt("Performance", "MapSchedulerThreads", &performance.mapSchedulerThreads));
+    ARCEMU_ASSERT(Config.MainConfig.tryGetInt("Performance", "MapSchedulerIdleInterval", &performance.mapSchedulerIdleInterval));
+    // the map update caps the time difference at 500ms
+    if (performance.mapSchedulerIdleInterval < 20)
+        performance.mapSchedulerIdleInterval = 20;
+    else if (performance.mapSchedulerIdleInterval > 500)
+        performance.mapSchedulerIdleInterval = 500;
+    ARCEMU_ASSERT(Config.MainConfig.tryGetInt("Performance", "AsyncQueryThreads", &performance.asyncQueryThreads));
+    ARCEMU_ASSERT(Config.MainConfig.tryGetInt("Performance", "CharacterDatabaseWriters", &performance.characterDatabaseWriters));
 }
 
 uint32_t WorldConfig::getPlayerLimit() const
@@ -98,6 +98,8 @@ class SERVER_DECL WorldConfig
         {
             std::string listenHost;
             int listenPort;
+            uint32_t networkThreads;
+            bool reusePort;
         } listen;
 
         // world.conf - Logger Settings
@@ -111,6 +113,7 @@ class SERVER_DECL WorldConfig
             bool enablePlayerLog;
             bool enableTimeStamp;
             bool enableSqlBanLog;
+            bool enableAsyncWrites;
         } logger;
 
         // world.conf - Server Settings
@@ -188,6 +191,7 @@ class SERVER_DECL WorldConfig
             uint32_t newsLogCount;
             uint32_t bankLogCount;
             uint32_t saveInterval;
+            uint32_t saveBatchSize;
         } guild;
 
         // world.conf - Announce Settings
@@ -370,4 +374,27 @@ class SERVER_DECL WorldConfig
             bool disconnectPlayerForExceedingLimits;
             bool broadcastMessageToGmOnExceeding;
         } limit;
+
+        // world.conf - Performance settings
+        struct PerformanceSettings
+        {
+            uint32_t mapUpdateTimingInterval;
+            float visibilityUpdateDistance;
+            uint32_t startupLoadThreads;
+            bool enableWorldDatabaseSnapshot;
+            uint32_t pathfindingThreads;
+            bool enableMovementBatching;
+            float movementNearDistance;
+            float movementFarDistance;
+            uint32_t movementMidInterval;
+            uint32_t movementFarInterval;
+            uint32_t lfgMatchTimeBudget;
+            bool enableUpdateProfiler;
+            uint32_t profilerDumpInterval;
+            bool enableMapScheduler;
+            uint32_t mapSchedulerThreads;
+            uint32_t mapSchedulerIdleInterval;
+            uint32_t asyncQueryThreads;
+            uint32_t characterDatabaseWriters;
+        } performance;
 };
@@ -37,6 +37,7 @@
 #include "Packets/SmsgNotification.h"
 #include "Packets/SmsgLogoutComplete.h"
 #include "OpcodeTable.hpp"
+#include "UpdateProfiler.h"
 
 using namespace AscEmu::Packets;
 
@@ -44,6 +45,7 @@ OpcodeHandler WorldPacketHandlers[NUM_OPCODES];
 
 WorldSession::WorldSession(uint32 id, std::string name, WorldSocket* sock) :
     m_loggingInPlayer(nullptr),
+    m_isPlayerLoginPending(false),
     m_currMsTime(Util::getMSTime()),
     m_lastPing(0),
     bDeleted(false),
@@ -157,13 +159,14 @@ uint8 WorldSession::Update(uint32 InstanceID)
     {
         ARCEMU_ASSERT(packet != NULL);
 
-        if (sOpcodeTables.getInternalIdForHex(packet->GetOpcode()) >= NUM_OPCODES)
+        const uint32_t internalId = sOpcodeTables.getInternalIdForHex(packet->GetOpcode());
+        if (internalId >= NUM_OPCODES)
         {
             sLogger.debug("[Session] Received out of range packet with opcode 0x%.4X", packet->GetOpcode());
         }
         else
         {
-            OpcodeHandler* handler = &WorldPacketHandlers[sOpcodeTables.getInternalIdForHex(packet->GetOpcode())];
+            OpcodeHandler* handler = &WorldPacketHandlers[internalId];
             if (handler->status == STATUS_LOGGEDIN && !_player && handler->handler != 0)
             {
                 sLogger.debug("[Session] Received unexpected/wrong state packet with opcode %s (0x%.4X)", 
@@ -177,6 +180,12 @@ uint8 WorldSession::Update(uint32 InstanceID)
                     sLogger.debug("[Session] Received unhandled packet with opcode %s (0x%.4X)",
                         sOpcodeTables.getNameForOpcode(packet->GetOpcode()).c_str(), packet->GetOpcode());
                 }
+                else if (sUpdateProfiler.isEnabled())
+                {
+                    const auto handlerStart = std::chrono::steady_clock::now();
+                    (this->*handler->handler)(*packet);
+                    sUpdateProfiler.addOpcodeTime(internalId, static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - handlerStart).count()));
+                }
                 else
                 {
                     (this->*handler->handler)(*packet);
@@ -717,6 +726,49 @@ void WorldSession::SendPacket(WorldPacket* packet)
     }
 }
 
+void WorldSession::SendSharedPacket(SharedWorldPacket const& packet)
+{
+    if (packet->GetOpcode() == 0x0000)
+    {
+        sLogger.failure("Return, packet 0x0000 is not a valid packet!");
+        return;
+    }
+
+    if (_socket && _socket->IsConnected())
+    {
+        _socket->SendSharedPacket(packet);
+    }
+}
+
+void WorldSession::SendBroadcastPacket(WorldPacket* packet, SharedWorldPacket& sharedPacket)
+{
+#ifdef CONFIG_USE_EPOLL
+    const bool isShared = packet->size() >= WORLDSOCKET_SHARED_PACKET_MIN_SIZE;
+#else
+    // IOCP and kqueue copy every payload to the send buffer, a shared copy would only cost one more
+    const bool isShared = false;
+#endif
+
+    if (!isShared)
+    {
+        SendPacket(packet);
+        return;
+    }
+
+    if (sharedPacket == nullptr)
+        sharedPacket = std::make_shared<const WorldPacket>(*packet);
+
+    SendSharedPacket(sharedPacket);
+}
+
+void WorldSession::SendSharedPackets(std::vector<SharedWorldPacket> const& packets)
+{
+    if (_socket && _socket->IsConnected())
+    {
+        _socket->SendSharedPackets(packets);
+    }
+}
+
 void WorldSession::OutPacket(uint16 opcode)
 {
     if (_socket && _socket->IsConnected())
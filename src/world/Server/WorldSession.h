@@ -25,6 +25,7 @@
 #include "Server/Opcodes.hpp"
 #include "Management/Quest.h"
 #include "FastQueue.h"
+#include "WorldPacket.h"
 #include "World.Legacy.h"
 #include "Units/Unit.h"
 #include "Server/CharacterErrors.h"
@@ -134,8 +135,21 @@ class SERVER_DECL WorldSession
 
         Player* m_loggingInPlayer;
 
+        // the character query of CMSG_PLAYER_LOGIN is running, cleared by loadPlayerFromDBProc
+        bool m_isPlayerLoginPending;
+
         void SendPacket(WorldPacket* packet);
 
+        // Sends a packet shared with other sessions, the socket references the payload instead of copying it
+        void SendSharedPacket(SharedWorldPacket const& packet);
+
+        // Use this when the same packet is sent to many sessions. Big packets are copied once into sharedPacket
+        // (pass the same, initially empty, pointer for every recipient), small ones are sent like SendPacket.
+        void SendBroadcastPacket(WorldPacket* packet, SharedWorldPacket& sharedPacket);
+
+        // Sends several shared packets with a single socket write
+        void SendSharedPackets(std::vector<SharedWorldPacket> const& packets);
+
         void OutPacket(uint16 opcode);
 
         void Delete();
@@ -154,12 +154,8 @@ WorldSocket::WorldSocket(SOCKET fd)
 
 WorldSocket::~WorldSocket()
 {
-    WorldPacket* pck;
     queueLock.Acquire();
-    while ((pck = _queue.Pop()) != nullptr)
-    {
-        delete pck;
-    }
+    _queue.clear();
     queueLock.Release();
 
     delete pAuthenticationPacket;
@@ -199,9 +195,9 @@ void WorldSocket::OnDisconnect()
 }
 
 #if VERSION_STRING != Mop
-void WorldSocket::OutPacket(uint16 opcode, size_t len, const void* data)
+void WorldSocket::OutPacket(uint16 opcode, size_t len, const void* data, SharedWorldPacket const& sharedPacket)
 #else
-void WorldSocket::OutPacket(uint32_t opcode, size_t len, const void* data)
+void WorldSocket::OutPacket(uint32_t opcode, size_t len, const void* data, SharedWorldPacket const& sharedPacket)
 #endif
 {
     if ((len + 10) > WORLDSOCKET_SENDBUF_SIZE)
@@ -210,41 +206,57 @@ void WorldSocket::OutPacket(uint32_t opcode, size_t len, const void* data)
         return;
     }
 
-    OUTPACKET_RESULT res = _OutPacket(opcode, len, data);
+    OUTPACKET_RESULT res = _OutPacket(opcode, len, data, sharedPacket);
     if (res == OUTPACKET_RESULT_SUCCESS)
         return;
 
     if (res == OUTPACKET_RESULT_NO_ROOM_IN_BUFFER)
     {
-        /* queue the packet */
+        /* queue the packet, shared packets are queued by reference */
         queueLock.Acquire();
-        WorldPacket* packet = new WorldPacket(opcode, len);
-        if (len)
-            packet->append(static_cast<const uint8_t*>(data), len);
+        if (sharedPacket)
+        {
+            _queue.push_back(sharedPacket);
+        }
+        else
+        {
+            auto packet = std::make_shared<WorldPacket>(opcode, len);
+            if (len)
+                packet->append(static_cast<const uint8_t*>(data), len);
 
-        _queue.Push(packet);
+            _queue.push_back(std::move(packet));
+        }
         queueLock.Release();
     }
 }
 
+void WorldSocket::SendSharedPackets(std::vector<SharedWorldPacket> const& packets)
+{
+    // the write mutex is recursive and held by the socket thread while it sends
+    BurstBegin();
+    for (const auto& packet : packets)
+        SendSharedPacket(packet);
+    BurstEnd();
+}
+
 void WorldSocket::UpdateQueuedPackets()
 {
     queueLock.Acquire();
-    if (!_queue.HasItems())
+    if (_queue.empty())
     {
         queueLock.Release();
         return;
     }
 
-    WorldPacket* pck;
-    while ((pck = _queue.front()) != nullptr)
+    while (!_queue.empty())
     {
+        const SharedWorldPacket pck = _queue.front();
+
         /* try to push out as many as you can */
-        switch (_OutPacket(pck->GetOpcode(), pck->size(), pck->size() ? pck->contents() : nullptr))
+        switch (_OutPacket(pck->GetOpcode(), pck->size(), pck->size() ? pck->contents() : nullptr, pck))
         {
             case OUTPACKET_RESULT_SUCCESS:
             {
-                delete pck;
                 _queue.pop_front();
             }
             break;
@@ -259,10 +271,7 @@ void WorldSocket::UpdateQueuedPackets()
         default:
             {
                 /* kill everything in the buffer */
-                while ((pck == _queue.Pop()) != 0)
-                {
-                    delete pck;
-                }
+                _queue.clear();
                 queueLock.Release();
                 return;
             }
@@ -272,15 +281,23 @@ void WorldSocket::UpdateQueuedPackets()
 }
 
 #if VERSION_STRING != Mop
-OUTPACKET_RESULT WorldSocket::_OutPacket(uint16 opcode, size_t len, const void* data)
+OUTPACKET_RESULT WorldSocket::_OutPacket(uint16 opcode, size_t len, const void* data, SharedWorldPacket const& sharedPacket)
 {
     bool rv;
     if (!IsConnected())
         return OUTPACKET_RESULT_NOT_CONNECTED;
 
+#ifdef CONFIG_USE_EPOLL
+    // big shared packets only need room for the header, their payload is referenced
+    const bool sendShared = sharedPacket != nullptr && len >= WORLDSOCKET_SHARED_PACKET_MIN_SIZE;
+#else
+    // IOCP and kqueue copy the payload behind the header, the copy path checks the room for both at once
+    const bool sendShared = false;
+#endif
+
     BurstBegin();
     //if ((m_writeByteCount + len + 4) >= m_writeBufferSize)
-    if (writeBuffer.GetSpace() < (len + 4))
+    if (sendShared ? (writeBuffer.GetSpace() < 8 || GetPendingSendSize() + len > WORLDSOCKET_SENDBUF_SIZE) : writeBuffer.GetSpace() < (len + 4))
     {
         BurstEnd();
         return OUTPACKET_RESULT_NO_ROOM_IN_BUFFER;
@@ -317,7 +334,10 @@ OUTPACKET_RESULT WorldSocket::_OutPacket(uint16 opcode, size_t len, const void*
     // Pass the rest of the packet to our send buffer (if there is any)
     if (len > 0 && rv)
     {
-        rv = BurstSend(static_cast<const uint8*>(data), static_cast<uint32>(len));
+        if (sendShared)
+            rv = BurstSendShared(sharedPacket);
+        else
+            rv = BurstSend(static_cast<const uint8*>(data), static_cast<uint32>(len));
     }
 
     if (rv) BurstPush();
@@ -325,15 +345,23 @@ OUTPACKET_RESULT WorldSocket::_OutPacket(uint16 opcode, size_t len, const void*
     return rv ? OUTPACKET_RESULT_SUCCESS : OUTPACKET_RESULT_SOCKET_ERROR;
 }
 #else
-OUTPACKET_RESULT WorldSocket::_OutPacket(uint32_t opcode, size_t len, const void* data)
+OUTPACKET_RESULT WorldSocket::_OutPacket(uint32_t opcode, size_t len, const void* data, SharedWorldPacket const& sharedPacket)
 {
     bool rv;
     if (!IsConnected())
         return OUTPACKET_RESULT_NOT_CONNECTED;
 
+#ifdef CONFIG_USE_EPOLL
+    // big shared packets only need room for the header, their payload is referenced
+    const bool sendShared = sharedPacket != nullptr && len >= WORLDSOCKET_SHARED_PACKET_MIN_SIZE;
+#else
+    // IOCP and kqueue copy the payload behind the header, the copy path checks the room for both at once
+    const bool sendShared = false;
+#endif
+
     BurstBegin();
 
-    if (writeBuffer.GetSpace() < (len + 4))
+    if (sendShared ? (writeBuffer.GetSpace() < 8 || GetPendingSendSize() + len > WORLDSOCKET_SENDBUF_SIZE) : writeBuffer.GetSpace() < (len + 4))
     {
         BurstEnd();
         return OUTPACKET_RESULT_NO_ROOM_IN_BUFFER;
@@ -394,7 +422,12 @@ OUTPACKET_RESULT WorldSocket::_OutPacket(uint32_t opcode, size_t len, const void
 
     // Pass the rest of the packet to our send buffer (if there is any)
     if (len > 0 && rv)
-        rv = BurstSend(static_cast<const uint8_t*>(data), static_cast<uint32_t>(len));
+    {
+        if (sendShared)
+            rv = BurstSendShared(sharedPacket);
+        else
+            rv = BurstSend(static_cast<const uint8_t*>(data), static_cast<uint32_t>(len));
+    }
 
     if (rv)
         BurstPush();
@@ -26,10 +26,15 @@
 #include "WorldPacket.h"
 #include "Network/Network.h"
 
+#include <deque>
 #include <string>
+#include <vector>
 
 #define WORLDSOCKET_SENDBUF_SIZE 131078
 #define WORLDSOCKET_RECVBUF_SIZE 16384
+// Shared packets smaller than this are copied to the send buffer, referencing them would cost more than the copy.
+// Only epoll references shared packets, IOCP and kqueue always copy.
+#define WORLDSOCKET_SHARED_PACKET_MIN_SIZE 256
 
 class SocketHandler;
 class WorldSession;
@@ -71,12 +76,18 @@ class SERVER_DECL WorldSocket : public Socket
         // vs8 fix - send null on empty buffer
         inline void SendPacket(WorldPacket* packet) { if (!packet) return; OutPacket(packet->GetOpcode(), packet->size(), (packet->size() ? (const void*)packet->contents() : NULL)); }
 
+        // Only the header is written per socket, the payload is sent from the shared packet
+        inline void SendSharedPacket(SharedWorldPacket const& packet) { if (!packet) return; OutPacket(packet->GetOpcode(), packet->size(), (packet->size() ? (const void*)packet->contents() : NULL), packet); }
+
+        // Writes all packets to the send buffer before the socket thread may send, they leave with one write
+        void SendSharedPackets(std::vector<SharedWorldPacket> const& packets);
+
 #if VERSION_STRING != Mop
-        void OutPacket(uint16 opcode, size_t len, const void* data);
-        OUTPACKET_RESULT _OutPacket(uint16 opcode, size_t len, const void* data);
+        void OutPacket(uint16 opcode, size_t len, const void* data, SharedWorldPacket const& sharedPacket = nullptr);
+        OUTPACKET_RESULT _OutPacket(uint16 opcode, size_t len, const void* data, SharedWorldPacket const& sharedPacket = nullptr);
 #else
-        void OutPacket(uint32_t opcode, size_t len, const void* data);
-        OUTPACKET_RESULT _OutPacket(uint32_t opcode, size_t len, const void* data);
+        void OutPacket(uint32_t opcode, size_t len, const void* data, SharedWorldPacket const& sharedPacket = nullptr);
+        OUTPACKET_RESULT _OutPacket(uint32_t opcode, size_t len, const void* data, SharedWorldPacket const& sharedPacket = nullptr);
 #endif
 
         inline uint32 GetLatency() { return _latency; }
@@ -113,7 +124,7 @@ class SERVER_DECL WorldSocket : public Socket
 
         WorldSession* mSession;
         WorldPacket* pAuthenticationPacket;
-        FastQueue<WorldPacket*, DummyLock> _queue;
+        std::deque<SharedWorldPacket> _queue;
         Mutex queueLock;
 
         WowCrypt _crypt;
@@ -232,7 +232,7 @@ void Aura::removeAura(AuraRemoveMode mode/* = AURA_REMOVE_BY_SERVER*/)
     }
 
     // Remove aura from unit before removing modifiers
-    getOwner()->m_auras[m_auraSlot] = nullptr;
+    getOwner()->m_auras.clear(m_auraSlot);
 
     // Remove all modifiers
     applyModifiers(false);
@@ -291,10 +291,10 @@ bool Aura::canPeriodicEffectCrit()
             return true;
     }
 
-    for (auto i = MAX_TOTAL_AURAS_START; i < MAX_TOTAL_AURAS_END; ++i)
+    for (const auto slot : caster->m_auras.getSlotsWithAuraEffect(SPELL_AURA_ALLOW_DOT_TO_CRIT))
     {
-        Aura* aur = caster->m_auras[i];
-        if (aur == nullptr || !aur->hasAuraEffect(SPELL_AURA_ALLOW_DOT_TO_CRIT))
+        Aura* aur = caster->m_auras[slot];
+        if (!aur->hasAuraEffect(SPELL_AURA_ALLOW_DOT_TO_CRIT))
             continue;
 
         if (aur->getSpellInfo()->isAuraEffectAffectingSpell(SPELL_AURA_ALLOW_DOT_TO_CRIT, spellInfo))
@@ -836,10 +836,10 @@ bool Aura::_canHasteAffectDuration()
     if (caster == nullptr)
         return false;
 
-    for (auto i = MAX_TOTAL_AURAS_START; i < MAX_TOTAL_AURAS_END; ++i)
+    for (const auto slot : caster->m_auras.getSlotsWithAuraEffect(SPELL_AURA_ALLOW_HASTE_AFFECT_DURATION))
     {
-        Aura* aur = caster->m_auras[i];
-        if (aur == nullptr || !aur->hasAuraEffect(SPELL_AURA_ALLOW_HASTE_AFFECT_DURATION))
+        Aura* aur = caster->m_auras[slot];
+        if (!aur->hasAuraEffect(SPELL_AURA_ALLOW_HASTE_AFFECT_DURATION))
             continue;
 
         // Check if caster has an aura which allows haste to modify duration
@@ -5,6 +5,8 @@ This file is released under the MIT license. See README-MIT for more information
 
 #include "StdAfx.h"
 #include "Storage/MySQLDataStore.hpp"
+#include "Management/WordFilter.h"
+#include "Storage/WorldDatabaseSnapshot.hpp"
 #include "Server/MainServerDefines.h"
 #include "Config/Config.h"
 #include "Spell/SpellMgr.hpp"
@@ -120,7 +122,7 @@ void MySQLDataStore::loadItemPagesTable()
 {
     auto startTime = Util::TimeNow();
 
-    QueryResult* itempages_result = WorldDatabase.Query("SELECT entry, text, next_page FROM item_pages");
+    QueryResult* itempages_result = sWorldDatabaseSnapshot.query("SELECT entry, text, next_page FROM item_pages");
     if (itempages_result == nullptr)
     {
         sLogger.info("MySQLDataLoads : Table `item_pages` is empty!");
@@ -173,7 +175,7 @@ void MySQLDataStore::loadItemPropertiesTable()
     for (tableiterator = ItemPropertiesTables.begin(); tableiterator != ItemPropertiesTables.end(); ++tableiterator)
     {
         std::string table_name = *tableiterator;
-        QueryResult* item_result = WorldDatabase.Query("SELECT * FROM %s base "
+        QueryResult* item_result = sWorldDatabaseSnapshot.query("SELECT * FROM %s base "
             "WHERE build=(SELECT MAX(build) FROM %s spec WHERE base.entry = spec.entry AND build <= %u)", table_name.c_str(), table_name.c_str(), VERSION_STRING);
 
         //                                                         0      1       2        3       4        5         6       7       8       9          10
@@ -560,7 +562,7 @@ void MySQLDataStore::loadCreaturePropertiesTable()
     {
         std::string table_name = *tableiterator;
         //                                                                      0          1           2             3                 4               5                  6
-        QueryResult* creature_properties_result = WorldDatabase.Query("SELECT entry, killcredit1, killcredit2, male_displayid, female_displayid, male_displayid2, female_displayid2, "
+        QueryResult* creature_properties_result = sWorldDatabaseSnapshot.query("SELECT entry, killcredit1, killcredit2, male_displayid, female_displayid, male_displayid2, female_displayid2, "
         //                                                         7      8         9         10       11     12     13       14            15              16           17
                                                                 "name, subname, info_str, type_flags, type, family, `rank`, encounter, base_attack_mod, range_attack_mod, leader, "
         //                                                          18        19        20        21         22      23     24      25          26           27
@@ -864,7 +866,7 @@ void MySQLDataStore::loadCreaturePropertiesMovementTable()
     uint32_t creature_properties_movement_count = 0;
 
     //                                                                      0          1           2             3                 4               5                  6
-    QueryResult* creature_properties_movement_result = WorldDatabase.Query("SELECT CreatureId, Ground, Swim, Flight, Rooted, Chase, Random, InteractionPauseTimer FROM creature_properties_movement");
+    QueryResult* creature_properties_movement_result = sWorldDatabaseSnapshot.query("SELECT CreatureId, Ground, Swim, Flight, Rooted, Chase, Random, InteractionPauseTimer FROM creature_properties_movement");
 
     if (creature_properties_movement_result == nullptr)
     {
@@ -930,7 +932,7 @@ void MySQLDataStore::loadGameObjectPropertiesTable()
     {
         std::string table_name = *tableiterator;
         //                                                                        0       1        2        3         4              5          6          7            8             9
-        QueryResult* gameobject_properties_result = WorldDatabase.Query("SELECT entry, type, display_id, name, category_name, cast_bar_text, UnkStr, parameter_0, parameter_1, parameter_2, "
+        QueryResult* gameobject_properties_result = sWorldDatabaseSnapshot.query("SELECT entry, type, display_id, name, category_name, cast_bar_text, UnkStr, parameter_0, parameter_1, parameter_2, "
         //                                                                10           11          12           13           14            15           16           17           18
                                                                     "parameter_3, parameter_4, parameter_5, parameter_6, parameter_7, parameter_8, parameter_9, parameter_10, parameter_11, "
         //                                                                19            20            21            22           23            24            25            26
@@ -1059,7 +1061,7 @@ void MySQLDataStore::loadQuestPropertiesTable()
     {
         std::string table_name = *tableiterator;
         //                                                        0       1     2      3       4          5        6          7              8                 9
-        QueryResult* quest_result = WorldDatabase.Query("SELECT entry, ZoneId, sort, flags, MinLevel, questlevel, Type, RequiredRaces, RequiredClass, RequiredTradeskill, "
+        QueryResult* quest_result = sWorldDatabaseSnapshot.query("SELECT entry, ZoneId, sort, flags, MinLevel, questlevel, Type, RequiredRaces, RequiredClass, RequiredTradeskill, "
         //                                                          10                    11                 12             13          14            15           16         17
                                                         "RequiredTradeskillValue, RequiredRepFaction, RequiredRepValue, LimitTime, SpecialFlags, PrevQuestId, NextQuestId, srcItem, "
         //                                                     18        19     20         21            22              23          24          25               26
@@ -1300,7 +1302,7 @@ void MySQLDataStore::loadGameObjectQuestItemBindingTable()
     auto startTime = Util::TimeNow();
 
     //                                                                        0      1     2        3
-    QueryResult* gameobject_quest_item_result = WorldDatabase.Query("SELECT entry, quest, item, item_count FROM gameobject_quest_item_binding");
+    QueryResult* gameobject_quest_item_result = sWorldDatabaseSnapshot.query("SELECT entry, quest, item, item_count FROM gameobject_quest_item_binding");
 
     uint32_t gameobject_quest_item_count = 0;
 
@@ -1344,7 +1346,7 @@ void MySQLDataStore::loadGameObjectQuestPickupBindingTable()
     auto startTime = Util::TimeNow();
 
     //                                                                          0      1           2
-    QueryResult* gameobject_quest_pickup_result = WorldDatabase.Query("SELECT entry, quest, required_count FROM gameobject_quest_pickup_binding");
+    QueryResult* gameobject_quest_pickup_result = sWorldDatabaseSnapshot.query("SELECT entry, quest, required_count FROM gameobject_quest_pickup_binding");
 
     uint32_t gameobject_quest_pickup_count = 0;
 
@@ -1390,7 +1392,7 @@ void MySQLDataStore::loadCreatureDifficultyTable()
     auto startTime = Util::TimeNow();
 
     //                                                                         0          1            2             3
-    QueryResult* creature_difficulty_result = WorldDatabase.Query("SELECT entry, difficulty_1, difficulty_2, difficulty_3 FROM creature_difficulty");
+    QueryResult* creature_difficulty_result = sWorldDatabaseSnapshot.query("SELECT entry, difficulty_1, difficulty_2, difficulty_3 FROM creature_difficulty");
 
     if (creature_difficulty_result == nullptr)
     {
@@ -1463,7 +1465,7 @@ void MySQLDataStore::loadDisplayBoundingBoxesTable()
 
     //                                                                            0       1    2     3      4      5      6         7
     //QueryResult* display_bounding_boxes_result = WorldDatabase.Query("SELECT displayid, lowx, lowy, lowz, highx, highy, highz, boundradius FROM display_bounding_boxes");
-    QueryResult* display_bounding_boxes_result = WorldDatabase.Query("SELECT displayid, highz FROM display_bounding_boxes");
+    QueryResult* display_bounding_boxes_result = sWorldDatabaseSnapshot.query("SELECT displayid, highz FROM display_bounding_boxes");
 
     if (display_bounding_boxes_result == nullptr)
     {
@@ -1520,7 +1522,7 @@ void MySQLDataStore::loadVendorRestrictionsTable()
     auto startTime = Util::TimeNow();
 
     //                                                                      0       1          2            3              4
-    QueryResult* vendor_restricitons_result = WorldDatabase.Query("SELECT entry, racemask, classmask, reqrepfaction, reqrepfactionvalue, "
+    QueryResult* vendor_restricitons_result = sWorldDatabaseSnapshot.query("SELECT entry, racemask, classmask, reqrepfaction, reqrepfactionvalue, "
     //                                                                    5                 6           7
                                                                   "canbuyattextid, cannotbuyattextid, flags FROM vendor_restrictions");
 
@@ -1574,7 +1576,7 @@ void MySQLDataStore::loadNpcTextTable()
     auto startTime = Util::TimeNow();
 
     //                                                                  0
-    QueryResult* npc_gossip_text_result = WorldDatabase.Query("SELECT entry, "
+    QueryResult* npc_gossip_text_result = sWorldDatabaseSnapshot.query("SELECT entry, "
     //                                                     1       2        3       4          5           6            7           8            9           10
                                                         "prob0, text0_0, text0_1, lang0, EmoteDelay0_0, Emote0_0, EmoteDelay0_1, Emote0_1, EmoteDelay0_2, Emote0_2, "
     //                                                     11      12       13      14         15          16           17          18           19          20
@@ -1655,7 +1657,7 @@ void MySQLDataStore::loadNpcScriptTextTable()
     auto startTime = Util::TimeNow();
 
     //                                                                  0      1           2       3     4       5          6         7       8        9         10
-    QueryResult* npc_script_text_result = WorldDatabase.Query("SELECT entry, text, creature_entry, id, type, language, probability, emote, duration, sound, broadcast_id FROM npc_script_text");
+    QueryResult* npc_script_text_result = sWorldDatabaseSnapshot.query("SELECT entry, text, creature_entry, id, type, language, probability, emote, duration, sound, broadcast_id FROM npc_script_text");
 
     if (npc_script_text_result == nullptr)
     {
@@ -1710,7 +1712,7 @@ void MySQLDataStore::loadGossipMenuOptionTable()
     auto startTime = Util::TimeNow();
 
     //                                                                      0         1
-    QueryResult* gossip_menu_optiont_result = WorldDatabase.Query("SELECT entry, option_text FROM gossip_menu_option");
+    QueryResult* gossip_menu_optiont_result = sWorldDatabaseSnapshot.query("SELECT entry, option_text FROM gossip_menu_option");
 
     if (gossip_menu_optiont_result == nullptr)
     {
@@ -1756,7 +1758,7 @@ void MySQLDataStore::loadGraveyardsTable()
     auto startTime = Util::TimeNow();
 
     //                                                            0         1         2           3            4         5          6           7       8
-    QueryResult* graveyards_result = WorldDatabase.Query("SELECT id, position_x, position_y, position_z, orientation, zoneid, adjacentzoneid, mapid, faction FROM graveyards");
+    QueryResult* graveyards_result = sWorldDatabaseSnapshot.query("SELECT id, position_x, position_y, position_z, orientation, zoneid, adjacentzoneid, mapid, faction FROM graveyards");
     if (graveyards_result == nullptr)
     {
         sLogger.info("MySQLDataLoads : Table `graveyards` is empty!");
@@ -1808,7 +1810,7 @@ void MySQLDataStore::loadTeleportCoordsTable()
     auto startTime = Util::TimeNow();
 
     //                                                                0     1         2           3           4
-    QueryResult* teleport_coords_result = WorldDatabase.Query("SELECT id, mapId, position_x, position_y, position_z FROM spell_teleport_coords");
+    QueryResult* teleport_coords_result = sWorldDatabaseSnapshot.query("SELECT id, mapId, position_x, position_y, position_z FROM spell_teleport_coords");
     if (teleport_coords_result == nullptr)
     {
         sLogger.info("MySQLDataLoads : Table `spell_teleport_coords` is empty!");
@@ -1856,7 +1858,7 @@ void MySQLDataStore::loadFishingTable()
     auto startTime = Util::TimeNow();
 
     //                                                          0      1         2
-    QueryResult* fishing_result = WorldDatabase.Query("SELECT zone, MinSkill, MaxSkill FROM fishing");
+    QueryResult* fishing_result = sWorldDatabaseSnapshot.query("SELECT zone, MinSkill, MaxSkill FROM fishing");
     if (fishing_result == nullptr)
     {
         sLogger.info("MySQLDataLoads : Table `fishing` is empty!");
@@ -1902,7 +1904,7 @@ void MySQLDataStore::loadWorldMapInfoTable()
     auto startTime = Util::TimeNow();
 
     //                                                                0        1       2       3           4             5          6        7      8          9
-    QueryResult* worldmap_info_result = WorldDatabase.Query("SELECT entry, screenid, type, maxplayers, minlevel, minlevel_heroic, repopx, repopy, repopz, repopentry, "
+    QueryResult* worldmap_info_result = sWorldDatabaseSnapshot.query("SELECT entry, screenid, type, maxplayers, minlevel, minlevel_heroic, repopx, repopy, repopz, repopentry, "
     //                                                           10       11      12         13           14                15              16
                                                             "area_name, flags, cooldown, lvl_mod_a, required_quest_A, required_quest_H, required_item, "
     //                                                              17              18              19                20
@@ -1971,7 +1973,7 @@ void MySQLDataStore::loadZoneGuardsTable()
     auto startTime = Util::TimeNow();
 
     //                                                             0         1              2
-    QueryResult* zone_guards_result = WorldDatabase.Query("SELECT zone, horde_entry, alliance_entry FROM zoneguards");
+    QueryResult* zone_guards_result = sWorldDatabaseSnapshot.query("SELECT zone, horde_entry, alliance_entry FROM zoneguards");
     if (zone_guards_result == nullptr)
     {
         sLogger.info("MySQLDataLoads : Table `zoneguards` is empty!");
@@ -2017,7 +2019,7 @@ void MySQLDataStore::loadBattleMastersTable()
     auto startTime = Util::TimeNow();
 
     //                                                                      0                1
-    QueryResult* battlemasters_result = WorldDatabase.Query("SELECT creature_entry, battleground_id FROM battlemasters");
+    QueryResult* battlemasters_result = sWorldDatabaseSnapshot.query("SELECT creature_entry, battleground_id FROM battlemasters");
     if (battlemasters_result == nullptr)
     {
         sLogger.info("MySQLDataLoads : Table `battlemasters` is empty!");
@@ -2064,7 +2066,7 @@ void MySQLDataStore::loadTotemDisplayIdsTable()
     auto startTime = Util::TimeNow();
 
     //                                                                  0     1        2
-    QueryResult* totemdisplayids_result = WorldDatabase.Query("SELECT race, totem, displayid FROM totemdisplayids base "
+    QueryResult* totemdisplayids_result = sWorldDatabaseSnapshot.query("SELECT race, totem, displayid FROM totemdisplayids base "
         "WHERE build=(SELECT MAX(build) FROM totemdisplayids spec WHERE base.race = spec.race AND base.totem = spec.totem AND build <= %u)", VERSION_STRING);
 
     if (totemdisplayids_result == nullptr)
@@ -2111,7 +2113,7 @@ void MySQLDataStore::loadSpellClickSpellsTable()
     auto startTime = Util::TimeNow();
 
     //                                                                      0         1
-    QueryResult* spellclickspells_result = WorldDatabase.Query("SELECT CreatureID, SpellID FROM spellclickspells");
+    QueryResult* spellclickspells_result = sWorldDatabaseSnapshot.query("SELECT CreatureID, SpellID FROM spellclickspells");
     if (spellclickspells_result == nullptr)
     {
         sLogger.info("MySQLDataLoads : Table `spellclickspells` is empty!");
@@ -2156,7 +2158,7 @@ void MySQLDataStore::loadWorldStringsTable()
     auto startTime = Util::TimeNow();
 
     //                                                                     0     1
-    QueryResult* worldstring_tables_result = WorldDatabase.Query("SELECT entry, text FROM worldstring_tables");
+    QueryResult* worldstring_tables_result = sWorldDatabaseSnapshot.query("SELECT entry, text FROM worldstring_tables");
     if (worldstring_tables_result == nullptr)
     {
         sLogger.info("MySQLDataLoads : Table `worldstring_tables` is empty!");
@@ -2201,7 +2203,7 @@ void MySQLDataStore::loadPointsOfInterestTable()
     auto startTime = Util::TimeNow();
 
     //                                                                      0   1  2    3     4     5        6
-    QueryResult* points_of_interest_result = WorldDatabase.Query("SELECT entry, x, y, icon, flags, data, icon_name FROM points_of_interest");
+    QueryResult* points_of_interest_result = sWorldDatabaseSnapshot.query("SELECT entry, x, y, icon, flags, data, icon_name FROM points_of_interest");
     if (points_of_interest_result == nullptr)
     {
         sLogger.info("MySQLDataLoads : Table `points_of_interest` is empty!");
@@ -2251,7 +2253,7 @@ void MySQLDataStore::loadItemSetLinkedSetBonusTable()
     auto startTime = Util::TimeNow();
 
     //                                                                    0            1
-    QueryResult* linked_set_bonus_result = WorldDatabase.Query("SELECT itemset, itemset_bonus FROM itemset_linked_itemsetbonus");
+    QueryResult* linked_set_bonus_result = sWorldDatabaseSnapshot.query("SELECT itemset, itemset_bonus FROM itemset_linked_itemsetbonus");
     if (linked_set_bonus_result == nullptr)
     {
         sLogger.info("MySQLDataLoads : Table `itemset_linked_itemsetbonus` is empty!");
@@ -2301,7 +2303,7 @@ void MySQLDataStore::loadCreatureInitialEquipmentTable()
     auto startTime = Util::TimeNow();
 
     //                                                                        0              1           2          3
-    QueryResult* initial_equipment_result = WorldDatabase.Query("SELECT creature_entry, itemslot_1, itemslot_2, itemslot_3 FROM creature_initial_equip;");
+    QueryResult* initial_equipment_result = sWorldDatabaseSnapshot.query("SELECT creature_entry, itemslot_1, itemslot_2, itemslot_3 FROM creature_initial_equip;");
     if (initial_equipment_result == nullptr)
     {
         sLogger.info("MySQLDataLoads : Table `creature_initial_equip` is empty!");
@@ -2340,7 +2342,7 @@ void MySQLDataStore::loadPlayerCreateInfoTable()
     auto startTime = Util::TimeNow();
 
     //                                                                     0       1      2       3      4       5          6          7           8
-    QueryResult* player_create_info_result = WorldDatabase.Query("SELECT `Index`, race, class, mapID, zoneID, positionX, positionY, positionZ, orientation, "
+    QueryResult* player_create_info_result = sWorldDatabaseSnapshot.query("SELECT `Index`, race, class, mapID, zoneID, positionX, positionY, positionZ, orientation, "
     //                                                                9            10           11           12           13           14         15        16        17
                                                                 "BaseStrength, BaseAgility, BaseStamina, BaseIntellect, BaseSpirit, BaseHealth, BaseMana, BaseRage, BaseFocus, "
     //                                                                18         19         20      21       22
@@ -2407,7 +2409,7 @@ void MySQLDataStore::loadPlayerCreateInfoSkillsTable()
     auto startTime = Util::TimeNow();
 
     //                                                                              0       1       2        3
-    QueryResult* player_create_info_skills_result = WorldDatabase.Query("SELECT Indexid, skillid, level, maxlevel FROM playercreateinfo_skills "
+    QueryResult* player_create_info_skills_result = sWorldDatabaseSnapshot.query("SELECT Indexid, skillid, level, maxlevel FROM playercreateinfo_skills "
                                                                         "WHERE build = %u", VERSION_STRING);
 
     if (player_create_info_skills_result == nullptr)
@@ -2456,7 +2458,7 @@ void MySQLDataStore::loadPlayerCreateInfoSpellsTable()
     auto startTime = Util::TimeNow();
 
     //                                                                            0       1
-    QueryResult* player_create_info_spells_result = WorldDatabase.Query("SELECT indexid, spellid FROM playercreateinfo_spells WHERE build = %u", VERSION_STRING);
+    QueryResult* player_create_info_spells_result = sWorldDatabaseSnapshot.query("SELECT indexid, spellid FROM playercreateinfo_spells WHERE build = %u", VERSION_STRING);
 
     if (player_create_info_spells_result == nullptr)
     {
@@ -2499,7 +2501,7 @@ void MySQLDataStore::loadPlayerCreateInfoItemsTable()
     auto startTime = Util::TimeNow();
 
     //                                                                            0        1       2        3
-    QueryResult* player_create_info_items_result = WorldDatabase.Query("SELECT indexid, protoid, slotid, amount FROM playercreateinfo_items WHERE build = %u", VERSION_STRING);
+    QueryResult* player_create_info_items_result = sWorldDatabaseSnapshot.query("SELECT indexid, protoid, slotid, amount FROM playercreateinfo_items WHERE build = %u", VERSION_STRING);
 
     if (player_create_info_items_result == nullptr)
     {
@@ -2551,7 +2553,7 @@ void MySQLDataStore::loadPlayerCreateInfoBarsTable(uint32_t player_info_index)
     PlayerCreateInfo& playerCreateInfo = _playerCreateInfoStore[player_info_index];
 
     //                                                                          0     1      2        3      4     5
-    QueryResult* player_create_info_bars_result = WorldDatabase.Query("SELECT race, class, button, action, type, misc FROM playercreateinfo_bars "
+    QueryResult* player_create_info_bars_result = sWorldDatabaseSnapshot.query("SELECT race, class, button, action, type, misc FROM playercreateinfo_bars "
                                                                       "WHERE build = %u AND class = %u", VERSION_STRING, uint32_t(playerCreateInfo.class_));
 
     if (player_create_info_bars_result == nullptr)
@@ -2604,7 +2606,7 @@ void MySQLDataStore::loadPlayerXpToLevelTable()
     for (uint32_t level = 0; level < worldConfig.player.playerLevelCap; ++level)
         _playerXPperLevelStore[level] = 0;
 
-    QueryResult* player_xp_to_level_result = WorldDatabase.Query("SELECT player_lvl, next_lvl_req_xp FROM player_xp_for_level base "
+    QueryResult* player_xp_to_level_result = sWorldDatabaseSnapshot.query("SELECT player_lvl, next_lvl_req_xp FROM player_xp_for_level base "
         "WHERE build=(SELECT MAX(build) FROM player_xp_for_level spec WHERE base.player_lvl = spec.player_lvl AND build <= %u)", VERSION_STRING);
 
     if (player_xp_to_level_result == nullptr)
@@ -2654,7 +2656,7 @@ uint32_t MySQLDataStore::getPlayerXPForLevel(uint32_t level)
 
 void MySQLDataStore::loadSpellOverrideTable()
 {
-    QueryResult* spelloverride_result = WorldDatabase.Query("SELECT DISTINCT overrideId FROM spelloverride");
+    QueryResult* spelloverride_result = sWorldDatabaseSnapshot.query("SELECT DISTINCT overrideId FROM spelloverride");
     if (spelloverride_result == nullptr)
     {
         sLogger.info("MySQLDataLoads : Table `spelloverride` is empty!");
@@ -2666,7 +2668,7 @@ void MySQLDataStore::loadSpellOverrideTable()
         Field* fields = spelloverride_result->Fetch();
         uint32_t distinct_override_id = fields[0].GetUInt32();
 
-        QueryResult* spellid_for_overrideid_result = WorldDatabase.Query("SELECT spellId FROM spelloverride WHERE overrideId = %u", distinct_override_id);
+        QueryResult* spellid_for_overrideid_result = sWorldDatabaseSnapshot.query("SELECT spellId FROM spelloverride WHERE overrideId = %u", distinct_override_id);
         std::list<SpellInfo const*>* list = new std::list <SpellInfo const*>;
         if (spellid_for_overrideid_result != nullptr)
         {
@@ -2708,7 +2710,7 @@ void MySQLDataStore::loadNpcGossipTextIdTable()
 {
     auto startTime = Util::TimeNow();
     //                                                    0         1
-    QueryResult* npc_gossip_properties_result = WorldDatabase.Query("SELECT creatureid, textid FROM npc_gossip_properties");
+    QueryResult* npc_gossip_properties_result = sWorldDatabaseSnapshot.query("SELECT creatureid, textid FROM npc_gossip_properties");
     if (npc_gossip_properties_result == nullptr)
     {
         sLogger.info("MySQLDataLoads : Table `npc_gossip_properties` is empty!");
@@ -2751,7 +2753,7 @@ void MySQLDataStore::loadPetLevelAbilitiesTable()
 {
     auto startTime = Util::TimeNow();
     //                                                                      0       1      2        3        4        5         6         7
-    QueryResult* pet_level_abilities_result = WorldDatabase.Query("SELECT level, health, armor, strength, agility, stamina, intellect, spirit FROM pet_level_abilities");
+    QueryResult* pet_level_abilities_result = sWorldDatabaseSnapshot.query("SELECT level, health, armor, strength, agility, stamina, intellect, spirit FROM pet_level_abilities");
     if (pet_level_abilities_result == nullptr)
     {
         sLogger.info("MySQLDataLoads : Table `pet_level_abilities` is empty!");
@@ -2805,7 +2807,7 @@ void MySQLDataStore::loadBroadcastTable()
 {
     auto startTime = Util::TimeNow();
 
-    QueryResult* broadcast_result = WorldDatabase.Query("SELECT * FROM worldbroadcast");
+    QueryResult* broadcast_result = sWorldDatabaseSnapshot.query("SELECT * FROM worldbroadcast");
     if (broadcast_result == nullptr)
     {
         sLogger.info("MySQLDataLoads : Table `worldbroadcast` is empty!");
@@ -2856,7 +2858,7 @@ void MySQLDataStore::loadAreaTriggerTable()
 {
     auto startTime = Util::TimeNow();
     //                                                               0      1    2     3       4       5           6          7             8               9                  10
-    QueryResult* area_trigger_result = WorldDatabase.Query("SELECT entry, type, map, screen, name, position_x, position_y, position_z, orientation, required_honor_rank, required_level FROM areatriggers");
+    QueryResult* area_trigger_result = sWorldDatabaseSnapshot.query("SELECT entry, type, map, screen, name, position_x, position_y, position_z, orientation, required_honor_rank, required_level FROM areatriggers");
     if (area_trigger_result == nullptr)
     {
         sLogger.info("MySQLDataLoads : Table `areatriggers` is empty!");
@@ -2942,16 +2944,17 @@ void MySQLDataStore::loadWordFilterCharacterNames()
 {
     auto startTime = Util::TimeNow();
 
-    QueryResult* filter_character_names_result = WorldDatabase.Query("SELECT * FROM wordfilter_character_names");
+    QueryResult* filter_character_names_result = sWorldDatabaseSnapshot.query("SELECT * FROM wordfilter_character_names");
     if (filter_character_names_result == nullptr)
     {
         sLogger.info("MySQLDataLoads : Table `wordfilter_character_names` is empty!");
+        std::atomic_store(&_wordFilterCharacterNames, std::shared_ptr<WordMatcher const>());
         return;
     }
 
     sLogger.info("MySQLDataLoads : Table `wordfilter_character_names` has %u columns", filter_character_names_result->GetFieldCount());
 
-    _wordFilterCharacterNamesStore.clear();
+    auto wordFilterCharacterNames = std::make_shared<WordMatcher>();
 
     uint32_t filter_character_names_count = 0;
     do
@@ -2966,7 +2969,8 @@ void MySQLDataStore::loadWordFilterCharacterNames()
             wfCharacterNames.nameReplace = "?%$?%$";
         }
 
-        _wordFilterCharacterNamesStore.push_back(wfCharacterNames);
+        // every name is blocked, the replacement is not used
+        wordFilterCharacterNames->addWord(wfCharacterNames.name, "");
 
         ++filter_character_names_count;
 
@@ -2974,38 +2978,36 @@ void MySQLDataStore::loadWordFilterCharacterNames()
 
     delete filter_character_names_result;
 
+    wordFilterCharacterNames->build();
+    std::atomic_store(&_wordFilterCharacterNames, std::shared_ptr<WordMatcher const>(wordFilterCharacterNames));
+
     sLogger.info("MySQLDataLoads : Loaded %u rows from `wordfilter_character_names` table in %u ms!", filter_character_names_count, static_cast<uint32_t>(Util::GetTimeDifferenceToNow(startTime)));
 }
 
 bool MySQLDataStore::isCharacterNameAllowed(std::string charName)
 {
-    std::list<MySQLStructure::WordFilterCharacterNames>::const_iterator iterator;
-    for (iterator = _wordFilterCharacterNamesStore.begin(); iterator != _wordFilterCharacterNamesStore.end(); ++iterator)
-    {
-        size_t pos = charName.find(iterator->name);
-        if (pos != std::string::npos)
-        {
-            return false;
-        }
-    }
+    const auto wordFilterCharacterNames = std::atomic_load(&_wordFilterCharacterNames);
+    if (wordFilterCharacterNames == nullptr)
+        return true;
 
-    return true;
+    return !wordFilterCharacterNames->containsWord(charName);
 }
 
 void MySQLDataStore::loadWordFilterChat()
 {
     auto startTime = Util::TimeNow();
 
-    QueryResult* filter_chat_result = WorldDatabase.Query("SELECT * FROM wordfilter_chat");
+    QueryResult* filter_chat_result = sWorldDatabaseSnapshot.query("SELECT * FROM wordfilter_chat");
     if (filter_chat_result == nullptr)
     {
         sLogger.info("MySQLDataLoads : Table `wordfilter_chat` is empty!");
+        std::atomic_store(&_wordFilterChat, std::shared_ptr<WordMatcher const>());
         return;
     }
 
     sLogger.info("MySQLDataLoads : Table `wordfilter_chat` has %u columns", filter_chat_result->GetFieldCount());
 
-    _wordFilterChatStore.clear();
+    auto wordFilterChat = std::make_shared<WordMatcher>();
 
     uint32_t filter_chat_count = 0;
     do
@@ -3024,7 +3026,7 @@ void MySQLDataStore::loadWordFilterChat()
             wfChat.blockMessage = false;
         }
 
-        _wordFilterChatStore.push_back(wfChat);
+        wordFilterChat->addWord(wfChat.word, wfChat.blockMessage ? "" : wfChat.wordReplace);
 
         ++filter_chat_count;
 
@@ -3032,6 +3034,9 @@ void MySQLDataStore::loadWordFilterChat()
 
     delete filter_chat_result;
 
+    wordFilterChat->build();
+    std::atomic_store(&_wordFilterChat, std::shared_ptr<WordMatcher const>(wordFilterChat));
+
     sLogger.info("MySQLDataLoads : Loaded %u rows from `wordfilter_chat` table in %u ms!", filter_chat_count, static_cast<uint32_t>(Util::GetTimeDifferenceToNow(startTime)));
 }
 
@@ -3041,7 +3046,7 @@ void MySQLDataStore::loadLocalesCreature()
 {
     auto startTime = Util::TimeNow();
     //                                                0         1          2      3
-    QueryResult* result = WorldDatabase.Query("SELECT id, language_code, name, subname FROM locales_creature");
+    QueryResult* result = sWorldDatabaseSnapshot.query("SELECT id, language_code, name, subname FROM locales_creature");
     if (result == nullptr)
     {
         sLogger.info("MySQLDataLoads : Table `locales_creature` is empty!");
@@ -3095,7 +3100,7 @@ void MySQLDataStore::loadLocalesGameobject()
 {
     auto startTime = Util::TimeNow();
     //                                                  0         1          2
-    QueryResult* result = WorldDatabase.Query("SELECT entry, language_code, name FROM locales_gameobject");
+    QueryResult* result = sWorldDatabaseSnapshot.query("SELECT entry, language_code, name FROM locales_gameobject");
     if (result == nullptr)
     {
         sLogger.info("MySQLDataLoads : Table `locales_gameobject` is empty!");
@@ -3148,7 +3153,7 @@ void MySQLDataStore::loadLocalesGossipMenuOption()
 {
     auto startTime = Util::TimeNow();
     //                                                   0         1             2
-    QueryResult* result = WorldDatabase.Query("SELECT entry, language_code, option_text FROM locales_gossip_menu_option");
+    QueryResult* result = sWorldDatabaseSnapshot.query("SELECT entry, language_code, option_text FROM locales_gossip_menu_option");
     if (result == nullptr)
     {
         sLogger.info("MySQLDataLoads : Table `locales_gossip_menu_option` is empty!");
@@ -3201,7 +3206,7 @@ void MySQLDataStore::loadLocalesItem()
 {
     auto startTime = Util::TimeNow();
     //                                                  0         1          2         3
-    QueryResult* result = WorldDatabase.Query("SELECT entry, language_code, name, description FROM locales_item");
+    QueryResult* result = sWorldDatabaseSnapshot.query("SELECT entry, language_code, name, description FROM locales_item");
     if (result == nullptr)
     {
         sLogger.info("MySQLDataLoads : Table `locales_item` is empty!");
@@ -3271,7 +3276,7 @@ void MySQLDataStore::loadLocalesItemPages()
 {
     auto startTime = Util::TimeNow();
     //                                                 0         1           2
-    QueryResult* result = WorldDatabase.Query("SELECT entry, language_code, text FROM locales_item_pages");
+    QueryResult* result = sWorldDatabaseSnapshot.query("SELECT entry, language_code, text FROM locales_item_pages");
     if (result == nullptr)
     {
         sLogger.info("MySQLDataLoads : Table `locales_item_pages` is empty!");
@@ -3324,7 +3329,7 @@ void MySQLDataStore::loadLocalesNpcScriptText()
 {
     auto startTime = Util::TimeNow();
     //                                                  0         1          2
-    QueryResult* result = WorldDatabase.Query("SELECT entry, language_code, text FROM locales_npc_script_text");
+    QueryResult* result = sWorldDatabaseSnapshot.query("SELECT entry, language_code, text FROM locales_npc_script_text");
     if (result == nullptr)
     {
         sLogger.info("MySQLDataLoads : Table `locales_npc_script_text` is empty!");
@@ -3377,7 +3382,7 @@ void MySQLDataStore::loadLocalesNpcText()
 {
     auto startTime = Util::TimeNow();
     //                                                  0         1           2       3       4       5       6       7       8       9       10      11     12      13      14      15      16      17
-    QueryResult* result = WorldDatabase.Query("SELECT entry, language_code, text0, text0_1, text1, text1_1, text2, text2_1, text3, text3_1, text4, text4_1, text5, text5_1, text6, text6_1, text7, text7_1 FROM locales_npc_gossip_texts");
+    QueryResult* result = sWorldDatabaseSnapshot.query("SELECT entry, language_code, text0, text0_1, text1, text1_1, text2, text2_1, text3, text3_1, text4, text4_1, text5, text5_1, text6, text6_1, text7, text7_1 FROM locales_npc_gossip_texts");
     if (result == nullptr)
     {
         sLogger.info("MySQLDataLoads : Table `locales_npc_gossip_texts` is empty!");
@@ -3435,7 +3440,7 @@ void MySQLDataStore::loadLocalesQuest()
 {
     auto startTime = Util::TimeNow();
     //                                                  0         1           2       3         4            5                 6           7           8                9              10             11
-    QueryResult* result = WorldDatabase.Query("SELECT entry, language_code, Title, Details, Objectives, CompletionText, IncompleteText, EndText, ObjectiveText1, ObjectiveText2, ObjectiveText3, ObjectiveText4 FROM locales_quest");
+    QueryResult* result = sWorldDatabaseSnapshot.query("SELECT entry, language_code, Title, Details, Objectives, CompletionText, IncompleteText, EndText, ObjectiveText1, ObjectiveText2, ObjectiveText3, ObjectiveText4 FROM locales_quest");
     if (result == nullptr)
     {
         sLogger.info("MySQLDataLoads : Table `locales_quest` is empty!");
@@ -3497,7 +3502,7 @@ void MySQLDataStore::loadLocalesWorldbroadcast()
 {
     auto startTime = Util::TimeNow();
     //                                                  0         1          2
-    QueryResult* result = WorldDatabase.Query("SELECT entry, language_code, text FROM locales_worldbroadcast");
+    QueryResult* result = sWorldDatabaseSnapshot.query("SELECT entry, language_code, text FROM locales_worldbroadcast");
     if (result == nullptr)
     {
         sLogger.info("MySQLDataLoads : Table `locales_worldbroadcast` is empty!");
@@ -3550,7 +3555,7 @@ void MySQLDataStore::loadLocalesWorldmapInfo()
 {
     auto startTime = Util::TimeNow();
     //                                                  0           1         2
-    QueryResult* result = WorldDatabase.Query("SELECT entry, language_code, text FROM locales_worldmap_info");
+    QueryResult* result = sWorldDatabaseSnapshot.query("SELECT entry, language_code, text FROM locales_worldmap_info");
     if (result == nullptr)
     {
         sLogger.info("MySQLDataLoads : Table `locales_worldmap_info` is empty!");
@@ -3603,7 +3608,7 @@ void MySQLDataStore::loadLocalesWorldStringTable()
 {
     auto startTime = Util::TimeNow();
     //                                                  0           1         2
-    QueryResult* result = WorldDatabase.Query("SELECT entry, language_code, text FROM locales_worldstring_table");
+    QueryResult* result = sWorldDatabaseSnapshot.query("SELECT entry, language_code, text FROM locales_worldstring_table");
     if (result == nullptr)
     {
         sLogger.info("MySQLDataLoads : Table `locales_worldstring_table` is empty!");
@@ -3686,7 +3691,7 @@ void MySQLDataStore::loadCreatureAiTextTable()
 {
     auto startTime = Util::TimeNow();
     //                                                  0      1       2        3       4       5          6
-    QueryResult* result = WorldDatabase.Query("SELECT entry, event, chance, text0, text1, text2, text3, text4 FROM creature_ai_texts");
+    QueryResult* result = sWorldDatabaseSnapshot.query("SELECT entry, event, chance, text0, text1, text2, text3, text4 FROM creature_ai_texts");
     if (result == nullptr)
     {
         sLogger.info("MySQLDataLoads : Table `creature_ai_texts` is empty!");
@@ -3826,7 +3831,7 @@ void MySQLDataStore::loadProfessionDiscoveriesTable()
 {
     auto startTime = Util::TimeNow();
     //                                                   0           1              2          3
-    QueryResult* result = WorldDatabase.Query("SELECT SpellId, SpellToDiscover, SkillValue, Chance FROM professiondiscoveries");
+    QueryResult* result = sWorldDatabaseSnapshot.query("SELECT SpellId, SpellToDiscover, SkillValue, Chance FROM professiondiscoveries");
     if (result == nullptr)
     {
         sLogger.info("MySQLDataLoads : Table `professiondiscoveries` is empty!");
@@ -3859,7 +3864,7 @@ void MySQLDataStore::loadTransportDataTable()
 {
     auto startTime = Util::TimeNow();
     //                                                  0      1
-    QueryResult* result = WorldDatabase.Query("SELECT entry, name FROM transport_data WHERE min_build <= %u AND max_build >= %u", getAEVersion(), getAEVersion());
+    QueryResult* result = sWorldDatabaseSnapshot.query("SELECT entry, name FROM transport_data WHERE min_build <= %u AND max_build >= %u", getAEVersion(), getAEVersion());
     if (result == nullptr)
     {
         sLogger.info("MySQLDataLoads : Table `transport_data` is empty!");
@@ -3904,7 +3909,7 @@ void MySQLDataStore::loadTransportEntrys()
 {
     auto startTime = Util::TimeNow();
     //                                                  
-    QueryResult* result = WorldDatabase.Query("SELECT entry FROM gameobject_properties WHERE type = 15 AND  build <= %u ORDER BY entry ASC", getAEVersion());
+    QueryResult* result = sWorldDatabaseSnapshot.query("SELECT entry FROM gameobject_properties WHERE type = 15 AND  build <= %u ORDER BY entry ASC", getAEVersion());
     if (result == nullptr)
     {
         sLogger.info("MySQLDataLoads : Loaded 0 transport templates. DB table `gameobject_properties` has no transports!");
@@ -3933,7 +3938,7 @@ void MySQLDataStore::loadTransportMaps()
 {
     auto startTime = Util::TimeNow();
     //                                                  
-    QueryResult* result = WorldDatabase.Query("SELECT parameter_6 FROM gameobject_properties WHERE type = 15 AND  build <= %u ORDER BY entry ASC", getAEVersion());
+    QueryResult* result = sWorldDatabaseSnapshot.query("SELECT parameter_6 FROM gameobject_properties WHERE type = 15 AND  build <= %u ORDER BY entry ASC", getAEVersion());
     if (result == nullptr)
     {
         sLogger.info("MySQLDataLoads : Loaded 0 transport maps. DB table `gameobject_properties` has no transports!");
@@ -3962,7 +3967,7 @@ void MySQLDataStore::loadGossipMenuItemsTable()
     auto startTime = Util::TimeNow();
 
     //                                                      0          1
-    QueryResult* result = WorldDatabase.Query("SELECT gossip_menu, text_id FROM gossip_menu ORDER BY gossip_menu");
+    QueryResult* result = sWorldDatabaseSnapshot.query("SELECT gossip_menu, text_id FROM gossip_menu ORDER BY gossip_menu");
     if (result == nullptr)
     {
         sLogger.info("MySQLDataLoads : Table `gossip_menu` is empty!");
@@ -3991,7 +3996,7 @@ void MySQLDataStore::loadGossipMenuItemsTable()
     _gossipMenuItemsStores.clear();
 
     //                                                      0       1            2        3            4                5               6               7                 8                9                10                11                 12
-    QueryResult* resultItems = WorldDatabase.Query("SELECT id, item_order, menu_option, icon, on_choose_action, on_choose_data, on_choose_data2, on_choose_data3, on_choose_data4, next_gossip_menu, next_gossip_text, requirement_type, requirement_data FROM gossip_menu_items ORDER BY id, item_order");
+    QueryResult* resultItems = sWorldDatabaseSnapshot.query("SELECT id, item_order, menu_option, icon, on_choose_action, on_choose_data, on_choose_data2, on_choose_data3, on_choose_data4, next_gossip_menu, next_gossip_text, requirement_type, requirement_data FROM gossip_menu_items ORDER BY id, item_order");
     if (resultItems == nullptr)
     {
         sLogger.info("MySQLDataLoads : Table `gossip_menu_items` is empty!");
@@ -4036,7 +4041,7 @@ void MySQLDataStore::loadCreatureSpawns()
     uint32_t count = 0;
     for (std::set<std::string>::iterator tableiterator = CreatureSpawnsTables.begin(); tableiterator != CreatureSpawnsTables.end(); ++tableiterator)
     {
-        QueryResult* creature_spawn_result = WorldDatabase.Query("SELECT * FROM %s WHERE min_build <= %u AND max_build >= %u AND event_entry = 0", (*tableiterator).c_str(), getAEVersion(), getAEVersion());
+        QueryResult* creature_spawn_result = sWorldDatabaseSnapshot.query("SELECT * FROM %s WHERE min_build <= %u AND max_build >= %u AND event_entry = 0", (*tableiterator).c_str(), getAEVersion(), getAEVersion());
         if (creature_spawn_result)
         {
             uint32 creature_spawn_fields = creature_spawn_result->GetFieldCount();
@@ -4142,7 +4147,7 @@ void MySQLDataStore::loadGameobjectSpawns()
 
     for (std::set<std::string>::iterator tableiterator = GameObjectSpawnsTables.begin(); tableiterator != GameObjectSpawnsTables.end(); ++tableiterator)
     {
-        QueryResult* gobject_spawn_result = WorldDatabase.Query("SELECT * FROM %s WHERE min_build <= %u AND max_build >= %u AND event_entry = 0", (*tableiterator).c_str(), VERSION_STRING, VERSION_STRING);
+        QueryResult* gobject_spawn_result = sWorldDatabaseSnapshot.query("SELECT * FROM %s WHERE min_build <= %u AND max_build >= %u AND event_entry = 0", (*tableiterator).c_str(), VERSION_STRING, VERSION_STRING);
         if (gobject_spawn_result)
         {
             uint32 gobject_spawn_fields = gobject_spawn_result->GetFieldCount();
@@ -4226,7 +4231,7 @@ void MySQLDataStore::loadRecallTable()
 
     for (std::set<std::string>::iterator tableiterator = RecallTables.begin(); tableiterator != RecallTables.end(); ++tableiterator)
     {
-        QueryResult* recall_result = WorldDatabase.Query("SELECT id, name, MapId, positionX, positionY, positionZ, Orientation FROM %s WHERE min_build <= %u AND max_build >= %u", (*tableiterator).c_str(), VERSION_STRING, VERSION_STRING);
+        QueryResult* recall_result = sWorldDatabaseSnapshot.query("SELECT id, name, MapId, positionX, positionY, positionZ, Orientation FROM %s WHERE min_build <= %u AND max_build >= %u", (*tableiterator).c_str(), VERSION_STRING, VERSION_STRING);
         if (recall_result)
         {
             do
@@ -10,6 +10,10 @@ This file is released under the MIT license. See README-MIT for more information
 #include "Spell/Definitions/TeleportCoords.hpp"
 #include "MySQLStructures.h"
 
+#include <memory>
+
+class WordMatcher;
+
 extern SERVER_DECL std::set<std::string> CreaturePropertiesTables;
 extern SERVER_DECL std::set<std::string> CreatureQuestStarterTables;
 extern SERVER_DECL std::set<std::string> CreatureQuestFinisherTables;
@@ -80,9 +84,6 @@ public:
 
     typedef std::unordered_map<uint32_t, MySQLStructure::AreaTrigger> AreaTriggerContainer;
 
-    typedef std::list<MySQLStructure::WordFilterCharacterNames> WordFilterCharacterNamesSet;
-    typedef std::list<MySQLStructure::WordFilterChat> WordFilterChatSet;
-
     //////////////////////////////////////////////////////////////////////////////////////////
     // locales
     typedef std::unordered_map<uint32_t, MySQLStructure::LocalesCreature> LocalesCreatureContainer;
@@ -226,6 +227,9 @@ public:
 
     bool isCharacterNameAllowed(std::string charName);
 
+    // replaced on reload, keep the returned pointer while using it
+    std::shared_ptr<WordMatcher const> getWordFilterChat() const { return std::atomic_load(&_wordFilterChat); }
+
     bool isTransportMap(uint32_t mapId) const
     {
         if (std::find(_transportMapStore.begin(), _transportMapStore.end(), mapId) != _transportMapStore.end())
@@ -363,8 +367,9 @@ public:
 
     AreaTriggerContainer _areaTriggerStore;
 
-    WordFilterCharacterNamesSet _wordFilterCharacterNamesStore;
-    WordFilterChatSet _wordFilterChatStore;
+    // compiled from the tables, swapped atomically by the loaders
+    std::shared_ptr<WordMatcher const> _wordFilterCharacterNames;
+    std::shared_ptr<WordMatcher const> _wordFilterChat;
 
     //////////////////////////////////////////////////////////////////////////////////////////
     // locales
@@ -0,0 +1,146 @@
+/*
+Copyright (c) 2014-2021 AscEmu Team <http://www.ascemu.org>
+This file is released under the MIT license. See README-MIT for more information.
+*/
+
+#include "MySQLTableLoader.hpp"
+#include "Logging/Logger.hpp"
+#include "Threading/AEWorkerPool.h"
+#include "Errors.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+
+using namespace AscEmu::Threading;
+
+void MySQLTableLoader::addTable(std::string const& name, LoadFunction loadFunction, std::vector<std::string> const& dependencies)
+{
+    ARCEMU_ASSERT(m_tableIndex.find(name) == m_tableIndex.end());
+
+    const size_t index = m_tables.size();
+
+    TableNode table;
+    table.name = name;
+    table.loadFunction = std::move(loadFunction);
+
+    for (const auto& dependency : dependencies)
+    {
+        // unknown dependencies would never be resolved, also this keeps the graph free of cycles
+        const auto dependencyItr = m_tableIndex.find(dependency);
+        if (dependencyItr == m_tableIndex.end())
+        {
+            sLogger.failure("MySQLTableLoader : Table %s depends on %s which is not added before it", name.c_str(), dependency.c_str());
+            ARCEMU_ASSERT(false);
+            continue;
+        }
+
+        m_tables[dependencyItr->second].dependents.push_back(index);
+        ++table.dependencyCount;
+    }
+
+    m_tables.push_back(std::move(table));
+    m_tableIndex.emplace(name, index);
+}
+
+void MySQLTableLoader::loadTable(TableNode& table, std::chrono::steady_clock::time_point loadStart)
+{
+    const auto tableStart = std::chrono::steady_clock::now();
+
+    table.loadFunction();
+
+    const auto tableEnd = std::chrono::steady_clock::now();
+    table.startTime = std::chrono::duration_cast<std::chrono::microseconds>(tableStart - loadStart).count();
+    table.duration = std::chrono::duration_cast<std::chrono::microseconds>(tableEnd - tableStart).count();
+}
+
+void MySQLTableLoader::load(uint32_t threadCount)
+{
+    if (m_tables.empty())
+        return;
+
+    const auto loadStart = std::chrono::steady_clock::now();
+
+    if (threadCount <= 1)
+    {
+        // tables are added after their dependencies, so the order of addition is always valid
+        for (auto& table : m_tables)
+            loadTable(table, loadStart);
+    }
+    else
+    {
+        threadCount = std::min<uint32_t>(threadCount, static_cast<uint32_t>(m_tables.size()));
+
+        std::mutex finishedMutex;
+        std::condition_variable finishedCondition;
+        size_t finishedTables = 0;
+
+        for (auto& table : m_tables)
+            table.pendingDependencies = table.dependencyCount;
+
+        AEWorkerPool loaderPool("MySQLTableLoader", static_cast<uint16_t>(threadCount));
+
+        std::function<void(size_t)> runTable = [&](size_t index)
+        {
+            TableNode& table = m_tables[index];
+            loadTable(table, loadStart);
+
+            std::vector<size_t> readyTables;
+            {
+                std::lock_guard<std::mutex> guard(finishedMutex);
+                ++finishedTables;
+
+                for (const auto dependent : table.dependents)
+                {
+                    if (--m_tables[dependent].pendingDependencies == 0)
+                        readyTables.push_back(dependent);
+                }
+
+                // notified under the lock, load() may return as soon as it is released
+                finishedCondition.notify_all();
+            }
+
+            for (const auto readyIndex : readyTables)
+                loaderPool.enqueue([&runTable, readyIndex]() { runTable(readyIndex); });
+        };
+
+        for (size_t i = 0; i < m_tables.size(); ++i)
+        {
+            if (m_tables[i].dependencyCount == 0)
+                loaderPool.enqueue([&runTable, i]() { runTable(i); });
+        }
+
+        std::unique_lock<std::mutex> lock(finishedMutex);
+        finishedCondition.wait(lock, [&] { return finishedTables == m_tables.size(); });
+        lock.unlock();
+
+        loaderPool.shutdown();
+    }
+
+    const uint64_t wallTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - loadStart).count();
+    logTimingReport(wallTime, threadCount <= 1 ? 1 : threadCount);
+}
+
+void MySQLTableLoader::logTimingReport(uint64_t wallTime, uint32_t threadCount) const
+{
+    std::vector<const TableNode*> sortedTables;
+    sortedTables.reserve(m_tables.size());
+
+    uint64_t tableTime = 0;
+    for (const auto& table : m_tables)
+    {
+        sortedTables.push_back(&table);
+        tableTime += table.duration;
+    }
+
+    std::sort(sortedTables.begin(), sortedTables.end(), [](const TableNode* a, const TableNode* b) { return a->duration > b->duration; });
+
+    sLogger.info("MySQLTableLoader : Loaded %u tables with %u thread(s) in %u ms (%u ms if loaded one after another)",
+        static_cast<uint32_t>(m_tables.size()), threadCount, static_cast<uint32_t>(wallTime / 1000), static_cast<uint32_t>(tableTime / 1000));
+
+    for (const auto table : sortedTables)
+    {
+        sLogger.info("MySQLTableLoader : %-36s %6u ms (started after %u ms, %u dependencies)",
+            table->name.c_str(), static_cast<uint32_t>(table->duration / 1000), static_cast<uint32_t>(table->startTime / 1000), table->dependencyCount);
+    }
+}
@@ -0,0 +1,53 @@
+/*
+Copyright (c) 2014-2021 AscEmu Team <http://www.ascemu.org>
+This file is released under the MIT license. See README-MIT for more information.
+*/
+
+#pragma once
+
+#include "CommonTypes.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+// Loads world database tables as a dependency graph.
+// Every table declares the tables it reads from, tables without pending dependencies are
+// loaded at the same time. Each loader thread uses its own connection of the world database.
+class SERVER_DECL MySQLTableLoader
+{
+public:
+    typedef std::function<void()> LoadFunction;
+
+    // Dependencies have to be added before the tables depending on them
+    void addTable(std::string const& name, LoadFunction loadFunction, std::vector<std::string> const& dependencies = {});
+
+    // Loads all added tables and logs the time spent on each of them.
+    // threadCount <= 1 loads the tables one after another in the order they were added.
+    void load(uint32_t threadCount);
+
+    size_t getTableCount() const { return m_tables.size(); }
+
+private:
+    struct TableNode
+    {
+        std::string name;
+        LoadFunction loadFunction;
+        std::vector<size_t> dependents;
+        uint32_t dependencyCount = 0;
+        uint32_t pendingDependencies = 0;
+
+        // microseconds, relative to the start of load()
+        uint64_t startTime = 0;
+        uint64_t duration = 0;
+    };
+
+    void loadTable(TableNode& table, std::chrono::steady_clock::time_point loadStart);
+    void logTimingReport(uint64_t wallTime, uint32_t threadCount) const;
+
+    std::vector<TableNode> m_tables;
+    std::map<std::string, size_t> m_tableIndex;
+};
@@ -0,0 +1,550 @@
+/*
+Copyright (c) 2014-2021 AscEmu Team <http://www.ascemu.org>
+This file is released under the MIT license. See README-MIT for more information.
+*/
+
+#include "StdAfx.h"
+#include "Storage/WorldDatabaseSnapshot.hpp"
+#include "Server/MainServerDefines.h"
+#include "Database/Database.h"
+#include "Logging/Logger.hpp"
+#include "Server/World.h"
+#include "Util.hpp"
+#include "crc32.h"
+
+#include <cstdarg>
+#include <cstring>
+#include <fstream>
+#include <map>
+
+#ifndef WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    const char snapshotMagic[8] = { 'A', 'E', 'S', 'N', 'A', 'P', 'S', 'H' };
+    const uint32_t snapshotFormatVersion = 1;
+
+    struct SnapshotHeader
+    {
+        char magic[8];
+        uint32_t formatVersion;
+        uint32_t databaseChecksum;
+        uint32_t entryCount;
+        uint32_t payloadChecksum;
+        uint64_t payloadSize;
+    };
+
+    class SnapshotQueryResult : public QueryResult
+    {
+    public:
+
+        SnapshotQueryResult(uint32_t fieldCount, uint32_t rowCount, std::vector<char*> values) :
+            QueryResult(fieldCount, rowCount), m_values(std::move(values)), m_fields(fieldCount), m_nextRow(0)
+        {
+            mCurrentRow = m_fields.data();
+        }
+
+        bool NextRow() override
+        {
+            if (m_nextRow >= mRowCount)
+                return false;
+
+            char** row = &m_values[static_cast<size_t>(m_nextRow) * mFieldCount];
+            for (uint32_t i = 0; i < mFieldCount; ++i)
+                m_fields[i].SetValue(row[i]);
+
+            ++m_nextRow;
+            return true;
+        }
+
+    private:
+
+        std::vector<char*> m_values;
+        std::vector<Field> m_fields;
+        uint32_t m_nextRow;
+    };
+
+    template <typename T>
+    bool readValue(const char*& position, const char* end, T& value)
+    {
+        if (static_cast<size_t>(end - position) < sizeof(T))
+            return false;
+
+        memcpy(&value, position, sizeof(T));
+        position += sizeof(T);
+        return true;
+    }
+
+    template <typename T>
+    void writeValue(std::ofstream& file, T const& value)
+    {
+        file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+}
+
+WorldDatabaseSnapshot& WorldDatabaseSnapshot::getInstance()
+{
+    static WorldDatabaseSnapshot mInstance;
+    return mInstance;
+}
+
+WorldDatabaseSnapshot::~WorldDatabaseSnapshot()
+{
+    unmapFile();
+}
+
+void WorldDatabaseSnapshot::open(std::string const& fileName)
+{
+    auto startTime = Util::TimeNow();
+
+    m_fileName = fileName;
+    m_isDirty = false;
+    m_hitCount = 0;
+    m_missCount = 0;
+    m_entries.clear();
+
+    // without checksum a snapshot can not be validated, neither use nor write one
+    m_databaseChecksum = calculateDatabaseChecksum();
+    if (m_databaseChecksum == 0)
+    {
+        sLogger.failure("WorldDatabaseSnapshot : Could not calculate the world database checksum, loading without snapshot");
+        return;
+    }
+
+    m_isOpen = true;
+
+    if (!mapFile())
+    {
+        sLogger.info("WorldDatabaseSnapshot : No snapshot found at %s, it will be created after loading", m_fileName.c_str());
+        m_isDirty = true;
+        return;
+    }
+
+    if (!readEntries())
+    {
+        m_entries.clear();
+        unmapFile();
+        m_isDirty = true;
+        return;
+    }
+
+    sLogger.info("WorldDatabaseSnapshot : Using %s with %u queries (%u MB), validated in %u ms", m_fileName.c_str(), static_cast<uint32_t>(m_entries.size()),
+        static_cast<uint32_t>(m_fileSize / (1024 * 1024)), static_cast<uint32_t>(Util::GetTimeDifferenceToNow(startTime)));
+}
+
+void WorldDatabaseSnapshot::close()
+{
+    if (!m_isOpen)
+        return;
+
+    m_isOpen = false;
+
+    sLogger.info("WorldDatabaseSnapshot : %u queries loaded from snapshot, %u queries loaded from database", m_hitCount, m_missCount);
+
+    if (m_isDirty || m_missCount > 0)
+    {
+        auto startTime = Util::TimeNow();
+        if (writeFile())
+            sLogger.info("WorldDatabaseSnapshot : Written %s in %u ms", m_fileName.c_str(), static_cast<uint32_t>(Util::GetTimeDifferenceToNow(startTime)));
+        else
+            sLogger.failure("WorldDatabaseSnapshot : Could not write %s", m_fileName.c_str());
+    }
+
+    m_entries.clear();
+    unmapFile();
+}
+
+uint32_t WorldDatabaseSnapshot::calculateDatabaseChecksum()
+{
+    // state of every table, one of
+    // quick: live checksum of MyISAM tables created with CHECKSUM=1, read without touching the rows
+    // update: last update time of the other tables, unless they were changed in the current second
+    // full: row checksum for tables without update time (InnoDB after a MySQL restart), this scans the table
+    std::map<std::string, std::string> tableStates;
+
+    QueryResult* tableResult = WorldDatabase.Query("SHOW TABLES");
+    if (tableResult == nullptr)
+        return 0;
+
+    do
+    {
+        tableStates.emplace(tableResult->Fetch()[0].GetString(), std::string());
+    } while (tableResult->NextRow());
+
+    delete tableResult;
+
+    const auto checksumTables = [&tableStates](const char* mode) -> bool
+    {
+        std::string checksumQuery;
+        for (const auto& table : tableStates)
+        {
+            if (!table.second.empty())
+                continue;
+
+            checksumQuery += checksumQuery.empty() ? "CHECKSUM TABLE `" : ", `";
+            checksumQuery += table.first;
+            checksumQuery += "`";
+        }
+
+        if (checksumQuery.empty())
+            return true;
+
+        const bool isQuick = strcmp(mode, "quick") == 0;
+        if (isQuick)
+            checksumQuery += " QUICK";
+
+        QueryResult* checksumResult = WorldDatabase.Query("%s", checksumQuery.c_str());
+        if (checksumResult == nullptr)
+            return false;
+
+        do
+        {
+            Field* fields = checksumResult->Fetch();
+
+            // the result names the table as database.table
+            std::string tableName = fields[0].GetString();
+            const auto separator = tableName.find('.');
+            if (separator != std::string::npos)
+                tableName.erase(0, separator + 1);
+
+            const auto tableItr = tableStates.find(tableName);
+            if (tableItr == tableStates.end())
+                continue;
+
+            if (fields[1].isSet())
+                tableItr->second = std::string(mode) + ":" + fields[1].GetString();
+            else if (!isQuick)
+                tableItr->second = std::string(mode) + ":null";
+        } while (checksumResult->NextRow());
+
+        delete checksumResult;
+        return true;
+    };
+
+    if (!checksumTables("quick"))
+        return 0;
+
+    // MySQL 8 caches the table statistics for a day unless information_schema_stats_expiry is 0,
+    // the session variable has to be set on the connection that reads them
+    DatabaseConnection* connection = WorldDatabase.GetFreeConnection();
+
+    bool hasStatsExpiry = false;
+    if (QueryResult* expiryResult = WorldDatabase.FQuery("SHOW VARIABLES LIKE 'information_schema_stats_expiry'", connection))
+    {
+        hasStatsExpiry = true;
+        delete expiryResult;
+        WorldDatabase.FWaitExecute("SET SESSION information_schema_stats_expiry = 0", connection);
+    }
+
+    // UPDATE_TIME only has seconds, a table changed in the current second could change again unnoticed.
+    // It is left out and checksummed in full below.
+    QueryResult* updateResult = WorldDatabase.FQuery("SELECT TABLE_NAME, UPDATE_TIME FROM information_schema.TABLES WHERE TABLE_SCHEMA = DATABASE() AND UPDATE_TIME < NOW()", connection);
+
+    if (hasStatsExpiry)
+        WorldDatabase.FWaitExecute("SET SESSION information_schema_stats_expiry = DEFAULT", connection);
+
+    WorldDatabase.releaseConnection(connection);
+
+    if (updateResult != nullptr)
+    {
+        do
+        {
+            Field* fields = updateResult->Fetch();
+
+            const auto tableItr = tableStates.find(fields[0].GetString());
+            if (tableItr != tableStates.end() && tableItr->second.empty() && fields[1].isSet())
+                tableItr->second = std::string("update:") + fields[1].GetString();
+        } while (updateResult->NextRow());
+
+        delete updateResult;
+    }
+
+    if (!checksumTables("full"))
+        return 0;
+
+    std::string checksums = worldConfig.worldDb.dbName;
+    for (const auto& table : tableStates)
+    {
+        // a table that did not show up in any result can not be validated
+        if (table.second.empty())
+            return 0;
+
+        checksums += ";";
+        checksums += table.first;
+        checksums += "=";
+        checksums += table.second;
+    }
+
+    return static_cast<uint32_t>(crc32(reinterpret_cast<const unsigned char*>(checksums.c_str()), static_cast<unsigned int>(checksums.size())));
+}
+
+bool WorldDatabaseSnapshot::mapFile()
+{
+#ifdef WIN32
+    std::ifstream file(m_fileName, std::ios::binary | std::ios::ate);
+    if (!file.is_open())
+        return false;
+
+    m_fileBuffer.resize(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    if (!file.read(m_fileBuffer.data(), m_fileBuffer.size()))
+    {
+        m_fileBuffer.clear();
+        return false;
+    }
+
+    m_fileData = m_fileBuffer.data();
+    m_fileSize = m_fileBuffer.size();
+#else
+    const int fd = ::open(m_fileName.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0 || fileStat.st_size == 0)
+    {
+        ::close(fd);
+        return false;
+    }
+
+    void* data = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+
+    if (data == MAP_FAILED)
+        return false;
+
+    m_fileData = static_cast<const char*>(data);
+    m_fileSize = static_cast<uint64_t>(fileStat.st_size);
+#endif
+
+    return true;
+}
+
+void WorldDatabaseSnapshot::unmapFile()
+{
+    if (m_fileData == nullptr)
+        return;
+
+#ifdef WIN32
+    m_fileBuffer.clear();
+    m_fileBuffer.shrink_to_fit();
+#else
+    munmap(const_cast<char*>(m_fileData), static_cast<size_t>(m_fileSize));
+#endif
+
+    m_fileData = nullptr;
+    m_fileSize = 0;
+}
+
+bool WorldDatabaseSnapshot::readEntries()
+{
+    SnapshotHeader header;
+    if (m_fileSize < sizeof(SnapshotHeader))
+    {
+        sLogger.failure("WorldDatabaseSnapshot : %s is damaged, it will be rewritten", m_fileName.c_str());
+        return false;
+    }
+
+    memcpy(&header, m_fileData, sizeof(SnapshotHeader));
+
+    if (memcmp(header.magic, snapshotMagic, sizeof(snapshotMagic)) != 0 || header.formatVersion != snapshotFormatVersion)
+    {
+        sLogger.info("WorldDatabaseSnapshot : %s was written by another version, it will be rewritten", m_fileName.c_str());
+        return false;
+    }
+
+    if (header.databaseChecksum != m_databaseChecksum)
+    {
+        sLogger.info("WorldDatabaseSnapshot : World database changed since %s was written, it will be rewritten", m_fileName.c_str());
+        return false;
+    }
+
+    const char* position = m_fileData + sizeof(SnapshotHeader);
+    const char* end = m_fileData + m_fileSize;
+
+    if (header.payloadSize != static_cast<uint64_t>(end - position)
+        || crc32(reinterpret_cast<const unsigned char*>(position), static_cast<unsigned int>(header.payloadSize)) != header.payloadChecksum)
+    {
+        sLogger.failure("WorldDatabaseSnapshot : %s is damaged, it will be rewritten", m_fileName.c_str());
+        return false;
+    }
+
+    for (uint32_t i = 0; i < header.entryCount; ++i)
+    {
+        uint32_t queryLength;
+        if (!readValue(position, end, queryLength) || static_cast<size_t>(end - position) < queryLength)
+            return false;
+
+        std::string queryString(position, queryLength);
+        position += queryLength;
+
+        SnapshotEntry entry;
+        if (!readValue(position, end, entry.fieldCount) || !readValue(position, end, entry.rowCount) || !readValue(position, end, entry.dataSize))
+            return false;
+
+        if (static_cast<uint64_t>(end - position) < entry.dataSize)
+            return false;
+
+        entry.data = position;
+        position += entry.dataSize;
+
+        m_entries.emplace(std::move(queryString), std::move(entry));
+    }
+
+    return true;
+}
+
+bool WorldDatabaseSnapshot::writeFile()
+{
+    const std::string tempFileName = m_fileName + ".tmp";
+
+    std::ofstream file(tempFileName, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+        return false;
+
+    // the header is written again once the payload checksum is known
+    SnapshotHeader header;
+    memcpy(header.magic, snapshotMagic, sizeof(snapshotMagic));
+    header.formatVersion = snapshotFormatVersion;
+    header.databaseChecksum = m_databaseChecksum;
+    header.entryCount = static_cast<uint32_t>(m_entries.size());
+    header.payloadChecksum = 0;
+    header.payloadSize = 0;
+    writeValue(file, header);
+
+    std::vector<char> payload;
+    for (const auto& entry : m_entries)
+    {
+        const uint32_t queryLength = static_cast<uint32_t>(entry.first.size());
+
+        const size_t offset = payload.size();
+        payload.resize(offset + sizeof(uint32_t) + queryLength + sizeof(uint32_t) * 2 + sizeof(uint64_t) + entry.second.dataSize);
+
+        char* position = payload.data() + offset;
+        memcpy(position, &queryLength, sizeof(uint32_t));
+        position += sizeof(uint32_t);
+        memcpy(position, entry.first.data(), queryLength);
+        position += queryLength;
+        memcpy(position, &entry.second.fieldCount, sizeof(uint32_t));
+        position += sizeof(uint32_t);
+        memcpy(position, &entry.second.rowCount, sizeof(uint32_t));
+        position += sizeof(uint32_t);
+        memcpy(position, &entry.second.dataSize, sizeof(uint64_t));
+        position += sizeof(uint64_t);
+        if (entry.second.dataSize > 0)
+            memcpy(position, entry.second.data, entry.second.dataSize);
+    }
+
+    header.payloadSize = payload.size();
+    header.payloadChecksum = static_cast<uint32_t>(crc32(reinterpret_cast<const unsigned char*>(payload.data()), static_cast<unsigned int>(payload.size())));
+
+    file.write(payload.data(), payload.size());
+    file.seekp(0);
+    writeValue(file, header);
+    file.close();
+
+    if (file.fail())
+        return false;
+
+    std::error_code error;
+    fs::rename(tempFileName, m_fileName, error);
+    return !error;
+}
+
+QueryResult* WorldDatabaseSnapshot::createResult(SnapshotEntry const& entry)
+{
+    if (entry.rowCount == 0 || entry.fieldCount == 0)
+        return nullptr;
+
+    std::vector<char*> values;
+    values.reserve(static_cast<size_t>(entry.rowCount) * entry.fieldCount);
+
+    const char* position = entry.data;
+    const char* end = entry.data + entry.dataSize;
+    while (position < end)
+    {
+        if (*position++ == 0)
+        {
+            values.push_back(nullptr);
+            continue;
+        }
+
+        // Field only hands out const values, the mapped file is never written
+        values.push_back(const_cast<char*>(position));
+        position += strlen(position) + 1;
+    }
+
+    auto result = new SnapshotQueryResult(entry.fieldCount, entry.rowCount, std::move(values));
+    result->NextRow();
+    return result;
+}
+
+QueryResult* WorldDatabaseSnapshot::query(const char* queryString, ...)
+{
+    char sql[16384];
+    va_list vlist;
+    va_start(vlist, queryString);
+    vsnprintf(sql, 16384, queryString, vlist);
+    va_end(vlist);
+
+    if (!m_isOpen)
+        return WorldDatabase.Query("%s", sql);
+
+    {
+        std::lock_guard<std::mutex> guard(m_entriesMutex);
+
+        const auto entryItr = m_entries.find(sql);
+        if (entryItr != m_entries.end())
+        {
+            ++m_hitCount;
+            return createResult(entryItr->second);
+        }
+    }
+
+    QueryResult* databaseResult = WorldDatabase.Query("%s", sql);
+
+    SnapshotEntry entry;
+    if (databaseResult != nullptr)
+    {
+        entry.fieldCount = databaseResult->GetFieldCount();
+        entry.rowCount = databaseResult->GetRowCount();
+
+        do
+        {
+            Field* fields = databaseResult->Fetch();
+            for (uint32_t i = 0; i < entry.fieldCount; ++i)
+            {
+                const char* value = fields[i].GetString();
+                if (value == nullptr)
+                {
+                    entry.recordedData.push_back(0);
+                    continue;
+                }
+
+                entry.recordedData.push_back(1);
+                entry.recordedData.insert(entry.recordedData.end(), value, value + strlen(value) + 1);
+            }
+        } while (databaseResult->NextRow());
+
+        delete databaseResult;
+    }
+
+    std::lock_guard<std::mutex> guard(m_entriesMutex);
+    ++m_missCount;
+
+    // results handed out before point into the stored entry, a query recorded twice keeps the first one
+    const auto inserted = m_entries.emplace(sql, std::move(entry));
+    SnapshotEntry& storedEntry = inserted.first->second;
+    if (inserted.second)
+    {
+        storedEntry.data = storedEntry.recordedData.data();
+        storedEntry.dataSize = storedEntry.recordedData.size();
+    }
+
+    return createResult(storedEntry);
+}
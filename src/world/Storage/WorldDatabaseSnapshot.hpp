@@ -0,0 +1,91 @@
+/*
+Copyright (c) 2014-2021 AscEmu Team <http://www.ascemu.org>
+This file is released under the MIT license. See README-MIT for more information.
+*/
+
+#pragma once
+
+#include "CommonTypes.hpp"
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class QueryResult;
+
+// Binary copy of the rows returned by the world database queries at startup.
+// While the snapshot is open query() serves known queries from the snapshot file instead of MySQL,
+// the file is only used when the checksums or update times of all world database tables still match the ones it was written with,
+// without a database checksum the snapshot is neither used nor written.
+class SERVER_DECL WorldDatabaseSnapshot
+{
+private:
+
+    WorldDatabaseSnapshot() = default;
+    ~WorldDatabaseSnapshot();
+
+public:
+
+    static WorldDatabaseSnapshot& getInstance();
+
+    WorldDatabaseSnapshot(WorldDatabaseSnapshot&&) = delete;
+    WorldDatabaseSnapshot(WorldDatabaseSnapshot const&) = delete;
+    WorldDatabaseSnapshot& operator=(WorldDatabaseSnapshot&&) = delete;
+    WorldDatabaseSnapshot& operator=(WorldDatabaseSnapshot const&) = delete;
+
+    // Maps the snapshot file, an outdated or damaged file is ignored and rewritten on close()
+    void open(std::string const& fileName);
+
+    // Writes the snapshot if queries were not part of it and releases the mapped file
+    void close();
+
+    bool isOpen() const { return m_isOpen; }
+
+    // Same as WorldDatabase.Query, results are taken from or recorded into the snapshot while it is open
+    QueryResult* query(const char* queryString, ...);
+
+private:
+
+    struct SnapshotEntry
+    {
+        uint32_t fieldCount = 0;
+        uint32_t rowCount = 0;
+
+        // every field is stored as one byte null flag followed by the zero terminated value
+        const char* data = nullptr;
+        uint64_t dataSize = 0;
+
+        // only used by entries recorded from MySQL, data points into it
+        std::vector<char> recordedData;
+    };
+
+    uint32_t calculateDatabaseChecksum();
+
+    bool mapFile();
+    void unmapFile();
+    bool readEntries();
+    bool writeFile();
+
+    QueryResult* createResult(SnapshotEntry const& entry);
+
+    std::string m_fileName;
+    bool m_isOpen = false;
+    bool m_isDirty = false;
+
+    uint32_t m_databaseChecksum = 0;
+    uint32_t m_hitCount = 0;
+    uint32_t m_missCount = 0;
+
+    const char* m_fileData = nullptr;
+    uint64_t m_fileSize = 0;
+#ifdef WIN32
+    std::vector<char> m_fileBuffer;
+#endif
+
+    std::mutex m_entriesMutex;
+    std::unordered_map<std::string, SnapshotEntry> m_entries;
+};
+
+#define sWorldDatabaseSnapshot WorldDatabaseSnapshot::getInstance()
@@ -0,0 +1,135 @@
+/*
+Copyright (c) 2014-2021 AscEmu Team <http://www.ascemu.org>
+This file is released under the MIT license. See README-MIT for more information.
+*/
+
+#include "AuraContainer.hpp"
+#include "Spell/SpellAuras.h"
+#include "Spell/SpellInfo.hpp"
+
+#include <algorithm>
+
+AuraContainer::AuraContainer()
+{
+    m_slots.fill(nullptr);
+}
+
+void AuraContainer::set(uint16_t slot, Aura* aura)
+{
+    if (slot >= MAX_TOTAL_AURAS_END)
+        return;
+
+    if (m_slots[slot] != nullptr)
+        clear(slot);
+
+    if (aura == nullptr)
+        return;
+
+    m_slots[slot] = aura;
+
+    addSlot(m_occupiedSlots, slot);
+    addIndexedSlot(m_spellIdSlots, aura->getSpellId(), slot);
+    addIndexedSlot(m_casterSlots, aura->getCasterGuid(), slot);
+    addAuraEffects(aura, slot);
+}
+
+void AuraContainer::clear(uint16_t slot)
+{
+    if (slot >= MAX_TOTAL_AURAS_END)
+        return;
+
+    const auto aura = m_slots[slot];
+    if (aura == nullptr)
+        return;
+
+    m_slots[slot] = nullptr;
+
+    removeSlot(m_occupiedSlots, slot);
+    removeIndexedSlot(m_spellIdSlots, aura->getSpellId(), slot);
+    removeIndexedSlot(m_casterSlots, aura->getCasterGuid(), slot);
+    removeAuraEffects(aura, slot);
+}
+
+uint16_t AuraContainer::getNextOccupiedSlot(uint16_t slot) const
+{
+    const auto itr = std::lower_bound(m_occupiedSlots.begin(), m_occupiedSlots.end(), slot);
+    return itr != m_occupiedSlots.end() ? *itr : static_cast<uint16_t>(MAX_TOTAL_AURAS_END);
+}
+
+AuraContainer::SlotList const& AuraContainer::getSlotsWithSpellId(uint32_t spellId) const
+{
+    return findSlots(m_spellIdSlots, spellId);
+}
+
+AuraContainer::SlotList const& AuraContainer::getSlotsWithCaster(uint64_t casterGuid) const
+{
+    return findSlots(m_casterSlots, casterGuid);
+}
+
+AuraContainer::SlotList const& AuraContainer::getSlotsWithAuraEffect(AuraEffect auraEffect) const
+{
+    return findSlots(m_auraEffectSlots, static_cast<uint32_t>(auraEffect));
+}
+
+void AuraContainer::addSlot(SlotList& slots, uint16_t slot)
+{
+    const auto itr = std::lower_bound(slots.begin(), slots.end(), slot);
+    if (itr == slots.end() || *itr != slot)
+        slots.insert(itr, slot);
+}
+
+void AuraContainer::removeSlot(SlotList& slots, uint16_t slot)
+{
+    const auto itr = std::lower_bound(slots.begin(), slots.end(), slot);
+    if (itr != slots.end() && *itr == slot)
+        slots.erase(itr);
+}
+
+template <typename Key>
+void AuraContainer::removeIndexedSlot(std::unordered_map<Key, SlotList>& index, Key key, uint16_t slot)
+{
+    const auto itr = index.find(key);
+    if (itr == index.end())
+        return;
+
+    removeSlot(itr->second, slot);
+    if (itr->second.empty())
+        index.erase(itr);
+}
+
+template <typename Key>
+AuraContainer::SlotList const& AuraContainer::findSlots(std::unordered_map<Key, SlotList> const& index, Key key)
+{
+    static const SlotList emptySlots;
+
+    const auto itr = index.find(key);
+    return itr != index.end() ? itr->second : emptySlots;
+}
+
+// Effects are taken from the spell, every aura effect added to an aura is one of them
+void AuraContainer::addAuraEffects(Aura const* aura, uint16_t slot)
+{
+    for (uint8_t i = 0; i < MAX_SPELL_EFFECTS; ++i)
+    {
+        const auto auraEffect = aura->getSpellInfo()->getEffectApplyAuraName(i);
+        if (auraEffect == SPELL_AURA_NONE || auraEffect >= TOTAL_SPELL_AURAS)
+            continue;
+
+        addIndexedSlot(m_auraEffectSlots, auraEffect, slot);
+        m_auraEffectMask.set(auraEffect);
+    }
+}
+
+void AuraContainer::removeAuraEffects(Aura const* aura, uint16_t slot)
+{
+    for (uint8_t i = 0; i < MAX_SPELL_EFFECTS; ++i)
+    {
+        const auto auraEffect = aura->getSpellInfo()->getEffectApplyAuraName(i);
+        if (auraEffect == SPELL_AURA_NONE || auraEffect >= TOTAL_SPELL_AURAS)
+            continue;
+
+        removeIndexedSlot(m_auraEffectSlots, auraEffect, slot);
+        if (m_auraEffectSlots.find(auraEffect) == m_auraEffectSlots.end())
+            m_auraEffectMask.reset(auraEffect);
+    }
+}
@@ -0,0 +1,75 @@
+/*
+Copyright (c) 2014-2021 AscEmu Team <http://www.ascemu.org>
+This file is released under the MIT license. See README-MIT for more information.
+*/
+
+#pragma once
+
+#include "CommonTypes.hpp"
+#include "Macros/UnitMacros.hpp"
+#include "Spell/Definitions/AuraEffects.hpp"
+
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+class Aura;
+
+// Aura slots of a unit with lookups by spell id, aura effect and caster guid.
+// Slot lists are sorted, so lookups return auras in the same order as a scan over all slots.
+// Auras removed while a slot list is walked change the list, copy it before removing auras.
+class SERVER_DECL AuraContainer
+{
+public:
+
+    typedef std::vector<uint16_t> SlotList;
+
+    AuraContainer();
+
+    Aura* operator[](size_t slot) const { return m_slots[slot]; }
+
+    Aura* const* begin() const { return m_slots.data(); }
+    Aura* const* end() const { return m_slots.data() + m_slots.size(); }
+
+    void set(uint16_t slot, Aura* aura);
+    void clear(uint16_t slot);
+
+    size_t getAuraCount() const { return m_occupiedSlots.size(); }
+
+    // Returns the first occupied slot >= slot or MAX_TOTAL_AURAS_END, safe to use while auras are added or removed
+    uint16_t getNextOccupiedSlot(uint16_t slot) const;
+
+    SlotList const& getSlotsWithSpellId(uint32_t spellId) const;
+    SlotList const& getSlotsWithCaster(uint64_t casterGuid) const;
+
+    // Slots of auras whose spell applies the aura effect, the effect itself may have been removed from the aura
+    SlotList const& getSlotsWithAuraEffect(AuraEffect auraEffect) const;
+    bool mayHaveAuraEffect(AuraEffect auraEffect) const { return auraEffect < TOTAL_SPELL_AURAS && m_auraEffectMask.test(auraEffect); }
+
+private:
+
+    static void addSlot(SlotList& slots, uint16_t slot);
+    static void removeSlot(SlotList& slots, uint16_t slot);
+
+    template <typename Key>
+    static void addIndexedSlot(std::unordered_map<Key, SlotList>& index, Key key, uint16_t slot) { addSlot(index[key], slot); }
+
+    template <typename Key>
+    static void removeIndexedSlot(std::unordered_map<Key, SlotList>& index, Key key, uint16_t slot);
+
+    template <typename Key>
+    static SlotList const& findSlots(std::unordered_map<Key, SlotList> const& index, Key key);
+
+    void addAuraEffects(Aura const* aura, uint16_t slot);
+    void removeAuraEffects(Aura const* aura, uint16_t slot);
+
+    std::array<Aura*, MAX_TOTAL_AURAS_END> m_slots;
+
+    SlotList m_occupiedSlots;
+    std::unordered_map<uint32_t, SlotList> m_spellIdSlots;
+    std::unordered_map<uint64_t, SlotList> m_casterSlots;
+    std::unordered_map<uint32_t, SlotList> m_auraEffectSlots;
+    std::bitset<TOTAL_SPELL_AURAS> m_auraEffectMask;
+};
@@ -63,6 +63,7 @@
 #include "Spell/Definitions/PowerType.hpp"
 #include "Spell/Definitions/Spec.hpp"
 #include "Spell/SpellMgr.hpp"
+#include "Server/CharacterDatabaseStatements.hpp"
 #include "Units/Creatures/Pet.h"
 #include "Server/Packets/SmsgInitialSpells.h"
 #include "Data/WoWPlayer.hpp"
@@ -121,6 +122,47 @@ using namespace MapManagement::AreaManagement;
 
 UpdateMask Player::m_visibleUpdateMask;
 
+namespace
+{
+    // rows of a new character are executed directly, everything else goes into the transaction of the save
+    void executeSaveQuery(std::string const& query, QueryBuffer* buf)
+    {
+        if (buf == nullptr)
+            CharacterDatabase.ExecuteNA(query.c_str());
+        else
+            buf->AddQueryStr(query);
+    }
+
+    std::string getPlayerPetSaveQuery(uint32 ownerGuid, PlayerPet const* pet)
+    {
+        std::stringstream ss;
+
+        ss << "REPLACE INTO playerpets VALUES('"
+            << ownerGuid << "','"
+            << pet->number << "','"
+            << pet->name << "','"
+            << pet->entry << "','"
+            << pet->xp << "','"
+            << (pet->active ? 1 : 0) + pet->stablestate * 10 << "','"
+            << pet->level << "','"
+            << pet->actionbar << "','"
+            << pet->happinessupdate << "','"
+            << (long)pet->reset_time << "','"
+            << pet->reset_cost << "','"
+            << pet->spellid << "','"
+            << pet->petstate << "','"
+            << pet->alive << "','"
+            << pet->talentpoints << "','"
+            << pet->current_power << "','"
+            << pet->current_hp << "','"
+            << pet->current_happiness << "','"
+            << pet->renamable << "','"
+            << pet->type << "')";
+
+        return ss.str();
+    }
+}
+
 bool Player::Teleport(const LocationVector& vec, MapMgr* map)
 {
     if (map == nullptr)
@@ -1534,12 +1576,6 @@ void Player::smsg_InitialSpells()
 
 void Player::_SavePet(QueryBuffer* buf)
 {
-    // Remove any existing info
-    if (buf == nullptr)
-        CharacterDatabase.Execute("DELETE FROM playerpets WHERE ownerguid = %u", getGuidLow());
-    else
-        buf->AddQuery("DELETE FROM playerpets WHERE ownerguid = %u", getGuidLow());
-
     Pet* summon = GetSummon();
     if (summon && summon->IsInWorld() && summon->getPlayerOwner() == this)    // update PlayerPets array with current pet's info
     {
@@ -1553,66 +1589,81 @@ void Player::_SavePet(QueryBuffer* buf)
         {
             // save pet spellz
             uint32 pn = summon->m_PetNumber;
-            if (buf == nullptr)
-                CharacterDatabase.Execute("DELETE FROM playerpetspells WHERE ownerguid=%u AND petnumber=%u", getGuidLow(), pn);
-            else
-                buf->AddQuery("DELETE FROM playerpetspells WHERE ownerguid=%u AND petnumber=%u", getGuidLow(), pn);
 
+            uint64_t spellsValue = 0;
             for (PetSpellMap::iterator itr = summon->mSpells.begin(); itr != summon->mSpells.end(); ++itr)
+                spellsValue = SavedRowSet::hashValues({ spellsValue, itr->first->getId(), itr->second });
+
+            if (m_savedRows.petSpells.update(pn, spellsValue))
             {
                 if (buf == nullptr)
-                    CharacterDatabase.Execute("INSERT INTO playerpetspells VALUES(%u, %u, %u, %u)", getGuidLow(), pn, itr->first->getId(), itr->second);
+                    CharacterDatabase.Execute("DELETE FROM playerpetspells WHERE ownerguid=%u AND petnumber=%u", getGuidLow(), pn);
                 else
-                    buf->AddQuery("INSERT INTO playerpetspells VALUES(%u, %u, %u, %u)", getGuidLow(), pn, itr->first->getId(), itr->second);
+                    buf->AddQuery("DELETE FROM playerpetspells WHERE ownerguid=%u AND petnumber=%u", getGuidLow(), pn);
+
+                m_lastSaveStatistics.add(PLAYER_SAVE_TABLE_PETS);
+
+                for (PetSpellMap::iterator itr = summon->mSpells.begin(); itr != summon->mSpells.end(); ++itr)
+                {
+                    if (buf == nullptr)
+                        CharacterDatabase.Execute("INSERT INTO playerpetspells VALUES(%u, %u, %u, %u)", getGuidLow(), pn, itr->first->getId(), itr->second);
+                    else
+                        buf->AddQuery("INSERT INTO playerpetspells VALUES(%u, %u, %u, %u)", getGuidLow(), pn, itr->first->getId(), itr->second);
+
+                    m_lastSaveStatistics.add(PLAYER_SAVE_TABLE_PETS);
+                }
             }
         }
     }
 
-    std::stringstream ss;
-
-    ss.rdbuf()->str("");
-
     for (std::map<uint32, PlayerPet*>::iterator itr = m_Pets.begin(); itr != m_Pets.end(); ++itr)
     {
-        ss.rdbuf()->str("");
+        const std::string query = getPlayerPetSaveQuery(getGuidLow(), itr->second);
+        if (!m_savedRows.pets.update(itr->first, std::hash<std::string>()(query)))
+            continue;
 
-        ss << "REPLACE INTO playerpets VALUES('"
-            << getGuidLow() << "','"
-            << itr->second->number << "','"
-            << itr->second->name << "','"
-            << itr->second->entry << "','"
-            << itr->second->xp << "','"
-            << (itr->second->active ? 1 : 0) + itr->second->stablestate * 10 << "','"
-            << itr->second->level << "','"
-            << itr->second->actionbar << "','"
-            << itr->second->happinessupdate << "','"
-            << (long)itr->second->reset_time << "','"
-            << itr->second->reset_cost << "','"
-            << itr->second->spellid << "','"
-            << itr->second->petstate << "','"
-            << itr->second->alive << "','"
-            << itr->second->talentpoints << "','"
-            << itr->second->current_power << "','"
-            << itr->second->current_hp << "','"
-            << itr->second->current_happiness << "','"
-            << itr->second->renamable << "','"
-            << itr->second->type << "')";
+        executeSaveQuery(query, buf);
+        m_lastSaveStatistics.add(PLAYER_SAVE_TABLE_PETS);
+    }
 
+    // Remove the pets which are gone since the last save
+    for (const auto petNumber : m_savedRows.pets.takeRemovedKeys())
+    {
         if (buf == nullptr)
-            CharacterDatabase.ExecuteNA(ss.str().c_str());
+            CharacterDatabase.Execute("DELETE FROM playerpets WHERE ownerguid = %u AND petnumber = %u", getGuidLow(), static_cast<uint32>(petNumber));
         else
-            buf->AddQueryStr(ss.str());
+            buf->AddQuery("DELETE FROM playerpets WHERE ownerguid = %u AND petnumber = %u", getGuidLow(), static_cast<uint32>(petNumber));
+
+        m_lastSaveStatistics.add(PLAYER_SAVE_TABLE_PETS);
+    }
+}
+
+uint64_t Player::_GetSummonSpellsSaveValue() const
+{
+    uint64_t value = 0;
+    for (const auto& summonSpells : SummonSpells)
+    {
+        for (const auto spellId : summonSpells.second)
+            value = SavedRowSet::hashValues({ value, summonSpells.first, spellId });
     }
+
+    return value;
 }
 
 void Player::_SavePetSpells(QueryBuffer* buf)
 {
+    // table has no key per row, so all rows are written again if any of them changed
+    if (!m_savedRows.summonSpells.update(0, _GetSummonSpellsSaveValue()))
+        return;
+
     // Remove any existing
     if (buf == nullptr)
         CharacterDatabase.Execute("DELETE FROM playersummonspells WHERE ownerguid=%u", getGuidLow());
     else
         buf->AddQuery("DELETE FROM playersummonspells WHERE ownerguid=%u", getGuidLow());
 
+    m_lastSaveStatistics.add(PLAYER_SAVE_TABLE_PETS);
+
     // Save summon spells
     for (std::map<uint32, std::set<uint32> >::iterator itr = SummonSpells.begin(); itr != SummonSpells.end(); ++itr)
     {
@@ -1622,6 +1673,8 @@ void Player::_SavePetSpells(QueryBuffer* buf)
                 CharacterDatabase.Execute("INSERT INTO playersummonspells VALUES(%u, %u, %u)", getGuidLow(), itr->first, (*it));
             else
                 buf->AddQuery("INSERT INTO playersummonspells VALUES(%u, %u, %u)", getGuidLow(), itr->first, (*it));
+
+            m_lastSaveStatistics.add(PLAYER_SAVE_TABLE_PETS);
         }
     }
 }
@@ -1701,6 +1754,7 @@ void Player::_LoadPet(QueryResult* result)
         pet->type = fields[19].GetUInt32();
 
         m_Pets[pet->number] = pet;
+        m_savedRows.pets.update(pet->number, std::hash<std::string>()(getPlayerPetSaveQuery(getGuidLow(), pet)));
 
         if (pet->number > m_PetNumberMax)
             m_PetNumberMax = pet->number;
@@ -2146,6 +2200,11 @@ void Player::SaveToDB(bool bNewCharacter /* =false */)
     if (!bNewCharacter)
         buf = new QueryBuffer;
 
+    m_lastSaveStatistics = PlayerSaveStatistics();
+
+    if (buf != nullptr && m_savedRows.saveFailed->exchange(false))
+        _ResetSavedRows(buf);
+
     if (m_bg != nullptr && isArena(m_bg->GetType()))
         in_arena = true;
 
@@ -2179,53 +2238,62 @@ void Player::SaveToDB(bool bNewCharacter /* =false */)
     if (m_cheats.hasTaxiCheat)
         active_cheats |= PLAYER_CHEAT_TAXI;
 
-    std::stringstream ss;
+    PreparedStatement* statement = new PreparedStatement(CHAR_REP_CHARACTER);
+    uint8_t index = 0;
 
-    ss << "REPLACE INTO characters VALUES (" << getGuidLow() << ", " << GetSession()->GetAccountId() << ", " << "'" << m_name << "', "
-        << uint32(getRace()) << ", " << uint32(getClass()) << ", " << uint32(getGender()) << ", " << getFactionTemplate() << ", ";
-
-    ss << uint32(getLevel()) << ", " << getXp() << ", " << active_cheats << ", ";
+    statement->setUInt32(index++, getGuidLow());
+    statement->setUInt32(index++, GetSession()->GetAccountId());
+    statement->setString(index++, m_name);
+    statement->setUInt8(index++, getRace());
+    statement->setUInt8(index++, getClass());
+    statement->setUInt8(index++, getGender());
+    statement->setUInt32(index++, getFactionTemplate());
+    statement->setUInt32(index++, getLevel());
+    statement->setUInt32(index++, getXp());
+    statement->setUInt32(index++, active_cheats);
 
     // exploration data
-    ss << "'";
+    std::stringstream ss;
     for (uint8 i = 0; i < WOWPLAYER_EXPLORED_ZONES_COUNT; ++i)
         ss << getExploredZone(i) << ",";
-    ss << "', ";
+    statement->setString(index++, ss.str());
 
     SaveSkills(bNewCharacter, buf);
 
-    ss << getWatchedFaction() << ", "
-#if VERSION_STRING > Classic
-        << getChosenTitle() << ", "
-#else
-        << uint32(0) << ", "
-#endif
-
+    statement->setUInt32(index++, getWatchedFaction());
 #if VERSION_STRING > Classic
-        << getKnownTitles(0) << ", "
+    statement->setUInt32(index++, getChosenTitle());
+    statement->setUInt64(index++, getKnownTitles(0));
 #else
-        << uint32(0) << ", "
+    statement->setUInt32(index++, 0);
+    statement->setUInt32(index++, 0);
 #endif
 
 #if VERSION_STRING < WotLK
-        << uint32(0) << ", " << uint32(0) << ", "
+    statement->setUInt32(index++, 0);
+    statement->setUInt32(index++, 0);
 #else
-        << getKnownTitles(1) << ", " << getKnownTitles(2) << ", "
+    statement->setUInt64(index++, getKnownTitles(1));
+    statement->setUInt64(index++, getKnownTitles(2));
 #endif
-        << static_cast<uint32_t>(getCoinage()) << ", ";
+    statement->setUInt32(index++, getCoinage());
 
     if (getClass() == MAGE || getClass() == PRIEST || (getClass() == WARLOCK))
-        ss << uint32_t(0) << ", "; // make sure ammo slot is 0 for these classes, otherwise it can mess up wand shoot
+        statement->setUInt32(index++, 0); // make sure ammo slot is 0 for these classes, otherwise it can mess up wand shoot
     else
 #if VERSION_STRING < Cata
-        ss << getAmmoId() << ", ";
+        statement->setUInt32(index++, getAmmoId());
 #else
-        ss << uint32_t(0) << ", ";
+        statement->setUInt32(index++, 0);
 #endif
 
-    ss << getFreePrimaryProfessionPoints() << ", ";
+    statement->setUInt32(index++, getFreePrimaryProfessionPoints());
 
-    ss << load_health << ", " << load_mana << ", " << uint32(getPvpRank()) << ", " << getPlayerBytes() << ", " << getPlayerBytes2() << ", ";
+    statement->setUInt32(index++, load_health);
+    statement->setUInt32(index++, load_mana);
+    statement->setUInt8(index++, getPvpRank());
+    statement->setUInt32(index++, getPlayerBytes());
+    statement->setUInt32(index++, getPlayerBytes2());
 
     // Remove un-needed and problematic player flags from being saved :p
     if (hasPlayerFlags(PLAYER_FLAG_PARTY_LEADER))
@@ -2246,57 +2314,94 @@ void Player::SaveToDB(bool bNewCharacter /* =false */)
     if (hasPlayerFlags(PLAYER_FLAG_FREE_FOR_ALL_PVP))
         removePlayerFlags(PLAYER_FLAG_FREE_FOR_ALL_PVP);
 
-    ss << getPlayerFlags() << ", " << getPlayerFieldBytes() << ", ";
+    statement->setUInt32(index++, getPlayerFlags());
+    statement->setUInt32(index++, getPlayerFieldBytes());
 
     // if its an arena, save the entry coords instead of the normal position
-    if (in_arena)
-        ss << getBGEntryPosition().x << ", " << getBGEntryPosition().y << ", " << getBGEntryPosition().z << ", " << getBGEntryPosition().o << ", " << getBGEntryMapId() << ", ";
-    else
-        ss << m_position.x << ", " << m_position.y << ", " << m_position.z << ", " << m_position.o << ", " << m_mapId << ", ";
+    const LocationVector savePosition = in_arena ? getBGEntryPosition() : m_position;
+    statement->setFloat(index++, savePosition.x);
+    statement->setFloat(index++, savePosition.y);
+    statement->setFloat(index++, savePosition.z);
+    statement->setFloat(index++, savePosition.o);
+    statement->setUInt32(index++, in_arena ? getBGEntryMapId() : m_mapId);
 
-    ss << m_zoneId << ", ";
+    statement->setUInt32(index++, m_zoneId);
 
     // taxi mask
-    ss << "'";
+    ss.str("");
     for (uint32_t i = 0; i < DBC_TAXI_MASK_SIZE; i++)
         ss << m_taximask[i] << " ";
-    ss << "', ";
+    statement->setString(index++, ss.str());
 
-    ss << m_banned << ", '" << CharacterDatabase.EscapeString(m_banreason) << "', " << uint32(UNIXTIME) << ", ";
+    statement->setUInt32(index++, m_banned);
+    statement->setString(index++, m_banreason);
+    statement->setUInt32(index++, static_cast<uint32_t>(UNIXTIME));
 
     //online state
-    if (GetSession()->_loggingOut || bNewCharacter)
-        ss << "0, ";
-    else
-        ss << "1, ";
+    statement->setBool(index++, !(GetSession()->_loggingOut || bNewCharacter));
 
-    ss << getBindPosition().x << ", " << getBindPosition().y << ", " << getBindPosition().z << ", " << getBindMapId() << ", " << getBindZoneId() << ", ";
+    statement->setFloat(index++, getBindPosition().x);
+    statement->setFloat(index++, getBindPosition().y);
+    statement->setFloat(index++, getBindPosition().z);
+    statement->setUInt32(index++, getBindMapId());
+    statement->setUInt32(index++, getBindZoneId());
 
-    ss << uint32(m_isResting) << ", " << uint32(m_restState) << ", " << uint32(m_restAmount) << ", ";
+    statement->setUInt8(index++, m_isResting);
+    statement->setUInt8(index++, m_restState);
+    statement->setUInt32(index++, m_restAmount);
 
-    ss << "'" << uint32(m_playedtime[0]) << " " << uint32(m_playedtime[1]) << " " << uint32(playedt) << "', ";
+    ss.str("");
+    ss << uint32(m_playedtime[0]) << " " << uint32(m_playedtime[1]) << " " << uint32(playedt);
+    statement->setString(index++, ss.str());
 
-    ss << uint32(m_deathState) << ", " << m_talentresettimes << ", "  << m_FirstLogin << ", " << login_flags << ", " << m_arenaPoints << ", " << (uint32)m_StableSlotCount << ", ";
+    statement->setUInt32(index++, m_deathState);
+    statement->setUInt32(index++, m_talentresettimes);
+    statement->setBool(index++, m_FirstLogin);
+    statement->setUInt32(index++, login_flags);
+    statement->setUInt32(index++, m_arenaPoints);
+    statement->setUInt8(index++, m_StableSlotCount);
 
     // instances
-    if (in_arena)
-        ss << getBGEntryInstanceId() << ", ";
-    else
-        ss << m_instanceId << ", ";
+    statement->setInt32(index++, in_arena ? getBGEntryInstanceId() : m_instanceId);
 
-    ss << getBGEntryMapId() << ", " << getBGEntryPosition().x << ", " << getBGEntryPosition().y << ", " << getBGEntryPosition().z << ", " << getBGEntryPosition().o << ", " << getBGEntryInstanceId() << ", ";
+    statement->setUInt32(index++, getBGEntryMapId());
+    statement->setFloat(index++, getBGEntryPosition().x);
+    statement->setFloat(index++, getBGEntryPosition().y);
+    statement->setFloat(index++, getBGEntryPosition().z);
+    statement->setFloat(index++, getBGEntryPosition().o);
+    statement->setInt32(index++, getBGEntryInstanceId());
 
     // taxi
     if (m_onTaxi && m_CurrentTaxiPath)
-        ss << m_CurrentTaxiPath->GetID() << ", " << lastNode << ", " << getMountDisplayId() << ", ";
+    {
+        statement->setUInt32(index++, m_CurrentTaxiPath->GetID());
+        statement->setUInt32(index++, lastNode);
+        statement->setUInt32(index++, getMountDisplayId());
+    }
     else
-        ss << "0, 0, 0" << ", ";
+    {
+        statement->setUInt32(index++, 0);
+        statement->setUInt32(index++, 0);
+        statement->setUInt32(index++, 0);
+    }
 
     const auto transport = this->GetTransport();
     if (!transport)
-        ss << uint32_t(0) << ",'0','0','0','0'" << ", ";
+    {
+        statement->setUInt32(index++, 0);
+        statement->setFloat(index++, 0.0f);
+        statement->setFloat(index++, 0.0f);
+        statement->setFloat(index++, 0.0f);
+        statement->setFloat(index++, 0.0f);
+    }
     else
-        ss << transport->getEntry() << ",'" << GetTransOffsetX()  << "','" << GetTransOffsetY()  << "','" << GetTransOffsetZ() << "','" << GetTransOffsetO() << "'" << ", ";
+    {
+        statement->setUInt32(index++, transport->getEntry());
+        statement->setFloat(index++, GetTransOffsetX());
+        statement->setFloat(index++, GetTransOffsetY());
+        statement->setFloat(index++, GetTransOffsetZ());
+        statement->setFloat(index++, GetTransOffsetO());
+    }
 
     SaveSpells(bNewCharacter, buf);
 
@@ -2308,139 +2413,137 @@ void Player::SaveToDB(bool bNewCharacter /* =false */)
 #ifdef FT_DUAL_SPEC
     for (uint8 s = 0; s < MAX_SPEC_COUNT; ++s)
     {
-        ss << "'";
+        ss.str("");
         for (uint8 i = 0; i < PLAYER_ACTION_BUTTON_COUNT; ++i)
         {
             ss << uint32(m_specs[s].mActions[i].Action) << ","
                 << uint32(m_specs[s].mActions[i].Type) << ","
                 << uint32(m_specs[s].mActions[i].Misc) << ",";
         }
-        ss << "'" << ", ";
+        statement->setString(index++, ss.str());
     }
 #else
-    ss << "'";
+    ss.str("");
     for (uint8 i = 0; i < PLAYER_ACTION_BUTTON_COUNT; ++i)
     {
         ss << uint32(m_spec.mActions[i].Action) << ","
            << uint32(m_spec.mActions[i].Type) << ","
            << uint32(m_spec.mActions[i].Misc) << ",";
     }
-    ss << "'" << ", " << "''" << ", ";
+    statement->setString(index++, ss.str());
+    statement->setString(index++, "");
 #endif
 
+    ss.str("");
     if (!bNewCharacter)
-    {
         SaveAuras(ss);
-        ss << ", ";
-    }
-    else
-    {
-        ss << "''" << ", ";
-    }
+    statement->setString(index++, ss.str());
 
     // Add player finished quests
-    ss << "'";
+    ss.str("");
     for (auto finishedQuests = m_finishedQuests.begin(); finishedQuests != m_finishedQuests.end(); ++finishedQuests)
         ss << (*finishedQuests) << ",";
-    ss << "'" << ", ";
+    statement->setString(index++, ss.str());
 
     // add finished dailies
-    ss << "'";
+    ss.str("");
     for (auto finishedDailies : getFinishedDailies())
         ss << finishedDailies << ",";
-    ss << "'" << ", ";
+    statement->setString(index++, ss.str());
 
-    ss << m_honorRolloverTime << ", " << m_killsToday << ", " << m_killsYesterday << ", " << m_killsLifetime << ", " << m_honorToday << ", " << m_honorYesterday << ", " << m_honorPoints << ", ";
+    statement->setUInt32(index++, m_honorRolloverTime);
+    statement->setUInt32(index++, m_killsToday);
+    statement->setUInt32(index++, m_killsYesterday);
+    statement->setUInt32(index++, m_killsLifetime);
+    statement->setUInt32(index++, m_honorToday);
+    statement->setUInt32(index++, m_honorYesterday);
+    statement->setUInt32(index++, m_honorPoints);
 
-    ss << uint32_t(getDrunkValue()) << ", ";
+    statement->setUInt8(index++, getDrunkValue());
 
     // TODO Remove
 #ifdef FT_DUAL_SPEC
     for (uint8 s = 0; s < MAX_SPEC_COUNT; ++s)
     {
-        ss << "'";
+        ss.str("");
         for (uint8 i = 0; i < GLYPHS_COUNT; ++i)
             ss << uint32_t(m_specs[s].glyphs[i]) << ",";
+        statement->setString(index++, ss.str());
 
-        ss << "', '";
+        ss.str("");
         for (std::map<uint32, uint8>::iterator itr = m_specs[s].talents.begin(); itr != m_specs[s].talents.end(); ++itr)
             ss << itr->first << "," << uint32(itr->second) << ",";
-
-        ss << "'" << ", ";
+        statement->setString(index++, ss.str());
     }
 #else
-    ss << "'', '";
+    statement->setString(index++, "");
+
+    ss.str("");
     for (const auto talent : m_spec.talents)
         ss << talent.first << "," << talent.second << ",";
+    statement->setString(index++, ss.str());
 
-    ss << "', '', '', ";
+    statement->setString(index++, "");
+    statement->setString(index++, "");
 #endif
 
-    ss << uint32(m_talentSpecsCount) << ", " << uint32(m_talentActiveSpec) << ", ";
+    statement->setUInt8(index++, m_talentSpecsCount);
+    statement->setUInt8(index++, m_talentActiveSpec);
 
-    ss << "'";
+    ss.str("");
 #ifdef FT_DUAL_SPEC
     ss << uint32(m_specs[SPEC_PRIMARY].GetTP()) << " " << uint32(m_specs[SPEC_SECONDARY].GetTP());
 #else
     ss << uint32(m_spec.GetTP()) << " 0";
 #endif
-    ss << "'" << ", ";
+    statement->setString(index++, ss.str());
 
 #if VERSION_STRING < Cata
-    ss << "'" << uint32(0) << "', ";
+    statement->setUInt32(index++, 0);
 #else
-    ss << "'" << uint32(m_FirstTalentTreeLock) << "', ";
+    statement->setUInt32(index++, m_FirstTalentTreeLock);
 #endif
 
-    ss << "'" << m_phase << "', ";
+    statement->setUInt32(index++, m_phase);
 
-    uint32 xpfield = 0;
-
-    if (m_XpGainAllowed)
-        xpfield = 1;
-
-    ss << "'" << xpfield << "'" << ", ";
+    statement->setBool(index++, m_XpGainAllowed);
 
     const bool saveData = worldConfig.server.saveExtendedCharData;
+    ss.str("");
     if (saveData)
     {
-        ss << "'";
         for (uint32 offset = getSizeOfStructure(WoWObject); offset < getSizeOfStructure(WoWPlayer); offset++)
             ss << uint32(m_uint32Values[offset]) << ";";
-        ss << "'" << ", ";
     }
-    else
-    {
-        ss << "'', ";
-    }
-
-    if (resettalents)
-        ss << uint32(1);
-    else
-        ss << uint32(0);
+    statement->setString(index++, ss.str());
 
-    ss << ", ";
+    statement->setBool(index++, resettalents);
 
-    ss << uint32(this->HasWonRbgToday()) << ", " << uint32(m_dungeonDifficulty) << ", " << uint32(m_raidDifficulty);
-    ss << ")";
+    statement->setBool(index++, this->HasWonRbgToday());
+    statement->setUInt8(index++, m_dungeonDifficulty);
+    statement->setUInt8(index++, m_raidDifficulty);
 
     if (bNewCharacter)
-        CharacterDatabase.WaitExecuteNA(ss.str().c_str());
+    {
+        CharacterDatabase.WaitExecute(statement);
+        delete statement;
+    }
     else
-        buf->AddQueryNA(ss.str().c_str());
+    {
+        buf->AddPreparedStatement(statement);
+    }
+
+    m_lastSaveStatistics.add(PLAYER_SAVE_TABLE_CHARACTER);
 
     //Save Other related player stuff
 
     // Inventory
-    getItemInterface()->mSaveItemsToDatabase(bNewCharacter, buf);
+    m_lastSaveStatistics.add(PLAYER_SAVE_TABLE_ITEMS, getItemInterface()->mSaveItemsToDatabase(bNewCharacter, buf));
 
-    getItemInterface()->m_EquipmentSets.SavetoDB(buf);
+    // these are still written completely on every save, only counted for the statistics
+    const uint32_t queriesBeforeOther = buf ? buf->getQueryCount() : 0;
 
-    // save quest progress
-    _SaveQuestLogEntry(buf);
-
-    // Tutorials
-    saveTutorials();
+    getItemInterface()->m_EquipmentSets.SavetoDB(buf);
 
     // GM Ticket
     //\todo Is this really necessary? Tickets will always be saved on creation, update and so on...
@@ -2448,6 +2551,19 @@ void Player::SaveToDB(bool bNewCharacter /* =false */)
     if (ticket != nullptr)
         sTicketMgr.saveGMTicket(ticket, buf);
 
+#if VERSION_STRING > TBC
+    m_achievementMgr.SaveToDB(buf);
+#endif
+
+    if (buf)
+        m_lastSaveStatistics.add(PLAYER_SAVE_TABLE_OTHER, buf->getQueryCount() - queriesBeforeOther);
+
+    // save quest progress
+    _SaveQuestLogEntry(buf);
+
+    // Tutorials
+    saveTutorials(buf);
+
     // Cooldown Items
     _SavePlayerCooldowns(buf);
 
@@ -2458,12 +2574,19 @@ void Player::SaveToDB(bool bNewCharacter /* =false */)
         _SavePetSpells(buf);
     }
     m_nextSave = Util::getMSTime() + worldConfig.getIntRate(INTRATE_SAVE);
-#if VERSION_STRING > TBC
-    m_achievementMgr.SaveToDB(buf);
-#endif
+
+    sLogger.debug("Player::SaveToDB : Saved player %s with %u rows", getName().c_str(), m_lastSaveStatistics.getTotal());
 
     if (buf)
-        CharacterDatabase.AddQueryBuffer(buf);
+    {
+        buf->setCompletionHandler([saveFailed = m_savedRows.saveFailed](bool success)
+        {
+            if (!success)
+                *saveFailed = true;
+        });
+
+        CharacterDatabase.AddQueryBuffer(buf, getGuidLow());
+    }
 }
 
 void Player::_SaveQuestLogEntry(QueryBuffer* buf)
@@ -2474,14 +2597,16 @@ void Player::_SaveQuestLogEntry(QueryBuffer* buf)
             CharacterDatabase.Execute("DELETE FROM questlog WHERE player_guid=%u AND quest_id=%u", getGuidLow(), removeableQuestId);
         else
             buf->AddQuery("DELETE FROM questlog WHERE player_guid=%u AND quest_id=%u", getGuidLow(), removeableQuestId);
+
+        m_lastSaveStatistics.add(PLAYER_SAVE_TABLE_QUESTS);
     }
 
     m_removequests.clear();
 
     for (auto& questlogEntry : m_questlog)
     {
-        if (questlogEntry != nullptr)
-            questlogEntry->saveToDB(buf);
+        if (questlogEntry != nullptr && questlogEntry->saveToDB(buf))
+            m_lastSaveStatistics.add(PLAYER_SAVE_TABLE_QUESTS);
     }
 }
 
@@ -2527,30 +2652,21 @@ bool Player::LoadFromDB(uint32 guid)
 {
     AsyncQuery* q = new AsyncQuery(new SQLClassCallbackP0<Player>(this, &Player::LoadFromDBProc));
 
-    q->AddQuery("SELECT * FROM characters WHERE guid = %u AND login_flags = %u", guid, (uint32)LOGIN_NO_FLAG); // 0
-    q->AddQuery("SELECT * FROM tutorials WHERE playerId = %u", guid); // 1
-    q->AddQuery("SELECT cooldown_type, cooldown_misc, cooldown_expire_time, cooldown_spellid, cooldown_itemid FROM playercooldowns WHERE player_guid = %u", guid); // 2
-    q->AddQuery("SELECT * FROM questlog WHERE player_guid = %u", guid); // 3
-    q->AddQuery("SELECT * FROM playeritems WHERE ownerguid = %u ORDER BY containerslot ASC", guid); // 4
-    q->AddQuery("SELECT * FROM playerpets WHERE ownerguid = %u ORDER BY petnumber", guid); // 5
-    q->AddQuery("SELECT * FROM playersummonspells where ownerguid = %u ORDER BY entryid", guid); // 6
-    q->AddQuery("SELECT * FROM mailbox WHERE player_guid = %u", guid); // 7
-
-    // social
-    q->AddQuery("SELECT friend_guid, note FROM social_friends WHERE character_guid = %u", guid); // 8
-    q->AddQuery("SELECT character_guid FROM social_friends WHERE friend_guid = %u", guid); // 9
-    q->AddQuery("SELECT ignore_guid FROM social_ignores WHERE character_guid = %u", guid); // 10
-
+    PreparedStatement* loginStatement = new PreparedStatement(CHAR_SEL_CHARACTER_LOGIN);
+    loginStatement->setUInt32(0, guid);
+    loginStatement->setUInt32(1, LOGIN_NO_FLAG);
+    q->AddPreparedStatement(loginStatement); // 0
 
-    q->AddQuery("SELECT * FROM equipmentsets WHERE ownerguid = %u", guid);  // 11
-    q->AddQuery("SELECT faction, flag, basestanding, standing FROM playerreputations WHERE guid = %u", guid); //12
-    q->AddQuery("SELECT SpellID FROM playerspells WHERE GUID = %u", guid);  // 13
-    q->AddQuery("SELECT SpellID FROM playerdeletedspells WHERE GUID = %u", guid);  // 14
-    q->AddQuery("SELECT SkillID, CurrentValue, MaximumValue FROM playerskills WHERE GUID = %u", guid);  // 15
+    // all other queries only need the guid, see PlayerQuery for their order
+    for (uint32_t statementId = CHAR_SEL_CHARACTER_TUTORIALS; statementId <= CHAR_SEL_CHARACTER_ACHIEVEMENT_PROGRESS; ++statementId)
+    {
+        PreparedStatement* statement = new PreparedStatement(statementId);
+        statement->setUInt32(0, guid);
+        q->AddPreparedStatement(statement);
+    }
 
-    //Achievements
-    q->AddQuery("SELECT achievement, date FROM character_achievement WHERE guid = '%u'", guid); // 16
-    q->AddQuery("SELECT criteria, counter, date FROM character_achievement_progress WHERE guid = '%u'", guid); // 17
+    // a save from the last logout may still be queued
+    q->WaitForWrites(guid);
 
     // queue it!
     setGuidLow(guid);
@@ -3225,6 +3341,8 @@ void Player::LoadFromDBProc(QueryResultVector & results)
     getItemInterface()->mLoadItemsFromDatabase(results[PlayerQuery::Items].result);
     getItemInterface()->m_EquipmentSets.LoadfromDB(results[PlayerQuery::EquipmentSets].result);
 
+    _InitializeSavedRows();
+
     m_mailBox.Load(results[PlayerQuery::Mailbox].result);
 
     // SOCIAL
@@ -5599,16 +5717,13 @@ void Player::CalcResistance(uint8_t type)
         res += getStat(STAT_AGILITY) * 2; //fix armor from agi
 
     // Dynamic aura 285 application, removing bonus
-    for (uint32 x = MAX_TOTAL_AURAS_START; x < MAX_TOTAL_AURAS_END; x++)
+    for (const auto x : m_auras.getSlotsWithAuraEffect(SPELL_AURA_MOD_ATTACK_POWER_OF_ARMOR))
     {
-        if (m_auras[x] != nullptr)
+        for (uint8_t i = 0; i < MAX_SPELL_EFFECTS; ++i)
         {
-            for (uint8_t i = 0; i < MAX_SPELL_EFFECTS; ++i)
-            {
-                auto aurEff = m_auras[x]->getAuraEffect(i);
-                if (aurEff.getAuraEffectType() == SPELL_AURA_MOD_ATTACK_POWER_OF_ARMOR)
-                    m_auras[x]->SpellAuraModAttackPowerOfArmor(&aurEff, false);
-            }
+            auto aurEff = m_auras[x]->getAuraEffect(i);
+            if (aurEff.getAuraEffectType() == SPELL_AURA_MOD_ATTACK_POWER_OF_ARMOR)
+                m_auras[x]->SpellAuraModAttackPowerOfArmor(&aurEff, false);
         }
     }
 
@@ -5626,16 +5741,13 @@ void Player::CalcResistance(uint8_t type)
         (*itr)->CalcResistance(type);  //Re-calculate pet's too.
 
     // Dynamic aura 285 application, adding bonus
-    for (uint32 x = MAX_TOTAL_AURAS_START; x < MAX_TOTAL_AURAS_END; x++)
+    for (const auto x : m_auras.getSlotsWithAuraEffect(SPELL_AURA_MOD_ATTACK_POWER_OF_ARMOR))
     {
-        if (m_auras[x] != nullptr)
+        for (uint8_t i = 0; i < MAX_SPELL_EFFECTS; ++i)
         {
-            for (uint8_t i = 0; i < MAX_SPELL_EFFECTS; ++i)
-            {
-                auto aurEff = m_auras[x]->getAuraEffect(i);
-                if (aurEff.getAuraEffectType() == SPELL_AURA_MOD_ATTACK_POWER_OF_ARMOR)
-                    m_auras[x]->SpellAuraModAttackPowerOfArmor(&aurEff, true);
-            }
+            auto aurEff = m_auras[x]->getAuraEffect(i);
+            if (aurEff.getAuraEffectType() == SPELL_AURA_MOD_ATTACK_POWER_OF_ARMOR)
+                m_auras[x]->SpellAuraModAttackPowerOfArmor(&aurEff, true);
         }
     }
 }
@@ -7800,7 +7912,6 @@ void Player::ModifyBonuses(uint32 type, int32 val, bool apply)
 
 void Player::SaveAuras(std::stringstream & ss)
 {
-    ss << "'";
     uint32 charges = 0, prevX = 0;
     //cebernic: save all auras why only just positive?
     for (uint32 x = MAX_POSITIVE_AURAS_EXTEDED_START; x < MAX_NEGATIVE_AURAS_EXTEDED_END; x++)
@@ -7845,8 +7956,6 @@ void Player::SaveAuras(std::stringstream & ss)
     {
         ss << m_auras[prevX]->getSpellId() << "," << m_auras[prevX]->getTimeLeft() << "," << !m_auras[prevX]->isNegative() << "," << charges << ",";
     }
-
-    ss << "'";
 }
 
 void Player::CalcDamage()
@@ -9106,31 +9215,102 @@ bool Player::Cooldown_CanCast(ItemProperties const* pProto, uint32 x)
     return true;
 }
 
+void Player::_InitializeSavedRows()
+{
+    // skills, spells, reputations and pets are recorded while they are loaded
+    m_savedRows.cooldowns.update(0, _GetCooldownsSaveValue(Util::getMSTime()));
+    m_savedRows.summonSpells.update(0, _GetSummonSpellsSaveValue());
+
+    // starts the first save, rows of these sets which are not saved again get deleted
+    m_savedRows.skills.takeRemovedKeys();
+    m_savedRows.spells.takeRemovedKeys();
+    m_savedRows.deletedSpells.takeRemovedKeys();
+    m_savedRows.reputations.takeRemovedKeys();
+    m_savedRows.pets.takeRemovedKeys();
+}
+
+void Player::_ResetSavedRows(QueryBuffer* buf)
+{
+    sLogger.failure("Player::SaveToDB : Previous save of player %s failed, writing all rows again", getName().c_str());
+
+    // rows the failed save should have deleted are still there, tables with a key per row are written from scratch
+    buf->AddQuery("DELETE FROM playerskills WHERE GUID = %u", getGuidLow());
+    buf->AddQuery("DELETE FROM playerspells WHERE GUID = %u", getGuidLow());
+    buf->AddQuery("DELETE FROM playerdeletedspells WHERE GUID = %u", getGuidLow());
+    buf->AddQuery("DELETE FROM playerreputations WHERE guid = %u", getGuidLow());
+    buf->AddQuery("DELETE FROM questlog WHERE player_guid = %u", getGuidLow());
+    if (getClass() == HUNTER || getClass() == WARLOCK)
+        buf->AddQuery("DELETE FROM playerpets WHERE ownerguid = %u", getGuidLow());
+
+    m_lastSaveStatistics.add(PLAYER_SAVE_TABLE_SKILLS);
+    m_lastSaveStatistics.add(PLAYER_SAVE_TABLE_SPELLS, 2);
+    m_lastSaveStatistics.add(PLAYER_SAVE_TABLE_REPUTATIONS);
+    m_lastSaveStatistics.add(PLAYER_SAVE_TABLE_QUESTS);
+    if (getClass() == HUNTER || getClass() == WARLOCK)
+        m_lastSaveStatistics.add(PLAYER_SAVE_TABLE_PETS);
+
+    m_savedRows.clear();
+    m_removequests.clear();
+
+    for (auto& questlogEntry : m_questlog)
+    {
+        if (questlogEntry != nullptr)
+            questlogEntry->clearSavedRow();
+    }
+
+    getItemInterface()->setItemsDirty();
+}
+
+uint64_t Player::_GetCooldownsSaveValue(uint32 mstime) const
+{
+    uint64_t value = 0;
+    for (uint32 i = 0; i < NUM_COOLDOWN_TYPES; ++i)
+    {
+        for (const auto& cooldown : m_cooldownMap[i])
+        {
+            if (mstime >= cooldown.second.ExpireTime || (cooldown.second.ExpireTime - mstime) < COOLDOWN_SKIP_SAVE_IF_MS_LESS_THAN)
+                continue;
+
+            value = SavedRowSet::hashValues({ value, i, cooldown.first, cooldown.second.ExpireTime, cooldown.second.SpellId, cooldown.second.ItemId });
+        }
+    }
+
+    return value;
+}
+
 void Player::_SavePlayerCooldowns(QueryBuffer* buf)
 {
     uint32 mstime = Util::getMSTime();
 
+    // expired ones - no point saving, nor keeping them around, wipe em
+    for (uint32 i = 0; i < NUM_COOLDOWN_TYPES; ++i)
+    {
+        for (PlayerCooldownMap::iterator itr = m_cooldownMap[i].begin(); itr != m_cooldownMap[i].end();)
+        {
+            PlayerCooldownMap::iterator itr2 = itr++;
+            if (mstime >= itr2->second.ExpireTime)
+                m_cooldownMap[i].erase(itr2);
+        }
+    }
+
+    // table has no key per row, so all rows are written again if any cooldown was added or removed since the last save
+    if (!m_savedRows.cooldowns.update(0, _GetCooldownsSaveValue(mstime)))
+        return;
+
     // clear them (this should be replaced with an update queue later)
     if (buf != nullptr)
         buf->AddQuery("DELETE FROM playercooldowns WHERE player_guid = %u", getGuidLow());        // 0 is guid always
     else
         CharacterDatabase.Execute("DELETE FROM playercooldowns WHERE player_guid = %u", getGuidLow());        // 0 is guid always
 
+    m_lastSaveStatistics.add(PLAYER_SAVE_TABLE_COOLDOWNS);
+
     for (uint32 i = 0; i < NUM_COOLDOWN_TYPES; ++i)
     {
-        for (PlayerCooldownMap::iterator itr = m_cooldownMap[i].begin(); itr != m_cooldownMap[i].end();)
+        for (PlayerCooldownMap::iterator itr = m_cooldownMap[i].begin(); itr != m_cooldownMap[i].end(); ++itr)
         {
-            PlayerCooldownMap::iterator itr2 = itr++;
-
-            // expired ones - no point saving, nor keeping them around, wipe em
-            if (mstime >= itr2->second.ExpireTime)
-            {
-                m_cooldownMap[i].erase(itr2);
-                continue;
-            }
-
             // skip small cooldowns which will end up expiring by the time we log in anyway
-            if ((itr2->second.ExpireTime - mstime) < COOLDOWN_SKIP_SAVE_IF_MS_LESS_THAN)
+            if ((itr->second.ExpireTime - mstime) < COOLDOWN_SKIP_SAVE_IF_MS_LESS_THAN)
                 continue;
 
             // work out the cooldown expire time in unix timestamp format
@@ -9138,19 +9318,21 @@ void Player::_SavePlayerCooldowns(QueryBuffer* buf)
             // under windows we use GetTickCount() which is the system uptime, if we reboot
             // the server all these timestamps will appear to be messed up.
 
-            uint32 seconds = (itr2->second.ExpireTime - mstime) / 1000;
+            uint32 seconds = (itr->second.ExpireTime - mstime) / 1000;
             // this shouldn't ever be nonzero because of our check before, so no check needed
 
             if (buf != nullptr)
             {
                 buf->AddQuery("INSERT INTO playercooldowns VALUES(%u, %u, %u, %u, %u, %u)", getGuidLow(),
-                              i, itr2->first, seconds + (uint32)UNIXTIME, itr2->second.SpellId, itr2->second.ItemId);
+                              i, itr->first, seconds + (uint32)UNIXTIME, itr->second.SpellId, itr->second.ItemId);
             }
             else
             {
                 CharacterDatabase.Execute("INSERT INTO playercooldowns VALUES(%u, %u, %u, %u, %u, %u)", getGuidLow(),
-                                          i, itr2->first, seconds + (uint32)UNIXTIME, itr2->second.SpellId, itr2->second.ItemId);
+                                          i, itr->first, seconds + (uint32)UNIXTIME, itr->second.SpellId, itr->second.ItemId);
             }
+
+            m_lastSaveStatistics.add(PLAYER_SAVE_TABLE_COOLDOWNS);
         }
     }
 }
@@ -9358,9 +9540,9 @@ void Player::CalcExpertise()
     setOffHandExpertise(0);
 #endif
 
-    for (uint32 x = MAX_TOTAL_AURAS_START; x < MAX_TOTAL_AURAS_END; ++x)
+    for (const auto x : m_auras.getSlotsWithAuraEffect(SPELL_AURA_EXPERTISE))
     {
-        if (m_auras[x] != nullptr && m_auras[x]->hasAuraEffect(SPELL_AURA_EXPERTISE))
+        if (m_auras[x]->hasAuraEffect(SPELL_AURA_EXPERTISE))
         {
             SpellInfo const* entry = m_auras[x]->getSpellInfo();
             int32 val = m_auras[x]->getEffectDamageByEffect(SPELL_AURA_EXPERTISE);
@@ -9539,6 +9721,12 @@ void Player::SendPacket(WorldPacket* packet)
     m_session->SendPacket(packet);
 }
 
+void Player::SendBroadcastPacket(WorldPacket* packet, SharedWorldPacket& sharedPacket)
+{
+    ARCEMU_ASSERT(m_session != NULL)
+    m_session->SendBroadcastPacket(packet, sharedPacket);
+}
+
 void Player::OutPacketToSet(uint16 Opcode, uint16 Len, const void* Data, bool self)
 {
     if (!IsInWorld())
@@ -9581,6 +9769,7 @@ void Player::SendMessageToSet(WorldPacket* data, bool bToSelf, bool myteam_only)
 
     gminvis = m_isGmInvisible;
     uint32 myphase = GetPhase();
+    SharedWorldPacket sharedPacket;
 
     if (myteam_only)
     {
@@ -9597,7 +9786,7 @@ void Player::SendMessageToSet(WorldPacket* data, bool bToSelf, bool myteam_only)
                         continue;
 
                     if (p->getTeam() == myteam && (p->GetPhase() & myphase) != 0 && p->IsVisible(getGuid()))
-                        p->SendPacket(data);
+                        p->SendBroadcastPacket(data, sharedPacket);
                 }
             }
         }
@@ -9609,7 +9798,7 @@ void Player::SendMessageToSet(WorldPacket* data, bool bToSelf, bool myteam_only)
                 {
                     Player* p = static_cast<Player*>(itr);
                     if (p->GetSession() && p->getTeam() == myteam && !p->isIgnored(getGuidLow()) && (p->GetPhase() & myphase) != 0)
-                        p->SendPacket(data);
+                        p->SendBroadcastPacket(data, sharedPacket);
                 }
             }
         }
@@ -9627,7 +9816,7 @@ void Player::SendMessageToSet(WorldPacket* data, bool bToSelf, bool myteam_only)
                         continue;
 
                     if ((p->GetPhase() & myphase) != 0 && p->IsVisible(getGuid()))
-                        p->SendPacket(data);
+                        p->SendBroadcastPacket(data, sharedPacket);
                 }
             }
         }
@@ -9639,7 +9828,7 @@ void Player::SendMessageToSet(WorldPacket* data, bool bToSelf, bool myteam_only)
                 {
                     Player* p = static_cast<Player*>(itr);
                     if (p->GetSession() && !p->isIgnored(getGuidLow()) && (p->GetPhase() & myphase) != 0)
-                        p->SendPacket(data);
+                        p->SendBroadcastPacket(data, sharedPacket);
                 }
             }
         }
@@ -10114,33 +10303,33 @@ bool Player::SaveReputations(bool NewCharacter, QueryBuffer *buf)
     if (!NewCharacter && (buf == nullptr))
         return false;
 
-    std::stringstream ds;
     uint32 guid = getGuidLow();
 
-    ds << "DELETE FROM playerreputations WHERE guid = '";
-    ds << guid;
-    ds << "';";
-
-    if (!NewCharacter)
-        buf->AddQueryStr(ds.str());
-    else
-        CharacterDatabase.ExecuteNA(ds.str().c_str());
-
     for (ReputationMap::iterator itr = m_reputation.begin(); itr != m_reputation.end(); ++itr)
     {
+        if (!m_savedRows.reputations.update(itr->first, PlayerSavedRows::getReputationValue(itr->second->flag, itr->second->baseStanding, itr->second->standing)))
+            continue;
+
         std::stringstream ss;
 
-        ss << "INSERT INTO playerreputations VALUES('";
-        ss << getGuidLow() << "','";
+        ss << "REPLACE INTO playerreputations VALUES('";
+        ss << guid << "','";
         ss << itr->first << "','";
         ss << uint32(itr->second->flag) << "','";
         ss << itr->second->baseStanding << "','";
         ss << itr->second->standing << "');";
 
-        if (!NewCharacter)
-            buf->AddQueryStr(ss.str());
-        else
-            CharacterDatabase.ExecuteNA(ss.str().c_str());
+        executeSaveQuery(ss.str(), buf);
+        m_lastSaveStatistics.add(PLAYER_SAVE_TABLE_REPUTATIONS);
+    }
+
+    for (const auto faction : m_savedRows.reputations.takeRemovedKeys())
+    {
+        std::stringstream ds;
+        ds << "DELETE FROM playerreputations WHERE guid = '" << guid << "' AND faction = '" << faction << "';";
+
+        executeSaveQuery(ds.str(), buf);
+        m_lastSaveStatistics.add(PLAYER_SAVE_TABLE_REPUTATIONS);
     }
 
     return true;
@@ -10151,32 +10340,32 @@ bool Player::SaveSpells(bool NewCharacter, QueryBuffer* buf)
     if (!NewCharacter && buf == nullptr)
         return false;
 
-    std::stringstream ds;
     uint32 guid = getGuidLow();
 
-    ds << "DELETE FROM playerspells WHERE GUID = '";
-    ds << guid;
-    ds << "';";
-
-    if (!NewCharacter)
-        buf->AddQueryStr(ds.str());
-    else
-        CharacterDatabase.ExecuteNA(ds.str().c_str());
-
     for (SpellSet::iterator itr = mSpells.begin(); itr != mSpells.end(); ++itr)
     {
         uint32 spellid = *itr;
 
+        if (!m_savedRows.spells.update(spellid))
+            continue;
+
         std::stringstream ss;
 
-        ss << "INSERT INTO playerspells VALUES('";
+        ss << "REPLACE INTO playerspells VALUES('";
         ss << guid << "','";
         ss << spellid << "');";
 
-        if (!NewCharacter)
-            buf->AddQueryStr(ss.str());
-        else
-            CharacterDatabase.ExecuteNA(ss.str().c_str());
+        executeSaveQuery(ss.str(), buf);
+        m_lastSaveStatistics.add(PLAYER_SAVE_TABLE_SPELLS);
+    }
+
+    for (const auto spellid : m_savedRows.spells.takeRemovedKeys())
+    {
+        std::stringstream ds;
+        ds << "DELETE FROM playerspells WHERE GUID = '" << guid << "' AND SpellID = '" << spellid << "';";
+
+        executeSaveQuery(ds.str(), buf);
+        m_lastSaveStatistics.add(PLAYER_SAVE_TABLE_SPELLS);
     }
 
     return true;
@@ -10191,6 +10380,7 @@ bool Player::LoadDeletedSpells(QueryResult* result)
         Field* fields = result->Fetch();
 
         uint32 spellid = fields[0].GetUInt32();
+        m_savedRows.deletedSpells.update(spellid);
 
         SpellInfo const* sp = sSpellMgr.getSpellInfo(spellid);
         if (sp != nullptr)
@@ -10207,32 +10397,32 @@ bool Player::SaveDeletedSpells(bool NewCharacter, QueryBuffer* buf)
     if (!NewCharacter && buf == nullptr)
         return false;
 
-    std::stringstream ds;
     uint32 guid = getGuidLow();
 
-    ds << "DELETE FROM playerdeletedspells WHERE GUID = '";
-    ds << guid;
-    ds << "';";
-
-    if (!NewCharacter)
-        buf->AddQueryStr(ds.str());
-    else
-        CharacterDatabase.ExecuteNA(ds.str().c_str());
-
     for (SpellSet::iterator itr = mDeletedSpells.begin(); itr != mDeletedSpells.end(); ++itr)
     {
         uint32 spellid = *itr;
 
+        if (!m_savedRows.deletedSpells.update(spellid))
+            continue;
+
         std::stringstream ss;
 
-        ss << "INSERT INTO playerdeletedspells VALUES('";
+        ss << "REPLACE INTO playerdeletedspells VALUES('";
         ss << guid << "','";
         ss << spellid << "');";
 
-        if (!NewCharacter)
-            buf->AddQueryStr(ss.str());
-        else
-            CharacterDatabase.ExecuteNA(ss.str().c_str());
+        executeSaveQuery(ss.str(), buf);
+        m_lastSaveStatistics.add(PLAYER_SAVE_TABLE_SPELLS);
+    }
+
+    for (const auto spellid : m_savedRows.deletedSpells.takeRemovedKeys())
+    {
+        std::stringstream ds;
+        ds << "DELETE FROM playerdeletedspells WHERE GUID = '" << guid << "' AND SpellID = '" << spellid << "';";
+
+        executeSaveQuery(ds.str(), buf);
+        m_lastSaveStatistics.add(PLAYER_SAVE_TABLE_SPELLS);
     }
 
     return true;
@@ -10250,6 +10440,7 @@ bool Player::LoadSkills(QueryResult* result)
         uint32 skillid = fields[0].GetUInt32();
         uint32 currval = fields[1].GetUInt32();
         uint32 maxval = fields[2].GetUInt32();
+        m_savedRows.skills.update(skillid, PlayerSavedRows::getSkillValue(currval, maxval));
 
         PlayerSkill sk;
         sk.Reset(skillid);
@@ -10272,18 +10463,8 @@ bool Player::SaveSkills(bool NewCharacter, QueryBuffer* buf)
     if (!NewCharacter && buf == nullptr)
         return false;
 
-    std::stringstream ds;
     uint32 guid = getGuidLow();
 
-    ds << "DELETE FROM playerskills WHERE GUID = '";
-    ds << guid;
-    ds << "';";
-
-    if (!NewCharacter)
-        buf->AddQueryStr(ds.str());
-    else
-        CharacterDatabase.ExecuteNA(ds.str().c_str());
-
     for (SkillMap::iterator itr = m_skills.begin(); itr != m_skills.end(); ++itr)
     {
 #if VERSION_STRING < Cata
@@ -10294,18 +10475,28 @@ bool Player::SaveSkills(bool NewCharacter, QueryBuffer* buf)
         uint32 currval = itr->second.CurrentValue;
         uint32 maxval = itr->second.MaximumValue;
 
+        if (!m_savedRows.skills.update(skillid, PlayerSavedRows::getSkillValue(currval, maxval)))
+            continue;
+
         std::stringstream ss;
 
-        ss << "INSERT INTO playerskills VALUES('";
+        ss << "REPLACE INTO playerskills VALUES('";
         ss << guid << "','";
         ss << skillid << "','";
         ss << currval << "','";
         ss << maxval << "');";
 
-        if (!NewCharacter)
-            buf->AddQueryStr(ss.str());
-        else
-            CharacterDatabase.ExecuteNA(ss.str().c_str());
+        executeSaveQuery(ss.str(), buf);
+        m_lastSaveStatistics.add(PLAYER_SAVE_TABLE_SKILLS);
+    }
+
+    for (const auto skillid : m_savedRows.skills.takeRemovedKeys())
+    {
+        std::stringstream ds;
+        ds << "DELETE FROM playerskills WHERE GUID = '" << guid << "' AND SkillID = '" << skillid << "';";
+
+        executeSaveQuery(ds.str(), buf);
+        m_lastSaveStatistics.add(PLAYER_SAVE_TABLE_SKILLS);
     }
 
     return true;
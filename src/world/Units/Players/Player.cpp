@@ -1698,6 +1698,7 @@ bool Player::loadSpells(QueryResult* result)
     {
         const auto fields = result->Fetch();
         const auto spellId = fields[0].GetUInt32();
+        m_savedRows.spells.update(spellId);
 
         const auto spellInfo = sSpellMgr.getSpellInfo(spellId);
         if (spellInfo == nullptr)
@@ -1729,6 +1730,7 @@ bool Player::loadReputations(QueryResult* result)
         const auto flag = field[1].GetUInt8();
         const auto basestanding = field[2].GetInt32();
         const auto standing = field[3].GetInt32();
+        m_savedRows.reputations.update(id, PlayerSavedRows::getReputationValue(flag, basestanding, standing));
 
         const auto faction = sFactionStore.LookupEntry(id);
         if (faction == nullptr || faction->RepListId < 0)
@@ -2662,13 +2664,22 @@ void Player::loadTutorials()
     tutorialsDirty = false;
 }
 
-void Player::saveTutorials()
+void Player::saveTutorials(QueryBuffer* buf)
 {
     if (tutorialsDirty)
     {
-        CharacterDatabase.Execute("DELETE FROM tutorials WHERE playerid = %u;", getGuidLow());
-        CharacterDatabase.Execute("INSERT INTO tutorials VALUES('%u','%u','%u','%u','%u','%u','%u','%u','%u');", getGuidLow(), m_Tutorials[0], m_Tutorials[1], m_Tutorials[2], m_Tutorials[3], m_Tutorials[4], m_Tutorials[5], m_Tutorials[6], m_Tutorials[7]);
+        if (buf == nullptr)
+        {
+            CharacterDatabase.Execute("DELETE FROM tutorials WHERE playerid = %u;", getGuidLow());
+            CharacterDatabase.Execute("INSERT INTO tutorials VALUES('%u','%u','%u','%u','%u','%u','%u','%u','%u');", getGuidLow(), m_Tutorials[0], m_Tutorials[1], m_Tutorials[2], m_Tutorials[3], m_Tutorials[4], m_Tutorials[5], m_Tutorials[6], m_Tutorials[7]);
+        }
+        else
+        {
+            buf->AddQuery("DELETE FROM tutorials WHERE playerid = %u;", getGuidLow());
+            buf->AddQuery("INSERT INTO tutorials VALUES('%u','%u','%u','%u','%u','%u','%u','%u','%u');", getGuidLow(), m_Tutorials[0], m_Tutorials[1], m_Tutorials[2], m_Tutorials[3], m_Tutorials[4], m_Tutorials[5], m_Tutorials[6], m_Tutorials[7]);
+        }
 
+        m_lastSaveStatistics.add(PLAYER_SAVE_TABLE_OTHER, 2);
         tutorialsDirty = false;
     }
 }
@@ -21,6 +21,7 @@
 #pragma once
 
 #include "Units/Players/PlayerDefines.hpp"
+#include "Units/Players/PlayerSaveState.hpp"
 #include "Units/Stats.h"
 #include "Server/Definitions.h"
 #include "Management/QuestDefines.hpp"
@@ -993,7 +994,7 @@ public:
     void setTutorialValueForId(uint8_t id, uint32_t value);
 
     void loadTutorials();
-    void saveTutorials();
+    void saveTutorials(QueryBuffer* buf = nullptr);
 
 protected:
     uint32_t m_Tutorials[8] = {0};
@@ -1463,6 +1464,8 @@ public:
 
         void OutPacket(uint16 opcode, uint16 len, const void* data);
         void SendPacket(WorldPacket* packet);
+        // see WorldSession::SendBroadcastPacket
+        void SendBroadcastPacket(WorldPacket* packet, SharedWorldPacket& sharedPacket);
         void SendMessageToSet(WorldPacket* data, bool self, bool myteam_only = false);
         void OutPacketToSet(uint16 Opcode, uint16 Len, const void* Data, bool self);
 
@@ -1796,6 +1799,9 @@ public:
         bool LoadSkills(QueryResult* result);
         bool SaveSkills(bool NewCharacter, QueryBuffer* buf);
 
+        // Rows written by the last SaveToDB
+        PlayerSaveStatistics const& getLastSaveStatistics() const { return m_lastSaveStatistics; }
+
         bool m_FirstLogin;
 protected:
         ReputationMap m_reputation;
@@ -2309,6 +2315,16 @@ public:
         void _LoadPetSpells(QueryResult* result);
         void _SavePet(QueryBuffer* buf);
         void _SavePetSpells(QueryBuffer* buf);
+
+        // Records the loaded rows as saved, so SaveToDB only writes what changed after login
+        void _InitializeSavedRows();
+        // After a failed save the saved rows do not match the database anymore, all rows are written again
+        void _ResetSavedRows(QueryBuffer* buf);
+        uint64_t _GetCooldownsSaveValue(uint32 mstime) const;
+        uint64_t _GetSummonSpellsSaveValue() const;
+
+        PlayerSavedRows m_savedRows;
+        PlayerSaveStatistics m_lastSaveStatistics;
         
         void _EventAttack(bool offhand);
         
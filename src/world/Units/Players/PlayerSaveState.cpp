@@ -0,0 +1,102 @@
+/*
+Copyright (c) 2014-2021 AscEmu Team <http://www.ascemu.org>
+This file is released under the MIT license. See README-MIT for more information.
+*/
+
+#include "PlayerSaveState.hpp"
+
+void PlayerSaveStatistics::add(PlayerSaveStatistics const& other)
+{
+    for (uint8_t i = 0; i < PLAYER_SAVE_TABLE_COUNT; ++i)
+        rows[i] += other.rows[i];
+}
+
+uint32_t PlayerSaveStatistics::getTotal() const
+{
+    uint32_t total = 0;
+    for (const auto count : rows)
+        total += count;
+
+    return total;
+}
+
+bool SavedRowSet::update(uint64_t key, uint64_t value)
+{
+    const auto result = m_rows.emplace(key, SavedRow{ value, m_generation });
+    if (result.second)
+        return true;
+
+    SavedRow& row = result.first->second;
+    row.generation = m_generation;
+
+    if (row.value == value)
+        return false;
+
+    row.value = value;
+    return true;
+}
+
+std::vector<uint64_t> SavedRowSet::takeRemovedKeys()
+{
+    std::vector<uint64_t> removedKeys;
+
+    for (auto itr = m_rows.begin(); itr != m_rows.end();)
+    {
+        if (itr->second.generation != m_generation)
+        {
+            removedKeys.push_back(itr->first);
+            itr = m_rows.erase(itr);
+        }
+        else
+        {
+            ++itr;
+        }
+    }
+
+    ++m_generation;
+    return removedKeys;
+}
+
+void SavedRowSet::clear()
+{
+    m_rows.clear();
+    ++m_generation;
+}
+
+void PlayerSavedRows::clear()
+{
+    skills.clear();
+    spells.clear();
+    deletedSpells.clear();
+    reputations.clear();
+    cooldowns.clear();
+    pets.clear();
+    petSpells.clear();
+    summonSpells.clear();
+}
+
+uint64_t PlayerSavedRows::getSkillValue(uint32_t currentValue, uint32_t maximumValue)
+{
+    return (static_cast<uint64_t>(currentValue) << 32) | maximumValue;
+}
+
+uint64_t PlayerSavedRows::getReputationValue(uint8_t flag, int32_t baseStanding, int32_t standing)
+{
+    return SavedRowSet::hashValues({ flag, static_cast<uint32_t>(baseStanding), static_cast<uint32_t>(standing) });
+}
+
+uint64_t SavedRowSet::hashValues(std::initializer_list<uint64_t> values)
+{
+    // FNV-1a over the bytes of the values
+    uint64_t hash = 14695981039346656037ULL;
+    for (auto value : values)
+    {
+        for (uint8_t i = 0; i < 8; ++i)
+        {
+            hash ^= (value >> (i * 8)) & 0xFF;
+            hash *= 1099511628211ULL;
+        }
+    }
+
+    return hash;
+}
@@ -0,0 +1,90 @@
+/*
+Copyright (c) 2014-2021 AscEmu Team <http://www.ascemu.org>
+This file is released under the MIT license. See README-MIT for more information.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+// Tables written by Player::SaveToDB, used to count the written rows
+enum PlayerSaveTable : uint8_t
+{
+    PLAYER_SAVE_TABLE_CHARACTER,
+    PLAYER_SAVE_TABLE_ITEMS,
+    PLAYER_SAVE_TABLE_SPELLS,
+    PLAYER_SAVE_TABLE_SKILLS,
+    PLAYER_SAVE_TABLE_QUESTS,
+    PLAYER_SAVE_TABLE_REPUTATIONS,
+    PLAYER_SAVE_TABLE_COOLDOWNS,
+    PLAYER_SAVE_TABLE_PETS,
+    PLAYER_SAVE_TABLE_OTHER,
+    PLAYER_SAVE_TABLE_COUNT
+};
+
+struct PlayerSaveStatistics
+{
+    // statements sent to the character database, a delete and a replace of the same row count as two
+    uint32_t rows[PLAYER_SAVE_TABLE_COUNT] = {};
+
+    void add(PlayerSaveTable table, uint32_t count = 1) { rows[table] += count; }
+    void add(PlayerSaveStatistics const& other);
+    uint32_t getTotal() const;
+};
+
+// Values of the rows of one character table as they were last written to or loaded from the database.
+// Save functions pass every row they would write and only write the rows update() reports as changed,
+// rows which were not passed during a save are returned by takeRemovedKeys() so they can be deleted.
+class SavedRowSet
+{
+public:
+
+    // Records the value of the row, returns true if the row is new or its value differs from the recorded one
+    bool update(uint64_t key, uint64_t value = 0);
+
+    // Returns the keys which were not passed to update() since the previous call and forgets them
+    std::vector<uint64_t> takeRemovedKeys();
+
+    void clear();
+
+    static uint64_t hashValues(std::initializer_list<uint64_t> values);
+
+private:
+
+    struct SavedRow
+    {
+        uint64_t value;
+        uint32_t generation;
+    };
+
+    std::unordered_map<uint64_t, SavedRow> m_rows;
+    uint32_t m_generation = 0;
+};
+
+// Saved rows of the character tables which are written row by row
+struct PlayerSavedRows
+{
+    static uint64_t getSkillValue(uint32_t currentValue, uint32_t maximumValue);
+    static uint64_t getReputationValue(uint8_t flag, int32_t baseStanding, int32_t standing);
+
+    // forgets all rows, the next save writes every row again
+    void clear();
+
+    SavedRowSet skills;
+    SavedRowSet spells;
+    SavedRowSet deletedSpells;
+    SavedRowSet reputations;
+    SavedRowSet cooldowns;
+    SavedRowSet pets;
+    SavedRowSet petSpells;
+    SavedRowSet summonSpells;
+
+    // The rows are recorded when a save is queued. Set by the character database writer
+    // when that save failed, the rows it should have written are not in the database.
+    std::shared_ptr<std::atomic<bool>> saveFailed = std::make_shared<std::atomic<bool>>(false);
+};
@@ -623,7 +623,6 @@ Unit::Unit() :
     trackStealth = false;
 
     m_threatModifyer = 0;
-    memset(m_auras, 0, (MAX_TOTAL_AURAS_END)*sizeof(Aura*));
 
     // diminishing return stuff
     memset(m_diminishAuraCount, 0, DIMINISHING_GROUP_COUNT);
@@ -8163,16 +8162,12 @@ bool Unit::RemoveAura(Aura* aur)
 
 bool Unit::RemoveAura(uint32 spellId)
 {
-    //this can be speed up, if we know passive \pos neg
-    for (uint32 x = MAX_TOTAL_AURAS_START; x < MAX_TOTAL_AURAS_END; x++)
-    {
-        if (m_auras[x] && m_auras[x]->getSpellId() == spellId)
-        {
-            m_auras[x]->removeAura();
-            return true;  // sky: yes, only one, see bug charges/auras queues
-        }
-    }
-    return false;
+    const auto& slots = m_auras.getSlotsWithSpellId(spellId);
+    if (slots.empty())
+        return false;
+
+    m_auras[slots.front()]->removeAura();
+    return true;  // sky: yes, only one, see bug charges/auras queues
 }
 
 bool Unit::RemoveAuras(uint32* SpellIds)
@@ -8181,17 +8176,15 @@ bool Unit::RemoveAuras(uint32* SpellIds)
         return false;
 
     bool res = false;
-    for (uint32 x = MAX_TOTAL_AURAS_START; x < MAX_TOTAL_AURAS_END; x++)
+    for (uint32 y = 0; SpellIds[y] != 0; y++)
     {
-        if (m_auras[x])
+        const auto slots = m_auras.getSlotsWithSpellId(SpellIds[y]);
+        for (const auto slot : slots)
         {
-            for (uint32 y = 0; SpellIds[y] != 0; y++)
+            if (m_auras[slot] && m_auras[slot]->getSpellId() == SpellIds[y])
             {
-                if (m_auras[x] && m_auras[x]->getSpellId() == SpellIds[y])
-                {
-                    m_auras[x]->removeAura();
-                    res = true;
-                }
+                m_auras[slot]->removeAura();
+                res = true;
             }
         }
     }
@@ -8299,15 +8292,12 @@ void Unit::RemoveAllAreaAuraByOther()
 
 bool Unit::RemoveAura(uint32 spellId, uint64 guid)
 {
-    for (uint32 x = MAX_TOTAL_AURAS_START; x < MAX_TOTAL_AURAS_END; x++)
+    for (const auto slot : m_auras.getSlotsWithSpellId(spellId))
     {
-        if (m_auras[x])
+        if (m_auras[slot]->getCasterGuid() == guid)
         {
-            if (m_auras[x]->getSpellId() == spellId && m_auras[x]->getCasterGuid() == guid)
-            {
-                m_auras[x]->removeAura();
-                return true;
-            }
+            m_auras[slot]->removeAura();
+            return true;
         }
     }
     return false;
@@ -8315,15 +8305,12 @@ bool Unit::RemoveAura(uint32 spellId, uint64 guid)
 
 bool Unit::RemoveAuraByItemGUID(uint32 spellId, uint64 guid)
 {
-    for (uint32 x = MAX_TOTAL_AURAS_START; x < MAX_TOTAL_AURAS_END; x++)
+    for (const auto slot : m_auras.getSlotsWithSpellId(spellId))
     {
-        if (m_auras[x])
+        if (m_auras[slot]->itemCasterGUID == guid)
         {
-            if (m_auras[x]->getSpellId() == spellId && m_auras[x]->itemCasterGUID == guid)
-            {
-                m_auras[x]->removeAura();
-                return true;
-            }
+            m_auras[slot]->removeAura();
+            return true;
         }
     }
     return false;
@@ -8345,11 +8332,8 @@ void Unit::RemoveNegativeAuras()
 
 void Unit::RemoveAllAuras()
 {
-    for (uint32 x = MAX_TOTAL_AURAS_START; x < MAX_TOTAL_AURAS_END; x++)
-    {
-        if (m_auras[x])
-            m_auras[x]->removeAura();
-    }
+    for (auto slot = m_auras.getNextOccupiedSlot(0); slot < MAX_TOTAL_AURAS_END; slot = m_auras.getNextOccupiedSlot(slot + 1))
+        m_auras[slot]->removeAura();
 }
 
 void Unit::RemoveAllNonPersistentAuras()
@@ -8369,9 +8353,14 @@ void Unit::RemoveAllNonPersistentAuras()
 //ex:to remove morph spells
 void Unit::RemoveAllAuraType(uint32 auratype)
 {
-    for (uint32 x = MAX_TOTAL_AURAS_START; x < MAX_TOTAL_AURAS_END; x++)
-        if (m_auras[x] && m_auras[x]->hasAuraEffect(static_cast<AuraEffect>(auratype)))
-            m_auras[x]->removeAura();//remove all morph auras containing to this spell (like wolf morph also gives speed)
+    const auto auraEffect = static_cast<AuraEffect>(auratype);
+    if (!m_auras.mayHaveAuraEffect(auraEffect))
+        return;
+
+    const auto slots = m_auras.getSlotsWithAuraEffect(auraEffect);
+    for (const auto slot : slots)
+        if (m_auras[slot] && m_auras[slot]->hasAuraEffect(auraEffect))
+            m_auras[slot]->removeAura();//remove all morph auras containing to this spell (like wolf morph also gives speed)
 }
 
 bool Unit::SetAurDuration(uint32 spellId, Unit* caster, uint32 duration)
@@ -8578,7 +8567,7 @@ void Unit::RemoveAurasByInterruptFlag(uint32 flag)
         if (a->getSpellInfo()->getAuraInterruptFlags() & flag)
         {
             a->removeAura();
-            m_auras[x] = NULL;
+            m_auras.clear(static_cast<uint16_t>(x));
         }
     }
 }
@@ -8595,11 +8584,7 @@ bool Unit::HasAuraVisual(uint32 visualid)
 
 bool Unit::HasAura(uint32 spellid)
 {
-    for (uint32 x = MAX_TOTAL_AURAS_START; x < MAX_TOTAL_AURAS_END; x++)
-        if (m_auras[x] && m_auras[x]->getSpellId() == spellid)
-            return true;
-
-    return false;
+    return !m_auras.getSlotsWithSpellId(spellid).empty();
 }
 
 Aura* Unit::GetAuraWithSlot(uint32 slot)
@@ -8613,12 +8598,7 @@ Aura* Unit::GetAuraWithSlot(uint32 slot)
 
 uint16 Unit::GetAuraStackCount(uint32 spellid)
 {
-    uint16 count = 0;
-    for (uint32 x = MAX_TOTAL_AURAS_START; x < MAX_TOTAL_AURAS_END; x++)
-        if (m_auras[x] && m_auras[x]->getSpellId() == spellid)
-            count++;
-
-    return count;
+    return static_cast<uint16>(m_auras.getSlotsWithSpellId(spellid).size());
 }
 
 void Unit::DropAurasOnDeath()
@@ -8668,8 +8648,8 @@ void Unit::UpdateSpeed()
 
 bool Unit::HasBuff(uint32 spellid) // cebernic:it does not check passive auras & must be visible auras
 {
-    for (uint32 x = MAX_POSITIVE_AURAS_EXTEDED_START; x < MAX_POSITIVE_AURAS_EXTEDED_END; x++)
-        if (m_auras[x] && m_auras[x]->getSpellId() == spellid)
+    for (const auto slot : m_auras.getSlotsWithSpellId(spellid))
+        if (slot >= MAX_POSITIVE_AURAS_EXTEDED_START && slot < MAX_POSITIVE_AURAS_EXTEDED_END)
             return true;
 
     return false;
@@ -8677,8 +8657,8 @@ bool Unit::HasBuff(uint32 spellid) // cebernic:it does not check passive auras &
 
 bool Unit::HasBuff(uint32 spellid, uint64 guid)
 {
-    for (uint32 x = MAX_POSITIVE_AURAS_EXTEDED_START; x < MAX_POSITIVE_AURAS_EXTEDED_END; x++)
-        if (m_auras[x] && m_auras[x]->getSpellId() == spellid && m_auras[x]->getCasterGuid() == guid)
+    for (const auto slot : m_auras.getSlotsWithSpellId(spellid))
+        if (slot >= MAX_POSITIVE_AURAS_EXTEDED_START && slot < MAX_POSITIVE_AURAS_EXTEDED_END && m_auras[slot]->getCasterGuid() == guid)
             return true;
 
     return false;
@@ -8869,7 +8849,7 @@ void Unit::RemoveFromWorld(bool free_guid)
     RemoveAllAreaAuraByOther();
 
     // Attempt to prevent memory corruption
-    for (auto& obj : getInRangeObjectsSet())
+    for (auto obj : getInRangeObjectsSet())
     {
         if (!obj->isCreatureOrPlayer())
             continue;
@@ -8886,7 +8866,7 @@ void Unit::RemoveFromWorld(bool free_guid)
         {
             if (m_auras[x]->m_deleted)
             {
-                m_auras[x] = NULL;
+                m_auras.clear(static_cast<uint16_t>(x));
                 continue;
             }
             m_auras[x]->RelocateEvents();
@@ -9456,18 +9436,11 @@ void Unit::CombatStatusHandler_ResetPvPTimeout()
         return;
 
     m_lock.Acquire();
-    EventMap::iterator itr = m_events.find(EVENT_ATTACK_TIMEOUT);
-    if (itr != m_events.end())
+    if (event_HasEvent(EVENT_ATTACK_TIMEOUT))
     {
-        for (; itr != m_events.upper_bound(EVENT_ATTACK_TIMEOUT); ++itr)
-        {
-            if (!itr->second->deleted)
-            {
-                itr->second->currTime = 5000;
-                m_lock.Release();
-                return;
-            }
-        }
+        event_ModifyTimeLeft(EVENT_ATTACK_TIMEOUT, 5000, true);
+        m_lock.Release();
+        return;
     }
 
     sEventMgr.AddEvent(this, &Unit::CombatStatusHandler_UpdatePvPTimeout, EVENT_ATTACK_TIMEOUT, 5000, 1, EVENT_FLAG_DO_NOT_EXECUTE_IN_WORLD_CONTEXT);
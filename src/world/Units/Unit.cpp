@@ -3360,7 +3360,7 @@ void Unit::addAura(Aura* aur)
     aur->m_visualSlot = visualSlot;
     aur->m_auraSlot = auraSlot;
 
-    m_auras[auraSlot] = aur;
+    m_auras.set(auraSlot, aur);
 
     if (visualSlot < MAX_NEGATIVE_VISUAL_AURAS_END)
     {
@@ -3506,28 +3506,16 @@ uint8_t Unit::findVisualSlotForAura(bool isPositive) const
 
 Aura* Unit::getAuraWithId(uint32_t spell_id)
 {
-    for (uint32_t i = MAX_TOTAL_AURAS_START; i < MAX_TOTAL_AURAS_END; ++i)
-    {
-        Aura* aura = m_auras[i];
-        if (aura != nullptr)
-        {
-            if (aura->getSpellId() == spell_id)
-                return aura;
-        }
-    }
-
-    return nullptr;
+    const auto& slots = m_auras.getSlotsWithSpellId(spell_id);
+    return slots.empty() ? nullptr : m_auras[slots.front()];
 }
 
 bool Unit::hasAurasWithId(uint32_t* auraId)
 {
     for (int i = 0; auraId[i] != 0; ++i)
     {
-        for (uint32_t x = MAX_TOTAL_AURAS_START; x < MAX_TOTAL_AURAS_END; ++x)
-        {
-            if (m_auras[x] && m_auras[x]->getSpellInfo()->getId() == auraId[i])
-                return true;
-        }
+        if (!m_auras.getSlotsWithSpellId(auraId[i]).empty())
+            return true;
     }
 
     return false;
@@ -3535,11 +3523,12 @@ bool Unit::hasAurasWithId(uint32_t* auraId)
 
 bool Unit::hasAuraWithAuraEffect(AuraEffect type) const
 {
-    for (auto i = MAX_TOTAL_AURAS_START; i < MAX_TOTAL_AURAS_END; ++i)
+    if (!m_auras.mayHaveAuraEffect(type))
+        return false;
+
+    for (const auto slot : m_auras.getSlotsWithAuraEffect(type))
     {
-        if (m_auras[i] == nullptr)
-            continue;
-        if (m_auras[i]->getSpellInfo()->hasEffectApplyAuraName(type))
+        if (m_auras[slot]->getSpellInfo()->hasEffectApplyAuraName(type))
             return true;
     }
     return false;
@@ -3549,13 +3538,11 @@ bool Unit::hasAuraState(AuraState state, SpellInfo const* spellInfo, Unit const*
 {
     if (caster != nullptr && spellInfo != nullptr && caster->hasAuraWithAuraEffect(SPELL_AURA_IGNORE_TARGET_AURA_STATE))
     {
-        for (auto i = MAX_TOTAL_AURAS_START; i < MAX_TOTAL_AURAS_END; ++i)
+        for (const auto slot : caster->m_auras.getSlotsWithAuraEffect(SPELL_AURA_IGNORE_TARGET_AURA_STATE))
         {
-            if (caster->m_auras[i] == nullptr)
-                continue;
-            if (!caster->m_auras[i]->getSpellInfo()->hasEffectApplyAuraName(SPELL_AURA_IGNORE_TARGET_AURA_STATE))
+            if (!caster->m_auras[slot]->getSpellInfo()->hasEffectApplyAuraName(SPELL_AURA_IGNORE_TARGET_AURA_STATE))
                 continue;
-            if (caster->m_auras[i]->getSpellInfo()->isAuraEffectAffectingSpell(SPELL_AURA_IGNORE_TARGET_AURA_STATE, spellInfo))
+            if (caster->m_auras[slot]->getSpellInfo()->isAuraEffectAffectingSpell(SPELL_AURA_IGNORE_TARGET_AURA_STATE, spellInfo))
                 return true;
         }
     }
@@ -3594,30 +3581,27 @@ void Unit::removeAuraStateAndAuras(AuraState state)
         removeAuraState(static_cast<uint32_t>(1 << (state - 1)));
         // Remove self-applied passive auras requiring this aurastate
         // Skip removing enrage effects
-        for (auto i = MAX_TOTAL_AURAS_START; i < MAX_TOTAL_AURAS_END; ++i)
+        const auto slots = m_auras.getSlotsWithCaster(getGuid());
+        for (const auto slot : slots)
         {
-            if (m_auras[i] == nullptr)
+            if (m_auras[slot] == nullptr)
                 continue;
-            if (m_auras[i]->getCasterGuid() != getGuid())
+            if (m_auras[slot]->getCasterGuid() != getGuid())
                 continue;
-            if (m_auras[i]->getSpellInfo()->getCasterAuraState() != static_cast<uint32_t>(state))
+            if (m_auras[slot]->getSpellInfo()->getCasterAuraState() != static_cast<uint32_t>(state))
                 continue;
-            if (m_auras[i]->getSpellInfo()->isPassive() || state != AURASTATE_FLAG_ENRAGED)
-                RemoveAura(m_auras[i]);
+            if (m_auras[slot]->getSpellInfo()->isPassive() || state != AURASTATE_FLAG_ENRAGED)
+                RemoveAura(m_auras[slot]);
         }
     }
 }
 
 Aura* Unit::getAuraWithIdForGuid(uint32_t spell_id, uint64_t target_guid)
 {
-    for (uint32_t i = MAX_TOTAL_AURAS_START; i < MAX_TOTAL_AURAS_END; ++i)
+    for (const auto slot : m_auras.getSlotsWithSpellId(spell_id))
     {
-        Aura* aura = m_auras[i];
-        if (aura != nullptr)
-        {
-            if (aura->getSpellId() == spell_id && aura->getCasterGuid() == target_guid)
-                return aura;
-        }
+        if (m_auras[slot]->getCasterGuid() == target_guid)
+            return m_auras[slot];
     }
 
     return nullptr;
@@ -3625,11 +3609,13 @@ Aura* Unit::getAuraWithIdForGuid(uint32_t spell_id, uint64_t target_guid)
 
 Aura* Unit::getAuraWithAuraEffect(AuraEffect aura_effect)
 {
-    for (uint32_t i = MAX_TOTAL_AURAS_START; i < MAX_TOTAL_AURAS_END; ++i)
+    if (!m_auras.mayHaveAuraEffect(aura_effect))
+        return nullptr;
+
+    for (const auto slot : m_auras.getSlotsWithAuraEffect(aura_effect))
     {
-        Aura* aura = m_auras[i];
-        if (aura != nullptr && aura->getSpellInfo()->hasEffectApplyAuraName(aura_effect))
-            return aura;
+        if (m_auras[slot]->getSpellInfo()->hasEffectApplyAuraName(aura_effect))
+            return m_auras[slot];
     }
 
     return nullptr;
@@ -3637,24 +3623,16 @@ Aura* Unit::getAuraWithAuraEffect(AuraEffect aura_effect)
 
 bool Unit::hasAurasWithId(uint32_t auraId)
 {
-    for (uint32_t x = MAX_TOTAL_AURAS_START; x < MAX_TOTAL_AURAS_END; ++x)
-    {
-        if (m_auras[x] && m_auras[x]->getSpellInfo()->getId() == auraId)
-            return true;
-    }
-
-    return false;
+    return !m_auras.getSlotsWithSpellId(auraId).empty();
 }
 
 Aura* Unit::getAuraWithId(uint32_t* auraId)
 {
     for (int i = 0; auraId[i] != 0; ++i)
     {
-        for (uint32_t x = MAX_TOTAL_AURAS_START; x < MAX_TOTAL_AURAS_END; ++x)
-        {
-            if (m_auras[x] && m_auras[x]->getSpellInfo()->getId() == auraId[i])
-                return m_auras[x];
-        }
+        const auto& slots = m_auras.getSlotsWithSpellId(auraId[i]);
+        if (!slots.empty())
+            return m_auras[slots.front()];
     }
 
     return nullptr;
@@ -3662,28 +3640,17 @@ Aura* Unit::getAuraWithId(uint32_t* auraId)
 
 uint32_t Unit::getAuraCountForId(uint32_t auraId)
 {
-    uint32_t auraCount = 0;
-
-    for (uint32_t x = MAX_TOTAL_AURAS_START; x < MAX_TOTAL_AURAS_END; ++x)
-    {
-        if (m_auras[x] && (m_auras[x]->getSpellInfo()->getId() == auraId))
-        {
-            ++auraCount;
-        }
-    }
-
-    return auraCount;
+    return static_cast<uint32_t>(m_auras.getSlotsWithSpellId(auraId).size());
 }
 
 Aura* Unit::getAuraWithIdForGuid(uint32_t* auraId, uint64 guid)
 {
     for (int i = 0; auraId[i] != 0; ++i)
     {
-        for (uint32 x = MAX_TOTAL_AURAS_START; x < MAX_TOTAL_AURAS_END; ++x)
+        for (const auto slot : m_auras.getSlotsWithSpellId(auraId[i]))
         {
-            Aura* aura = m_auras[x];
-            if (aura != nullptr && aura->getSpellInfo()->getId() == auraId[i] && aura->getCasterGuid() == guid)
-                return aura;
+            if (m_auras[slot]->getCasterGuid() == guid)
+                return m_auras[slot];
         }
     }
 
@@ -3692,48 +3659,29 @@ Aura* Unit::getAuraWithIdForGuid(uint32_t* auraId, uint64 guid)
 
 void Unit::removeAllAurasById(uint32_t auraId)
 {
-    for (uint32_t x = MAX_TOTAL_AURAS_START; x < MAX_TOTAL_AURAS_END; ++x)
+    const auto slots = m_auras.getSlotsWithSpellId(auraId);
+    for (const auto slot : slots)
     {
-        if (m_auras[x])
-        {
-            if (m_auras[x]->getSpellInfo()->getId() == auraId)
-            {
-                m_auras[x]->removeAura();
-            }
-        }
+        if (m_auras[slot] && m_auras[slot]->getSpellId() == auraId)
+            m_auras[slot]->removeAura();
     }
 }
 
 void Unit::removeAllAurasById(uint32_t* auraId)
 {
     for (int i = 0; auraId[i] != 0; ++i)
-    {
-        for (uint32_t x = MAX_TOTAL_AURAS_START; x < MAX_TOTAL_AURAS_END; ++x)
-        {
-            if (m_auras[x])
-            {
-                if (m_auras[x]->getSpellInfo()->getId() == auraId[i])
-                {
-                    m_auras[x]->removeAura();
-                }
-            }
-        }
-    }
+        removeAllAurasById(auraId[i]);
 }
 
 void Unit::removeAllAurasByIdForGuid(uint32_t spellId, uint64_t guid)
 {
-    for (uint32_t x = MAX_TOTAL_AURAS_START; x < MAX_TOTAL_AURAS_END; ++x)
+    const auto slots = m_auras.getSlotsWithSpellId(spellId);
+    for (const auto slot : slots)
     {
-        if (m_auras[x])
+        if (m_auras[slot] && m_auras[slot]->getSpellId() == spellId)
         {
-            if (m_auras[x]->getSpellId() == spellId)
-            {
-                if (!guid || m_auras[x]->getCasterGuid() == guid)
-                {
-                    m_auras[x]->removeAura();
-                }
-            }
+            if (!guid || m_auras[slot]->getCasterGuid() == guid)
+                m_auras[slot]->removeAura();
         }
     }
 }
@@ -3741,15 +3689,14 @@ void Unit::removeAllAurasByIdForGuid(uint32_t spellId, uint64_t guid)
 uint32_t Unit::removeAllAurasByIdReturnCount(uint32_t auraId)
 {
     uint32_t res = 0;
-    for (uint32_t x = MAX_TOTAL_AURAS_START; x < MAX_TOTAL_AURAS_END; ++x)
+
+    const auto slots = m_auras.getSlotsWithSpellId(auraId);
+    for (const auto slot : slots)
     {
-        if (m_auras[x])
+        if (m_auras[slot] && m_auras[slot]->getSpellId() == auraId)
         {
-            if (m_auras[x]->getSpellInfo()->getId() == auraId)
-            {
-                m_auras[x]->removeAura();
-                ++res;
-            }
+            m_auras[slot]->removeAura();
+            ++res;
         }
     }
     return res;
@@ -3757,12 +3704,16 @@ uint32_t Unit::removeAllAurasByIdReturnCount(uint32_t auraId)
 
 void Unit::removeAllAurasByAuraEffect(AuraEffect effect, uint32_t skipSpell/* = 0*/, bool removeOnlyEffect/* = false*/)
 {
-    for (auto i = MAX_TOTAL_AURAS_START; i < MAX_TOTAL_AURAS_END; ++i)
+    if (!m_auras.mayHaveAuraEffect(effect))
+        return;
+
+    const auto slots = m_auras.getSlotsWithAuraEffect(effect);
+    for (const auto slot : slots)
     {
-        if (m_auras[i] == nullptr)
+        if (m_auras[slot] == nullptr)
             continue;
 
-        const auto aur = m_auras[i];
+        const auto aur = m_auras[slot];
         for (uint8_t x = 0; x < MAX_SPELL_EFFECTS; ++x)
         {
             if (aur->getAuraEffect(x).getAuraEffectType() == SPELL_AURA_NONE)
@@ -4028,14 +3979,8 @@ bool Unit::sendPeriodicAuraLog(const WoWGuid& casterGuid, const WoWGuid& targetG
 
 void Unit::_updateAuras(unsigned long diff)
 {
-    for (auto i = MAX_TOTAL_AURAS_START; i < MAX_TOTAL_AURAS_END; ++i)
-    {
-        const auto aur = m_auras[i];
-        if (aur == nullptr)
-            continue;
-
-        aur->update(diff);
-    }
+    for (auto slot = m_auras.getNextOccupiedSlot(0); slot < MAX_TOTAL_AURAS_END; slot = m_auras.getNextOccupiedSlot(slot + 1))
+        m_auras[slot]->update(diff);
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////
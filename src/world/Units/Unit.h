@@ -24,6 +24,7 @@
 #include "Objects/Object.h"
 
 #include "UnitDefines.hpp"
+#include "Units/AuraContainer.hpp"
 #include "Management/LootMgr.h"
 #include "Objects/Object.h"
 #include "Macros/UnitMacros.hpp"
@@ -1369,7 +1370,7 @@ public:
 
     bool m_can_stealth;
 
-    Aura* m_auras[MAX_TOTAL_AURAS_END];
+    AuraContainer m_auras;
 
     int32 m_modlanguage;
 